@@ -65,6 +65,32 @@
 #define MSK_16BIT_FIFO1         (5U)
 #define MSK_32BIT               (6U)
 
+/* The receive buffers are indexed with ptr & (length - 1) */
+#if (CAN0_USE_RX_BUFFER == 1) && ((CAN0_RX_BUFFER_LENGTH & (CAN0_RX_BUFFER_LENGTH - 1U)) != 0U)
+#error "CAN0_RECEIVE_BUFFER_LENGTH must be a power of two"
+#endif
+#if (CAN1_USE_RX_BUFFER == 1) && ((CAN1_RX_BUFFER_LENGTH & (CAN1_RX_BUFFER_LENGTH - 1U)) != 0U)
+#error "CAN1_RECEIVE_BUFFER_LENGTH must be a power of two"
+#endif
+
+/**
+ * entry of the sorted RX message lookup table
+ */
+typedef struct {
+    uint32_t ID;        /*!< message ID */
+    uint8_t rxIndex;    /*!< index of the message in can0_RxMsgs or can1_RxMsgs */
+    uint8_t bypass;     /*!< TRUE if the message bypasses the receive buffer */
+} CAN_RX_LOOKUP_ENTRY_s;
+
+/**
+ * RX message IDs of one CAN node, sorted by ID for binary search
+ */
+typedef struct {
+    CAN_RX_LOOKUP_ENTRY_s* entries;     /*!< entries sorted by ID */
+    uint8_t maxLength;                  /*!< size of entries */
+    uint8_t length;                     /*!< number of used entries */
+} CAN_RX_LOOKUP_s;
+
 /*================== Constant and Variable Definitions ====================*/
 uint8_t canNode0_listenonly_mode = 0;
 uint8_t canNode1_listenonly_mode = 0;
@@ -81,14 +107,20 @@ CAN_TX_BUFFER_s can0_txbuffer = {
 #if CAN0_USE_RX_BUFFER
 CAN_RX_BUFFERELEMENT_s can0_rxbufferelements[CAN0_RX_BUFFER_LENGTH];
 CAN_RX_BUFFER_s can0_rxbuffer = {
+    .ptrRead = 0,
+    .ptrWrite = 0,
     .length = CAN0_RX_BUFFER_LENGTH,
     .buffer = &can0_rxbufferelements[0],
+    .droppedMsgs = 0,
 };
 #endif /* CAN0_USE_RX_BUFFER */
 
-#if CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0
-uint8_t can0_fastLinkIndex[CAN0_BUFFER_BYPASS_NUMBER_OF_IDs];   /* Link Table for bufferBypassing */
-#endif
+static CAN_RX_LOOKUP_ENTRY_s can0_rxLookupEntries[CAN0_RX_LOOKUP_LENGTH];
+static CAN_RX_LOOKUP_s can0_rxLookup = {
+    .entries = &can0_rxLookupEntries[0],
+    .maxLength = CAN0_RX_LOOKUP_LENGTH,
+    .length = 0,
+};
 
 CAN_ERROR_s CAN0_errorStruct = {
     .canError = HAL_CAN_ERROR_NONE,
@@ -108,14 +140,20 @@ CAN_TX_BUFFER_s can1_txbuffer = {
 #if CAN1_USE_RX_BUFFER
 CAN_RX_BUFFERELEMENT_s can1_rxbufferelements[CAN1_RX_BUFFER_LENGTH];
 CAN_RX_BUFFER_s can1_rxbuffer = {
+        .ptrRead = 0,
+        .ptrWrite = 0,
         .length = CAN1_RX_BUFFER_LENGTH,
         .buffer = &can1_rxbufferelements[0],
+        .droppedMsgs = 0,
 };
 #endif /* CAN1_USE_RX_BUFFER */
 
-#if CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0
-uint8_t can1_fastLinkIndex[CAN1_BUFFER_BYPASS_NUMBER_OF_IDs];   /* Link Table for bufferBypassing */
-#endif
+static CAN_RX_LOOKUP_ENTRY_s can1_rxLookupEntries[CAN1_RX_LOOKUP_LENGTH];
+static CAN_RX_LOOKUP_s can1_rxLookup = {
+        .entries = &can1_rxLookupEntries[0],
+        .maxLength = CAN1_RX_LOOKUP_LENGTH,
+        .length = 0,
+};
 
 CAN_ERROR_s CAN1_errorStruct = {
     .canError = HAL_CAN_ERROR_NONE,
@@ -138,6 +176,10 @@ static uint8_t CAN_GetNextID(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxID
         uint8_t filterCase);
 static uint8_t CAN_NumberOfNeededFilters(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t* numberOfDifferentIDs, uint32_t* error);
 static uint32_t CAN_InitFilter(CAN_HandleTypeDef* ptrHcan, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs);
+static STD_RETURN_TYPE_e CAN_InitRxLookup(CAN_RX_LOOKUP_s* lookup, const CAN_MSG_RX_TYPE_s* can_RxMsgs,
+        uint8_t numberOfRxMsgs, const uint32_t* bypassIDs, uint8_t numberOfBypassIDs);
+static const CAN_RX_LOOKUP_ENTRY_s* CAN_FindRxMsg(CAN_NodeTypeDef_e canNode, uint32_t msgID);
+static CAN_RX_BUFFER_s* CAN_GetRxBuffer(CAN_NodeTypeDef_e canNode);
 
 /* Interrupts */
 static void CAN_TxCpltCallback(CAN_NodeTypeDef_e canNode);
@@ -174,6 +216,12 @@ uint32_t CAN_Init(void) {
     /* Configure CAN0 hardware filter */
     retval |= CAN_InitFilter(&hcan0, &can0_RxMsgs[0], can_CAN0_rx_length);
 
+    /* Sort RX message IDs for the lookup in the receive interrupt */
+    if (CAN_InitRxLookup(&can0_rxLookup, &can0_RxMsgs[0], can_CAN0_rx_length,
+            &can0_bufferBypass_RxMsgs[0], CAN0_BUFFER_BYPASS_NUMBER_OF_IDs) != E_OK) {
+        retval |= STD_ERR_BIT_17;
+    }
+
     /* Check if more rx messages are bypassed than received */
 #pragma GCC diagnostic push
     /* configurations might exist that use this comparison */
@@ -225,6 +273,12 @@ uint32_t CAN_Init(void) {
     /* Configure CAN1 hardware filter */
     retval |= CAN_InitFilter(&hcan1, &can1_RxMsgs[0], can_CAN1_rx_length);
 
+    /* Sort RX message IDs for the lookup in the receive interrupt */
+    if (CAN_InitRxLookup(&can1_rxLookup, &can1_RxMsgs[0], can_CAN1_rx_length,
+            &can1_bufferBypass_RxMsgs[0], CAN1_BUFFER_BYPASS_NUMBER_OF_IDs) != E_OK) {
+        retval |= STD_ERR_BIT_18;
+    }
+
     /* Check if more RX messages are bypassed than received */
 #pragma GCC diagnostic push
     /* configurations might exist that use this comparison */
@@ -469,34 +523,6 @@ static uint8_t CAN_NumberOfNeededFilters(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t*
     }
 
     for (uint8_t i = 0; i < can_rx_length; i++) {
-#if (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0) && (CAN_USE_CAN_NODE0 == 1)
-
-        if (can_RxMsgs  ==  &can0_RxMsgs[0]) {
-            /* Set buffer bypass IDs link table */
-            for (uint8_t k = 0; k < CAN0_BUFFER_BYPASS_NUMBER_OF_IDs; k++) {
-                if (can_RxMsgs[i].ID  ==  can0_bufferBypass_RxMsgs[k]) {
-                    /* bypass ID  ==  ID in message receive struct */
-
-                    can0_fastLinkIndex[k] = i;   /* set for can_bufferBypass_RxMsgs[k] link to array index */
-                    break;
-                }
-            }
-        }
-#endif /* (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0) && (CAN_USE_CAN_NODE0 == 1) */
-#if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0) && (CAN_USE_CAN_NODE1 == 1)
-
-        if (can_RxMsgs  ==  &can1_RxMsgs[0]) {
-            /* Set buffer bypass IDs link table */
-            for (int k = 0; k < CAN1_BUFFER_BYPASS_NUMBER_OF_IDs; k++) {
-                if (can1_RxMsgs[i].ID  ==  can1_bufferBypass_RxMsgs[k]) {
-                    /* bypass ID  ==  ID in message receive struct */
-
-                    can1_fastLinkIndex[k] = i;   /* set for can1_bufferBypass_RxMsgs[k] link to array index */
-                    break;
-                }
-            }
-        }
-#endif /* (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0) && (CAN_USE_CAN_NODE1 == 1) */
         if (can_RxMsgs[i].mask == 0 && IS_CAN_STDID(can_RxMsgs[i].ID)) {
             /* ID List mode 16bit */
 
@@ -556,6 +582,63 @@ static uint8_t CAN_NumberOfNeededFilters(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t*
     return retVal;
 }
 
+/**
+ * @brief  Sorts the RX message IDs of a CAN node for the lookup in the receive interrupt
+ *
+ * Insertion sort is used, the configuration is small and only sorted once.
+ * If an ID is configured more than once, the first message is kept, as the
+ * linear search did before.
+ *
+ * @param  lookup:              lookup table to fill
+ * @param  can_RxMsgs:          RX message configuration of the CAN node
+ * @param  numberOfRxMsgs:      number of RX messages
+ * @param  bypassIDs:           IDs that bypass the receive buffer
+ * @param  numberOfBypassIDs:   number of bypassed IDs
+ *
+ * @retval E_OK if all RX messages fit in the lookup table, otherwise E_NOT_OK
+ */
+static STD_RETURN_TYPE_e CAN_InitRxLookup(CAN_RX_LOOKUP_s* lookup, const CAN_MSG_RX_TYPE_s* can_RxMsgs,
+        uint8_t numberOfRxMsgs, const uint32_t* bypassIDs, uint8_t numberOfBypassIDs) {
+    STD_RETURN_TYPE_e retVal = E_OK;
+    uint8_t pos = 0;
+    uint8_t duplicate = FALSE;
+
+    lookup->length = 0;
+    for (uint8_t i = 0; i < numberOfRxMsgs; i++) {
+        if (lookup->length >= lookup->maxLength) {
+            /* CANx_RX_LOOKUP_LENGTH too small */
+            retVal = E_NOT_OK;
+            break;
+        }
+
+        /* find insert position and shift larger IDs up */
+        duplicate = FALSE;
+        pos = lookup->length;
+        while ((pos > 0) && (lookup->entries[pos - 1].ID >= can_RxMsgs[i].ID)) {
+            if (lookup->entries[pos - 1].ID == can_RxMsgs[i].ID) {
+                duplicate = TRUE;
+                break;
+            }
+            pos--;
+        }
+        if (duplicate == FALSE) {
+            for (uint8_t k = lookup->length; k > pos; k--) {
+                lookup->entries[k] = lookup->entries[k - 1];
+            }
+            lookup->entries[pos].ID = can_RxMsgs[i].ID;
+            lookup->entries[pos].rxIndex = i;
+            lookup->entries[pos].bypass = FALSE;
+            for (uint8_t k = 0; k < numberOfBypassIDs; k++) {
+                if (bypassIDs[k] == can_RxMsgs[i].ID) {
+                    lookup->entries[pos].bypass = TRUE;
+                }
+            }
+            lookup->length++;
+        }
+    }
+    return retVal;
+}
+
 /**
  * @brief  Returns the next index of wished filter ID setting in CAN_MSG_RX_TYPE_t can_RxMsgs[CAN_NUMBER_OF_RX_IDs]
  *
@@ -1095,146 +1178,137 @@ STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode) {
  * @retval none (void)
  */
 static void CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef* ptrHcan, uint8_t FIFONumber) {
-    uint8_t bypassLinkIndex = 0;
     CAN_RX_BUFFERELEMENT_s tmpMsgBuffer;
+    CAN_RX_BUFFERELEMENT_s* rxElement = &tmpMsgBuffer;
     uint32_t msgID = 0;
-
-#if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
-    uint32_t* can_bufferbypass_rxmsgs = NULL;
-    uint32_t bufferbypasslength = 0;
-    CAN_RX_BUFFER_s* can_rxbuffer = NULL;
+    const CAN_RX_LOOKUP_ENTRY_s* rxEntry = NULL;
     CAN_MSG_RX_TYPE_s* can_rxmsgs = NULL;
-    uint8_t* can_fastLinkIndex = NULL;
-#endif /* CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER */
+    CAN_RX_BUFFER_s* can_rxbuffer = CAN_GetRxBuffer(canNode);
 
-    /* Set pointer on respective RxBuffer */
     if (canNode  ==  CAN_NODE1) {
-#if CAN1_USE_RX_BUFFER && CAN_USE_CAN_NODE1 == 1
-        can_rxbuffer = &can1_rxbuffer;
-#if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0u)
         can_rxmsgs = &can1_RxMsgs[0];
-        can_bufferbypass_rxmsgs = &can1_bufferBypass_RxMsgs[0];
-        bufferbypasslength = CAN1_BUFFER_BYPASS_NUMBER_OF_IDs;
-        can_fastLinkIndex = &can1_fastLinkIndex[0];
-#endif /* (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0u) */
-#endif /* CAN1_USE_RX_BUFFER && CAN_USE_CAN_NODE1 == 1 */
-    } else if (canNode  ==  CAN_NODE0) {
-#if CAN0_USE_RX_BUFFER && CAN_USE_CAN_NODE0 == 1
-        can_rxbuffer = &can0_rxbuffer;
-#if (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0U)
+    } else {
         can_rxmsgs = &can0_RxMsgs[0];
-        can_bufferbypass_rxmsgs = &can0_bufferBypass_RxMsgs[0];
-        bufferbypasslength = CAN0_BUFFER_BYPASS_NUMBER_OF_IDs;
-        can_fastLinkIndex = &can0_fastLinkIndex[0];
-#endif /* (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0u) */
-#endif /* CAN0_USE_RX_BUFFER && CAN_USE_CAN_NODE0 == 1 */
     }
 
-    /* Get message ID */
-    HAL_CAN_GetRxMessage(ptrHcan, FIFONumber, &tmpMsgBuffer.msg , &tmpMsgBuffer.data[0]);
-
-#if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0) || (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0)
-    if (can_bufferbypass_rxmsgs != NULL) {
-        /* only needed when messages are bypassed */
+    /* NO NEED TO DISABLE INTERRUPTS, BECAUSE FUNCTION IS CALLED FROM ISR */
 
-        for (bypassLinkIndex = 0; bypassLinkIndex < bufferbypasslength; bypassLinkIndex++) {
-            if ((tmpMsgBuffer.msg.StdId == can_bufferbypass_rxmsgs[bypassLinkIndex]) ||
-                (tmpMsgBuffer.msg.ExtId == can_bufferbypass_rxmsgs[bypassLinkIndex])) {
-                break;
-            }
-        }
+    /* Read the message directly into the next free buffer element. It is
+     * only published by incrementing ptrWrite, so a bypassed message or a
+     * full buffer leaves the buffer unchanged. */
+    if ((can_rxbuffer != NULL) && ((can_rxbuffer->ptrWrite - can_rxbuffer->ptrRead) < can_rxbuffer->length)) {
+        rxElement = &can_rxbuffer->buffer[can_rxbuffer->ptrWrite & (can_rxbuffer->length - 1u)];
     }
-#endif /* #if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0) || (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0) */
-    if (bypassLinkIndex >= bufferbypasslength && can_rxbuffer != NULL) {
-        /* ##### Use buffer / Copy data in buffer ##### */
 
-#if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
-        /* NO NEED TO DISABLE INTERRUPTS, BECAUSE FUNCTION IS CALLED FROM ISR */
+    /* Get message ID */
+    HAL_CAN_GetRxMessage(ptrHcan, FIFONumber, &rxElement->msg , &rxElement->data[0]);
+    if (rxElement->msg.IDE == 0U) {
+        msgID = rxElement->msg.StdId;
+    } else  {
+        msgID = rxElement->msg.ExtId;
+    }
 
-        /* Set to 1 to mark message as new received. Set to 0 when reading message from buffer */
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].newMsg = 1;
+    /* Binary search in the RX message IDs sorted by CAN_Init() */
+    rxEntry = CAN_FindRxMsg(canNode, msgID);
 
-        /* Get message header */
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].msg = tmpMsgBuffer.msg;
+    if ((can_rxbuffer != NULL) && ((rxEntry == NULL) || (rxEntry->bypass == FALSE))) {
+        /* ##### Use buffer ##### */
 
-        /* Get the data field */
-        for (uint8_t i = 0; i < can_rxbuffer->buffer[can_rxbuffer->ptrWrite].msg.DLC; i++) {
-            can_rxbuffer->buffer[can_rxbuffer->ptrWrite].data[i] = tmpMsgBuffer.data[i];
+        if (rxElement == &tmpMsgBuffer) {
+            /* buffer full, unread messages are not overwritten */
+            can_rxbuffer->droppedMsgs++;
+        } else {
+            /* element has to be written completely before it is published to the reader */
+            __DMB();
+            can_rxbuffer->ptrWrite++;
         }
-
-        /* Increment write pointer */
-        can_rxbuffer->ptrWrite++;
-        can_rxbuffer->ptrWrite = can_rxbuffer->ptrWrite % can_rxbuffer->length;
-#endif /* CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER */
-    } else if (bypassLinkIndex < bufferbypasslength && can_rxmsgs != NULL && can_fastLinkIndex != NULL) {
+    } else if (can_rxbuffer != NULL) {
         /* ##### Buffer active but bypassed ##### */
 
-#if ((CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0) || (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0)) && ((CAN_USE_CAN_NODE0 == 1) || (CAN_USE_CAN_NODE1 == 1))
         /* call buffer bypass callback function */
-        if (tmpMsgBuffer.msg.IDE == 0U) {
-            if (can_rxmsgs[can_fastLinkIndex[bypassLinkIndex]].func != NULL) {
-                can_rxmsgs[can_fastLinkIndex[bypassLinkIndex]].func(tmpMsgBuffer.msg.StdId,
-                                                                    tmpMsgBuffer.data,
-                                                                    tmpMsgBuffer.msg.DLC,
-                                                                    tmpMsgBuffer.msg.RTR);
-            } else {
-                /* No callback function defined */
-                CAN_BufferBypass(canNode, tmpMsgBuffer.msg.StdId, tmpMsgBuffer.data, tmpMsgBuffer.msg.DLC, tmpMsgBuffer.msg.RTR);
-            }
+        if (can_rxmsgs[rxEntry->rxIndex].func != NULL) {
+            can_rxmsgs[rxEntry->rxIndex].func(msgID, rxElement->data, rxElement->msg.DLC, rxElement->msg.RTR);
         } else {
-            if (can_rxmsgs[can_fastLinkIndex[bypassLinkIndex]].func != NULL) {
-                can_rxmsgs[can_fastLinkIndex[bypassLinkIndex]].func(tmpMsgBuffer.msg.ExtId,
-                                                                    tmpMsgBuffer.data,
-                                                                    tmpMsgBuffer.msg.DLC,
-                                                                    tmpMsgBuffer.msg.RTR);
-            } else {
-                /* No callback function defined */
-                CAN_BufferBypass(canNode, tmpMsgBuffer.msg.ExtId, tmpMsgBuffer.data, tmpMsgBuffer.msg.DLC, tmpMsgBuffer.msg.RTR);
-            }
+            /* No callback function defined */
+            CAN_BufferBypass(canNode, msgID, rxElement->data, rxElement->msg.DLC, rxElement->msg.RTR);
         }
-#endif /* ((CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0) || (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0)) && ((CAN_USE_CAN_NODE0 == 1) || (CAN_USE_CAN_NODE1 == 1)) */
     } else {
         /* ##### Buffer not active ##### */
 
-        CAN_MSG_RX_TYPE_s* msgRXstruct;
-        uint8_t length;
-        if (canNode == CAN_NODE0) {
-            msgRXstruct = &can0_RxMsgs[0];
-            length = can_CAN0_rx_length;
+        /* Interpret received message */
+        if ((rxEntry != NULL) && (can_rxmsgs[rxEntry->rxIndex].func != NULL)) {
+            can_rxmsgs[rxEntry->rxIndex].func(msgID, &rxElement->data[0], rxElement->msg.DLC, rxElement->msg.RTR);
         } else {
-            msgRXstruct = &can1_RxMsgs[0];
-            length = can_CAN1_rx_length;
+            CAN_InterpretReceivedMsg(canNode, msgID, &rxElement->data[0], rxElement->msg.DLC, rxElement->msg.RTR);
         }
+    }
+}
 
-        if (tmpMsgBuffer.msg.IDE == 0U) {
-           msgID = tmpMsgBuffer.msg.StdId;
-        } else  {
-            msgID = tmpMsgBuffer.msg.ExtId;
-        }
 
-        /* Search for correct message in RX message array to check for callback */
-        uint8_t rxMsg = 0;
-        for (; rxMsg < length; rxMsg++) {
-            if (msgRXstruct[rxMsg].ID == msgID) {
+/**
+ * @brief  Searches a message ID in the sorted RX message lookup table
+ *
+ * @param  canNode: canNode on which the message has been received
+ * @param  msgID:   message ID
+ *
+ * @retval lookup table entry of the message, NULL if the ID is not configured
+ */
+static const CAN_RX_LOOKUP_ENTRY_s* CAN_FindRxMsg(CAN_NodeTypeDef_e canNode, uint32_t msgID) {
+    const CAN_RX_LOOKUP_s* lookup = NULL;
+    const CAN_RX_LOOKUP_ENTRY_s* entry = NULL;
+    uint8_t low = 0;
+    uint8_t high = 0;
+    uint8_t mid = 0;
+
+#if CAN_USE_CAN_NODE0 == 1
+    if (canNode == CAN_NODE0) {
+        lookup = &can0_rxLookup;
+    }
+#endif /* CAN_USE_CAN_NODE0 == 1 */
+#if CAN_USE_CAN_NODE1 == 1
+    if (canNode == CAN_NODE1) {
+        lookup = &can1_rxLookup;
+    }
+#endif /* CAN_USE_CAN_NODE1 == 1 */
+
+    if (lookup != NULL) {
+        high = lookup->length;
+        while (low < high) {
+            mid = (uint8_t)((low + high) / 2u);
+            if (lookup->entries[mid].ID < msgID) {
+                low = mid + 1u;
+            } else if (lookup->entries[mid].ID > msgID) {
+                high = mid;
+            } else {
+                entry = &lookup->entries[mid];
                 break;
             }
         }
-
-        /* Interpret received message */
-        if (msgRXstruct[rxMsg].func != NULL) {
-            msgRXstruct[rxMsg].func(msgID, &tmpMsgBuffer.data[0], tmpMsgBuffer.msg.DLC, tmpMsgBuffer.msg.RTR);
-        } else {
-            CAN_InterpretReceivedMsg(canNode, msgID, &tmpMsgBuffer.data[0], tmpMsgBuffer.msg.DLC, tmpMsgBuffer.msg.RTR);
-        }
     }
+    return entry;
 }
 
 
-STD_RETURN_TYPE_e CAN_ReceiveBuffer(CAN_NodeTypeDef_e canNode, Can_PduType* msg) {
-    /* E_OK is returned, if buffer is empty and interpret function is called successful */
+STD_RETURN_TYPE_e CAN_GetRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* rxIndex) {
     STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    const CAN_RX_LOOKUP_ENTRY_s* entry = CAN_FindRxMsg(canNode, msgID);
+
+    if ((entry != NULL) && (rxIndex != NULL)) {
+        *rxIndex = entry->rxIndex;
+        retVal = E_OK;
+    }
+    return retVal;
+}
 
-#if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
+
+/**
+ * @brief  Gets the receive buffer of a CAN node
+ *
+ * @param  canNode: CAN node
+ *
+ * @retval pointer to the receive buffer, NULL if the node does not use a receive buffer
+ */
+static CAN_RX_BUFFER_s* CAN_GetRxBuffer(CAN_NodeTypeDef_e canNode) {
     CAN_RX_BUFFER_s* can_rxbuffer = NULL;
 
 #if CAN0_USE_RX_BUFFER && CAN_USE_CAN_NODE0 == 1
@@ -1247,40 +1321,69 @@ STD_RETURN_TYPE_e CAN_ReceiveBuffer(CAN_NodeTypeDef_e canNode, Can_PduType* msg)
         can_rxbuffer = &can1_rxbuffer;
     }
 #endif /* CAN1_USE_RX_BUFFER && CAN_USE_CAN_NODE1 == 1 */
+    return can_rxbuffer;
+}
 
-    if (msg  ==  NULL) {
-        /* null pointer to message data struct */
-        can_rxbuffer = NULL;
-    }
 
-    if ((can_rxbuffer->ptrWrite != can_rxbuffer->ptrRead) &&
-            (can_rxbuffer->buffer[can_rxbuffer->ptrRead].newMsg  ==  1) &&
-            (can_rxbuffer != NULL)) {
-        /* buffer not empty -> read message */
-        if (can_rxbuffer->buffer[can_rxbuffer->ptrRead].msg.IDE == 1) {
-            /* Extended ID used */
-            msg->id = can_rxbuffer->buffer[can_rxbuffer->ptrRead].msg.ExtId;
-        } else {
-            msg->id = can_rxbuffer->buffer[can_rxbuffer->ptrRead].msg.StdId;
+uint8_t CAN_ReceiveBurst(CAN_NodeTypeDef_e canNode, Can_PduType* msgs, uint8_t maxNrOfMsgs) {
+    uint8_t nrOfMsgs = 0;
+    uint32_t ptrRead = 0;
+    uint32_t ptrWrite = 0;
+    CAN_RX_BUFFERELEMENT_s* rxElement = NULL;
+    CAN_RX_BUFFER_s* can_rxbuffer = CAN_GetRxBuffer(canNode);
+
+    if ((can_rxbuffer != NULL) && (msgs != NULL)) {
+        /* ptrRead is only written here, ptrWrite only in the receive interrupt */
+        ptrRead = can_rxbuffer->ptrRead;
+        ptrWrite = can_rxbuffer->ptrWrite;
+        /* elements must not be read before ptrWrite */
+        __DMB();
+
+        while ((nrOfMsgs < maxNrOfMsgs) && (ptrRead != ptrWrite)) {
+            rxElement = &can_rxbuffer->buffer[ptrRead & (can_rxbuffer->length - 1u)];
+            if (rxElement->msg.IDE == 1) {
+                /* Extended ID used */
+                msgs[nrOfMsgs].id = rxElement->msg.ExtId;
+            } else {
+                msgs[nrOfMsgs].id = rxElement->msg.StdId;
+            }
+            msgs[nrOfMsgs].dlc = rxElement->msg.DLC;
+            for (uint8_t i = 0; i < 8U; i++) {
+                msgs[nrOfMsgs].sdu[i] = rxElement->data[i];
+            }
+            ptrRead++;
+            nrOfMsgs++;
         }
-        msg->dlc = can_rxbuffer->buffer[can_rxbuffer->ptrRead].msg.DLC;
 
-        for (uint8_t i = 0; i < 8U; i++) {
-            msg->sdu[i] = can_rxbuffer->buffer[can_rxbuffer->ptrRead].data[i];
-        }
+        /* elements have to be read completely before they are released to the receive interrupt */
+        __DMB();
+        can_rxbuffer->ptrRead = ptrRead;
+    }
+    return nrOfMsgs;
+}
 
-        /* Set to 0 to mark buffer entry as read. Set to 1 when writing message into buffer */
-        can_rxbuffer->buffer[can_rxbuffer->ptrRead].newMsg = 0;
 
-        /* Move to next buffer element */
-        can_rxbuffer->ptrRead++;
-        can_rxbuffer->ptrRead = can_rxbuffer->ptrRead % can_rxbuffer->length;
+STD_RETURN_TYPE_e CAN_ReceiveBuffer(CAN_NodeTypeDef_e canNode, Can_PduType* msg) {
+    /* E_OK is returned, if a message has been read from the buffer */
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+
+    if (CAN_ReceiveBurst(canNode, msg, 1u) == 1u) {
         retVal = E_OK;
     }
-#endif /* CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER */
     return retVal;
 }
 
+
+uint32_t CAN_GetRxDroppedMsgs(CAN_NodeTypeDef_e canNode) {
+    uint32_t droppedMsgs = 0;
+    CAN_RX_BUFFER_s* can_rxbuffer = CAN_GetRxBuffer(canNode);
+
+    if (can_rxbuffer != NULL) {
+        droppedMsgs = can_rxbuffer->droppedMsgs;
+    }
+    return droppedMsgs;
+}
+
 /**
  * @brief  Receives a bypassed CAN message and interprets it
  *
@@ -100,7 +100,6 @@ typedef struct CAN_ERROR {
 typedef struct CAN_RX_BUFFERELEMENT {
     CAN_RxHeaderTypeDef msg;
     uint8_t data[8];
-    uint8_t newMsg;
 } CAN_RX_BUFFERELEMENT_s;
 
 typedef struct CAN_TX_BUFFERELEMENT {
@@ -109,11 +108,17 @@ typedef struct CAN_TX_BUFFERELEMENT {
     uint8_t newMsg;
 } CAN_TX_BUFFERELEMENT_s;
 
+/**
+ * receive buffer, written by the CAN receive interrupt (single producer) and
+ * read by one task (single consumer). ptrRead and ptrWrite are free-running
+ * counters, the element index is ptr & (length - 1).
+ */
 typedef struct CAN_RX_BUFFER {
-    uint8_t ptrRead;
-    uint8_t ptrWrite;
-    uint8_t length;
-    CAN_RX_BUFFERELEMENT_s* buffer;
+    volatile uint32_t ptrRead;          /*!< number of read messages, only written by the reader */
+    volatile uint32_t ptrWrite;         /*!< number of written messages, only written by the receive interrupt */
+    uint32_t length;                    /*!< number of elements, power of two */
+    CAN_RX_BUFFERELEMENT_s* buffer;     /*!< buffer elements */
+    volatile uint32_t droppedMsgs;      /*!< number of messages dropped because the buffer was full */
 } CAN_RX_BUFFER_s;
 
 typedef struct CAN_TX_BUFFER {
@@ -236,8 +241,42 @@ extern STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode);
  */
 extern STD_RETURN_TYPE_e CAN_ReceiveBuffer(CAN_NodeTypeDef_e canNode, Can_PduType* msg);
 
+/**
+ * @brief  Reads all buffered can messages from RxBuffer, up to maxNrOfMsgs
+ *
+ * @param canNode       canNode on which the messages have been received
+ * @param msgs          array for the received messages
+ * @param maxNrOfMsgs   length of msgs
+ *
+ * @retval number of messages read, 0 if the buffer is empty or the pointer invalid
+ */
+extern uint8_t CAN_ReceiveBurst(CAN_NodeTypeDef_e canNode, Can_PduType* msgs, uint8_t maxNrOfMsgs);
+
+/**
+ * @brief  Gets the number of messages dropped because RxBuffer was full
+ *
+ * @param canNode   canNode
+ *
+ * @retval number of dropped messages since startup
+ */
+extern uint32_t CAN_GetRxDroppedMsgs(CAN_NodeTypeDef_e canNode);
+
 /* Sleep mode */
 
+/**
+ * @brief  Gets the index of a received message ID in can0_RxMsgs or can1_RxMsgs
+ *
+ * The RX message IDs are sorted by CAN_Init(), so the ID is found by a
+ * binary search.
+ *
+ * @param  canNode: canNode on which the message has been received
+ * @param  msgID:   message ID
+ * @param  rxIndex: index of the message in the RX message configuration
+ *
+ * @retval E_OK if the message ID is configured for reception, otherwise E_NOT_OK
+ */
+extern STD_RETURN_TYPE_e CAN_GetRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* rxIndex);
+
 /**
  * @brief  Set CAN to sleep mode
  *
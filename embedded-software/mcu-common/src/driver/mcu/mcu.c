@@ -121,6 +121,14 @@ uint32_t MCU_GetTimeBase(void) {
      return (time);
 }
 
+uint32_t MCU_GetTimeSinceTick_us(void) {
+    uint32_t reload = SysTick->LOAD;
+    uint32_t elapsed = reload - SysTick->VAL;
+
+    /* SysTick period is 1ms, so one reload period corresponds to 1000us */
+    return ((elapsed * 1000u) / (reload + 1u));
+}
+
 uint32_t MCU_SystemResetStatus(uint32_t* regValue) {
     uint32_t errCode = 0;
     uint32_t csr;
@@ -112,6 +112,16 @@ extern uint32_t MCU_SystemResetStatus(uint32_t* regValue);
  */
 extern uint32_t MCU_GetTimeBase(void);
 
+/**
+ * @brief   gets the time elapsed since the last SysTick reload in microseconds
+ *
+ * Combined with the OS tick count this gives a timestamp with microsecond
+ * resolution, e.g., to measure execution times.
+ *
+ * @return  time since the last SysTick reload in us (0 to 999)
+ */
+extern uint32_t MCU_GetTimeSinceTick_us(void);
+
 /**
  * @brief   Get unique device ID
  */
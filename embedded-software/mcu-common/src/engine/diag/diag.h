@@ -153,6 +153,11 @@ typedef struct {
 /* FIXME doxygen comment missing */
 extern DIAG_FAILURECODE_s diag_fc;
 
+/**
+ * error memory in the backup SRAM, ring buffer of the last DIAG_FAIL_ENTRY_LENGTH errors
+ */
+extern DIAG_ERROR_ENTRY_s diag_memory[DIAG_FAIL_ENTRY_LENGTH];
+
 /*================== Function Prototypes ==================================*/
 
 /**
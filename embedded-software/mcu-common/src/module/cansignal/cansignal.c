@@ -56,20 +56,70 @@
 /*================== Includes =============================================*/
 #include "cansignal.h"
 
+#include "cansignal_stream.h"
+#include "isotp.h"
+#include "xcp.h"
 #include "database.h"
 #include "diag.h"
-#include "foxmath.h"
 #include "os.h"
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * number of data bytes of a CAN message
+ */
+#define CANS_MAX_DATA_LENGTH    8u
+
+/**
+ * number of messages read from the receive buffer per CAN_ReceiveBurst() call
+ */
+#define CANS_RX_BURST_LENGTH    8u
+
+/**
+ * range of the signals of one message in the signal array of its CAN node
+ */
+typedef struct {
+    uint16_t first;         /*!< index of the first signal of the message */
+    uint16_t count;         /*!< number of signals of the message */
+    uint8_t contiguous;     /*!< FALSE if the signals are spread over the array, the message is then parsed by a full search */
+} CANS_SIGNAL_RANGE_s;
+
+/**
+ * transmission state of a TX message sent on change
+ */
+typedef struct {
+    uint32_t lastTick;      /*!< tick of the last transmission */
+    uint32_t hash;          /*!< hash of the last transmitted data */
+    uint8_t sent;           /*!< TRUE after the first transmission */
+} CANS_TX_ON_CHANGE_s;
+
 /*================== Constant and Variable Definitions ====================*/
 static CANS_STATE_s cans_state = {
         .periodic_enable = FALSE,
         .current_sensor_present = FALSE,
         .current_sensor_cc_present = FALSE,
+        .signal_index_ready = FALSE,
+        .tx_phase_ready = FALSE,
+        .tx_max_slot_load_node0 = 0,
+        .tx_max_slot_load_node1 = 0,
+        .rx_dropped_msgs = 0,
     };
 
+/** signal ranges of the TX messages, built by CANS_Init() */
+static CANS_SIGNAL_RANGE_s cans_txSignalRanges[CANS_MSG_TX_MAX];
+
+/** signal ranges of the RX messages, built by CANS_Init() */
+static CANS_SIGNAL_RANGE_s cans_rxSignalRanges[CANS_MSG_RX_MAX];
+
+/** phases of the TX messages in ms, assigned by CANS_Init() */
+static uint32_t cans_txPhases[CANS_MSG_TX_MAX];
+
+/** number of TX messages per tick, used by CANS_Init() to assign the phases */
+static uint8_t cans_txSlotLoad[CANS_TX_SCHEDULE_MAX_TICKS];
+
+/** transmission state of the TX messages sent on change */
+static CANS_TX_ON_CHANGE_s cans_txOnChange[CANS_MSG_TX_MAX];
+
 static DATA_BLOCK_STATEREQUEST_s canstatereq_tab;
 
 /*================== Function Prototypes ==================================*/
@@ -77,24 +127,97 @@ static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void);
 static STD_RETURN_TYPE_e CANS_PeriodicReceive(void);
 static void CANS_SetSignalData(CANS_signal_s signal, uint64_t value, uint8_t *dataPtr);
 static void CANS_GetSignalData(uint64_t *dst, CANS_signal_s signal, uint8_t *dataPtr);
+static uint8_t CANS_GetMotorolaLayout(uint8_t startBit, uint8_t bitLength, uint8_t *firstByte, uint8_t *lastByte, uint8_t *lsbShift);
+static uint64_t CANS_GetMotorolaSignal(const uint8_t *dataPtr, uint8_t startBit, uint8_t bitLength);
+static void CANS_SetMotorolaSignal(uint8_t *dataPtr, uint8_t startBit, uint8_t bitLength, uint64_t value);
 static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msgIdx, uint8_t dataptr[]);
 static void CANS_ParseMessage(CAN_NodeTypeDef_e canNode, CANS_messagesRx_e msgIdx, uint8_t dataptr[]);
 static uint8_t CANS_CheckCanTiming(void);
+static void CANS_CheckRxDropped(void);
 static void CANS_SetCurrentSensorPresent(uint8_t command);
 static void CANS_SetCurrentSensorCCPresent(uint8_t command);
+static void CANS_BuildSignalIndex(CANS_SIGNAL_RANGE_s *ranges, uint16_t nrOfMessages, const CANS_signal_s *signals,
+        uint16_t nrOfSignals, CANS_messageDirection_t direction);
+static void CANS_GetSignalRange(const CANS_SIGNAL_RANGE_s *ranges, uint16_t nrOfMessages, uint16_t msgIdx,
+        uint16_t nrOfSignals, uint16_t *first, uint16_t *end);
+static uint32_t CANS_GetGreatestCommonDivisor(uint32_t a, uint32_t b);
+static STD_RETURN_TYPE_e CANS_ScheduleTx(const CAN_MSG_TX_TYPE_s *messages, uint8_t nrOfMessages, uint16_t msgOffset,
+        uint8_t *maxSlotLoad);
+static void CANS_ScheduleTxMessage(uint16_t msgIdx, uint32_t period, uint32_t hyperperiod, uint8_t *maxSlotLoad);
+static uint32_t CANS_GetTxPhase(const CAN_MSG_TX_TYPE_s *message, uint16_t msgIdx);
+static uint32_t CANS_GetTxCheckTime(const CAN_MSG_TX_TYPE_s *message);
+static uint8_t CANS_IsTxDue(const CAN_MSG_TX_TYPE_s *message, uint16_t msgIdx, uint32_t counter_ticks);
+static uint32_t CANS_GetDataHash(const uint8_t *dataPtr);
+static uint8_t CANS_IsTxContentDue(const CAN_MSG_TX_TYPE_s *message, uint16_t msgIdx, uint32_t counter_ticks,
+        uint32_t hash);
+static void CANS_SetTxContentSent(uint16_t msgIdx, uint32_t counter_ticks, uint32_t hash);
 /*================== Function Implementations =============================*/
 
 /*================== Public functions =====================================*/
 void CANS_Init(void) {
-    /* custom initialization could be made here. right now no need for any init */
+    for (uint16_t i = 0; i < CANS_MSG_TX_MAX; i++) {
+        cans_txSignalRanges[i].first = 0;
+        cans_txSignalRanges[i].count = 0;
+        cans_txSignalRanges[i].contiguous = TRUE;
+    }
+    for (uint16_t i = 0; i < CANS_MSG_RX_MAX; i++) {
+        cans_rxSignalRanges[i].first = 0;
+        cans_rxSignalRanges[i].count = 0;
+        cans_rxSignalRanges[i].contiguous = TRUE;
+    }
+
+    /* The messages of one node only reference signals of this node, so the
+     * ranges of both nodes can share one array per direction. */
+    CANS_BuildSignalIndex(cans_txSignalRanges, CANS_MSG_TX_MAX, cans_CAN0_signals_tx, cans_CAN0_signals_tx_length, CAN_TX_DIRECTION);
+    CANS_BuildSignalIndex(cans_txSignalRanges, CANS_MSG_TX_MAX, cans_CAN1_signals_tx, cans_CAN1_signals_tx_length, CAN_TX_DIRECTION);
+    CANS_BuildSignalIndex(cans_rxSignalRanges, CANS_MSG_RX_MAX, cans_CAN0_signals_rx, cans_CAN0_signals_rx_length, CAN_RX_DIRECTION);
+    CANS_BuildSignalIndex(cans_rxSignalRanges, CANS_MSG_RX_MAX, cans_CAN1_signals_rx, cans_CAN1_signals_rx_length, CAN_RX_DIRECTION);
+
+    cans_state.signal_index_ready = TRUE;
+
+#if CANS_TX_AUTO_PHASE == TRUE
+    uint8_t maxSlotLoad0 = 0;
+    uint8_t maxSlotLoad1 = 0;
+    STD_RETURN_TYPE_e result0 = CANS_ScheduleTx(can_CAN0_messages_tx, can_CAN0_tx_length, 0, &maxSlotLoad0);
+    STD_RETURN_TYPE_e result1 = CANS_ScheduleTx(can_CAN1_messages_tx, can_CAN1_tx_length, can_CAN0_tx_length, &maxSlotLoad1);
+
+#if CAN_CELLVOLTAGE_STREAM == TRUE
+    /* the cell voltage stream spreads its frames over the ticks on its own */
+    maxSlotLoad0 += CANS_StreamGetMaxFramesPerTick();
+#endif /* CAN_CELLVOLTAGE_STREAM == TRUE */
+
+    if ((result0 == E_OK) && (result1 == E_OK)) {
+        cans_state.tx_max_slot_load_node0 = maxSlotLoad0;
+        cans_state.tx_max_slot_load_node1 = maxSlotLoad1;
+        cans_state.tx_phase_ready = TRUE;
+    }
+#endif /* CANS_TX_AUTO_PHASE == TRUE */
+}
+
+uint8_t CANS_GetTxMaxSlotLoad(CAN_NodeTypeDef_e canNode) {
+    uint8_t retVal = 0;
+
+    if (canNode == CAN_NODE0) {
+        retVal = cans_state.tx_max_slot_load_node0;
+    } else if (canNode == CAN_NODE1) {
+        retVal = cans_state.tx_max_slot_load_node1;
+    }
+    return retVal;
 }
 
 void CANS_MainFunction(void) {
     (void)CANS_PeriodicReceive();
+    CANS_CheckRxDropped();
     CANS_CheckCanTiming();
     if (cans_state.periodic_enable == TRUE) {
         (void)CANS_PeriodicTransmit();
+#if CAN_CELLVOLTAGE_STREAM == TRUE
+        CANS_StreamCellVoltages();
+#endif /* CAN_CELLVOLTAGE_STREAM == TRUE */
     }
+#if CAN_USE_CAN_NODE0 == TRUE
+    ISOTP_MainFunction();
+#endif
     DIAG_SysMonNotify(DIAG_SYSMON_CANS_ID, 0);  /* task is running, state = ok */
 }
 
@@ -135,7 +258,9 @@ STD_RETURN_TYPE_e CANS_TransmitMessage(CAN_NodeTypeDef_e canNode, uint32_t msgID
  * messages that are intended to be sent periodically. If a comparison with
  * an internal counter (i.e., the counter how often this function has been called)
  * states that a transmit is pending, the message is composed by call of CANS_ComposeMessage
- * and transfered to the buffer of the CAN module. If a callback function
+ * and transfered to the buffer of the CAN module. Messages with mode CAN_TX_ON_CHANGE
+ * are composed every min_interval, but only transfered if their data changed or
+ * repetition_time elapsed since the last transmission. If a callback function
  * is declared in configuration, this callback is called after successful transmission.
  *
  * @return E_OK if a successful transfer to CAN buffer occured, E_NOT_OK otherwise
@@ -143,20 +268,27 @@ STD_RETURN_TYPE_e CANS_TransmitMessage(CAN_NodeTypeDef_e canNode, uint32_t msgID
 static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void) {
     static uint32_t counter_ticks = 0;
     uint32_t i = 0;
+    uint32_t hash = 0;
     STD_RETURN_TYPE_e result = E_NOT_OK;
 
 #if CAN_USE_CAN_NODE0 == TRUE
     for (i = 0; i < can_CAN0_tx_length; i++) {
-        if (((counter_ticks * CANS_TICK_MS) % (can_CAN0_messages_tx[i].repetition_time)) == can_CAN0_messages_tx[i].repetition_phase) {
+        if (CANS_IsTxDue(&can_CAN0_messages_tx[i], i, counter_ticks) == TRUE) {
             Can_PduType PduToSend = { {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 0x0, 8 };
             CANS_ComposeMessage(CAN_NODE0, (CANS_messagesTx_e)(i), PduToSend.sdu);
             PduToSend.id = can_CAN0_messages_tx[i].ID;
+            hash = CANS_GetDataHash(PduToSend.sdu);
 
-            result = CANS_AddMessage(CAN_NODE0, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
-            DIAG_checkEvent(result, DIAG_CH_CANS_CAN_MOD_FAILURE, 1);
+            if (CANS_IsTxContentDue(&can_CAN0_messages_tx[i], i, counter_ticks, hash) == TRUE) {
+                result = CANS_AddMessage(CAN_NODE0, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
+                DIAG_checkEvent(result, DIAG_CH_CANS_CAN_MOD_FAILURE, 1);
 
-            if (can_CAN0_messages_tx[i].cbk_func != NULL_PTR && result == E_OK) {
-                can_CAN0_messages_tx[i].cbk_func(i, NULL_PTR);
+                if (result == E_OK) {
+                    CANS_SetTxContentSent(i, counter_ticks, hash);
+                }
+                if (can_CAN0_messages_tx[i].cbk_func != NULL_PTR && result == E_OK) {
+                    can_CAN0_messages_tx[i].cbk_func(i, NULL_PTR);
+                }
             }
         }
     }
@@ -164,16 +296,22 @@ static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void) {
 
 #if CAN_USE_CAN_NODE1 == TRUE
     for (i = 0; i < can_CAN1_tx_length; i++) {
-        if (((counter_ticks * CANS_TICK_MS) % (can_CAN1_messages_tx[i].repetition_time)) == can_CAN1_messages_tx[i].repetition_phase) {
+        if (CANS_IsTxDue(&can_CAN1_messages_tx[i], i + can_CAN0_tx_length, counter_ticks) == TRUE) {
             Can_PduType PduToSend = { {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 0x0, 8 };
             CANS_ComposeMessage(CAN_NODE1, (CANS_messagesTx_e)i + can_CAN0_tx_length, PduToSend.sdu);
             PduToSend.id = can_CAN1_messages_tx[i].ID;
+            hash = CANS_GetDataHash(PduToSend.sdu);
 
-            result = CANS_AddMessage(CAN_NODE1, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
-            DIAG_checkEvent(result, DIAG_CH_CANS_CAN_MOD_FAILURE, 0);
+            if (CANS_IsTxContentDue(&can_CAN1_messages_tx[i], i + can_CAN0_tx_length, counter_ticks, hash) == TRUE) {
+                result = CANS_AddMessage(CAN_NODE1, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
+                DIAG_checkEvent(result, DIAG_CH_CANS_CAN_MOD_FAILURE, 0);
 
-            if (can_CAN1_messages_tx[i].cbk_func != NULL_PTR && result == E_OK) {
-                can_CAN1_messages_tx[i].cbk_func(i, NULL_PTR);
+                if (result == E_OK) {
+                    CANS_SetTxContentSent(i + can_CAN0_tx_length, counter_ticks, hash);
+                }
+                if (can_CAN1_messages_tx[i].cbk_func != NULL_PTR && result == E_OK) {
+                    can_CAN1_messages_tx[i].cbk_func(i, NULL_PTR);
+                }
             }
         }
     }
@@ -185,6 +323,246 @@ static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void) {
     return TRUE;
 }
 
+/**
+ * gets the phase of a periodic TX message
+ *
+ * @param   message     configuration of the message
+ * @param   msgIdx      index of the message in CANS_messagesTx_e
+ *
+ * @return  phase assigned by CANS_Init(), configured phase if none was assigned
+ */
+static uint32_t CANS_GetTxPhase(const CAN_MSG_TX_TYPE_s *message, uint16_t msgIdx) {
+    uint32_t phase = message->repetition_phase;
+
+    if ((cans_state.tx_phase_ready == TRUE) && (msgIdx < CANS_MSG_TX_MAX)) {
+        phase = cans_txPhases[msgIdx];
+    }
+    return phase;
+}
+
+/**
+ * gets the time between two checks of a TX message: the repetition time of
+ * periodic messages, the minimum interval of messages sent on change
+ *
+ * @param   message     configuration of the message
+ *
+ * @return  time in ms, 0 if the message is not sent
+ */
+static uint32_t CANS_GetTxCheckTime(const CAN_MSG_TX_TYPE_s *message) {
+    uint32_t checkTime = message->repetition_time;
+
+    if (message->mode == CAN_TX_OFF) {
+        checkTime = 0;
+    } else if (message->mode == CAN_TX_ON_CHANGE) {
+        checkTime = message->min_interval;
+        if (checkTime < CANS_TICK_MS) {
+            checkTime = CANS_TICK_MS;
+        }
+    }
+    return checkTime;
+}
+
+/**
+ * checks if a TX message has to be composed in this tick
+ *
+ * @param   message         configuration of the message
+ * @param   msgIdx          index of the message in CANS_messagesTx_e
+ * @param   counter_ticks   number of calls of CANS_PeriodicTransmit()
+ *
+ * @return  TRUE if the message is due, FALSE otherwise
+ */
+static uint8_t CANS_IsTxDue(const CAN_MSG_TX_TYPE_s *message, uint16_t msgIdx, uint32_t counter_ticks) {
+    uint8_t due = FALSE;
+    uint32_t checkTime = CANS_GetTxCheckTime(message);
+
+    if ((checkTime != 0u) &&
+            (((counter_ticks * CANS_TICK_MS) % checkTime) == (CANS_GetTxPhase(message, msgIdx) % checkTime))) {
+        due = TRUE;
+    }
+    return due;
+}
+
+/**
+ * computes the FNV-1a hash of the composed data of a message
+ *
+ * @param   dataPtr     message data, CANS_MAX_DATA_LENGTH bytes
+ *
+ * @return  hash of the data
+ */
+static uint32_t CANS_GetDataHash(const uint8_t *dataPtr) {
+    uint32_t hash = 2166136261u;
+
+    for (uint8_t i = 0; i < CANS_MAX_DATA_LENGTH; i++) {
+        hash ^= dataPtr[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * checks if a composed TX message has to be transfered to the CAN module.
+ * Periodic messages are always sent. Messages sent on change are sent if
+ * the hash of their data differs from the last transmission, or if
+ * repetition_time elapsed since then. A hash collision thus delays a change
+ * by at most repetition_time.
+ *
+ * @param   message         configuration of the message
+ * @param   msgIdx          index of the message in CANS_messagesTx_e
+ * @param   counter_ticks   number of calls of CANS_PeriodicTransmit()
+ * @param   hash            hash of the composed data
+ *
+ * @return  TRUE if the message has to be sent, FALSE otherwise
+ */
+static uint8_t CANS_IsTxContentDue(const CAN_MSG_TX_TYPE_s *message, uint16_t msgIdx, uint32_t counter_ticks,
+        uint32_t hash) {
+    uint8_t due = TRUE;
+
+    if ((message->mode == CAN_TX_ON_CHANGE) && (msgIdx < CANS_MSG_TX_MAX) && (cans_txOnChange[msgIdx].sent == TRUE)) {
+        if ((cans_txOnChange[msgIdx].hash == hash) &&
+                (((counter_ticks - cans_txOnChange[msgIdx].lastTick) * CANS_TICK_MS) < message->repetition_time)) {
+            due = FALSE;
+        }
+    }
+    return due;
+}
+
+/**
+ * stores the transmission of a TX message for the on change check
+ *
+ * @param   msgIdx          index of the message in CANS_messagesTx_e
+ * @param   counter_ticks   number of calls of CANS_PeriodicTransmit()
+ * @param   hash            hash of the transmitted data
+ */
+static void CANS_SetTxContentSent(uint16_t msgIdx, uint32_t counter_ticks, uint32_t hash) {
+    if (msgIdx < CANS_MSG_TX_MAX) {
+        cans_txOnChange[msgIdx].lastTick = counter_ticks;
+        cans_txOnChange[msgIdx].hash = hash;
+        cans_txOnChange[msgIdx].sent = TRUE;
+    }
+}
+
+/**
+ * gets the greatest common divisor of two numbers
+ */
+static uint32_t CANS_GetGreatestCommonDivisor(uint32_t a, uint32_t b) {
+    uint32_t tmp = 0;
+
+    while (b != 0u) {
+        tmp = a % b;
+        a = b;
+        b = tmp;
+    }
+    return a;
+}
+
+/**
+ * assigns the phases of the periodic TX messages of one CAN node.
+ *
+ * The load of every tick (number of messages queued in this call of
+ * CANS_MainFunction()) is tracked over one schedule period, i.e., the least
+ * common multiple of the check times (repetition time, or minimum interval of
+ * messages sent on change). Messages with the shortest check time have the
+ * fewest phases to choose from and are placed first.
+ * Each message gets the phase that keeps the maximum load of its ticks lowest.
+ *
+ * @param   messages        TX message configuration of the CAN node
+ * @param   nrOfMessages    number of TX messages of the CAN node
+ * @param   msgOffset       index of the first message of the node in CANS_messagesTx_e
+ * @param   maxSlotLoad     worst-case number of messages in one tick
+ *
+ * @return  E_OK if the phases were assigned, E_NOT_OK if the configured phases have to be used
+ */
+static STD_RETURN_TYPE_e CANS_ScheduleTx(const CAN_MSG_TX_TYPE_s *messages, uint8_t nrOfMessages, uint16_t msgOffset,
+        uint8_t *maxSlotLoad) {
+    STD_RETURN_TYPE_e retVal = E_OK;
+    uint32_t hyperperiod = 1;   /* in ticks */
+    uint32_t period = 0;        /* in ticks */
+    uint32_t lastPeriod = 0;
+    uint32_t nextPeriod = 0;
+
+    *maxSlotLoad = 0;
+    if ((msgOffset + nrOfMessages) > CANS_MSG_TX_MAX) {
+        retVal = E_NOT_OK;
+    }
+    for (uint8_t i = 0; (i < nrOfMessages) && (retVal == E_OK); i++) {
+        if (messages[i].mode == CAN_TX_OFF) {
+            /* not scheduled, CANS_GetTxCheckTime() is 0 */
+        } else if ((CANS_GetTxCheckTime(&messages[i]) == 0u) || ((CANS_GetTxCheckTime(&messages[i]) % CANS_TICK_MS) != 0u)) {
+            retVal = E_NOT_OK;
+        } else {
+            period = CANS_GetTxCheckTime(&messages[i]) / CANS_TICK_MS;
+            hyperperiod = (hyperperiod / CANS_GetGreatestCommonDivisor(hyperperiod, period)) * period;
+            if (hyperperiod > CANS_TX_SCHEDULE_MAX_TICKS) {
+                retVal = E_NOT_OK;
+            }
+        }
+    }
+
+    if (retVal == E_OK) {
+        for (uint32_t t = 0; t < hyperperiod; t++) {
+            cans_txSlotLoad[t] = 0;
+        }
+        /* schedule the messages grouped by ascending repetition time */
+        do {
+            nextPeriod = 0;
+            for (uint8_t i = 0; i < nrOfMessages; i++) {
+                period = CANS_GetTxCheckTime(&messages[i]) / CANS_TICK_MS;
+                if ((period > lastPeriod) && ((nextPeriod == 0u) || (period < nextPeriod))) {
+                    nextPeriod = period;
+                }
+            }
+            for (uint8_t i = 0; (i < nrOfMessages) && (nextPeriod != 0u); i++) {
+                if ((CANS_GetTxCheckTime(&messages[i]) / CANS_TICK_MS) == nextPeriod) {
+                    CANS_ScheduleTxMessage(msgOffset + i, nextPeriod, hyperperiod, maxSlotLoad);
+                }
+            }
+            lastPeriod = nextPeriod;
+        } while (nextPeriod != 0u);
+    }
+    return retVal;
+}
+
+/**
+ * assigns the phase of one TX message with the lowest maximum load of its
+ * ticks. Ties are resolved by the lowest total load, then by the earliest phase.
+ *
+ * @param   msgIdx          index of the message in CANS_messagesTx_e
+ * @param   period          repetition time of the message in ticks
+ * @param   hyperperiod     length of the schedule in ticks
+ * @param   maxSlotLoad     worst-case number of messages in one tick, updated
+ */
+static void CANS_ScheduleTxMessage(uint16_t msgIdx, uint32_t period, uint32_t hyperperiod, uint8_t *maxSlotLoad) {
+    uint32_t bestPhase = 0;
+    uint32_t bestMax = UINT32_MAX;
+    uint32_t bestSum = UINT32_MAX;
+    uint32_t max = 0;
+    uint32_t sum = 0;
+
+    for (uint32_t phase = 0; phase < period; phase++) {
+        max = 0;
+        sum = 0;
+        for (uint32_t t = phase; t < hyperperiod; t += period) {
+            if (cans_txSlotLoad[t] > max) {
+                max = cans_txSlotLoad[t];
+            }
+            sum += cans_txSlotLoad[t];
+        }
+        if ((max < bestMax) || ((max == bestMax) && (sum < bestSum))) {
+            bestPhase = phase;
+            bestMax = max;
+            bestSum = sum;
+        }
+    }
+
+    for (uint32_t t = bestPhase; t < hyperperiod; t += period) {
+        cans_txSlotLoad[t]++;
+        if (cans_txSlotLoad[t] > *maxSlotLoad) {
+            *maxSlotLoad = cans_txSlotLoad[t];
+        }
+    }
+    cans_txPhases[msgIdx] = bestPhase * CANS_TICK_MS;
+}
+
 /**
  * handles the processing of received CAN messages.
  *
@@ -197,32 +575,41 @@ static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void) {
  * @return E_OK, if a message has been received and parsed, E_NOT_OK otherwise
  */
 static STD_RETURN_TYPE_e CANS_PeriodicReceive(void) {
-    Can_PduType msg = {};
+    Can_PduType msgs[CANS_RX_BURST_LENGTH] = {};
     STD_RETURN_TYPE_e result_node0 = E_NOT_OK, result_node1 = E_NOT_OK;
-    uint32_t i = 0;
+    uint8_t rxIndex = 0;
+    uint8_t nrOfMsgs = 0;
 
 #if CAN_USE_CAN_NODE0 == TRUE
-    while (CAN_ReceiveBuffer(CAN_NODE0, &msg)  ==  E_OK) {
-        for (i = 0; i < can_CAN0_rx_length; i++) {
-            if (msg.id  ==  can0_RxMsgs[i].ID) {
-                CANS_ParseMessage(CAN_NODE0, (CANS_messagesRx_e)i, msg.sdu);
+    do {
+        nrOfMsgs = CAN_ReceiveBurst(CAN_NODE0, &msgs[0], CANS_RX_BURST_LENGTH);
+        for (uint8_t i = 0; i < nrOfMsgs; i++) {
+            if (msgs[i].id == CAN_ID_ISOTP_REQUEST) {
+                ISOTP_ReceiveFrame(msgs[i].sdu, msgs[i].dlc);
+                result_node0 = E_OK;
+            } else if (msgs[i].id == CAN_ID_XCP_REQUEST) {
+                XCP_ReceiveFrame(msgs[i].sdu, msgs[i].dlc);
+                result_node0 = E_OK;
+            } else if (CAN_GetRxMsgIndex(CAN_NODE0, msgs[i].id, &rxIndex) == E_OK) {
+                CANS_ParseMessage(CAN_NODE0, (CANS_messagesRx_e)rxIndex, msgs[i].sdu);
                 result_node0 = E_OK;
             }
         }
-    }
+    } while (nrOfMsgs == CANS_RX_BURST_LENGTH);
 #else
     result_node0 = E_OK;
 #endif
 
 #if CAN_USE_CAN_NODE1 == TRUE
-    while (CAN_ReceiveBuffer(CAN_NODE1, &msg) == E_OK) {
-        for (i = 0; i < can_CAN1_rx_length; i++) {
-            if (msg.id == can1_RxMsgs[i].ID) {
-                CANS_ParseMessage(CAN_NODE1, (CANS_messagesRx_e)i + can_CAN0_rx_length - CAN0_BUFFER_BYPASS_NUMBER_OF_IDs, msg.sdu);
+    do {
+        nrOfMsgs = CAN_ReceiveBurst(CAN_NODE1, &msgs[0], CANS_RX_BURST_LENGTH);
+        for (uint8_t i = 0; i < nrOfMsgs; i++) {
+            if (CAN_GetRxMsgIndex(CAN_NODE1, msgs[i].id, &rxIndex) == E_OK) {
+                CANS_ParseMessage(CAN_NODE1, (CANS_messagesRx_e)rxIndex + can_CAN0_rx_length - CAN0_BUFFER_BYPASS_NUMBER_OF_IDs, msgs[i].sdu);
                 result_node1 = E_OK;
             }
         }
-    }
+    } while (nrOfMsgs == CANS_RX_BURST_LENGTH);
 #else
     result_node1 = E_OK;
 #endif
@@ -237,15 +624,111 @@ static STD_RETURN_TYPE_e CANS_PeriodicReceive(void) {
  * @return  bitmask     bitfield mask
  */
 static uint64_t CANS_GetBitmask(uint8_t bitlength) {
-    uint64_t bitmask = 0x00000000;
-    uint8_t i = 0;
-    for (i = 0; i < bitlength; i++) {
-        bitmask = bitmask << 1;
-        bitmask = bitmask | 0x00000001;
+    uint64_t bitmask = 0xFFFFFFFFFFFFFFFFuLL;
+    /* shifting by the full width of the type is undefined, so 64 bit is the unshifted mask */
+    if (bitlength < 64) {
+        bitmask = (((uint64_t)1u) << bitlength) - 1u;
     }
     return bitmask;
 }
 
+/**
+ * @brief   computes the bytes covered by a Motorola (big-endian) signal
+ *
+ * The start bit of a Motorola signal is the position of its most significant
+ * bit, counted as in the dbc: bit 0 is the LSB of byte 0, bit 7 the MSB of
+ * byte 0, bit 8 the LSB of byte 1. From there, the signal continues to the
+ * lower bits of the same byte and then to the MSB of the next byte.
+ *
+ * @param[in]   startBit    position of the most significant bit of the signal
+ * @param[in]   bitLength   length of the signal in bits
+ * @param[out]  firstByte   byte that contains the most significant bit
+ * @param[out]  lastByte    byte that contains the least significant bit
+ * @param[out]  lsbShift    position of the least significant bit in lastByte
+ *
+ * @return  TRUE if the signal fits in the CAN message, otherwise FALSE
+ */
+static uint8_t CANS_GetMotorolaLayout(uint8_t startBit, uint8_t bitLength, uint8_t *firstByte, uint8_t *lastByte, uint8_t *lsbShift) {
+    /* position of the LSB counted from the MSB of byte 0 */
+    uint16_t lsbPosition = (uint16_t)(((uint16_t)startBit & 0xF8u) + (7u - ((uint16_t)startBit & 0x07u)) + bitLength - 1u);
+    uint8_t retval = FALSE;
+
+    if ((bitLength > 0u) && (bitLength <= 64u) && (lsbPosition < (CANS_MAX_DATA_LENGTH * 8u))) {
+        *firstByte = startBit / 8u;
+        *lastByte = (uint8_t)(lsbPosition / 8u);
+        *lsbShift = (uint8_t)(7u - (lsbPosition % 8u));
+        retval = TRUE;
+    }
+    return retval;
+}
+
+/**
+ * @brief   reads a Motorola (big-endian) signal from CAN message data
+ *
+ * Only the bytes covered by the signal are read. Byte-aligned signals are
+ * assembled without shifting and masking.
+ *
+ * @param   dataPtr     CAN message data
+ * @param   startBit    position of the most significant bit, see CANS_GetMotorolaLayout()
+ * @param   bitLength   length of the signal in bits
+ *
+ * @return  raw signal value, 0 if the signal does not fit in the message
+ */
+static uint64_t CANS_GetMotorolaSignal(const uint8_t *dataPtr, uint8_t startBit, uint8_t bitLength) {
+    uint8_t firstByte = 0;
+    uint8_t lastByte = 0;
+    uint8_t lsbShift = 0;
+    uint64_t value = 0;
+
+    if (CANS_GetMotorolaLayout(startBit, bitLength, &firstByte, &lastByte, &lsbShift) == TRUE) {
+        for (uint8_t i = firstByte; i <= lastByte; i++) {
+            value = (value << 8u) | dataPtr[i];
+        }
+        if ((lsbShift != 0u) || ((bitLength % 8u) != 0u)) {
+            /* signal is not byte-aligned */
+            value = (value >> lsbShift) & CANS_GetBitmask(bitLength);
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief   writes a Motorola (big-endian) signal to CAN message data
+ *
+ * Only the bits of the signal are changed. Byte-aligned signals are written
+ * without read-modify-write.
+ *
+ * @param   dataPtr     CAN message data
+ * @param   startBit    position of the most significant bit, see CANS_GetMotorolaLayout()
+ * @param   bitLength   length of the signal in bits
+ * @param   value       raw signal value
+ */
+static void CANS_SetMotorolaSignal(uint8_t *dataPtr, uint8_t startBit, uint8_t bitLength, uint64_t value) {
+    uint8_t firstByte = 0;
+    uint8_t lastByte = 0;
+    uint8_t lsbShift = 0;
+    uint64_t bitmask = 0;
+
+    if (CANS_GetMotorolaLayout(startBit, bitLength, &firstByte, &lastByte, &lsbShift) == TRUE) {
+        if ((lsbShift == 0u) && ((bitLength % 8u) == 0u)) {
+            /* byte-aligned signal */
+            for (uint8_t i = lastByte + 1u; i > firstByte; i--) {
+                dataPtr[i - 1u] = (uint8_t)value;
+                value = value >> 8u;
+            }
+        } else {
+            /* the signal spans at most 8 bytes, so the shifted mask fits in 64 bit */
+            bitmask = CANS_GetBitmask(bitLength) << lsbShift;
+            value = (value << lsbShift) & bitmask;
+            for (uint8_t i = lastByte + 1u; i > firstByte; i--) {
+                dataPtr[i - 1u] = (uint8_t)((dataPtr[i - 1u] & (uint8_t)~(uint8_t)bitmask) | (uint8_t)value);
+                bitmask = bitmask >> 8u;
+                value = value >> 8u;
+            }
+        }
+    }
+}
+
 /**
  * extracts signal data from CAN message data
  *
@@ -256,25 +739,13 @@ static uint64_t CANS_GetBitmask(uint8_t bitlength) {
 static void CANS_GetSignalData(uint64_t *dst, CANS_signal_s signal, uint8_t *dataPtr) {
     uint64_t bitmask = 0x00000000;
     uint64_t *dataPtr64 = (uint64_t *)dataPtr;
-    /* Get signal data */
-    bitmask = CANS_GetBitmask(signal.bit_length);
-    *dst = (((*dataPtr64) >> signal.bit_position) & bitmask);
-    /* Swap byte order if necessary */
-    if (signal.byteOrder == littleEndian) {
+
+    if (signal.byteOrder == bigEndian) {
+        *dst = CANS_GetMotorolaSignal(dataPtr, signal.bit_position, signal.bit_length);
+    } else {
         /* No need to switch byte order as native MCU endianness is little-endian (intel) */
-    } else if (signal.byteOrder == bigEndian) {
-        if (signal.bit_length <= 8) {
-            /* No need to switch byte order as signal length is smaller than one byte */
-        } else if (signal.bit_length <= 16) {
-            /* Swap byte order */
-            *dst = (uint64_t)MATH_swapBytes_uint16_t((uint16_t)*dst);
-        } else if (signal.bit_length <= 32) {
-            /* Swap byte order */
-            *dst = (uint64_t)MATH_swapBytes_uint32_t((uint32_t)*dst);
-        } else {  /* (signal.bit_length <= 64) */
-            /* Swap byte order */
-            *dst = MATH_swapBytes_uint64_t(*dst);
-        }
+        bitmask = CANS_GetBitmask(signal.bit_length);
+        *dst = (((*dataPtr64) >> signal.bit_position) & bitmask);
     }
 }
 
@@ -290,28 +761,71 @@ static void CANS_SetSignalData(CANS_signal_s signal, uint64_t value, uint8_t *da
     uint64_t bitmask = 0x0000000000000000;
     uint64_t *dataPtr64 = (uint64_t *)dataPtr;
 
-    /* Swap byte order if necessary */
-    if (signal.byteOrder == littleEndian) {
+    if (signal.byteOrder == bigEndian) {
+        CANS_SetMotorolaSignal(dataPtr, signal.bit_position, signal.bit_length, value);
+    } else {
         /* No need to switch byte order as native MCU endianness is little-endian (intel) */
-    } else if (signal.byteOrder == bigEndian) {
-        if (signal.bit_length <= 8) {
-            /* No need to switch byte order as signal length is smaller than one byte */
-        } else if (signal.bit_length <= 16) {
-            /* Swap byte order */
-            value = (uint64_t)MATH_swapBytes_uint16_t((uint16_t)value);
-        } else if (signal.bit_length <= 32) {
-            /* Swap byte order */
-            value = (uint64_t)MATH_swapBytes_uint32_t((uint32_t)value);
-        } else {  /* (signal.bit_length <= 64) */
-            /* Swap byte order */
-            value = MATH_swapBytes_uint64_t(value);
+        bitmask = CANS_GetBitmask(signal.bit_length);
+        dataPtr64[0] &= ~(((uint64_t)bitmask) << signal.bit_position);
+        dataPtr64[0] |= ((((uint64_t)value) & bitmask) << signal.bit_position);
+    }
+}
+
+/**
+ * @brief   adds the signals of one node to the signal ranges of the messages
+ *
+ * The signals of a message are expected to be defined one after the other in
+ * the signal array. If they are not, the message is marked as not contiguous
+ * and falls back to a search over all signals.
+ *
+ * @param   ranges          signal ranges of all messages of this direction
+ * @param   nrOfMessages    length of ranges
+ * @param   signals         signal array of one node
+ * @param   nrOfSignals     length of signals
+ * @param   direction       CAN_TX_DIRECTION or CAN_RX_DIRECTION
+ */
+static void CANS_BuildSignalIndex(CANS_SIGNAL_RANGE_s *ranges, uint16_t nrOfMessages, const CANS_signal_s *signals,
+        uint16_t nrOfSignals, CANS_messageDirection_t direction) {
+    uint16_t msgIdx = 0;
+
+    for (uint16_t i = 0; i < nrOfSignals; i++) {
+        if (direction == CAN_TX_DIRECTION) {
+            msgIdx = (uint16_t)signals[i].msgIdx.Tx;
+        } else {
+            msgIdx = (uint16_t)signals[i].msgIdx.Rx;
+        }
+        if (msgIdx < nrOfMessages) {
+            if (ranges[msgIdx].count == 0) {
+                ranges[msgIdx].first = i;
+                ranges[msgIdx].count = 1;
+            } else if ((ranges[msgIdx].first + ranges[msgIdx].count) == i) {
+                ranges[msgIdx].count++;
+            } else {
+                ranges[msgIdx].contiguous = FALSE;
+            }
         }
     }
+}
 
-    /* Set can data according to configuration */
-    bitmask = CANS_GetBitmask(signal.bit_length);
-    dataPtr64[0] &= ~(((uint64_t)bitmask) << signal.bit_position);
-    dataPtr64[0] |= ((((uint64_t)value) & bitmask) << signal.bit_position);
+/**
+ * @brief   gets the part of the signal array that has to be searched for the signals of a message
+ *
+ * @param[in]   ranges          signal ranges of all messages of this direction
+ * @param[in]   nrOfMessages    length of ranges
+ * @param[in]   msgIdx          message index
+ * @param[in]   nrOfSignals     length of the signal array of the node
+ * @param[out]  first           index of the first signal to check
+ * @param[out]  end             index after the last signal to check
+ */
+static void CANS_GetSignalRange(const CANS_SIGNAL_RANGE_s *ranges, uint16_t nrOfMessages, uint16_t msgIdx,
+        uint16_t nrOfSignals, uint16_t *first, uint16_t *end) {
+    if ((cans_state.signal_index_ready == TRUE) && (msgIdx < nrOfMessages) && (ranges[msgIdx].contiguous == TRUE)) {
+        *first = ranges[msgIdx].first;
+        *end = ranges[msgIdx].first + ranges[msgIdx].count;
+    } else {
+        *first = 0;
+        *end = nrOfSignals;
+    }
 }
 
 /**
@@ -323,21 +837,25 @@ static void CANS_SetSignalData(CANS_signal_s signal, uint64_t value, uint8_t *da
  * @param[out] dataptr  pointer where the message data should be stored to
  */
 static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msgIdx, uint8_t dataptr[]) {
-    uint32_t i = 0;
-    uint32_t nrTxSignals = 0;
+    uint16_t i = 0;
+    uint16_t first = 0;
+    uint16_t end = 0;
+    uint16_t nrTxSignals = 0;
     /* find multiplexor if multiplexed signal */
 
-    CANS_signal_s *cans_signals_tx;
+    const CANS_signal_s *cans_signals_tx = NULL_PTR;
 
     if (canNode == CAN_NODE0) {
-        cans_signals_tx = (CANS_signal_s *)&cans_CAN0_signals_tx;
+        cans_signals_tx = cans_CAN0_signals_tx;
         nrTxSignals = cans_CAN0_signals_tx_length;
     } else if (canNode == CAN_NODE1) {
-        cans_signals_tx = (CANS_signal_s *)&cans_CAN1_signals_tx;
+        cans_signals_tx = cans_CAN1_signals_tx;
         nrTxSignals = cans_CAN1_signals_tx_length;
     }
 
-    for (i = 0; i < nrTxSignals; i++) {
+    /* only the signals of this message are visited if the index is available */
+    CANS_GetSignalRange(cans_txSignalRanges, CANS_MSG_TX_MAX, (uint16_t)msgIdx, nrTxSignals, &first, &end);
+    for (i = first; i < end; i++) {
         if (cans_signals_tx[i].msgIdx.Tx == msgIdx) {
             /* simple, not multiplexed signal */
             uint64_t value = 0;
@@ -360,30 +878,28 @@ static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msg
  * @param[in]   dataptr  pointer where the message data is stored
 */
 static void CANS_ParseMessage(CAN_NodeTypeDef_e canNode, CANS_messagesRx_e msgIdx, uint8_t dataptr[]) {
-    uint32_t i = 0;
+    uint16_t i = 0;
+    uint16_t first = 0;
+    uint16_t end = 0;
+    uint16_t nrRxSignals = 0;
+    const CANS_signal_s *cans_signals_rx = NULL_PTR;
 
     if (canNode == CAN_NODE0) {
-        for (i = 0; i < cans_CAN0_signals_rx_length; i++) {
-            /* Iterate over CAN0 rx signals and find message */
-
-            if (cans_CAN0_signals_rx[i].msgIdx.Rx  ==  msgIdx) {
-                uint64_t value = 0;
-                CANS_GetSignalData(&value, cans_CAN0_signals_rx[i], dataptr);
-                if (cans_CAN0_signals_rx[i].callback != NULL_PTR) {
-                    cans_CAN0_signals_rx[i].callback(i, &value);
-                }
-            }
-        }
+        cans_signals_rx = cans_CAN0_signals_rx;
+        nrRxSignals = cans_CAN0_signals_rx_length;
     } else if (canNode == CAN_NODE1) {
-        for (i = 0; i < cans_CAN1_signals_rx_length; i++) {
-            /* Iterate over CAN1 rx signals and find message */
-
-            if (cans_CAN1_signals_rx[i].msgIdx.Rx  ==  msgIdx) {
-                uint64_t value = 0;
-                CANS_GetSignalData(&value, cans_CAN1_signals_rx[i], dataptr);
-                if (cans_CAN1_signals_rx[i].callback != NULL_PTR) {
-                    cans_CAN1_signals_rx[i].callback(i, &value);
-                }
+        cans_signals_rx = cans_CAN1_signals_rx;
+        nrRxSignals = cans_CAN1_signals_rx_length;
+    }
+
+    /* Iterate over the rx signals of this message, all rx signals if the index is not available */
+    CANS_GetSignalRange(cans_rxSignalRanges, CANS_MSG_RX_MAX, (uint16_t)msgIdx, nrRxSignals, &first, &end);
+    for (i = first; i < end; i++) {
+        if (cans_signals_rx[i].msgIdx.Rx  ==  msgIdx) {
+            uint64_t value = 0;
+            CANS_GetSignalData(&value, cans_signals_rx[i], dataptr);
+            if (cans_signals_rx[i].callback != NULL_PTR) {
+                cans_signals_rx[i].callback(i, &value);
             }
         }
     }
@@ -456,6 +972,33 @@ static uint8_t CANS_CheckCanTiming(void) {
 }
 
 
+/**
+ * @brief   checks if the CAN driver dropped received messages
+ *
+ * @details The RX buffers of the CAN driver are emptied in every call of
+ *          CANS_MainFunction(). Messages that arrive while a buffer is full
+ *          are dropped and counted by the driver. Every new drop since the
+ *          last call is reported on DIAG_CH_CAN_RX_QUEUE_FULL.
+ */
+static void CANS_CheckRxDropped(void) {
+    uint32_t droppedMsgs = 0;
+
+#if CAN_USE_CAN_NODE0 == TRUE
+    droppedMsgs += CAN_GetRxDroppedMsgs(CAN_NODE0);
+#endif
+#if CAN_USE_CAN_NODE1 == TRUE
+    droppedMsgs += CAN_GetRxDroppedMsgs(CAN_NODE1);
+#endif
+
+    if (droppedMsgs != cans_state.rx_dropped_msgs) {
+        DIAG_Handler(DIAG_CH_CAN_RX_QUEUE_FULL, DIAG_EVENT_NOK, 0);
+    } else {
+        DIAG_Handler(DIAG_CH_CAN_RX_QUEUE_FULL, DIAG_EVENT_OK, 0);
+    }
+    cans_state.rx_dropped_msgs = droppedMsgs;
+}
+
+
 /**
  * @brief   enable/disable the periodic transmit/receive.
  *
@@ -71,17 +71,34 @@ typedef struct {
     uint8_t periodic_enable;                   /*!< defines if periodic transmit and receive should run  */
     uint8_t current_sensor_present;            /*!< defines if a current sensor is detected  */
     uint8_t current_sensor_cc_present;         /*!< defines if a CC info is being sent  */
+    uint8_t signal_index_ready;                /*!< TRUE after CANS_Init() built the signal ranges of the messages */
+    uint8_t tx_phase_ready;                    /*!< TRUE after CANS_Init() assigned the phases of the TX messages */
+    uint8_t tx_max_slot_load_node0;            /*!< worst-case number of TX messages queued in one tick on CAN0 */
+    uint8_t tx_max_slot_load_node1;            /*!< worst-case number of TX messages queued in one tick on CAN1 */
+    uint32_t rx_dropped_msgs;                  /*!< RX messages dropped by the CAN driver on all nodes at the last check */
 } CANS_STATE_s;
 
 
 /*================== Function Prototypes ==================================*/
 /**
  * initializes local variables and module internals needed to use conversion of
- * can signals. Until now no initialization is needed and thus the function does
- * nothing.
+ * can signals. Builds the index of the signals of each message, so composing
+ * and parsing a message only visits its own signals. Without this call, all
+ * signals are searched for each message.
  */
 extern void CANS_Init(void);
 
+/**
+ * gets the worst-case number of periodic TX messages that are queued on a
+ * CAN node in the same call of CANS_MainFunction(). It is computed by
+ * CANS_Init() and has to fit in the TX buffer of the node.
+ *
+ * @param   canNode     CAN node
+ *
+ * @return  maximum number of messages per tick, 0 if unknown
+ */
+extern uint8_t CANS_GetTxMaxSlotLoad(CAN_NodeTypeDef_e canNode);
+
 /**
  * handles the conversion of can signals from and to datamanager database or
  * other modules defined by the getter and setter configuration.
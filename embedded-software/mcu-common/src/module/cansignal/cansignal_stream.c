@@ -0,0 +1,234 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    cansignal_stream.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  CANS
+ *
+ * @brief   Multiplexed, delta encoded cell voltage stream on CAN
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "cansignal_stream.h"
+
+#include "batterysystem_cfg.h"
+#include "cansignal.h"
+#include "database.h"
+
+/*================== Macros and Definitions ===============================*/
+#define CANS_STREAM_CELLS_PER_GROUP     8u
+#define CANS_STREAM_CELLS_PER_ABSOLUTE  4u
+#define CANS_STREAM_NR_OF_GROUPS        ((BS_NR_OF_BAT_CELLS + CANS_STREAM_CELLS_PER_GROUP - 1u) / CANS_STREAM_CELLS_PER_GROUP)
+#define CANS_STREAM_PERIOD_TICKS        (CANS_STREAM_PERIOD_MS / CANS_TICK_MS)
+
+#define CANS_STREAM_TYPE_SHIFT          6u
+#define CANS_STREAM_SEQUENCE_SHIFT      8u
+#define CANS_STREAM_SEQUENCE_MASK       0x0Fu
+#define CANS_STREAM_PAYLOAD_SHIFT       12u
+
+#define CANS_STREAM_VOLTAGE_BITS        13u
+#define CANS_STREAM_VOLTAGE_MAX         ((1u << CANS_STREAM_VOLTAGE_BITS) - 1u)
+#define CANS_STREAM_DELTA_BITS          6u
+#define CANS_STREAM_DELTA_MASK          ((1u << CANS_STREAM_DELTA_BITS) - 1u)
+#define CANS_STREAM_DELTA_MIN           (-32)
+#define CANS_STREAM_DELTA_MAX           (31)
+
+#if CANS_STREAM_NR_OF_GROUPS > 64u
+#error "The cell voltage stream supports at most 512 cells"
+#endif
+
+#if (CANS_STREAM_PERIOD_MS % CANS_TICK_MS) != 0
+#error "CANS_STREAM_PERIOD_MS has to be a multiple of CANS_TICK_MS"
+#endif
+
+/*================== Constant and Variable Definitions ====================*/
+/** cell voltages of the current period */
+static DATA_BLOCK_CELLVOLTAGE_s cans_streamVoltages;
+
+/** voltages last sent for each cell, reference of the delta frames */
+static uint16_t cans_streamSentVoltages[CANS_STREAM_NR_OF_GROUPS * CANS_STREAM_CELLS_PER_GROUP];
+
+/** sequence counter of each group */
+static uint8_t cans_streamSequence[CANS_STREAM_NR_OF_GROUPS];
+
+/** TRUE if the receiver knows the values in cans_streamSentVoltages of the group */
+static uint8_t cans_streamSynchronized[CANS_STREAM_NR_OF_GROUPS];
+
+static uint32_t cans_streamTick = 0;
+static uint32_t cans_streamCycle = 0;
+
+/*================== Function Prototypes ==================================*/
+static uint16_t CANS_StreamGetVoltage(uint16_t cellIdx);
+static STD_RETURN_TYPE_e CANS_StreamSendFrame(uint8_t group, CANS_STREAM_FRAME_TYPE_e type, uint64_t payload);
+static void CANS_StreamGroup(uint8_t group, uint8_t keyframe);
+
+/*================== Function Implementations =============================*/
+
+/*================== Public functions =====================================*/
+void CANS_StreamCellVoltages(void) {
+    uint32_t slot = cans_streamTick % CANS_STREAM_PERIOD_TICKS;
+
+    if (slot == 0u) {
+        /* one consistent set of voltages per period */
+        DB_ReadBlock(&cans_streamVoltages, DATA_BLOCK_ID_CELLVOLTAGE);
+        cans_streamCycle++;
+    }
+
+    for (uint32_t group = slot; group < CANS_STREAM_NR_OF_GROUPS; group += CANS_STREAM_PERIOD_TICKS) {
+        /* the keyframes of the groups are spread over the cycles */
+        CANS_StreamGroup((uint8_t)group, ((cans_streamCycle + group) % CANS_STREAM_KEYFRAME_CYCLES) == 0u);
+    }
+    cans_streamTick++;
+}
+
+uint8_t CANS_StreamGetMaxFramesPerTick(void) {
+    /* groups per tick, two absolute frames per group */
+    return (uint8_t)(2u * ((CANS_STREAM_NR_OF_GROUPS + CANS_STREAM_PERIOD_TICKS - 1u) / CANS_STREAM_PERIOD_TICKS));
+}
+
+/*================== Static functions =====================================*/
+/**
+ * gets the voltage of a cell as sent in the stream
+ *
+ * @param   cellIdx     index of the cell in the battery system
+ *
+ * @return  voltage in mV, limited to 13 bit, 0 if the cell is invalid or does not exist
+ */
+static uint16_t CANS_StreamGetVoltage(uint16_t cellIdx) {
+    uint16_t voltage = 0;
+    uint16_t modIdx = cellIdx / BS_NR_OF_BAT_CELLS_PER_MODULE;
+
+    if (cellIdx < BS_NR_OF_BAT_CELLS) {
+        if (((cans_streamVoltages.valid_volt[modIdx] >> (cellIdx % BS_NR_OF_BAT_CELLS_PER_MODULE)) & 0x01u) == 0u) {
+            voltage = cans_streamVoltages.voltage[cellIdx];
+            if (voltage > CANS_STREAM_VOLTAGE_MAX) {
+                voltage = CANS_STREAM_VOLTAGE_MAX;
+            }
+        }
+    }
+    return voltage;
+}
+
+/**
+ * sends one frame of the stream and increments the sequence counter of the group
+ *
+ * @param   group       index of the group
+ * @param   type        frame type
+ * @param   payload     bits 12 - 63 of the frame
+ *
+ * @return  E_OK if the frame was transferred to the CAN module, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e CANS_StreamSendFrame(uint8_t group, CANS_STREAM_FRAME_TYPE_e type, uint64_t payload) {
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    uint8_t data[8] = {0};
+    uint64_t frame = ((uint64_t)group) |
+            (((uint64_t)type) << CANS_STREAM_TYPE_SHIFT) |
+            (((uint64_t)(cans_streamSequence[group] & CANS_STREAM_SEQUENCE_MASK)) << CANS_STREAM_SEQUENCE_SHIFT) |
+            (payload << CANS_STREAM_PAYLOAD_SHIFT);
+
+    for (uint8_t i = 0; i < 8u; i++) {
+        data[i] = (uint8_t)(frame >> (8u * i));
+    }
+    retVal = CANS_AddMessage(CAN_NODE0, CAN_ID_CELLVOLTAGE_STREAM, data, 8, 0);
+    if (retVal == E_OK) {
+        cans_streamSequence[group]++;
+    }
+    return retVal;
+}
+
+/**
+ * sends a group of cells as one delta frame if possible, else as two absolute frames
+ *
+ * @param   group       index of the group
+ * @param   keyframe    TRUE to send absolute frames
+ */
+static void CANS_StreamGroup(uint8_t group, uint8_t keyframe) {
+    uint16_t voltages[CANS_STREAM_CELLS_PER_GROUP];
+    uint16_t *sent = &cans_streamSentVoltages[group * CANS_STREAM_CELLS_PER_GROUP];
+    uint64_t payload = 0;
+    int32_t delta = 0;
+    uint8_t useDelta = cans_streamSynchronized[group];
+    STD_RETURN_TYPE_e result = E_OK;
+
+    if (keyframe == TRUE) {
+        useDelta = FALSE;
+    }
+    for (uint8_t i = 0; i < CANS_STREAM_CELLS_PER_GROUP; i++) {
+        voltages[i] = CANS_StreamGetVoltage((group * CANS_STREAM_CELLS_PER_GROUP) + i);
+        delta = (int32_t)voltages[i] - (int32_t)sent[i];
+        if ((delta < CANS_STREAM_DELTA_MIN) || (delta > CANS_STREAM_DELTA_MAX)) {
+            useDelta = FALSE;
+        }
+    }
+
+    if (useDelta == TRUE) {
+        for (uint8_t i = 0; i < CANS_STREAM_CELLS_PER_GROUP; i++) {
+            delta = (int32_t)voltages[i] - (int32_t)sent[i];
+            payload |= ((uint64_t)((uint32_t)delta & CANS_STREAM_DELTA_MASK)) << (CANS_STREAM_DELTA_BITS * i);
+        }
+        result = CANS_StreamSendFrame(group, CANS_STREAM_DELTA, payload);
+    } else {
+        for (uint8_t i = 0; i < CANS_STREAM_CELLS_PER_GROUP; i++) {
+            payload |= ((uint64_t)voltages[i]) << (CANS_STREAM_VOLTAGE_BITS * (i % CANS_STREAM_CELLS_PER_ABSOLUTE));
+            if ((i % CANS_STREAM_CELLS_PER_ABSOLUTE) == (CANS_STREAM_CELLS_PER_ABSOLUTE - 1u)) {
+                if (CANS_StreamSendFrame(group, (i < CANS_STREAM_CELLS_PER_ABSOLUTE) ?
+                        CANS_STREAM_ABSOLUTE_LOW : CANS_STREAM_ABSOLUTE_HIGH, payload) != E_OK) {
+                    result = E_NOT_OK;
+                }
+                payload = 0;
+            }
+        }
+    }
+
+    if (result == E_OK) {
+        for (uint8_t i = 0; i < CANS_STREAM_CELLS_PER_GROUP; i++) {
+            sent[i] = voltages[i];
+        }
+        cans_streamSynchronized[group] = TRUE;
+    } else {
+        /* the receiver may have missed values, resend absolute values */
+        cans_streamSynchronized[group] = FALSE;
+    }
+}
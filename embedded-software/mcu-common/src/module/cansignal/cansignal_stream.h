@@ -0,0 +1,109 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    cansignal_stream.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  CANS
+ *
+ * @brief   Header for the multiplexed, delta encoded cell voltage stream on CAN
+ *
+ * All frames of the stream use the ID CAN_ID_CELLVOLTAGE_STREAM. The cells of
+ * the battery system are split into groups of 8 consecutive cells. The 8 data
+ * bytes of a frame are read as one little endian 64 bit value:
+ *
+ *  bits     | content
+ *  -------- | -------------------------------------------------------------
+ *  0 - 5    | group index, cells 8 * group ... 8 * group + 7
+ *  6 - 7    | frame type, see CANS_STREAM_FRAME_TYPE_e
+ *  8 - 11   | sequence counter of the group, incremented with every frame
+ *  12 - 63  | absolute frame: 4 cell voltages with 13 bit, unit mV
+ *  12 - 59  | delta frame: 8 changes with 6 bit two's complement, unit mV
+ *
+ * A voltage of 0 marks an invalid or not existing cell. Delta frames refer to
+ * the last values sent for the group, so a receiver only applies them if it
+ * received both absolute frames and no sequence counter value is missing.
+ *
+ * The decoder for the stream is in tools/gui/foxbms_interface.py.
+ */
+
+#ifndef CANSIGNAL_STREAM_H_
+#define CANSIGNAL_STREAM_H_
+
+/*================== Includes =============================================*/
+#include "cansignal_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * type of a frame of the cell voltage stream
+ */
+typedef enum {
+    CANS_STREAM_ABSOLUTE_LOW    = 0,    /*!< absolute voltages of the cells 0 - 3 of the group */
+    CANS_STREAM_ABSOLUTE_HIGH   = 1,    /*!< absolute voltages of the cells 4 - 7 of the group */
+    CANS_STREAM_DELTA           = 2,    /*!< changes of the cells 0 - 7 of the group */
+} CANS_STREAM_FRAME_TYPE_e;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+/**
+ * @brief   sends the groups of cell voltages due in this tick
+ *
+ * Called every CANS_TICK_MS by CANS_MainFunction(). The database is read at
+ * the start of every CANS_STREAM_PERIOD_MS, then the groups are spread over
+ * the ticks of the period. A group is sent as one delta frame if all changes
+ * fit in 6 bit, otherwise and every CANS_STREAM_KEYFRAME_CYCLES periods as two
+ * absolute frames.
+ */
+extern void CANS_StreamCellVoltages(void);
+
+/**
+ * @brief   gets the maximum number of frames the stream sends in one tick
+ *
+ * @return  number of frames
+ */
+extern uint8_t CANS_StreamGetMaxFramesPerTick(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* CANSIGNAL_STREAM_H_ */
@@ -0,0 +1,447 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    isotp.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  ISOTP
+ *
+ * @brief   ISO-TP (ISO 15765-2) segmentation and reassembly of requests and responses on CAN0
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "isotp.h"
+
+#include "cansignal.h"
+#include "os.h"
+#include <string.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * protocol control information, upper nibble of the first byte of a frame
+ */
+#define ISOTP_PCI_SINGLE_FRAME          0x0
+#define ISOTP_PCI_FIRST_FRAME           0x1
+#define ISOTP_PCI_CONSECUTIVE_FRAME     0x2
+#define ISOTP_PCI_FLOW_CONTROL          0x3
+
+/**
+ * flow status of a flow control frame
+ */
+#define ISOTP_FLOW_CONTINUE_TO_SEND     0x0
+#define ISOTP_FLOW_WAIT                 0x1
+#define ISOTP_FLOW_OVERFLOW             0x2
+
+/**
+ * response service ID of negative responses
+ */
+#define ISOTP_NEGATIVE_RESPONSE         0x7F
+
+/**
+ * offset of the service ID of positive responses
+ */
+#define ISOTP_POSITIVE_RESPONSE_OFFSET  0x40
+
+/**
+ * states of the reception of a request
+ */
+typedef enum {
+    ISOTP_RX_IDLE           = 0,    /*!< no request in reception */
+    ISOTP_RX_CONSECUTIVE    = 1,    /*!< first frame received, waiting for consecutive frames */
+    ISOTP_RX_COMPLETE       = 2,    /*!< request received, waiting for processing */
+} ISOTP_RX_STATE_e;
+
+/**
+ * states of the transmission of a response
+ */
+typedef enum {
+    ISOTP_TX_IDLE           = 0,    /*!< no response to send */
+    ISOTP_TX_FIRST          = 1,    /*!< response ready, single or first frame not sent yet */
+    ISOTP_TX_WAIT_FC        = 2,    /*!< waiting for a flow control frame of the tester */
+    ISOTP_TX_CONSECUTIVE    = 3,    /*!< sending consecutive frames */
+} ISOTP_TX_STATE_e;
+
+/**
+ * reception of a request
+ */
+typedef struct {
+    ISOTP_RX_STATE_e state;
+    uint16_t length;            /*!< length of the request in bytes */
+    uint16_t index;             /*!< number of bytes received */
+    uint8_t sequence;           /*!< sequence number of the next consecutive frame */
+    uint8_t blockCounter;       /*!< consecutive frames received since the last flow control frame */
+    uint8_t flowStatus;         /*!< flow status to send */
+    uint8_t flowPending;        /*!< TRUE if the flow control frame could not be sent yet */
+    uint32_t timestamp;         /*!< time of the last frame in ms */
+    uint8_t buffer[ISOTP_RX_BUFFER_LENGTH];
+} ISOTP_RX_s;
+
+/**
+ * transmission of a response
+ */
+typedef struct {
+    ISOTP_TX_STATE_e state;
+    uint16_t length;            /*!< length of the response in bytes */
+    uint16_t index;             /*!< number of bytes sent */
+    uint8_t sequence;           /*!< sequence number of the next consecutive frame */
+    uint8_t blockSize;          /*!< block size requested by the tester, 0: no further flow control */
+    uint8_t blockCounter;       /*!< consecutive frames sent since the last flow control frame */
+    uint8_t nrOfWaits;          /*!< flow control frames with status wait received in a row */
+    uint32_t separationTime;    /*!< separation time requested by the tester in ms */
+    uint32_t timestamp;         /*!< time of the last frame sent or received in ms */
+    uint8_t buffer[ISOTP_TX_BUFFER_LENGTH];
+} ISOTP_TX_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+static ISOTP_RX_s isotp_rx = {
+        .state = ISOTP_RX_IDLE,
+};
+
+static ISOTP_TX_s isotp_tx = {
+        .state = ISOTP_TX_IDLE,
+};
+
+/*================== Function Prototypes ==================================*/
+
+static void ISOTP_ReceiveFlowControl(const uint8_t *data, uint8_t dlc);
+static void ISOTP_SendFlowControl(void);
+static void ISOTP_ProcessRequest(void);
+static void ISOTP_SendFirstFrame(uint32_t timestamp);
+static void ISOTP_SendConsecutiveFrames(uint32_t timestamp);
+static uint32_t ISOTP_GetSeparationTime(uint8_t stmin);
+
+/*================== Function Implementations =============================*/
+
+/*================== Public functions =====================================*/
+void ISOTP_ReceiveFrame(const uint8_t *data, uint8_t dlc) {
+    uint16_t length = 0;
+    uint16_t nrOfBytes = 0;
+    uint8_t requestAccepted = FALSE;
+
+    if ((isotp_rx.state != ISOTP_RX_COMPLETE) && (isotp_tx.state == ISOTP_TX_IDLE)) {
+        requestAccepted = TRUE;
+    }
+
+    if (dlc > 0) {
+        switch (data[0] >> 4) {
+            case ISOTP_PCI_SINGLE_FRAME:
+                length = data[0] & 0x0F;
+                if ((requestAccepted == TRUE) && (length > 0) && (length < dlc)) {
+                    memcpy(&isotp_rx.buffer[0], &data[1], length);
+                    isotp_rx.length = length;
+                    isotp_rx.flowPending = FALSE;
+                    isotp_rx.state = ISOTP_RX_COMPLETE;
+                }
+                break;
+
+            case ISOTP_PCI_FIRST_FRAME:
+                length = (uint16_t)(((uint16_t)(data[0] & 0x0F) << 8) | data[1]);
+                if ((requestAccepted == TRUE) && (length > 7) && (dlc == 8)) {
+                    isotp_rx.state = ISOTP_RX_IDLE;
+                    isotp_rx.flowStatus = ISOTP_FLOW_OVERFLOW;
+                    if (length <= ISOTP_RX_BUFFER_LENGTH) {
+                        memcpy(&isotp_rx.buffer[0], &data[2], 6);
+                        isotp_rx.length = length;
+                        isotp_rx.index = 6;
+                        isotp_rx.sequence = 1;
+                        isotp_rx.blockCounter = 0;
+                        isotp_rx.timestamp = OS_getOSSysTick();
+                        isotp_rx.flowStatus = ISOTP_FLOW_CONTINUE_TO_SEND;
+                        isotp_rx.state = ISOTP_RX_CONSECUTIVE;
+                    }
+                    ISOTP_SendFlowControl();
+                }
+                break;
+
+            case ISOTP_PCI_CONSECUTIVE_FRAME:
+                if (isotp_rx.state == ISOTP_RX_CONSECUTIVE) {
+                    if ((data[0] & 0x0F) != isotp_rx.sequence) {
+                        /* frame lost, the tester has to repeat the request */
+                        isotp_rx.state = ISOTP_RX_IDLE;
+                    } else {
+                        nrOfBytes = isotp_rx.length - isotp_rx.index;
+                        if (nrOfBytes > 7) {
+                            nrOfBytes = 7;
+                        }
+                        if (nrOfBytes < dlc) {
+                            memcpy(&isotp_rx.buffer[isotp_rx.index], &data[1], nrOfBytes);
+                            isotp_rx.index += nrOfBytes;
+                            isotp_rx.sequence = (isotp_rx.sequence + 1) & 0x0F;
+                            isotp_rx.timestamp = OS_getOSSysTick();
+                            if (isotp_rx.index >= isotp_rx.length) {
+                                isotp_rx.state = ISOTP_RX_COMPLETE;
+                            } else if (ISOTP_BLOCK_SIZE > 0) {
+                                isotp_rx.blockCounter++;
+                                if (isotp_rx.blockCounter >= ISOTP_BLOCK_SIZE) {
+                                    isotp_rx.blockCounter = 0;
+                                    ISOTP_SendFlowControl();
+                                }
+                            }
+                        } else {
+                            isotp_rx.state = ISOTP_RX_IDLE;
+                        }
+                    }
+                }
+                break;
+
+            case ISOTP_PCI_FLOW_CONTROL:
+                ISOTP_ReceiveFlowControl(data, dlc);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+
+void ISOTP_MainFunction(void) {
+    uint32_t timestamp = OS_getOSSysTick();
+
+    if (isotp_rx.flowPending == TRUE) {
+        ISOTP_SendFlowControl();
+    }
+    if ((isotp_rx.state == ISOTP_RX_CONSECUTIVE) && ((timestamp - isotp_rx.timestamp) > ISOTP_TIMEOUT_MS)) {
+        /* N_Cr timeout */
+        isotp_rx.flowPending = FALSE;
+        isotp_rx.state = ISOTP_RX_IDLE;
+    }
+    if ((isotp_tx.state != ISOTP_TX_IDLE) && ((timestamp - isotp_tx.timestamp) > ISOTP_TIMEOUT_MS)) {
+        /* N_As, N_Bs or N_Cs timeout */
+        isotp_tx.state = ISOTP_TX_IDLE;
+    }
+
+    if ((isotp_rx.state == ISOTP_RX_COMPLETE) && (isotp_tx.state == ISOTP_TX_IDLE)) {
+        ISOTP_ProcessRequest();
+        isotp_rx.state = ISOTP_RX_IDLE;
+        isotp_tx.timestamp = timestamp;
+        isotp_tx.state = ISOTP_TX_FIRST;
+    }
+    if (isotp_tx.state == ISOTP_TX_FIRST) {
+        ISOTP_SendFirstFrame(timestamp);
+    }
+    if (isotp_tx.state == ISOTP_TX_CONSECUTIVE) {
+        ISOTP_SendConsecutiveFrames(timestamp);
+    }
+}
+
+
+/*================== Static functions =====================================*/
+/**
+ * @brief   processes a flow control frame of the tester for the response in transmission
+ *
+ * @param   data    data of the frame
+ * @param   dlc     length of data in bytes
+ */
+static void ISOTP_ReceiveFlowControl(const uint8_t *data, uint8_t dlc) {
+    if ((isotp_tx.state == ISOTP_TX_WAIT_FC) && (dlc >= 3)) {
+        switch (data[0] & 0x0F) {
+            case ISOTP_FLOW_CONTINUE_TO_SEND:
+                isotp_tx.blockSize = data[1];
+                isotp_tx.blockCounter = 0;
+                isotp_tx.nrOfWaits = 0;
+                isotp_tx.separationTime = ISOTP_GetSeparationTime(data[2]);
+                /* the first consecutive frame is sent without waiting */
+                isotp_tx.timestamp = OS_getOSSysTick() - isotp_tx.separationTime;
+                isotp_tx.state = ISOTP_TX_CONSECUTIVE;
+                break;
+
+            case ISOTP_FLOW_WAIT:
+                isotp_tx.nrOfWaits++;
+                isotp_tx.timestamp = OS_getOSSysTick();
+                if (isotp_tx.nrOfWaits > ISOTP_MAX_WAIT_FRAMES) {
+                    isotp_tx.state = ISOTP_TX_IDLE;
+                }
+                break;
+
+            default:
+                /* overflow or invalid flow status, the response is aborted */
+                isotp_tx.state = ISOTP_TX_IDLE;
+                break;
+        }
+    }
+}
+
+
+/**
+ * @brief   sends a flow control frame with the status isotp_rx.flowStatus
+ *
+ * If the CAN0 transmit buffer is full, the frame is sent by the next ISOTP_MainFunction().
+ */
+static void ISOTP_SendFlowControl(void) {
+    uint8_t data[8] = {ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE,
+            ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE};
+
+    data[0] = (uint8_t)((ISOTP_PCI_FLOW_CONTROL << 4) | isotp_rx.flowStatus);
+    data[1] = ISOTP_BLOCK_SIZE;
+    data[2] = ISOTP_STMIN_MS;
+    isotp_rx.flowPending = FALSE;
+    if (CANS_AddMessage(CAN_NODE0, CAN_ID_ISOTP_RESPONSE, &data[0], 8, 0) != E_OK) {
+        isotp_rx.flowPending = TRUE;
+    }
+}
+
+
+/**
+ * @brief   calls the handler of the received request and writes the response to isotp_tx.buffer
+ */
+static void ISOTP_ProcessRequest(void) {
+    uint8_t serviceId = isotp_rx.buffer[0];
+    uint8_t responseCode = ISOTP_NRC_SERVICE_NOT_SUPPORTED;
+    uint16_t responseLength = 0;
+
+    for (uint8_t i = 0; i < isotp_nr_of_services; i++) {
+        if (isotp_services[i].serviceId == serviceId) {
+            responseCode = isotp_services[i].handler(&isotp_rx.buffer[1], isotp_rx.length - 1,
+                    &isotp_tx.buffer[1], &responseLength, ISOTP_TX_BUFFER_LENGTH - 1);
+            break;
+        }
+    }
+
+    if (responseCode == ISOTP_POSITIVE_RESPONSE) {
+        isotp_tx.buffer[0] = serviceId + ISOTP_POSITIVE_RESPONSE_OFFSET;
+        isotp_tx.length = responseLength + 1;
+    } else {
+        isotp_tx.buffer[0] = ISOTP_NEGATIVE_RESPONSE;
+        isotp_tx.buffer[1] = serviceId;
+        isotp_tx.buffer[2] = responseCode;
+        isotp_tx.length = 3;
+    }
+}
+
+
+/**
+ * @brief   sends the response as single frame, or the first frame of a segmented response
+ *
+ * @param   timestamp   current time in ms
+ */
+static void ISOTP_SendFirstFrame(uint32_t timestamp) {
+    uint8_t data[8] = {ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE,
+            ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE};
+
+    if (isotp_tx.length <= 7) {
+        data[0] = (uint8_t)((ISOTP_PCI_SINGLE_FRAME << 4) | isotp_tx.length);
+        memcpy(&data[1], &isotp_tx.buffer[0], isotp_tx.length);
+        if (CANS_AddMessage(CAN_NODE0, CAN_ID_ISOTP_RESPONSE, &data[0], 8, 0) == E_OK) {
+            isotp_tx.state = ISOTP_TX_IDLE;
+        }
+    } else {
+        data[0] = (uint8_t)((ISOTP_PCI_FIRST_FRAME << 4) | (isotp_tx.length >> 8));
+        data[1] = (uint8_t)(isotp_tx.length & 0xFF);
+        memcpy(&data[2], &isotp_tx.buffer[0], 6);
+        if (CANS_AddMessage(CAN_NODE0, CAN_ID_ISOTP_RESPONSE, &data[0], 8, 0) == E_OK) {
+            isotp_tx.index = 6;
+            isotp_tx.sequence = 1;
+            isotp_tx.nrOfWaits = 0;
+            isotp_tx.timestamp = timestamp;
+            isotp_tx.state = ISOTP_TX_WAIT_FC;
+        }
+    }
+}
+
+
+/**
+ * @brief   sends the consecutive frames of the response due in this call
+ *
+ * @param   timestamp   current time in ms
+ */
+static void ISOTP_SendConsecutiveFrames(uint32_t timestamp) {
+    uint8_t data[8] = {0};
+    uint16_t nrOfBytes = 0;
+    uint8_t nrOfFrames = 0;
+    uint8_t bufferFull = FALSE;
+
+    while ((isotp_tx.state == ISOTP_TX_CONSECUTIVE) && (nrOfFrames < ISOTP_MAX_FRAMES_PER_CALL) &&
+            (bufferFull == FALSE) && ((timestamp - isotp_tx.timestamp) >= isotp_tx.separationTime)) {
+        nrOfBytes = isotp_tx.length - isotp_tx.index;
+        if (nrOfBytes > 7) {
+            nrOfBytes = 7;
+        }
+        memset(&data[0], ISOTP_PADDING_BYTE, sizeof(data));
+        data[0] = (uint8_t)((ISOTP_PCI_CONSECUTIVE_FRAME << 4) | isotp_tx.sequence);
+        memcpy(&data[1], &isotp_tx.buffer[isotp_tx.index], nrOfBytes);
+
+        if (CANS_AddMessage(CAN_NODE0, CAN_ID_ISOTP_RESPONSE, &data[0], 8, 0) == E_OK) {
+            nrOfFrames++;
+            isotp_tx.index += nrOfBytes;
+            isotp_tx.sequence = (isotp_tx.sequence + 1) & 0x0F;
+            isotp_tx.timestamp = timestamp;
+            if (isotp_tx.index >= isotp_tx.length) {
+                isotp_tx.state = ISOTP_TX_IDLE;
+            } else if (isotp_tx.blockSize > 0) {
+                isotp_tx.blockCounter++;
+                if (isotp_tx.blockCounter >= isotp_tx.blockSize) {
+                    isotp_tx.state = ISOTP_TX_WAIT_FC;
+                }
+            }
+        } else {
+            /* retried in the next call, the transfer is aborted after ISOTP_TIMEOUT_MS */
+            bufferFull = TRUE;
+        }
+    }
+}
+
+
+/**
+ * @brief   decodes the separation time of a flow control frame
+ *
+ * Values of 100 us - 900 us are rounded up to 1 ms, reserved values are handled as the
+ * longest separation time (127 ms), as specified in ISO 15765-2.
+ *
+ * @param   stmin   separation time parameter of the flow control frame
+ *
+ * @return  separation time in ms
+ */
+static uint32_t ISOTP_GetSeparationTime(uint8_t stmin) {
+    uint32_t separationTime = 0x7F;
+
+    if (stmin <= 0x7F) {
+        separationTime = stmin;
+    } else if ((stmin >= 0xF1) && (stmin <= 0xF9)) {
+        separationTime = 1;
+    }
+    return separationTime;
+}
@@ -0,0 +1,91 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    isotp.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  ISOTP
+ *
+ * @brief   Header for the ISO-TP (ISO 15765-2) transport on CAN0
+ *
+ * Requests of up to ISOTP_RX_BUFFER_LENGTH bytes are received on CAN_ID_ISOTP_REQUEST and
+ * responses of up to ISOTP_TX_BUFFER_LENGTH bytes are sent on CAN_ID_ISOTP_RESPONSE, with
+ * normal addressing, 8 byte frames and the unused bytes set to ISOTP_PADDING_BYTE. A complete
+ * request is processed by the handler of its service ID in isotp_services[].
+ *
+ * One request is processed at a time: new requests are ignored until the response is sent.
+ */
+
+#ifndef ISOTP_H_
+#define ISOTP_H_
+
+/*================== Includes =============================================*/
+#include "isotp_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+/**
+ * @brief   processes a frame received on CAN_ID_ISOTP_REQUEST
+ *
+ * Called by CANS_PeriodicReceive(), i.e., in the same task as ISOTP_MainFunction().
+ *
+ * @param   data    data of the frame
+ * @param   dlc     length of data in bytes
+ */
+extern void ISOTP_ReceiveFrame(const uint8_t *data, uint8_t dlc);
+
+/**
+ * @brief   processes the received requests, sends the responses and supervises the timeouts
+ *
+ * Called every CANS_TICK_MS by CANS_MainFunction(). Consecutive frames are sent as long as the
+ * CAN0 transmit buffer accepts them, up to ISOTP_MAX_FRAMES_PER_CALL. If the tester requests a
+ * separation time, one consecutive frame is sent per separation time, but at most one per call.
+ */
+extern void ISOTP_MainFunction(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* ISOTP_H_ */
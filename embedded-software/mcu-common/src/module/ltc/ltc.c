@@ -84,6 +84,16 @@
 
 #define LTC_MAX_SUPPORTED_CELLS         12
 
+#if (LTC_PAUSE_BALANCING_DURING_MEASUREMENT == TRUE) && (BS_NR_OF_BAT_CELLS_PER_MODULE > LTC_MAX_SUPPORTED_CELLS)
+#error "Pausing the balancing during the measurement is only supported up to 12 cells per module"
+#endif
+
+/**
+ * Longest time in ms accounted at once for the discharged balancing charge,
+ * keeps the integer calculation in LTC_AccountBalancingCharge() in range
+ */
+#define LTC_BALANCING_MAX_ACCOUNTING_TIME_MS    60000u
+
 /**
  * Saves the last state and the last substate
  */
@@ -107,6 +117,10 @@ static uint16_t ltc_openwire_pup_buffer[BS_NR_OF_BAT_CELLS];
 static uint16_t ltc_openwire_pdown_buffer[BS_NR_OF_BAT_CELLS];
 static int32_t ltc_openwire_delta[BS_NR_OF_BAT_CELLS];
 
+static uint8_t ltc_balancing_applied[BS_NR_OF_BAT_CELLS];   /* balancing state last written to the LTCs */
+static uint32_t ltc_balancing_remainder[BS_NR_OF_BAT_CELLS]; /* remainder of the charge division, unit: mV*ms */
+static uint32_t ltc_balancing_timestamp[2];                 /* time of the last write per register set */
+
 static LTC_ERRORTABLE_s LTC_ErrorTable[LTC_N_LTC];  /* init in LTC_ResetErrorTable-function */
 
 
@@ -137,6 +151,7 @@ static LTC_STATE_s ltc_state = {
     .ltc_muxcycle_finished   = E_NOT_OK,
     .check_spi_flag          = FALSE,
     .balance_control_done     = FALSE,
+    .balancing_paused         = FALSE,
 };
 
 static const uint8_t ltc_cmdDummy[1]={0x00};
@@ -223,7 +238,9 @@ static void LTC_Get_BalancingControlValues(void);
 static void LTC_StateTransition(LTC_STATEMACH_e state, uint8_t substate, uint16_t timer_ms);
 static void LTC_CondBasedStateTransition(STD_RETURN_TYPE_e retVal, DIAG_CH_ID_e diagCode, uint8_t state_ok, uint8_t substate_ok, uint16_t timer_ms_ok, uint8_t state_nok, uint8_t substate_nok, uint16_t timer_ms_nok);
 
-static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet);
+static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet, uint8_t pauseBalancing);
+static void LTC_AccountBalancingCharge(uint8_t registerSet);
+static uint8_t LTC_IsBalancingActive(void);
 static void LTC_ResetErrorTable(void);
 
 static STD_RETURN_TYPE_e LTC_StartVoltageMeasurement(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh);
@@ -762,17 +779,56 @@ void LTC_Trigger(void) {
             ltc_state.adcMode = LTC_VOLTAGE_MEASUREMENT_MODE;
             ltc_state.adcMeasCh = LTC_ADCMEAS_ALLCHANNEL;
 
+#if LTC_PAUSE_BALANCING_DURING_MEASUREMENT == TRUE
+            if (ltc_state.substate == LTC_PAUSE_BALANCING_STARTMEAS) {
+                if (LTC_IsBalancingActive() == TRUE) {
+                    /* the timer runs independent of the SPI flag to let the cell voltages settle */
+                    ltc_state.check_spi_flag = FALSE;
+                    ltc_state.balancing_paused = TRUE;
+                    SPI_SetTransmitOngoing();
+                    retVal = LTC_BalanceControl(0, TRUE);
+                    LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
+                            LTC_STATEMACH_STARTMEAS, LTC_TRIGGER_CONVERSION_STARTMEAS, (ltc_state.commandDataTransferTime + LTC_BALANCING_SETTLE_TIME_MS),
+                            LTC_STATEMACH_STARTMEAS, LTC_TRIGGER_CONVERSION_STARTMEAS, LTC_STATEMACH_SHORTTIME);
+                    break;
+                }
+            } else if (ltc_state.substate == LTC_TRIGGER_CONVERSION_STARTMEAS) {
+                if (SPI_IsTransmitOngoing() == TRUE) {
+                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0);
+                } else {
+                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0);
+                }
+            }
+#endif
+
             ltc_state.check_spi_flag = FALSE;
             retVal = LTC_StartVoltageMeasurement(ltc_state.adcMode, ltc_state.adcMeasCh);
-            LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
-                                      LTC_STATEMACH_READVOLTAGE, LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE, (ltc_state.commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state.adcMode, ltc_state.adcMeasCh)),
-                                      LTC_STATEMACH_READVOLTAGE, LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE, LTC_STATEMACH_SHORTTIME);
+            if (ltc_state.balancing_paused == TRUE) {
+                LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
+                        LTC_STATEMACH_READVOLTAGE, LTC_RESUME_BALANCING_READVOLTAGE, (ltc_state.commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state.adcMode, ltc_state.adcMeasCh)),
+                        LTC_STATEMACH_READVOLTAGE, LTC_RESUME_BALANCING_READVOLTAGE, LTC_STATEMACH_SHORTTIME);
+            } else {
+                LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
+                        LTC_STATEMACH_READVOLTAGE, LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE, (ltc_state.commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state.adcMode, ltc_state.adcMeasCh)),
+                        LTC_STATEMACH_READVOLTAGE, LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE, LTC_STATEMACH_SHORTTIME);
+            }
             break;
 
         /****************************READ VOLTAGE************************************/
         case LTC_STATEMACH_READVOLTAGE:
 
-            if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE) {
+            if (ltc_state.substate == LTC_RESUME_BALANCING_READVOLTAGE) {
+                /* conversion finished, the balancing can go on while the results are read */
+                ltc_state.check_spi_flag = TRUE;
+                ltc_state.balancing_paused = FALSE;
+                SPI_SetTransmitOngoing();
+                retVal = LTC_BalanceControl(0, FALSE);
+                LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
+                        LTC_STATEMACH_READVOLTAGE, LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE, (ltc_state.commandDataTransferTime+LTC_TRANSMISSION_TIMEOUT),
+                        LTC_STATEMACH_READVOLTAGE, LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE, LTC_STATEMACH_SHORTTIME);
+                break;
+
+            } else if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE) {
                 ltc_state.check_spi_flag = TRUE;
                 SPI_SetTransmitOngoing();
                 retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVA), ltc_RXPECbuffer);
@@ -1067,7 +1123,7 @@ void LTC_Trigger(void) {
             if (ltc_state.substate == LTC_CONFIG_BALANCECONTROL) {
                 ltc_state.check_spi_flag = TRUE;
                 SPI_SetTransmitOngoing();
-                retVal = LTC_BalanceControl(0);
+                retVal = LTC_BalanceControl(0, FALSE);
                 LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
                         LTC_STATEMACH_BALANCECONTROL, LTC_CONFIG2_BALANCECONTROL, (ltc_state.commandDataTransferTime+LTC_TRANSMISSION_TIMEOUT),
                         LTC_STATEMACH_BALANCECONTROL, LTC_CONFIG2_BALANCECONTROL, LTC_STATEMACH_SHORTTIME);
@@ -1084,7 +1140,7 @@ void LTC_Trigger(void) {
 
                 if (BS_NR_OF_BAT_CELLS_PER_MODULE > 12) {
                     SPI_SetTransmitOngoing();
-                    retVal = LTC_BalanceControl(1);
+                    retVal = LTC_BalanceControl(1, FALSE);
                     LTC_CondBasedStateTransition(retVal, DIAG_CH_LTC_SPI,
                             LTC_STATEMACH_BALANCECONTROL, LTC_CONFIG2_BALANCECONTROL_END, ltc_state.commandDataTransferTime+LTC_TRANSMISSION_TIMEOUT,
                             LTC_STATEMACH_BALANCECONTROL, LTC_CONFIG2_BALANCECONTROL_END, LTC_STATEMACH_SHORTTIME);
@@ -2343,18 +2399,24 @@ static STD_RETURN_TYPE_e LTC_Init(void) {
  * To set balancing for the cells, the corresponding bits have to be written in the configuration register.
  * The LTC driver only executes the balancing orders written by the BMS in the database.
  *
- * @param registerSet   Register Set, 0: cells 1 to 12 (WRCFG), 1: cells 13 to 15/18 (WRCFG2)
+ * @param registerSet       Register Set, 0: cells 1 to 12 (WRCFG), 1: cells 13 to 15/18 (WRCFG2)
+ * @param pauseBalancing    TRUE to switch off all cells of the register set regardless of the control values
  *
  * @return              E_OK if dummy byte was sent correctly by SPI, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet) {
+static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet, uint8_t pauseBalancing) {
     STD_RETURN_TYPE_e retVal = E_OK;
 
     uint16_t i = 0;
     uint16_t j = 0;
 
     LTC_Get_BalancingControlValues();
+    if (pauseBalancing == TRUE) {
+        for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
+            ltc_balancing_control.balancing_state[i] = 0;
+        }
+    }
 
     if (registerSet == 0) {  /* cells 1 to 12, WRCFG */
         for (j=0; j < BS_NR_OF_MODULES; j++) {
@@ -2443,6 +2505,80 @@ static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet) {
     } else {
         return E_NOT_OK;
     }
+    if (retVal == E_OK) {
+        LTC_AccountBalancingCharge(registerSet);
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   accounts the charge discharged by the balancing resistors and stores it in the database.
+ *
+ * Called each time a balancing configuration was sent. The charge discharged by
+ * every cell that was balanced since the last call for the same register set is
+ * computed with the last measured cell voltage as U[mV] * t[ms] / R[mOhm] = mAs.
+ * The remainder of the integer division is kept per cell, so no charge is lost
+ * however short the balancing intervals are. Afterwards, the sent configuration
+ * becomes the applied balancing state of the cells.
+ *
+ * @param registerSet   Register Set, 0: cells 1 to 12 (WRCFG), 1: cells 13 to 15/18 (WRCFG2)
+ */
+static void LTC_AccountBalancingCharge(uint8_t registerSet) {
+    uint16_t i = 0;
+    uint16_t j = 0;
+    uint16_t cell = 0;
+    uint16_t firstCell = 0;
+    uint16_t lastCell = LTC_MAX_SUPPORTED_CELLS;
+    uint32_t timestamp = OS_getOSSysTick();
+    uint32_t elapsed_ms = timestamp - ltc_balancing_timestamp[registerSet];
+    uint32_t charge = 0;
+    uint8_t changed = FALSE;
+
+    if (registerSet != 0) {
+        firstCell = LTC_MAX_SUPPORTED_CELLS;
+        lastCell = BS_NR_OF_BAT_CELLS_PER_MODULE;
+    } else if (lastCell > BS_NR_OF_BAT_CELLS_PER_MODULE) {
+        lastCell = BS_NR_OF_BAT_CELLS_PER_MODULE;
+    }
+    if (elapsed_ms > LTC_BALANCING_MAX_ACCOUNTING_TIME_MS) {
+        elapsed_ms = LTC_BALANCING_MAX_ACCOUNTING_TIME_MS;
+    }
+    ltc_balancing_timestamp[registerSet] = timestamp;
+
+    for (j=0; j < BS_NR_OF_MODULES; j++) {
+        for (i=firstCell; i < lastCell; i++) {
+            cell = j*(BS_NR_OF_BAT_CELLS_PER_MODULE) + i;
+            if (ltc_balancing_applied[cell] == 1) {
+                charge = (uint32_t)ltc_cellvoltage.voltage[cell] * elapsed_ms + ltc_balancing_remainder[cell];
+                ltc_balancing_feedback.discharged_charge[cell] += charge / LTC_BALANCING_RESISTANCE_MOHM;
+                ltc_balancing_remainder[cell] = charge % LTC_BALANCING_RESISTANCE_MOHM;
+                changed = TRUE;
+            }
+            ltc_balancing_applied[cell] = ltc_balancing_control.balancing_state[cell];
+        }
+    }
+
+    if (changed == TRUE) {
+        DB_WriteBlock(&ltc_balancing_feedback, DATA_BLOCK_ID_BALANCING_FEEDBACK_VALUES);
+    }
+}
+
+
+/**
+ * @brief   checks if the balancing of any cell is currently switched on.
+ *
+ * @return  TRUE if at least one cell is balanced, FALSE otherwise
+ */
+static uint8_t LTC_IsBalancingActive(void) {
+    uint16_t i = 0;
+    uint8_t retVal = FALSE;
+
+    for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
+        if (ltc_balancing_applied[i] == 1) {
+            retVal = TRUE;
+        }
+    }
     return retVal;
 }
 
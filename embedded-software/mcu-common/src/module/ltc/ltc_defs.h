@@ -171,6 +171,14 @@ typedef enum {
     LTC_ENTRY_INITIALIZED   = 0,    /*!<    */
 } LTC_STATEMACH_INITIALIZED_SUB_e;
 
+/**
+ * Substates for the start measurement state
+ */
+typedef enum {
+    LTC_PAUSE_BALANCING_STARTMEAS       = 0,    /*!< switch off balancing before the conversion */
+    LTC_TRIGGER_CONVERSION_STARTMEAS    = 1,    /*!< start the cell voltage conversion          */
+} LTC_STATEMACH_STARTMEAS_SUB_e;
+
 /**
  * Substates for the read voltage state
  */
@@ -188,6 +196,7 @@ typedef enum {
     LTC_READ_AUXILIARY_REGISTER_C_RDAUXC  = 9,    /*!<    */
     LTC_READ_AUXILIARY_REGISTER_D_RDAUXD  = 10,   /*!<    */
     LTC_EXIT_READAUXILIARY_ALLGPIOS                   = 11,   /*!<    */
+    LTC_RESUME_BALANCING_READVOLTAGE      = 12,   /*!< switch on balancing again after the conversion */
 } LTC_STATEMACH_READVOLTAGE_SUB_e;
 
 /**
@@ -571,6 +580,7 @@ typedef struct {
     STD_RETURN_TYPE_e ltc_muxcycle_finished;  /*!< flag that indictes if the measurement sequence of the multiplexers is finished              */
     STD_RETURN_TYPE_e check_spi_flag;         /*!< indicates if interrupt flag or timer must be considered */
     STD_RETURN_TYPE_e balance_control_done;   /*!< indicates if balance control was done */
+    uint8_t balancing_paused;                 /*!< TRUE if the balancing was switched off for the running cell voltage conversion */
     uint8_t resendCommandCounter;             /*!< counter if commandy should be send multiple times e.g. ADOW command */
 } LTC_STATE_s;
 
@@ -54,7 +54,7 @@
 #include "epcos_b57251v5103j060.h"
 
 #include <float.h>
-#include "foxmath.h"
+#include "lut.h"
 
 /*================== Macros and Definitions =================================*/
 
@@ -139,6 +139,8 @@ static uint16_t sizeLUT = sizeof(b57251v5103j060_LUT)/sizeof(B57251V5103J060_LUT
 
 /*================== Static Function Implementations ========================*/
 
+LUT_DEFINE_SEARCH_FLOAT(B57251V5103J060_Interpolate, B57251V5103J060_LUT_s, .resistance_Ohm, .temperature_C, LUT_CLAMP)
+
 /*================== Extern Function Implementations ========================*/
 
 extern float B57251V5103J060_GetTempFromLUT(uint16_t vadc_mV) {
@@ -167,25 +169,8 @@ extern float B57251V5103J060_GetTempFromLUT(uint16_t vadc_mV) {
                 (adcVoltage_V/(B57251V5103J060_RESISTOR_DIVIDER_SUPPLY_VOLTAGE_V - adcVoltage_V));
 #endif /* B57251V5103J060_POSITION_IN_RESISTOR_DIVIDER_IS_R1 */
 
-        /* Variables for interpolating LUT value */
-        uint16_t between_high = 0;
-        uint16_t between_low = 0;
-        for (uint16_t i = 1; i < sizeLUT; i++) {
-            if (resistance_Ohm < b57251v5103j060_LUT[i].resistance_Ohm) {
-                between_low = i+1;
-                between_high = i;
-            }
-        }
-
-        /* Interpolate between LUT vales, but do not extrapolate LUT! */
-        if (!((between_high == 0 && between_low == 0) ||  /* measured resistance > maximum LUT resistance */
-                 (between_low > sizeLUT))) {              /* measured resistance < minimum LUT resistance */
-            temperature = MATH_linearInterpolation(b57251v5103j060_LUT[between_low].resistance_Ohm,
-                    b57251v5103j060_LUT[between_low].temperature_C,
-                    b57251v5103j060_LUT[between_high].resistance_Ohm,
-                    b57251v5103j060_LUT[between_high].temperature_C,
-                              resistance_Ohm);
-        }
+        /* Interpolate between LUT values, the ADC voltage check above prevents extrapolation */
+        temperature = B57251V5103J060_Interpolate(b57251v5103j060_LUT, sizeLUT, resistance_Ohm);
     }
 
     /* Return temperature based on measured NTC resistance */
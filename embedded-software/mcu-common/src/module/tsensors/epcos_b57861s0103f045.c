@@ -54,7 +54,7 @@
 #include "epcos_b57861s0103f045.h"
 
 #include <float.h>
-#include "foxmath.h"
+#include "lut.h"
 
 /*================== Macros and Definitions =================================*/
 
@@ -140,6 +140,8 @@ static uint16_t sizeLUT = sizeof(B57861s0103f045_LUT)/sizeof(B57861S0103F045_LUT
 
 /*================== Static Function Implementations ========================*/
 
+LUT_DEFINE_SEARCH_FLOAT(B57861S0103F045_Interpolate, B57861S0103F045_LUT_s, .resistance_Ohm, .temperature_C, LUT_CLAMP)
+
 /*================== Extern Function Implementations ========================*/
 
 extern float B57861S0103F045_GetTempFromLUT(uint16_t vadc_mV) {
@@ -168,25 +170,8 @@ extern float B57861S0103F045_GetTempFromLUT(uint16_t vadc_mV) {
                 (adcVoltage_V/(B57861S0103F045_RESISTOR_DIVIDER_SUPPLY_VOLTAGE_V - adcVoltage_V));
 #endif /* B57861S0103F045_POSITION_IN_RESISTOR_DIVIDER_IS_R1 */
 
-        /* Variables for interpolating LUT value */
-        uint16_t between_high = 0;
-        uint16_t between_low = 0;
-        for (uint16_t i = 1; i < sizeLUT; i++) {
-            if (resistance_Ohm < B57861s0103f045_LUT[i].resistance_Ohm) {
-                between_low = i+1;
-                between_high = i;
-            }
-        }
-
-        /* Interpolate between LUT vales, but do not extrapolate LUT! */
-        if (!((between_high == 0 && between_low == 0) ||  /* measured resistance > maximum LUT resistance */
-                 (between_low > sizeLUT))) {              /* measured resistance < minimum LUT resistance */
-            temperature = MATH_linearInterpolation(B57861s0103f045_LUT[between_low].resistance_Ohm,
-                    B57861s0103f045_LUT[between_low].temperature_C,
-                    B57861s0103f045_LUT[between_high].resistance_Ohm,
-                    B57861s0103f045_LUT[between_high].temperature_C,
-                              resistance_Ohm);
-        }
+        /* Interpolate between LUT values, the ADC voltage check above prevents extrapolation */
+        temperature = B57861S0103F045_Interpolate(B57861s0103f045_LUT, sizeLUT, resistance_Ohm);
     }
 
     /* Return temperature based on measured NTC resistance */
@@ -54,7 +54,7 @@
 #include "vishay_ntcalug01a103g.h"
 
 #include <float.h>
-#include "foxmath.h"
+#include "lut.h"
 
 /*================== Macros and Definitions =================================*/
 
@@ -243,6 +243,8 @@ static const uint16_t sizeLUT = sizeof(ntcalug01a103g_LUT)/sizeof(NTCALUG01A103G
 
 /*================== Static Function Implementations ========================*/
 
+LUT_DEFINE_SEARCH_FLOAT(NTCALUG01A103G_Interpolate, NTCALUG01A103G_LUT_s, .resistance_Ohm, .temperature_C, LUT_CLAMP)
+
 /*================== Extern Function Implementations ========================*/
 
 extern float NTCALUG01A103G_GetTempFromLUT(uint16_t vadc_mV) {
@@ -271,25 +273,8 @@ extern float NTCALUG01A103G_GetTempFromLUT(uint16_t vadc_mV) {
                 (adcVoltage_V/(NTCALUG01A103G_RESISTOR_DIVIDER_SUPPLY_VOLTAGE_V - adcVoltage_V));
 #endif /* NTCALUG01A103G_POSITION_IN_RESISTOR_DIVIDER_IS_R1 */
 
-        /* Variables for interpolating LUT value */
-        uint16_t between_high = 0;
-        uint16_t between_low = 0;
-        for (uint16_t i = 1; i < sizeLUT; i++) {
-            if (resistance_Ohm < ntcalug01a103g_LUT[i].resistance_Ohm) {
-                between_low = i+1;
-                between_high = i;
-            }
-        }
-
-        /* Interpolate between LUT vales, but do not extrapolate LUT! */
-        if (!((between_high == 0 && between_low == 0) ||  /* measured resistance > maximum LUT resistance */
-                 (between_low > sizeLUT))) {              /* measured resistance < minimum LUT resistance */
-                     temperature = MATH_linearInterpolation(ntcalug01a103g_LUT[between_low].resistance_Ohm,
-                                       ntcalug01a103g_LUT[between_low].temperature_C,
-                                       ntcalug01a103g_LUT[between_high].resistance_Ohm,
-                                       ntcalug01a103g_LUT[between_high].temperature_C,
-                                       resistance_Ohm);
-        }
+        /* Interpolate between LUT values, the ADC voltage check above prevents extrapolation */
+        temperature = NTCALUG01A103G_Interpolate(ntcalug01a103g_LUT, sizeLUT, resistance_Ohm);
     }
 
     /* Return temperature based on measured NTC resistance */
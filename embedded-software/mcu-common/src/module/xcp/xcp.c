@@ -0,0 +1,933 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    xcp.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  XCP
+ *
+ * @brief   XCP on CAN slave: command processing and dynamic DAQ lists
+ *
+ * The commands are processed in the task of CANS_MainFunction(), the DAQ lists are sampled in
+ * the tasks of their event channels. The DAQ configuration is only changed while no DAQ list
+ * runs and no event channel samples, otherwise the master gets ERR_DAQ_ACTIVE or ERR_CMD_BUSY.
+ */
+
+/*================== Includes =============================================*/
+#include "xcp.h"
+
+#include "cansignal.h"
+#include "os.h"
+#include <string.h>
+
+/*================== Macros and Definitions ===============================*/
+
+#if XCP_MAX_ODTS > 0xFC
+#error "XCP_MAX_ODTS too large, the PIDs 0xFC - 0xFF are reserved for CTOs"
+#endif
+
+#if (XCP_MAX_FRAMES_PER_EVENT == 0) || (XCP_MAX_FRAMES_PER_EVENT > (CAN0_TRANSMIT_BUFFER_LENGTH / 4))
+#error "XCP_MAX_FRAMES_PER_EVENT out of range, the DAQ frames would fill the CAN0 transmit buffer"
+#endif
+
+/**
+ * maximum length of command, response and DAQ packets
+ */
+#define XCP_MAX_CTO                     8
+#define XCP_MAX_DTO                     8
+
+/**
+ * packet identifiers of responses
+ */
+#define XCP_PID_RES                     0xFF
+#define XCP_PID_ERR                     0xFE
+
+/**
+ * command codes
+ */
+#define XCP_CMD_CONNECT                 0xFF
+#define XCP_CMD_DISCONNECT              0xFE
+#define XCP_CMD_GET_STATUS              0xFD
+#define XCP_CMD_SYNCH                   0xFC
+#define XCP_CMD_GET_COMM_MODE_INFO      0xFB
+#define XCP_CMD_SET_MTA                 0xF6
+#define XCP_CMD_UPLOAD                  0xF5
+#define XCP_CMD_SHORT_UPLOAD            0xF4
+#define XCP_CMD_DOWNLOAD                0xF0
+#define XCP_CMD_SET_DAQ_PTR             0xE2
+#define XCP_CMD_WRITE_DAQ               0xE1
+#define XCP_CMD_SET_DAQ_LIST_MODE       0xE0
+#define XCP_CMD_START_STOP_DAQ_LIST     0xDE
+#define XCP_CMD_START_STOP_SYNCH        0xDD
+#define XCP_CMD_GET_DAQ_PROCESSOR_INFO  0xDA
+#define XCP_CMD_GET_DAQ_RESOLUTION_INFO 0xD9
+#define XCP_CMD_GET_DAQ_EVENT_INFO      0xD7
+#define XCP_CMD_FREE_DAQ                0xD6
+#define XCP_CMD_ALLOC_DAQ               0xD5
+#define XCP_CMD_ALLOC_ODT               0xD4
+#define XCP_CMD_ALLOC_ODT_ENTRY         0xD3
+
+/**
+ * error codes, XCP_NO_ERROR is only used internally
+ */
+#define XCP_NO_ERROR                    0xFF
+#define XCP_ERR_CMD_SYNCH               0x00
+#define XCP_ERR_CMD_BUSY                0x10
+#define XCP_ERR_DAQ_ACTIVE              0x11
+#define XCP_ERR_CMD_UNKNOWN             0x20
+#define XCP_ERR_CMD_SYNTAX              0x21
+#define XCP_ERR_OUT_OF_RANGE            0x22
+#define XCP_ERR_ACCESS_DENIED           0x24
+#define XCP_ERR_MODE_NOT_VALID          0x27
+#define XCP_ERR_SEQUENCE                0x29
+#define XCP_ERR_DAQ_CONFIG              0x2A
+#define XCP_ERR_MEMORY_OVERFLOW         0x30
+#define XCP_ERR_RES_TEMP_NOT_ACCESS     0x33
+
+/**
+ * CONNECT: resources CAL/PAG (if XCP_CALIBRATION_ENABLE) and DAQ, Intel byte order, byte granularity,
+ * GET_COMM_MODE_INFO available
+ */
+#if XCP_CALIBRATION_ENABLE == TRUE
+#define XCP_RESOURCE                    0x05
+#else
+#define XCP_RESOURCE                    0x04
+#endif
+#define XCP_COMM_MODE_BASIC             0x80
+
+/**
+ * GET_STATUS: session status bit of running DAQ lists
+ */
+#define XCP_SESSION_DAQ_RUNNING         0x40
+
+/**
+ * GET_DAQ_PROCESSOR_INFO: dynamic DAQ configuration, prescaler supported
+ */
+#define XCP_DAQ_PROPERTIES              0x03
+
+/**
+ * GET_DAQ_EVENT_INFO: event channel for DAQ, cycle time unit 1 ms
+ */
+#define XCP_EVENT_PROPERTY_DAQ          0x04
+#define XCP_EVENT_TIME_UNIT_1MS         0x06
+
+/**
+ * states of the allocation of the dynamic DAQ lists, the allocation commands have to be sent in this order
+ */
+typedef enum {
+    XCP_ALLOC_FREE          = 0,    /*!< after FREE_DAQ */
+    XCP_ALLOC_DAQ           = 1,    /*!< after ALLOC_DAQ */
+    XCP_ALLOC_ODT           = 2,    /*!< after ALLOC_ODT */
+    XCP_ALLOC_ODT_ENTRY     = 3,    /*!< after ALLOC_ODT_ENTRY */
+} XCP_ALLOC_STATE_e;
+
+/**
+ * sampled variable
+ */
+typedef struct {
+    const uint8_t *address;     /*!< address of the variable, checked against xcp_readAreas[] */
+    uint8_t size;               /*!< size of the variable in bytes, 0 if not written */
+} XCP_ODT_ENTRY_s;
+
+/**
+ * object descriptor table, sent as one CAN frame
+ */
+typedef struct {
+    uint16_t firstEntry;        /*!< index of the first entry in xcp_odtEntries[] */
+    uint16_t nrOfEntries;       /*!< number of entries */
+} XCP_ODT_s;
+
+/**
+ * DAQ list
+ */
+typedef struct {
+    uint16_t firstOdt;                  /*!< index of the first ODT in xcp_odts[], equals its PID */
+    uint16_t nrOfOdts;                  /*!< number of ODTs */
+    XCP_EVENT_CHANNEL_e eventChannel;   /*!< event channel sampling the list */
+    uint8_t prescaler;                  /*!< the list is sampled every prescaler events */
+    uint8_t prescalerCounter;           /*!< events since the last sample */
+    uint8_t selected;                   /*!< TRUE if selected for START_STOP_SYNCH */
+    volatile uint8_t running;           /*!< TRUE if sampled */
+} XCP_DAQ_LIST_s;
+
+/**
+ * state of the XCP slave
+ */
+typedef struct {
+    uint8_t connected;                          /*!< TRUE after CONNECT */
+    uint32_t mta;                               /*!< memory transfer address of UPLOAD and DOWNLOAD */
+    XCP_ALLOC_STATE_e allocState;               /*!< allocation state of the dynamic DAQ lists */
+    uint16_t nrOfDaqLists;                      /*!< allocated DAQ lists */
+    uint16_t nrOfOdts;                          /*!< allocated ODTs */
+    uint16_t nrOfOdtEntries;                    /*!< allocated ODT entries */
+    uint16_t daqPtr;                            /*!< ODT entry written by the next WRITE_DAQ */
+    uint16_t daqPtrEnd;                         /*!< first ODT entry after the ODT of daqPtr */
+    volatile uint8_t daqRunning;                /*!< TRUE if at least one DAQ list runs */
+    volatile uint8_t eventBusy[XCP_EVENT_MAX];  /*!< TRUE while the event channel samples */
+} XCP_STATE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+static XCP_STATE_s xcp_state = {
+        .connected = FALSE,
+        .allocState = XCP_ALLOC_FREE,
+        .daqRunning = FALSE,
+};
+
+static XCP_DAQ_LIST_s xcp_daqLists[XCP_MAX_DAQ_LISTS];
+static XCP_ODT_s xcp_odts[XCP_MAX_ODTS];
+static XCP_ODT_ENTRY_s xcp_odtEntries[XCP_MAX_ODT_ENTRIES];
+
+/*================== Function Prototypes ==================================*/
+
+static uint8_t XCP_ProcessCommand(const uint8_t *data, uint8_t dlc, uint8_t *response, uint8_t *length);
+static uint8_t XCP_ProcessDaqCommand(const uint8_t *data, uint8_t dlc, uint8_t *response, uint8_t *length);
+static uint8_t XCP_AllocateDaq(const uint8_t *data, uint8_t dlc);
+static uint8_t XCP_StartStopDaqList(const uint8_t *data, uint8_t dlc, uint8_t *response, uint8_t *length);
+static uint8_t XCP_StartStopSynch(const uint8_t *data, uint8_t dlc);
+static uint8_t XCP_Upload(uint32_t address, uint8_t size, uint8_t *response, uint8_t *length);
+#if XCP_CALIBRATION_ENABLE == TRUE
+static uint8_t XCP_Download(const uint8_t *data, uint8_t size);
+#endif
+static uint8_t XCP_IsInArea(uint32_t address, uint32_t size, const XCP_MEMORY_AREA_s *areas, uint8_t nrOfAreas);
+static uint8_t XCP_IsDaqListValid(uint16_t daqList);
+static uint8_t XCP_IsEventLoadValid(uint16_t daqList, uint8_t withSelected);
+static uint8_t XCP_CheckDaqChange(void);
+static void XCP_StopAllDaqLists(void);
+static void XCP_UpdateDaqRunning(void);
+static void XCP_SendDaqList(const XCP_DAQ_LIST_s *daqList);
+static uint16_t XCP_GetUint16(const uint8_t *data);
+static uint32_t XCP_GetUint32(const uint8_t *data);
+
+/*================== Function Implementations =============================*/
+
+/*================== Public functions =====================================*/
+void XCP_ReceiveFrame(const uint8_t *data, uint8_t dlc) {
+    uint8_t response[XCP_MAX_CTO] = {XCP_PID_RES};
+    uint8_t length = 1;
+    uint8_t errorCode = XCP_NO_ERROR;
+
+    /* until CONNECT, all commands are ignored */
+    if ((dlc > 0) && ((xcp_state.connected == TRUE) || (data[0] == XCP_CMD_CONNECT))) {
+        errorCode = XCP_ProcessCommand(data, dlc, response, &length);
+        if (errorCode != XCP_NO_ERROR) {
+            response[0] = XCP_PID_ERR;
+            response[1] = errorCode;
+            length = 2;
+        }
+        (void)CANS_AddMessage(CAN_NODE0, CAN_ID_XCP_RESPONSE, &response[0], length, 0);
+    }
+}
+
+
+void XCP_Event(XCP_EVENT_CHANNEL_e channel) {
+    /* the only check on the hot path while no DAQ list runs */
+    if ((xcp_state.daqRunning == TRUE) && (channel < XCP_EVENT_MAX)) {
+        xcp_state.eventBusy[channel] = TRUE;
+        for (uint8_t i = 0; i < XCP_MAX_DAQ_LISTS; i++) {
+            if ((xcp_daqLists[i].running == TRUE) && (xcp_daqLists[i].eventChannel == channel)) {
+                xcp_daqLists[i].prescalerCounter++;
+                if (xcp_daqLists[i].prescalerCounter >= xcp_daqLists[i].prescaler) {
+                    xcp_daqLists[i].prescalerCounter = 0;
+                    XCP_SendDaqList(&xcp_daqLists[i]);
+                }
+            }
+        }
+        xcp_state.eventBusy[channel] = FALSE;
+    }
+}
+
+
+/*================== Static functions =====================================*/
+/**
+ * @brief   processes the standard and memory access commands
+ *
+ * @param   data        command packet
+ * @param   dlc         length of data in bytes
+ * @param   response    positive response packet, response[0] is XCP_PID_RES
+ * @param   length      length of the positive response in bytes
+ *
+ * @return  XCP_NO_ERROR, or the error code for the negative response
+ */
+static uint8_t XCP_ProcessCommand(const uint8_t *data, uint8_t dlc, uint8_t *response, uint8_t *length) {
+    uint8_t errorCode = XCP_NO_ERROR;
+
+    switch (data[0]) {
+        case XCP_CMD_CONNECT:
+            xcp_state.connected = TRUE;
+            response[1] = XCP_RESOURCE;
+            response[2] = XCP_COMM_MODE_BASIC;
+            response[3] = XCP_MAX_CTO;
+            response[4] = XCP_MAX_DTO;
+            response[5] = 0;
+            response[6] = 0x01;     /* protocol layer version */
+            response[7] = 0x01;     /* transport layer version */
+            *length = 8;
+            break;
+
+        case XCP_CMD_DISCONNECT:
+            XCP_StopAllDaqLists();
+            xcp_state.connected = FALSE;
+            break;
+
+        case XCP_CMD_GET_STATUS:
+            response[1] = (xcp_state.daqRunning == TRUE) ? XCP_SESSION_DAQ_RUNNING : 0;
+            response[2] = 0;        /* no resource protected */
+            response[3] = 0;
+            response[4] = 0;        /* session configuration ID */
+            response[5] = 0;
+            *length = 6;
+            break;
+
+        case XCP_CMD_SYNCH:
+            errorCode = XCP_ERR_CMD_SYNCH;
+            break;
+
+        case XCP_CMD_GET_COMM_MODE_INFO:
+            response[1] = 0;
+            response[2] = 0;        /* no master block mode, no interleaved mode */
+            response[3] = 0;
+            response[4] = 0;        /* MAX_BS */
+            response[5] = 0;        /* MIN_ST */
+            response[6] = 0;        /* QUEUE_SIZE */
+            response[7] = 0x10;     /* driver version 1.0 */
+            *length = 8;
+            break;
+
+        case XCP_CMD_SET_MTA:
+            if (dlc < 8) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else if (data[3] != 0) {
+                errorCode = XCP_ERR_OUT_OF_RANGE;
+            } else {
+                xcp_state.mta = XCP_GetUint32(&data[4]);
+            }
+            break;
+
+        case XCP_CMD_UPLOAD:
+            if (dlc < 2) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else {
+                errorCode = XCP_Upload(xcp_state.mta, data[1], response, length);
+                if (errorCode == XCP_NO_ERROR) {
+                    xcp_state.mta += data[1];
+                }
+            }
+            break;
+
+        case XCP_CMD_SHORT_UPLOAD:
+            if (dlc < 8) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else if (data[3] != 0) {
+                errorCode = XCP_ERR_OUT_OF_RANGE;
+            } else {
+                errorCode = XCP_Upload(XCP_GetUint32(&data[4]), data[1], response, length);
+            }
+            break;
+
+#if XCP_CALIBRATION_ENABLE == TRUE
+        case XCP_CMD_DOWNLOAD:
+            if ((dlc < 2) || (data[1] > (XCP_MAX_CTO - 2)) || (dlc < (data[1] + 2))) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else {
+                errorCode = XCP_Download(&data[2], data[1]);
+            }
+            break;
+#endif
+
+        default:
+            errorCode = XCP_ProcessDaqCommand(data, dlc, response, length);
+            break;
+    }
+    return errorCode;
+}
+
+
+/**
+ * @brief   processes the DAQ commands
+ *
+ * See XCP_ProcessCommand() for the parameters and the return value.
+ */
+static uint8_t XCP_ProcessDaqCommand(const uint8_t *data, uint8_t dlc, uint8_t *response, uint8_t *length) {
+    uint8_t errorCode = XCP_NO_ERROR;
+    uint16_t daqList = 0;
+    uint16_t odt = 0;
+
+    switch (data[0]) {
+        case XCP_CMD_GET_DAQ_PROCESSOR_INFO:
+            response[1] = XCP_DAQ_PROPERTIES;
+            response[2] = XCP_MAX_DAQ_LISTS & 0xFF;
+            response[3] = XCP_MAX_DAQ_LISTS >> 8;
+            response[4] = XCP_EVENT_MAX & 0xFF;
+            response[5] = XCP_EVENT_MAX >> 8;
+            response[6] = 0;        /* no predefined DAQ lists */
+            response[7] = 0;        /* absolute ODT number as identification field */
+            *length = 8;
+            break;
+
+        case XCP_CMD_GET_DAQ_RESOLUTION_INFO:
+            response[1] = 1;                /* granularity of ODT entries */
+            response[2] = XCP_MAX_DTO - 1;  /* maximum size of an ODT entry */
+            response[3] = 1;
+            response[4] = 0;                /* no STIM */
+            response[5] = 0;                /* no timestamp */
+            response[6] = 0;
+            response[7] = 0;
+            *length = 8;
+            break;
+
+        case XCP_CMD_GET_DAQ_EVENT_INFO:
+            if (dlc < 4) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else if (XCP_GetUint16(&data[2]) >= XCP_EVENT_MAX) {
+                errorCode = XCP_ERR_OUT_OF_RANGE;
+            } else {
+                /* the master reads the name with UPLOAD */
+                xcp_state.mta = (uint32_t)(uintptr_t)xcp_eventChannels[XCP_GetUint16(&data[2])].name;
+                response[1] = XCP_EVENT_PROPERTY_DAQ;
+                response[2] = 0xFF;         /* no limit of DAQ lists */
+                response[3] = (uint8_t)strlen(xcp_eventChannels[XCP_GetUint16(&data[2])].name);
+                response[4] = xcp_eventChannels[XCP_GetUint16(&data[2])].cycleTime_ms;
+                response[5] = XCP_EVENT_TIME_UNIT_1MS;
+                response[6] = 0;            /* priority */
+                *length = 7;
+            }
+            break;
+
+        case XCP_CMD_FREE_DAQ:
+            XCP_StopAllDaqLists();
+            errorCode = XCP_CheckDaqChange();
+            if (errorCode == XCP_NO_ERROR) {
+                xcp_state.nrOfDaqLists = 0;
+                xcp_state.nrOfOdts = 0;
+                xcp_state.nrOfOdtEntries = 0;
+                xcp_state.daqPtr = 0;
+                xcp_state.daqPtrEnd = 0;
+                xcp_state.allocState = XCP_ALLOC_FREE;
+            }
+            break;
+
+        case XCP_CMD_ALLOC_DAQ:
+        case XCP_CMD_ALLOC_ODT:
+        case XCP_CMD_ALLOC_ODT_ENTRY:
+            errorCode = XCP_CheckDaqChange();
+            if (errorCode == XCP_NO_ERROR) {
+                errorCode = XCP_AllocateDaq(data, dlc);
+            }
+            break;
+
+        case XCP_CMD_SET_DAQ_PTR:
+            if (dlc < 6) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else {
+                daqList = XCP_GetUint16(&data[2]);
+                errorCode = XCP_ERR_OUT_OF_RANGE;
+                if ((daqList < xcp_state.nrOfDaqLists) && (data[4] < xcp_daqLists[daqList].nrOfOdts)) {
+                    odt = xcp_daqLists[daqList].firstOdt + data[4];
+                    if (data[5] < xcp_odts[odt].nrOfEntries) {
+                        xcp_state.daqPtr = xcp_odts[odt].firstEntry + data[5];
+                        xcp_state.daqPtrEnd = xcp_odts[odt].firstEntry + xcp_odts[odt].nrOfEntries;
+                        errorCode = XCP_NO_ERROR;
+                    }
+                }
+            }
+            break;
+
+        case XCP_CMD_WRITE_DAQ:
+            errorCode = XCP_CheckDaqChange();
+            if (errorCode != XCP_NO_ERROR) {
+                /* configuration locked */
+            } else if (dlc < 8) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else if (xcp_state.daqPtr >= xcp_state.daqPtrEnd) {
+                errorCode = XCP_ERR_SEQUENCE;
+            } else if ((data[1] != 0xFF) || (data[2] == 0) || (data[2] > (XCP_MAX_DTO - 1)) || (data[3] != 0)) {
+                errorCode = XCP_ERR_OUT_OF_RANGE;
+            } else if (XCP_IsInArea(XCP_GetUint32(&data[4]), data[2], xcp_readAreas, xcp_nr_of_readAreas) == FALSE) {
+                errorCode = XCP_ERR_ACCESS_DENIED;
+            } else {
+                xcp_odtEntries[xcp_state.daqPtr].address = (const uint8_t *)(uintptr_t)XCP_GetUint32(&data[4]);
+                xcp_odtEntries[xcp_state.daqPtr].size = data[2];
+                xcp_state.daqPtr++;
+            }
+            break;
+
+        case XCP_CMD_SET_DAQ_LIST_MODE:
+            errorCode = XCP_CheckDaqChange();
+            if (errorCode != XCP_NO_ERROR) {
+                /* configuration locked */
+            } else if (dlc < 8) {
+                errorCode = XCP_ERR_CMD_SYNTAX;
+            } else if ((XCP_GetUint16(&data[2]) >= xcp_state.nrOfDaqLists) ||
+                    (XCP_GetUint16(&data[4]) >= XCP_EVENT_MAX) || (data[6] == 0)) {
+                errorCode = XCP_ERR_OUT_OF_RANGE;
+            } else if (data[1] != 0) {
+                /* no alternating display, STIM, timestamp or PID_OFF */
+                errorCode = XCP_ERR_MODE_NOT_VALID;
+            } else {
+                daqList = XCP_GetUint16(&data[2]);
+                xcp_daqLists[daqList].eventChannel = (XCP_EVENT_CHANNEL_e)XCP_GetUint16(&data[4]);
+                xcp_daqLists[daqList].prescaler = data[6];
+            }
+            break;
+
+        case XCP_CMD_START_STOP_DAQ_LIST:
+            errorCode = XCP_StartStopDaqList(data, dlc, response, length);
+            break;
+
+        case XCP_CMD_START_STOP_SYNCH:
+            errorCode = XCP_StartStopSynch(data, dlc);
+            break;
+
+        default:
+            errorCode = XCP_ERR_CMD_UNKNOWN;
+            break;
+    }
+    return errorCode;
+}
+
+
+/**
+ * @brief   processes ALLOC_DAQ, ALLOC_ODT and ALLOC_ODT_ENTRY
+ *
+ * The ODTs and ODT entries are taken from the pools in allocation order, so the ODTs of a DAQ
+ * list and the entries of an ODT are consecutive.
+ *
+ * @param   data    command packet
+ * @param   dlc     length of data in bytes
+ *
+ * @return  XCP_NO_ERROR, or the error code for the negative response
+ */
+static uint8_t XCP_AllocateDaq(const uint8_t *data, uint8_t dlc) {
+    uint8_t errorCode = XCP_NO_ERROR;
+    uint16_t daqList = 0;
+    uint16_t odt = 0;
+
+    if (data[0] == XCP_CMD_ALLOC_DAQ) {
+        if (dlc < 4) {
+            errorCode = XCP_ERR_CMD_SYNTAX;
+        } else if (xcp_state.allocState != XCP_ALLOC_FREE) {
+            errorCode = XCP_ERR_SEQUENCE;
+        } else if (XCP_GetUint16(&data[2]) > XCP_MAX_DAQ_LISTS) {
+            errorCode = XCP_ERR_MEMORY_OVERFLOW;
+        } else {
+            xcp_state.nrOfDaqLists = XCP_GetUint16(&data[2]);
+            for (uint16_t i = 0; i < xcp_state.nrOfDaqLists; i++) {
+                xcp_daqLists[i].firstOdt = 0;
+                xcp_daqLists[i].nrOfOdts = 0;
+                xcp_daqLists[i].eventChannel = XCP_EVENT_10MS;
+                xcp_daqLists[i].prescaler = 1;
+                xcp_daqLists[i].prescalerCounter = 0;
+                xcp_daqLists[i].selected = FALSE;
+            }
+            xcp_state.allocState = XCP_ALLOC_DAQ;
+        }
+    } else if (data[0] == XCP_CMD_ALLOC_ODT) {
+        if (dlc < 5) {
+            errorCode = XCP_ERR_CMD_SYNTAX;
+        } else if ((xcp_state.allocState != XCP_ALLOC_DAQ) && (xcp_state.allocState != XCP_ALLOC_ODT)) {
+            errorCode = XCP_ERR_SEQUENCE;
+        } else if (XCP_GetUint16(&data[2]) >= xcp_state.nrOfDaqLists) {
+            errorCode = XCP_ERR_OUT_OF_RANGE;
+        } else if (xcp_daqLists[XCP_GetUint16(&data[2])].nrOfOdts != 0) {
+            errorCode = XCP_ERR_SEQUENCE;
+        } else if ((xcp_state.nrOfOdts + data[4]) > XCP_MAX_ODTS) {
+            errorCode = XCP_ERR_MEMORY_OVERFLOW;
+        } else {
+            daqList = XCP_GetUint16(&data[2]);
+            xcp_daqLists[daqList].firstOdt = xcp_state.nrOfOdts;
+            xcp_daqLists[daqList].nrOfOdts = data[4];
+            for (uint16_t i = xcp_state.nrOfOdts; i < (xcp_state.nrOfOdts + data[4]); i++) {
+                xcp_odts[i].firstEntry = 0;
+                xcp_odts[i].nrOfEntries = 0;
+            }
+            xcp_state.nrOfOdts += data[4];
+            xcp_state.allocState = XCP_ALLOC_ODT;
+        }
+    } else {
+        if (dlc < 6) {
+            errorCode = XCP_ERR_CMD_SYNTAX;
+        } else if ((xcp_state.allocState != XCP_ALLOC_ODT) && (xcp_state.allocState != XCP_ALLOC_ODT_ENTRY)) {
+            errorCode = XCP_ERR_SEQUENCE;
+        } else if ((XCP_GetUint16(&data[2]) >= xcp_state.nrOfDaqLists) ||
+                (data[4] >= xcp_daqLists[XCP_GetUint16(&data[2])].nrOfOdts)) {
+            errorCode = XCP_ERR_OUT_OF_RANGE;
+        } else if (xcp_odts[xcp_daqLists[XCP_GetUint16(&data[2])].firstOdt + data[4]].nrOfEntries != 0) {
+            errorCode = XCP_ERR_SEQUENCE;
+        } else if ((xcp_state.nrOfOdtEntries + data[5]) > XCP_MAX_ODT_ENTRIES) {
+            errorCode = XCP_ERR_MEMORY_OVERFLOW;
+        } else {
+            odt = xcp_daqLists[XCP_GetUint16(&data[2])].firstOdt + data[4];
+            xcp_odts[odt].firstEntry = xcp_state.nrOfOdtEntries;
+            xcp_odts[odt].nrOfEntries = data[5];
+            for (uint16_t i = xcp_state.nrOfOdtEntries; i < (xcp_state.nrOfOdtEntries + data[5]); i++) {
+                xcp_odtEntries[i].address = NULL_PTR;
+                xcp_odtEntries[i].size = 0;
+            }
+            xcp_state.nrOfOdtEntries += data[5];
+            xcp_state.allocState = XCP_ALLOC_ODT_ENTRY;
+        }
+    }
+    return errorCode;
+}
+
+
+/**
+ * @brief   processes START_STOP_DAQ_LIST
+ *
+ * See XCP_ProcessCommand() for the parameters and the return value.
+ */
+static uint8_t XCP_StartStopDaqList(const uint8_t *data, uint8_t dlc, uint8_t *response, uint8_t *length) {
+    uint8_t errorCode = XCP_NO_ERROR;
+    uint16_t daqList = 0;
+
+    if (dlc < 4) {
+        errorCode = XCP_ERR_CMD_SYNTAX;
+    } else if ((XCP_GetUint16(&data[2]) >= xcp_state.nrOfDaqLists) || (data[1] > 2)) {
+        errorCode = XCP_ERR_OUT_OF_RANGE;
+    } else {
+        daqList = XCP_GetUint16(&data[2]);
+        if (data[1] == 0) {
+            xcp_daqLists[daqList].running = FALSE;
+        } else if (XCP_IsDaqListValid(daqList) == FALSE) {
+            errorCode = XCP_ERR_DAQ_CONFIG;
+        } else if ((data[1] == 1) && (XCP_IsEventLoadValid(daqList, FALSE) == FALSE)) {
+            errorCode = XCP_ERR_DAQ_CONFIG;
+        } else if (data[1] == 1) {
+            xcp_daqLists[daqList].prescalerCounter = 0;
+            /* the list is completely configured before it is published to the event channel */
+            xcp_daqLists[daqList].running = TRUE;
+        } else {
+            xcp_daqLists[daqList].selected = TRUE;
+        }
+        XCP_UpdateDaqRunning();
+        if (errorCode == XCP_NO_ERROR) {
+            response[1] = (uint8_t)xcp_daqLists[daqList].firstOdt;     /* first PID */
+            *length = 2;
+        }
+    }
+    return errorCode;
+}
+
+
+/**
+ * @brief   processes START_STOP_SYNCH
+ *
+ * @param   data    command packet
+ * @param   dlc     length of data in bytes
+ *
+ * @return  XCP_NO_ERROR, or the error code for the negative response
+ */
+static uint8_t XCP_StartStopSynch(const uint8_t *data, uint8_t dlc) {
+    uint8_t errorCode = XCP_NO_ERROR;
+
+    if (dlc < 2) {
+        errorCode = XCP_ERR_CMD_SYNTAX;
+    } else if (data[1] == 0) {
+        XCP_StopAllDaqLists();
+    } else if (data[1] > 2) {
+        errorCode = XCP_ERR_OUT_OF_RANGE;
+    } else {
+        for (uint16_t i = 0; i < xcp_state.nrOfDaqLists; i++) {
+            if ((data[1] == 1) && (xcp_daqLists[i].selected == TRUE) && (XCP_IsDaqListValid(i) == FALSE)) {
+                errorCode = XCP_ERR_DAQ_CONFIG;
+            }
+        }
+        if ((data[1] == 1) && (XCP_IsEventLoadValid(XCP_MAX_DAQ_LISTS, TRUE) == FALSE)) {
+            errorCode = XCP_ERR_DAQ_CONFIG;
+        }
+        for (uint16_t i = 0; (i < xcp_state.nrOfDaqLists) && (errorCode == XCP_NO_ERROR); i++) {
+            if (xcp_daqLists[i].selected == TRUE) {
+                xcp_daqLists[i].prescalerCounter = 0;
+                xcp_daqLists[i].running = (data[1] == 1) ? TRUE : FALSE;
+                xcp_daqLists[i].selected = FALSE;
+            }
+        }
+        XCP_UpdateDaqRunning();
+    }
+    return errorCode;
+}
+
+
+/**
+ * @brief   copies memory into a positive response
+ *
+ * @param   address     first address to read
+ * @param   size        number of bytes, 1 to XCP_MAX_CTO - 1
+ * @param   response    positive response packet
+ * @param   length      length of the positive response in bytes
+ *
+ * @return  XCP_NO_ERROR, or the error code for the negative response
+ */
+static uint8_t XCP_Upload(uint32_t address, uint8_t size, uint8_t *response, uint8_t *length) {
+    uint8_t errorCode = XCP_NO_ERROR;
+
+    if ((size == 0) || (size > (XCP_MAX_CTO - 1))) {
+        errorCode = XCP_ERR_OUT_OF_RANGE;
+    } else if (XCP_IsInArea(address, size, xcp_readAreas, xcp_nr_of_readAreas) == FALSE) {
+        errorCode = XCP_ERR_ACCESS_DENIED;
+    } else {
+        OS_TaskEnter_Critical();
+        memcpy(&response[1], (const uint8_t *)(uintptr_t)address, size);
+        OS_TaskExit_Critical();
+        *length = size + 1;
+    }
+    return errorCode;
+}
+
+
+#if XCP_CALIBRATION_ENABLE == TRUE
+/**
+ * @brief   writes data to the memory transfer address, which is incremented
+ *
+ * Only the variables defined with MEM_XCP_CAL can be written, and only while
+ * XCP_IsCalibrationAllowed(). The bytes are written at once for the other tasks, so calibration
+ * values are consistent.
+ *
+ * @param   data    data to write
+ * @param   size    number of bytes
+ *
+ * @return  XCP_NO_ERROR, or the error code for the negative response
+ */
+static uint8_t XCP_Download(const uint8_t *data, uint8_t size) {
+    uint8_t errorCode = XCP_NO_ERROR;
+    /* the bounds of the section are only known at link time */
+    XCP_MEMORY_AREA_s calibrationArea = {
+            (uint32_t)(uintptr_t)&_s_xcp_cal[0],
+            (uint32_t)(&_e_xcp_cal[0] - &_s_xcp_cal[0]),
+    };
+
+    if (size == 0) {
+        errorCode = XCP_ERR_OUT_OF_RANGE;
+    } else if (XCP_IsInArea(xcp_state.mta, size, &calibrationArea, 1) == FALSE) {
+        errorCode = XCP_ERR_ACCESS_DENIED;
+    } else if (XCP_IsCalibrationAllowed() == FALSE) {
+        errorCode = XCP_ERR_RES_TEMP_NOT_ACCESS;
+    } else {
+        OS_TaskEnter_Critical();
+        memcpy((uint8_t *)(uintptr_t)xcp_state.mta, data, size);
+        OS_TaskExit_Critical();
+        xcp_state.mta += size;
+    }
+    return errorCode;
+}
+#endif
+
+
+/**
+ * @brief   checks if a block of memory lies completely inside one of the areas
+ *
+ * @param   address     first address of the block
+ * @param   size        size of the block in bytes
+ * @param   areas       memory areas
+ * @param   nrOfAreas   number of areas
+ *
+ * @return  TRUE if the block is inside an area, FALSE otherwise
+ */
+static uint8_t XCP_IsInArea(uint32_t address, uint32_t size, const XCP_MEMORY_AREA_s *areas, uint8_t nrOfAreas) {
+    uint8_t retVal = FALSE;
+
+    for (uint8_t i = 0; i < nrOfAreas; i++) {
+        /* written without overflow for blocks at the end of the address space */
+        if ((address >= areas[i].start) && (size <= areas[i].length) &&
+                ((address - areas[i].start) <= (areas[i].length - size))) {
+            retVal = TRUE;
+        }
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   checks if the ODTs of a DAQ list are allocated and fit in a CAN frame
+ *
+ * @param   daqList     index of the DAQ list
+ *
+ * @return  TRUE if the DAQ list can be started, FALSE otherwise
+ */
+static uint8_t XCP_IsDaqListValid(uint16_t daqList) {
+    uint8_t retVal = TRUE;
+    uint16_t odtSize = 0;
+
+    if (xcp_daqLists[daqList].nrOfOdts == 0) {
+        retVal = FALSE;
+    }
+    for (uint16_t odt = xcp_daqLists[daqList].firstOdt;
+            odt < (xcp_daqLists[daqList].firstOdt + xcp_daqLists[daqList].nrOfOdts); odt++) {
+        odtSize = 0;
+        for (uint16_t entry = xcp_odts[odt].firstEntry;
+                entry < (xcp_odts[odt].firstEntry + xcp_odts[odt].nrOfEntries); entry++) {
+            odtSize += xcp_odtEntries[entry].size;
+        }
+        if (odtSize > (XCP_MAX_DTO - 1)) {
+            retVal = FALSE;
+        }
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   checks if every event channel sends at most XCP_MAX_FRAMES_PER_EVENT frames
+ *
+ * Counts the ODTs of the running DAQ lists, of daqList and, if withSelected is TRUE, of the
+ * lists selected for START_STOP_SYNCH. Lists with a prescaler are counted as if they were sent
+ * at every event, as they can coincide with the other lists of the channel.
+ *
+ * @param   daqList         index of the DAQ list to start, XCP_MAX_DAQ_LISTS for none
+ * @param   withSelected    TRUE to count the selected DAQ lists
+ *
+ * @return  TRUE if the DAQ lists can run, FALSE otherwise
+ */
+static uint8_t XCP_IsEventLoadValid(uint16_t daqList, uint8_t withSelected) {
+    uint8_t retVal = TRUE;
+    uint16_t nrOfFrames[XCP_EVENT_MAX] = {0};
+
+    for (uint16_t i = 0; i < xcp_state.nrOfDaqLists; i++) {
+        if ((xcp_daqLists[i].running == TRUE) || (i == daqList) ||
+                ((withSelected == TRUE) && (xcp_daqLists[i].selected == TRUE))) {
+            nrOfFrames[xcp_daqLists[i].eventChannel] += xcp_daqLists[i].nrOfOdts;
+        }
+    }
+    for (uint8_t i = 0; i < XCP_EVENT_MAX; i++) {
+        if (nrOfFrames[i] > XCP_MAX_FRAMES_PER_EVENT) {
+            retVal = FALSE;
+        }
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   checks if the DAQ configuration may be changed
+ *
+ * This is the case if all DAQ lists are stopped and no event channel samples. As an event
+ * channel checks the running flags of the lists after setting its busy flag, it does not sample
+ * any list after this check.
+ *
+ * @return  XCP_NO_ERROR, or the error code for the negative response
+ */
+static uint8_t XCP_CheckDaqChange(void) {
+    uint8_t errorCode = XCP_NO_ERROR;
+
+    if (xcp_state.daqRunning == TRUE) {
+        errorCode = XCP_ERR_DAQ_ACTIVE;
+    }
+    for (uint8_t i = 0; i < XCP_EVENT_MAX; i++) {
+        if ((errorCode == XCP_NO_ERROR) && (xcp_state.eventBusy[i] == TRUE)) {
+            errorCode = XCP_ERR_CMD_BUSY;
+        }
+    }
+    return errorCode;
+}
+
+
+/**
+ * @brief   stops all DAQ lists
+ */
+static void XCP_StopAllDaqLists(void) {
+    for (uint8_t i = 0; i < XCP_MAX_DAQ_LISTS; i++) {
+        xcp_daqLists[i].running = FALSE;
+        xcp_daqLists[i].selected = FALSE;
+    }
+    xcp_state.daqRunning = FALSE;
+}
+
+
+/**
+ * @brief   sets xcp_state.daqRunning if at least one DAQ list runs
+ */
+static void XCP_UpdateDaqRunning(void) {
+    uint8_t daqRunning = FALSE;
+
+    for (uint8_t i = 0; i < XCP_MAX_DAQ_LISTS; i++) {
+        if (xcp_daqLists[i].running == TRUE) {
+            daqRunning = TRUE;
+        }
+    }
+    xcp_state.daqRunning = daqRunning;
+}
+
+
+/**
+ * @brief   samples the ODTs of a DAQ list and sends them, one CAN frame per ODT
+ *
+ * @param   daqList     DAQ list to send
+ */
+static void XCP_SendDaqList(const XCP_DAQ_LIST_s *daqList) {
+    uint8_t data[XCP_MAX_DTO] = {0};
+    uint8_t length = 0;
+    const XCP_ODT_ENTRY_s *entry = NULL_PTR;
+
+    for (uint16_t odt = daqList->firstOdt; (odt < (daqList->firstOdt + daqList->nrOfOdts)) && (odt < XCP_MAX_ODTS);
+            odt++) {
+        data[0] = (uint8_t)odt;     /* absolute ODT number */
+        length = 1;
+        for (uint16_t i = 0; (i < xcp_odts[odt].nrOfEntries) && ((xcp_odts[odt].firstEntry + i) < XCP_MAX_ODT_ENTRIES);
+                i++) {
+            entry = &xcp_odtEntries[xcp_odts[odt].firstEntry + i];
+            if ((entry->size > 0) && (entry->size <= (XCP_MAX_DTO - length))) {
+                memcpy(&data[length], entry->address, entry->size);
+                length += entry->size;
+            }
+        }
+        /* a full transmit buffer loses the frame, the master notices the missing ODT */
+        (void)CANS_AddMessage(CAN_NODE0, CAN_ID_XCP_RESPONSE, &data[0], length, 0);
+    }
+}
+
+
+/**
+ * @brief   reads a little endian 16 bit value of a command
+ */
+static uint16_t XCP_GetUint16(const uint8_t *data) {
+    return (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+}
+
+
+/**
+ * @brief   reads a little endian 32 bit value of a command
+ */
+static uint32_t XCP_GetUint32(const uint8_t *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
@@ -0,0 +1,92 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    xcp.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  XCP
+ *
+ * @brief   Header for the XCP on CAN slave for measurement and calibration
+ *
+ * Commands are received on CAN_ID_XCP_REQUEST, responses and DAQ data are sent on
+ * CAN_ID_XCP_RESPONSE (CAN0). Supported are the standard commands, SHORT_UPLOAD and UPLOAD in
+ * the areas of xcp_readAreas[], DOWNLOAD of the variables defined with MEM_XCP_CAL if
+ * XCP_CALIBRATION_ENABLE, and dynamic DAQ lists with prescaler, absolute ODT numbers as
+ * identification field and no timestamp. Multi-byte values are little endian, the address
+ * granularity is one byte.
+ */
+
+#ifndef XCP_H_
+#define XCP_H_
+
+/*================== Includes =============================================*/
+#include "xcp_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+/**
+ * @brief   processes a command received on CAN_ID_XCP_REQUEST and sends the response
+ *
+ * Called by CANS_PeriodicReceive().
+ *
+ * @param   data    data of the frame
+ * @param   dlc     length of data in bytes
+ */
+extern void XCP_ReceiveFrame(const uint8_t *data, uint8_t dlc);
+
+/**
+ * @brief   samples and sends the running DAQ lists of an event channel
+ *
+ * Called at the end of the task of the event channel. As long as no DAQ list runs, only one
+ * flag is checked. Otherwise at most XCP_MAX_FRAMES_PER_EVENT frames are sent per call.
+ *
+ * @param   channel     event channel of the calling task
+ */
+extern void XCP_Event(XCP_EVENT_CHANNEL_e channel);
+
+/*================== Function Implementations =============================*/
+
+#endif /* XCP_H_ */
@@ -55,14 +55,35 @@
 
 /*================== Macros and Definitions =================================*/
 
+/* initial guess of the reciprocal of d in [0.5, 1): 48/17 - 32/17 * d, in Q30 */
+#define MATH_RECIPROCAL_OFFSET_Q30      (3031741620u)
+#define MATH_RECIPROCAL_SLOPE_Q30       (2021161080u)
+#define MATH_RECIPROCAL_ITERATIONS      (3u)
+
 /*================== Static Constant and Variable Definitions ===============*/
 
 /*================== Extern Constant and Variable Definitions ===============*/
 
 /*================== Static Function Prototypes =============================*/
+static int32_t MATH_interpolateSegment(int32_t y0, int32_t y1, int32_t width, int32_t dx);
 
 /*================== Static Function Implementations ========================*/
 
+/**
+ * @brief   interpolates linearly between two points
+ *
+ * @param   y0:     y value of the left point
+ * @param   y1:     y value of the right point
+ * @param   width:  distance between the points in x, larger than 0
+ * @param   dx:     distance of the interpolation point from the left point
+ *
+ * @return  interpolated y value, rounded toward zero
+ */
+static int32_t MATH_interpolateSegment(int32_t y0, int32_t y1, int32_t width, int32_t dx) {
+    /* the step y1 - y0 needs 33 bit, the sum is in the range of y0 and y1 again */
+    return (int32_t)(y0 + ((((int64_t)y1 - y0) * dx) / width));
+}
+
 /*================== Extern Function Implementations ========================*/
 
 float MATH_linearInterpolation(float x1, float y1, float x2, float y2, float x_interpolate) {
@@ -96,3 +117,125 @@ uint64_t MATH_swapBytes_uint64_t(uint64_t val) {
     val = ((val << 16) & 0xFFFF0000FFFF0000ull) | ((val >> 16) & 0x0000FFFF0000FFFFull);
     return (val << 32) | (val >> 32);
 }
+
+uint32_t MATH_sqrt_uint64(uint64_t x) {
+    uint64_t result = 0u;
+    uint64_t bit = 1ull << 62;
+
+    /* digit-by-digit calculation, two bits of the radicand per result bit */
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0u) {
+        if (x >= (result + bit)) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+int16_t MATH_sqrt_q15(int16_t x) {
+    int16_t result = 0;
+
+    if (x > 0) {
+        /* sqrt(x / 2^15) * 2^15 = sqrt(x * 2^15) */
+        result = (int16_t)MATH_sqrt_uint64((uint64_t)x << 15);
+    }
+    return result;
+}
+
+int32_t MATH_sqrt_q31(int32_t x) {
+    int32_t result = 0;
+
+    if (x > 0) {
+        /* sqrt(x / 2^31) * 2^31 = sqrt(x * 2^31) */
+        result = (int32_t)MATH_sqrt_uint64((uint64_t)x << 31);
+    }
+    return result;
+}
+
+int32_t MATH_reciprocal_q31(int32_t x, uint8_t *shift) {
+    uint32_t absX = 0u;
+    uint32_t d = 0u;
+    uint32_t y = 0u;
+    uint8_t n = 0u;
+    int32_t result = MATH_Q31_MAX;
+
+    if (x == 0) {
+        *shift = 32u;
+        return result;
+    }
+
+    if (x < 0) {
+        absX = 0u - (uint32_t)x;
+    } else {
+        absX = (uint32_t)x;
+    }
+
+    /* Normalize: d = |x| * 2^n in [0.5, 1) as Q32, then 1/x = 2^n / (2 * d) */
+    n = (uint8_t)__builtin_clz(absX);
+    d = absX << n;
+
+    /* Newton-Raphson y = y * (2 - d * y) in Q30, y converges to 1/d in (1, 2] */
+    y = MATH_RECIPROCAL_OFFSET_Q30 - (uint32_t)(((uint64_t)MATH_RECIPROCAL_SLOPE_Q30 * d) >> 32);
+    for (uint8_t i = 0u; i < MATH_RECIPROCAL_ITERATIONS; i++) {
+        uint32_t e = 0x80000000u - (uint32_t)(((uint64_t)d * y) >> 32);
+        y = (uint32_t)(((uint64_t)y * e) >> 30);
+    }
+
+    /* y / 2^30 = 2 * (y / 2^31), so y is the Q31 mantissa of 1 / (2 * d) */
+    if (y < 0x80000000u) {
+        result = (int32_t)y;
+    }
+    if (x < 0) {
+        result = -result;
+    }
+    *shift = n;
+    return result;
+}
+
+int32_t MATH_interpolateTable(const MATH_TABLE_s *table, int32_t x) {
+    uint16_t low = 0u;
+    uint16_t high = table->length - 1u;
+
+    if (x <= table->x[low]) {
+        return table->y[low];
+    }
+    if (x >= table->x[high]) {
+        return table->y[high];
+    }
+
+    /* binary search of the segment x[low] <= x < x[high] */
+    while ((high - low) > 1) {
+        uint16_t mid = low + ((high - low) / 2u);
+        if (x < table->x[mid]) {
+            high = mid;
+        } else {
+            low = mid;
+        }
+    }
+    return MATH_interpolateSegment(table->y[low], table->y[high],
+                                   table->x[high] - table->x[low], x - table->x[low]);
+}
+
+int32_t MATH_interpolateGrid(const MATH_GRID_s *grid, int32_t x) {
+    int64_t offset = (int64_t)x - grid->x0;
+    int64_t range = (int64_t)(grid->length - 1u) << grid->stepShift;
+    uint32_t idx = 0u;
+    int32_t dx = 0;
+
+    if (offset <= 0) {
+        return grid->y[0];
+    }
+    if (offset >= range) {
+        return grid->y[grid->length - 1u];
+    }
+
+    idx = (uint32_t)(offset >> grid->stepShift);
+    dx = (int32_t)(offset - ((int64_t)idx << grid->stepShift));
+    return (int32_t)(grid->y[idx] + ((((int64_t)grid->y[idx + 1u] - grid->y[idx]) * dx) >> grid->stepShift));
+}
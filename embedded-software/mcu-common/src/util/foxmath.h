@@ -52,6 +52,16 @@
  *          Currently the following functions are supported:
  *          - Slope
  *          - Linear interpolation
+ *          - Byte swaps
+ *          - Q15/Q31 fixed-point arithmetic with saturation
+ *          - Fixed-point square root and reciprocal
+ *          - Piecewise-linear interpolation over constant integer tables
+ *
+ *          Q15 values are stored in int16_t and Q31 values in int32_t, both
+ *          represent the range [-1, 1). The saturating operations use the
+ *          DSP instructions of the Cortex-M4 if available and portable C
+ *          otherwise, so the same code runs in host builds. Code using only
+ *          these functions does not touch the FPU.
  *
  */
 
@@ -93,6 +103,60 @@
 #define M_INVLN2        1.4426950408889633870E0  /* 1 / log(2) */
 #endif /* __STRICT_ANSI__ */
 
+/**
+ * TRUE if the saturating operations use the DSP instructions SSAT, QADD and
+ * QSUB of the Cortex-M4, FALSE for portable C. Defaults to the DSP extension
+ * of the compiler target. A host build can set it to TRUE and provide
+ * emulations of MATH_dspSsat16(), MATH_dspQadd() and MATH_dspQsub() to
+ * compare both implementations.
+ */
+#ifndef MATH_USE_DSP_INSTRUCTIONS
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define MATH_USE_DSP_INSTRUCTIONS   TRUE
+#else
+#define MATH_USE_DSP_INSTRUCTIONS   FALSE
+#endif
+#endif
+
+#define MATH_Q15_MAX    (INT16_MAX)     /*!< largest Q15 value, 1 - 2^-15 */
+#define MATH_Q15_MIN    (INT16_MIN)     /*!< smallest Q15 value, -1 */
+#define MATH_Q31_MAX    (INT32_MAX)     /*!< largest Q31 value, 1 - 2^-31 */
+#define MATH_Q31_MIN    (INT32_MIN)     /*!< smallest Q31 value, -1 */
+
+/**
+ * Q15 constant from a floating point constant in [-1, 1), e.g., for tables.
+ * Not saturating, use MATH_floatToQ15() for variables.
+ */
+#define MATH_Q15_CONST(x)   ((int16_t)((x) * 32768.0f))
+
+/**
+ * Q31 constant from a floating point constant in [-1, 1), e.g., for tables.
+ * Not saturating, use MATH_floatToQ31() for variables.
+ */
+#define MATH_Q31_CONST(x)   ((int32_t)((double)(x) * 2147483648.0))
+
+/**
+ * piecewise-linear curve with arbitrary x values
+ */
+typedef struct {
+    const int32_t *x;   /*!< x values, strictly increasing */
+    const int32_t *y;   /*!< y values */
+    uint16_t length;    /*!< number of points, at least 1 */
+} MATH_TABLE_s;
+
+/**
+ * piecewise-linear curve with equidistant x values
+ *
+ * The x values are x0 + i * 2^stepShift, so the segment is found with a
+ * shift instead of a search and no division is needed.
+ */
+typedef struct {
+    int32_t x0;         /*!< x value of the first point */
+    uint8_t stepShift;  /*!< distance between two points is 2^stepShift */
+    const int32_t *y;   /*!< y values */
+    uint16_t length;    /*!< number of points, at least 1 */
+} MATH_GRID_s;
+
 /*================== Extern Constant and Variable Declarations ==============*/
 
 /*================== Extern Function Prototypes =============================*/
@@ -131,4 +195,284 @@ uint32_t MATH_swapBytes_uint32_t(uint32_t val);
  */
 uint64_t MATH_swapBytes_uint64_t(uint64_t val);
 
+/**
+ * @brief   calculates the integer square root
+ *
+ * @param   x:  radicand
+ *
+ * @return  largest integer r with r*r <= x
+ */
+extern uint32_t MATH_sqrt_uint64(uint64_t x);
+
+/**
+ * @brief   calculates the square root of a Q15 value
+ *
+ * @param   x:  radicand in Q15, negative values are treated as 0
+ *
+ * @return  square root in Q15
+ */
+extern int16_t MATH_sqrt_q15(int16_t x);
+
+/**
+ * @brief   calculates the square root of a Q31 value
+ *
+ * @param   x:  radicand in Q31, negative values are treated as 0
+ *
+ * @return  square root in Q31
+ */
+extern int32_t MATH_sqrt_q31(int32_t x);
+
+/**
+ * @brief   calculates the reciprocal of a Q31 value
+ *
+ * As the reciprocal of a Q31 value is not in [-1, 1), it is returned as
+ * mantissa and exponent: 1/x = return value * 2^shift. The mantissa is
+ * calculated by normalization and three Newton-Raphson iterations without
+ * division.
+ *
+ * @param   x:      divisor in Q31
+ * @param   shift:  pointer where the exponent (0 to 32) is written to
+ *
+ * @return  mantissa in Q31, MATH_Q31_MAX with shift 32 if x is 0
+ */
+extern int32_t MATH_reciprocal_q31(int32_t x, uint8_t *shift);
+
+/**
+ * @brief   interpolates linearly in a table, x values are found by binary search
+ *
+ * @param   table:  piecewise-linear curve
+ * @param   x:      x value of interpolation point, clamped to the table range
+ *
+ * @return  interpolated y value, rounded toward zero
+ */
+extern int32_t MATH_interpolateTable(const MATH_TABLE_s *table, int32_t x);
+
+/**
+ * @brief   interpolates linearly in a table with equidistant x values
+ *
+ * @param   grid:   piecewise-linear curve
+ * @param   x:      x value of interpolation point, clamped to the grid range
+ *
+ * @return  interpolated y value, rounded toward minus infinity
+ */
+extern int32_t MATH_interpolateGrid(const MATH_GRID_s *grid, int32_t x);
+
+#if (MATH_USE_DSP_INSTRUCTIONS == TRUE) && !(defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+/* DSP instructions emulated by the build, e.g., by a host test */
+extern int32_t MATH_dspSsat16(int32_t x);
+extern int32_t MATH_dspQadd(int32_t a, int32_t b);
+extern int32_t MATH_dspQsub(int32_t a, int32_t b);
+#endif
+
+/*================== Inline Function Implementations ========================*/
+
+/**
+ * @brief   limits a value to a range
+ *
+ * @param   x:      value
+ * @param   min:    lower limit
+ * @param   max:    upper limit
+ *
+ * @return  x limited to [min, max]
+ */
+static inline int32_t MATH_clamp_int32(int32_t x, int32_t min, int32_t max) {
+    if (x < min) {
+        x = min;
+    } else if (x > max) {
+        x = max;
+    }
+    return x;
+}
+
+/**
+ * @brief   limits a value to a range
+ *
+ * @param   x:      value
+ * @param   min:    lower limit
+ * @param   max:    upper limit
+ *
+ * @return  x limited to [min, max]
+ */
+static inline float MATH_clamp_float(float x, float min, float max) {
+    if (x < min) {
+        x = min;
+    } else if (x > max) {
+        x = max;
+    }
+    return x;
+}
+
+#if (MATH_USE_DSP_INSTRUCTIONS == TRUE) && defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+/**
+ * @brief   SSAT instruction, saturates a signed value to 16 bit
+ */
+static inline int32_t MATH_dspSsat16(int32_t x) {
+    int32_t result;
+    __asm("ssat %0, #16, %1" : "=r" (result) : "r" (x));
+    return result;
+}
+
+/**
+ * @brief   QADD instruction, saturating 32 bit addition
+ */
+static inline int32_t MATH_dspQadd(int32_t a, int32_t b) {
+    int32_t result;
+    __asm("qadd %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+/**
+ * @brief   QSUB instruction, saturating 32 bit subtraction a - b
+ */
+static inline int32_t MATH_dspQsub(int32_t a, int32_t b) {
+    int32_t result;
+    __asm("qsub %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+#endif
+
+/**
+ * @brief   saturates a 32 bit value to the Q15 range in portable C
+ *
+ * @param   x:  value
+ *
+ * @return  x limited to [MATH_Q15_MIN, MATH_Q15_MAX]
+ */
+static inline int16_t MATH_saturate_q15_c(int32_t x) {
+    return (int16_t)MATH_clamp_int32(x, MATH_Q15_MIN, MATH_Q15_MAX);
+}
+
+/**
+ * @brief   saturates a 32 bit value to the Q15 range
+ *
+ * @param   x:  value
+ *
+ * @return  x limited to [MATH_Q15_MIN, MATH_Q15_MAX]
+ */
+static inline int16_t MATH_saturate_q15(int32_t x) {
+#if MATH_USE_DSP_INSTRUCTIONS == TRUE
+    return (int16_t)MATH_dspSsat16(x);
+#else
+    return MATH_saturate_q15_c(x);
+#endif
+}
+
+/**
+ * @brief   saturates a 64 bit value to the Q31 range
+ *
+ * @param   x:  value
+ *
+ * @return  x limited to [MATH_Q31_MIN, MATH_Q31_MAX]
+ */
+static inline int32_t MATH_saturate_q31(int64_t x) {
+    if (x < MATH_Q31_MIN) {
+        x = MATH_Q31_MIN;
+    } else if (x > MATH_Q31_MAX) {
+        x = MATH_Q31_MAX;
+    }
+    return (int32_t)x;
+}
+
+/**
+ * @brief   adds two Q15 values with saturation
+ */
+static inline int16_t MATH_addSat_q15(int16_t a, int16_t b) {
+    return MATH_saturate_q15((int32_t)a + b);
+}
+
+/**
+ * @brief   subtracts two Q15 values (a - b) with saturation
+ */
+static inline int16_t MATH_subSat_q15(int16_t a, int16_t b) {
+    return MATH_saturate_q15((int32_t)a - b);
+}
+
+/**
+ * @brief   multiplies two Q15 values with saturation, rounded to nearest
+ */
+static inline int16_t MATH_mulSat_q15(int16_t a, int16_t b) {
+    return MATH_saturate_q15((((int32_t)a * b) + (1 << 14)) >> 15);
+}
+
+/**
+ * @brief   adds two Q31 values with saturation in portable C
+ */
+static inline int32_t MATH_addSat_q31_c(int32_t a, int32_t b) {
+    return MATH_saturate_q31((int64_t)a + b);
+}
+
+/**
+ * @brief   adds two Q31 values with saturation
+ */
+static inline int32_t MATH_addSat_q31(int32_t a, int32_t b) {
+#if MATH_USE_DSP_INSTRUCTIONS == TRUE
+    return MATH_dspQadd(a, b);
+#else
+    return MATH_addSat_q31_c(a, b);
+#endif
+}
+
+/**
+ * @brief   subtracts two Q31 values (a - b) with saturation in portable C
+ */
+static inline int32_t MATH_subSat_q31_c(int32_t a, int32_t b) {
+    return MATH_saturate_q31((int64_t)a - b);
+}
+
+/**
+ * @brief   subtracts two Q31 values (a - b) with saturation
+ */
+static inline int32_t MATH_subSat_q31(int32_t a, int32_t b) {
+#if MATH_USE_DSP_INSTRUCTIONS == TRUE
+    return MATH_dspQsub(a, b);
+#else
+    return MATH_subSat_q31_c(a, b);
+#endif
+}
+
+/**
+ * @brief   multiplies two Q31 values with saturation, rounded to nearest
+ */
+static inline int32_t MATH_mulSat_q31(int32_t a, int32_t b) {
+    return MATH_saturate_q31((((int64_t)a * b) + (1ll << 30)) >> 31);
+}
+
+/**
+ * @brief   converts a Q15 value to float
+ */
+static inline float MATH_q15ToFloat(int16_t x) {
+    return (float)x * (1.0f / 32768.0f);
+}
+
+/**
+ * @brief   converts a float to Q15 with saturation, truncated toward zero
+ */
+static inline int16_t MATH_floatToQ15(float x) {
+    return (int16_t)MATH_clamp_float(x * 32768.0f, (float)MATH_Q15_MIN, (float)MATH_Q15_MAX);
+}
+
+/**
+ * @brief   converts a Q31 value to float
+ */
+static inline float MATH_q31ToFloat(int32_t x) {
+    return (float)x * (1.0f / 2147483648.0f);
+}
+
+/**
+ * @brief   converts a float to Q31 with saturation, truncated toward zero
+ */
+static inline int32_t MATH_floatToQ31(float x) {
+    float scaled = x * 2147483648.0f;
+    int32_t result;
+
+    if (scaled >= 2147483648.0f) {
+        result = MATH_Q31_MAX;
+    } else if (scaled <= -2147483648.0f) {
+        result = MATH_Q31_MIN;
+    } else {
+        result = (int32_t)scaled;
+    }
+    return result;
+}
+
 #endif /* FOXMATH_H_ */
@@ -0,0 +1,221 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    lut.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  LUT
+ *
+ * @brief   header-only, macro-specialized interpolation in lookup tables
+ *
+ * @details Each macro defines a static inline function for one table type,
+ *          so member access, arithmetic and range handling are resolved at
+ *          compile time. Tables are arrays of structs or of scalars. The
+ *          member arguments are passed with the leading dot
+ *          (e.g. .resistance_Ohm), or left empty for arrays of scalars.
+ *
+ *          - LUT_DEFINE_FIND_SEGMENT: binary search in a monotonic table
+ *          - LUT_DEFINE_SEARCH_FLOAT: non-uniform table, float result
+ *          - LUT_DEFINE_SEARCH_INT: non-uniform table, int32 result, e.g., Q15/Q31
+ *          - LUT_DEFINE_GRID_FLOAT: uniform grid in x, float result, O(1)
+ *          - LUT_DEFINE_GRID_INT: uniform grid in x, int32 result, O(1)
+ *
+ *          The x values of non-uniform tables may be increasing or
+ *          decreasing, tables need at least two points. The mode argument
+ *          selects LUT_CLAMP (result limited to the end points) or
+ *          LUT_EXTRAPOLATE (linear continuation of the first/last segment).
+ *
+ * Example:
+ * @code
+ * LUT_DEFINE_SEARCH_FLOAT(NTC_Interpolate, NTC_LUT_s, .resistance_Ohm, .temperature_C, LUT_CLAMP)
+ * temperature = NTC_Interpolate(ntc_LUT, sizeLUT, resistance_Ohm);
+ * @endcode
+ *
+ */
+
+#ifndef LUT_H_
+#define LUT_H_
+
+/*================== Includes ===============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions =================================*/
+
+#define LUT_CLAMP           0   /*!< limit the result to the end points of the table */
+#define LUT_EXTRAPOLATE     1   /*!< extrapolate linearly beyond the end points of the table */
+
+/**
+ * defines uint16_t name(const entryType *table, uint16_t length, xType x)
+ *
+ * Returns the index i of the segment [table[i], table[i+1]] containing x,
+ * limited to 0 ... length-2, found by binary search.
+ */
+#define LUT_DEFINE_FIND_SEGMENT(name, entryType, xMember, xType) \
+static inline uint16_t name(const entryType *table, uint16_t length, xType x) { \
+    uint16_t low = 0u; \
+    uint16_t high = length - 1u; \
+    int ascending = (table[0]xMember <= table[high]xMember); \
+    while ((high - low) > 1) { \
+        uint16_t mid = low + ((high - low) / 2u); \
+        if ((x < table[mid]xMember) == ascending) { \
+            high = mid; \
+        } else { \
+            low = mid; \
+        } \
+    } \
+    return low; \
+}
+
+/**
+ * defines float name(const entryType *table, uint16_t length, float x)
+ *
+ * Interpolates yMember over xMember, the segment is found by binary search.
+ */
+#define LUT_DEFINE_SEARCH_FLOAT(name, entryType, xMember, yMember, mode) \
+LUT_DEFINE_FIND_SEGMENT(name##_FindSegment, entryType, xMember, float) \
+static inline float name(const entryType *table, uint16_t length, float x) { \
+    uint16_t i = name##_FindSegment(table, length, x); \
+    float x0 = (float)table[i]xMember; \
+    float y0 = (float)table[i]yMember; \
+    float fraction = (x - x0) / ((float)table[i + 1u]xMember - x0); \
+    if ((mode) == LUT_CLAMP) { \
+        if (fraction < 0.0f) { \
+            fraction = 0.0f; \
+        } else if (fraction > 1.0f) { \
+            fraction = 1.0f; \
+        } \
+    } \
+    return y0 + (fraction * ((float)table[i + 1u]yMember - y0)); \
+}
+
+/**
+ * defines int32_t name(const entryType *table, uint16_t length, int32_t x)
+ *
+ * Interpolates yMember over xMember in integer arithmetic, the segment is
+ * found by binary search. The result is rounded toward zero.
+ */
+#define LUT_DEFINE_SEARCH_INT(name, entryType, xMember, yMember, mode) \
+LUT_DEFINE_FIND_SEGMENT(name##_FindSegment, entryType, xMember, int32_t) \
+static inline int32_t name(const entryType *table, uint16_t length, int32_t x) { \
+    uint16_t i = name##_FindSegment(table, length, x); \
+    int64_t width = (int64_t)table[i + 1u]xMember - table[i]xMember; \
+    int64_t dx = (int64_t)x - table[i]xMember; \
+    if ((mode) == LUT_CLAMP) { \
+        if (((dx < 0) && (width > 0)) || ((dx > 0) && (width < 0))) { \
+            dx = 0; \
+        } else if (((dx > width) && (width > 0)) || ((dx < width) && (width < 0))) { \
+            dx = width; \
+        } \
+    } \
+    return (int32_t)(table[i]yMember + ((((int64_t)table[i + 1u]yMember - table[i]yMember) * dx) / width)); \
+}
+
+/**
+ * defines float name(const entryType *table, uint16_t length, float x, float *slope)
+ *
+ * Interpolates yMember in a table with the x values x0 + i*step. The segment
+ * is calculated, 1/step is folded at compile time. If slope is not NULL_PTR,
+ * the slope dy/dx of the segment is written to it.
+ */
+#define LUT_DEFINE_GRID_FLOAT(name, entryType, yMember, x0, step, mode) \
+static inline float name(const entryType *table, uint16_t length, float x, float *slope) { \
+    float position = (x - (float)(x0)) * (1.0f / (float)(step)); \
+    uint16_t i = 0u; \
+    float y0 = 0.0f; \
+    float dy = 0.0f; \
+    if (position <= 0.0f) { \
+        i = 0u; \
+        if ((mode) == LUT_CLAMP) { \
+            position = 0.0f; \
+        } \
+    } else if (position >= (float)(length - 1u)) { \
+        i = length - 2u; \
+        if ((mode) == LUT_CLAMP) { \
+            position = (float)(length - 1u); \
+        } \
+    } else { \
+        i = (uint16_t)position; \
+    } \
+    y0 = (float)table[i]yMember; \
+    dy = (float)table[i + 1u]yMember - y0; \
+    if (slope != NULL_PTR) { \
+        *slope = dy * (1.0f / (float)(step)); \
+    } \
+    return y0 + (dy * (position - (float)i)); \
+}
+
+/**
+ * defines int32_t name(const entryType *table, uint16_t length, int32_t x)
+ *
+ * Interpolates yMember in a table with the x values x0 + i*step. The step is
+ * a compile-time constant, so the division is replaced by the compiler
+ * (a shift for powers of two). The result is rounded toward zero.
+ */
+#define LUT_DEFINE_GRID_INT(name, entryType, yMember, x0, step, mode) \
+static inline int32_t name(const entryType *table, uint16_t length, int32_t x) { \
+    int64_t offset = (int64_t)x - (x0); \
+    int64_t range = (int64_t)(length - 1u) * (step); \
+    uint16_t i = 0u; \
+    int64_t y0 = 0; \
+    if (offset <= 0) { \
+        i = 0u; \
+        if ((mode) == LUT_CLAMP) { \
+            offset = 0; \
+        } \
+    } else if (offset >= range) { \
+        i = length - 2u; \
+        if ((mode) == LUT_CLAMP) { \
+            offset = range; \
+        } \
+    } else { \
+        i = (uint16_t)(offset / (step)); \
+    } \
+    y0 = table[i]yMember; \
+    return (int32_t)(y0 + ((((int64_t)table[i + 1u]yMember - y0) * (offset - ((int64_t)i * (step)))) / (step))); \
+}
+
+/*================== Extern Constant and Variable Declarations ==============*/
+
+/*================== Extern Function Prototypes =============================*/
+
+#endif /* LUT_H_ */
@@ -55,61 +55,373 @@
 /*================== Includes =============================================*/
 #include "algo.h"
 
+#include "diag.h"
+#include "mcu.h"
 #include "os.h"
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * weight of a new execution time in the average execution time as power of 2
+ * (3 -> 1/8)
+ */
+#define ALGO_RUNTIME_AVERAGE_SHIFT      3
+
 /*================== Constant and Variable Definitions ====================*/
 
+/** indices of the algorithms in algo_algorithms[], sorted by priority */
+static uint16_t algo_order[ALGO_MAX_NR_OF_ALGORITHMS];
+
+/** number of scheduled algorithms */
+static uint16_t algo_nrOfScheduled = 0;
+
+static uint8_t algo_initialized = FALSE;
+
+/** ALGO time in ms, incremented by ALGO_TICK_MS with each call of ALGO_MainFunction() */
+static uint32_t algo_counter_ms = 0;
+
+/** start of the current ALGO tick in us */
+static uint32_t algo_tickStart_us = 0;
+
+/** start of the current execution slice in us */
+static uint32_t algo_sliceStart_us = 0;
+
 /*================== Function Prototypes ==================================*/
+static uint32_t ALGO_GetTimeStamp_us(void);
+static uint8_t ALGO_IsDue(uint16_t algoIdx);
+static void ALGO_AdvanceNextCall(uint16_t algoIdx);
+static uint8_t ALGO_IsBudgetLeft(void);
+static void ALGO_Continue(uint16_t algoIdx);
+static void ALGO_Execute(uint16_t algoIdx);
+static void ALGO_UpdateRuntime(uint16_t algoIdx, uint32_t duration_us);
+static void ALGO_Unblock(uint16_t algoIdx);
 
 /*================== Function Implementations =============================*/
+
+/**
+ * @brief   gets a timestamp with microsecond resolution from the OS tick and
+ *          the SysTick counter value
+ *
+ * @return  timestamp in us, wraps around after 71 minutes
+ */
+static uint32_t ALGO_GetTimeStamp_us(void) {
+    uint32_t tick_ms = 0;
+    uint32_t fraction_us = 0;
+
+    /* read again if the OS tick was incremented in between */
+    do {
+        tick_ms = OS_getOSSysTick();
+        fraction_us = MCU_GetTimeSinceTick_us();
+    } while (tick_ms != OS_getOSSysTick());
+
+    return ((tick_ms * 1000u) + fraction_us);
+}
+
+
+/**
+ * @brief   checks if the call of an algorithm is due in the current ALGO tick
+ *
+ * @param   algoIdx     index of the algorithm
+ *
+ * @return  TRUE if the cycle time including phase has elapsed, FALSE otherwise
+ */
+static uint8_t ALGO_IsDue(uint16_t algoIdx) {
+    uint8_t retVal = FALSE;
+
+    /* difference interpreted as signed to be robust against wrap-around of the ALGO time */
+    if ((int32_t)(algo_counter_ms - algo_algorithms[algoIdx].nextCall_ms) >= 0) {
+        retVal = TRUE;
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   sets the next call of an algorithm to the next cycle after the
+ *          current ALGO time, calls missed because of deferral are dropped
+ *
+ * @param   algoIdx     index of the algorithm
+ */
+static void ALGO_AdvanceNextCall(uint16_t algoIdx) {
+    do {
+        algo_algorithms[algoIdx].nextCall_ms += algo_algorithms[algoIdx].cycleTime_ms;
+    } while (ALGO_IsDue(algoIdx) == TRUE);
+}
+
+
+/**
+ * @brief   checks if the computation time budget of the current ALGO tick is left
+ *
+ * @return  TRUE if ALGO_TICK_BUDGET_US is not used up, FALSE otherwise
+ */
+static uint8_t ALGO_IsBudgetLeft(void) {
+    uint8_t retVal = FALSE;
+
+    if ((ALGO_GetTimeStamp_us() - algo_tickStart_us) < ALGO_TICK_BUDGET_US) {
+        retVal = TRUE;
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   executes an algorithm that is not bound to its cycle (suspended
+ *          or waiting for execution as soon as possible) if the tick budget
+ *          allows, otherwise defers it to the next tick
+ *
+ * @param   algoIdx     index of the algorithm
+ */
+static void ALGO_Continue(uint16_t algoIdx) {
+    if (ALGO_IsBudgetLeft() == TRUE) {
+        ALGO_Execute(algoIdx);
+    } else {
+        algo_algorithms[algoIdx].runtime.deferrals++;
+    }
+}
+
+
+/**
+ * @brief   executes an algorithm or the next slice of a suspended algorithm
+ *          and measures its execution time
+ *
+ * The execution times of all slices of a job are summed up. The statistics
+ * are updated when the job has finished. With the FreeRTOS runtime statistics
+ * the CPU time of the task is measured, otherwise the elapsed time.
+ *
+ * @param   algoIdx     index of the algorithm
+ */
+static void ALGO_Execute(uint16_t algoIdx) {
+    ALGO_TASKS_s *algo = &algo_algorithms[algoIdx];
+#if BUILD_MODULE_ENABLE_RUNTIMESTATS == 1
+    uint32_t sliceStartRunTime = 0;
+#endif /* BUILD_MODULE_ENABLE_RUNTIMESTATS == 1 */
+
+    if (algo->state != ALGO_SUSPENDED) {
+        /* new job */
+        algo->jobTime_us = 0;
+        algo->overrunReported = FALSE;
+    }
+
+    /* Set state to running -> reset to READY before leaving algo function */
+    algo->startTime = OS_getOSSysTick();
+    algo->state = ALGO_RUNNING;
+
+    algo_sliceStart_us = ALGO_GetTimeStamp_us();
+#if BUILD_MODULE_ENABLE_RUNTIMESTATS == 1
+    sliceStartRunTime = OS_GetTaskRunTime();
+    algo->func(algoIdx);
+    algo->jobTime_us += OS_RunTimeToUs(OS_GetTaskRunTime() - sliceStartRunTime);
+#else
+    algo->func(algoIdx);
+    algo->jobTime_us += ALGO_GetTimeStamp_us() - algo_sliceStart_us;
+#endif /* BUILD_MODULE_ENABLE_RUNTIMESTATS == 1 */
+
+    if (algo->state == ALGO_SUSPENDED) {
+        /* job yielded, continued in the next tick */
+        algo->startTime = 0;
+    } else {
+        ALGO_UpdateRuntime(algoIdx, algo->jobTime_us);
+    }
+}
+
+
+/**
+ * @brief   updates the execution time statistics of an algorithm and checks
+ *          the execution time against the maximum calculation duration
+ *
+ * An overrun is reported to the diagnosis module. After
+ * ALGO_MAX_CONSECUTIVE_OVERRUNS consecutive overruns the algorithm is blocked
+ * for ALGO_BLOCKED_RETRY_MS.
+ *
+ * @param   algoIdx         index of the algorithm
+ * @param   duration_us     measured execution time in us
+ */
+static void ALGO_UpdateRuntime(uint16_t algoIdx, uint32_t duration_us) {
+    ALGO_TASKS_s *algo = &algo_algorithms[algoIdx];
+    ALGO_RUNTIME_s runtime = algo->runtime;
+
+    if (runtime.calls == 0) {
+        runtime.min_us = duration_us;
+        runtime.max_us = duration_us;
+        runtime.avg_us = duration_us;
+    } else {
+        if (duration_us < runtime.min_us) {
+            runtime.min_us = duration_us;
+        }
+        if (duration_us > runtime.max_us) {
+            runtime.max_us = duration_us;
+        }
+        runtime.avg_us = runtime.avg_us - (runtime.avg_us >> ALGO_RUNTIME_AVERAGE_SHIFT) +
+                (duration_us >> ALGO_RUNTIME_AVERAGE_SHIFT);
+    }
+    if (runtime.calls < UINT32_MAX) {
+        runtime.calls++;
+    }
+
+    if (duration_us > (algo->maxCalcDuration_ms * 1000u)) {
+        runtime.overruns++;
+        if (algo->consecutiveOverruns < UINT8_MAX) {
+            algo->consecutiveOverruns++;
+        }
+        if (algo->overrunReported == FALSE) {
+            /* not yet reported by ALGO_MonitorExecutionTime() */
+            DIAG_Handler(DIAG_CH_ALGO_DEADLINE_VIOLATION, DIAG_EVENT_NOK, algoIdx);
+        }
+        if (algo->consecutiveOverruns >= ALGO_MAX_CONSECUTIVE_OVERRUNS) {
+            /* Block algorithm from further execution because of repeated runtime violation */
+            algo->state = ALGO_BLOCKED;
+            algo->blockedUntil_ms = algo_counter_ms + ALGO_BLOCKED_RETRY_MS;
+            DIAG_Handler(DIAG_CH_ALGO_BLOCKED, DIAG_EVENT_NOK, algoIdx);
+        }
+    } else {
+        algo->consecutiveOverruns = 0;
+        DIAG_Handler(DIAG_CH_ALGO_DEADLINE_VIOLATION, DIAG_EVENT_OK, algoIdx);
+    }
+
+    if (algo->state == ALGO_RUNNING) {
+        /* algorithm did not reset its state */
+        algo->state = ALGO_READY;
+    }
+    algo->startTime = 0;
+
+    OS_TaskEnter_Critical();
+    algo->runtime = runtime;
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   enables a blocked algorithm again after ALGO_BLOCKED_RETRY_MS
+ *
+ * The overrun counter starts from zero, so the algorithm is blocked again
+ * after ALGO_MAX_CONSECUTIVE_OVERRUNS further overruns.
+ *
+ * @param   algoIdx     index of the algorithm
+ */
+static void ALGO_Unblock(uint16_t algoIdx) {
+    ALGO_TASKS_s *algo = &algo_algorithms[algoIdx];
+
+    /* difference interpreted as signed to be robust against wrap-around of the ALGO time */
+    if ((int32_t)(algo_counter_ms - algo->blockedUntil_ms) >= 0) {
+        algo->consecutiveOverruns = 0;
+        algo->state = ALGO_READY;
+        DIAG_Handler(DIAG_CH_ALGO_BLOCKED, DIAG_EVENT_OK, algoIdx);
+    }
+}
+
+
 void ALGO_Init(void) {
-    /* Currently nothing to initialize */
+    uint16_t nrOfAlgorithms = algo_length;
+
+    if (nrOfAlgorithms > ALGO_MAX_NR_OF_ALGORITHMS) {
+        /* algorithms beyond the table size are not scheduled */
+        nrOfAlgorithms = ALGO_MAX_NR_OF_ALGORITHMS;
+    }
 
-    return;
+    /* insertion sort by priority, stable with respect to configuration order */
+    for (uint16_t i = 0; i < nrOfAlgorithms; i++) {
+        uint16_t j = i;
+        while ((j > 0) && (algo_algorithms[algo_order[j - 1]].priority > algo_algorithms[i].priority)) {
+            algo_order[j] = algo_order[j - 1];
+            j--;
+        }
+        algo_order[j] = i;
+
+        algo_algorithms[i].nextCall_ms = algo_counter_ms + algo_algorithms[i].phase_ms;
+        algo_algorithms[i].consecutiveOverruns = 0;
+        algo_algorithms[i].overrunReported = FALSE;
+    }
+    algo_nrOfScheduled = nrOfAlgorithms;
+    algo_initialized = TRUE;
 }
 
 
 void ALGO_MainFunction(void) {
-    static uint32_t counter_ticks = 0;
+    uint16_t i = 0;
 
-    for (uint16_t i = 0; i < algo_length; i++) {
-        if (counter_ticks % algo_algorithms[i].cycleTime_ms == 0) {
+    if (algo_initialized == FALSE) {
+        ALGO_Init();
+    }
+
+    algo_tickStart_us = ALGO_GetTimeStamp_us();
+
+    for (uint16_t k = 0; k < algo_nrOfScheduled; k++) {
+        i = algo_order[k];
+
+        if (ALGO_IsDue(i) == TRUE) {
             /* Cycle time elapsed -> call function */
             if (algo_algorithms[i].state == ALGO_READY) {
-                /* Set state to running -> reset to READY before leaving algo function */
-                algo_algorithms[i].state = ALGO_RUNNING;
-                algo_algorithms[i].startTime = OS_getOSSysTick();
-                algo_algorithms[i].func(i);
+                if (ALGO_IsBudgetLeft() == TRUE) {
+                    ALGO_AdvanceNextCall(i);
+                    ALGO_Execute(i);
+                } else {
+                    /* Tick budget used up -> stays due and is executed in the next tick */
+                    algo_algorithms[i].runtime.deferrals++;
+                }
             } else if (algo_algorithms[i].state == ALGO_WAIT_FOR_OTHER) {
                 algo_algorithms[i].state = ALGO_RDY_BUT_WAITING;
+                ALGO_AdvanceNextCall(i);
+            } else if (algo_algorithms[i].state == ALGO_SUSPENDED) {
+                /* Previous job not finished: cycle is skipped, job is continued */
+                ALGO_AdvanceNextCall(i);
+                ALGO_Continue(i);
+            } else if (algo_algorithms[i].state == ALGO_BLOCKED) {
+                /* cycle is skipped, executed again in the next cycle after the block has expired */
+                ALGO_AdvanceNextCall(i);
+                ALGO_Unblock(i);
             } else {
-                /* TODO: explain why empty else */
+                /* Already waiting: cycle is skipped */
+                ALGO_AdvanceNextCall(i);
             }
-        } else if (algo_algorithms[i].state == ALGO_EXECUTE_ASAP) {
-            /* Waited for other algo to finish -> can now be executed */
-            /* Set state to running -> reset to READY before leaving algo function */
-            algo_algorithms[i].state = ALGO_RUNNING;
-            algo_algorithms[i].startTime = OS_getOSSysTick();
-            algo_algorithms[i].func(i);
+        } else if ((algo_algorithms[i].state == ALGO_EXECUTE_ASAP) || (algo_algorithms[i].state == ALGO_SUSPENDED)) {
+            /* Waited for other algo to finish or yielded in the last tick -> can now be executed */
+            ALGO_Continue(i);
         }
     }
 
-    counter_ticks += ALGO_TICK_MS;
+    algo_counter_ms += ALGO_TICK_MS;
 }
 
 
 void ALGO_MonitorExecutionTime(void) {
     uint32_t timestamp = OS_getOSSysTick();
 
-    for (uint16_t i = 0; i < algo_length; i++) {
-        if ((algo_algorithms[i].startTime != 0) && algo_algorithms[i].state == ALGO_RUNNING &&
-                ((algo_algorithms[i].startTime + algo_algorithms[i].maxCalcDuration_ms) < timestamp)) {
-            /* Block task from further execution because of runtime violation, but task will finish its execution */
-            algo_algorithms[i].state = ALGO_BLOCKED;
+    for (uint16_t i = 0; i < algo_nrOfScheduled; i++) {
+        if ((algo_algorithms[i].startTime != 0) && (algo_algorithms[i].state == ALGO_RUNNING) &&
+                (algo_algorithms[i].overrunReported == FALSE) &&
+                ((timestamp - algo_algorithms[i].startTime) > algo_algorithms[i].cycleTime_ms)) {
+            /* Report while still running, counting and blocking is done with the CPU time when the algorithm has finished */
+            algo_algorithms[i].overrunReported = TRUE;
+            DIAG_Handler(DIAG_CH_ALGO_DEADLINE_VIOLATION, DIAG_EVENT_NOK, i);
+        }
+    }
+}
+
 
-            /* TODO: Add diag call to notify error in algorithm module */
+uint8_t ALGO_YieldRequested(uint32_t algoIdx) {
+    uint8_t retVal = FALSE;
+    uint32_t now_us = 0;
+
+    if ((algoIdx < algo_length) && (algo_algorithms[algoIdx].state == ALGO_RUNNING)) {
+        now_us = ALGO_GetTimeStamp_us();
+        if (((now_us - algo_sliceStart_us) >= ALGO_JOB_SLICE_US) ||
+                ((now_us - algo_tickStart_us) >= ALGO_TICK_BUDGET_US)) {
+            algo_algorithms[algoIdx].state = ALGO_SUSPENDED;
+            retVal = TRUE;
         }
     }
+    return retVal;
+}
+
+
+STD_RETURN_TYPE_e ALGO_GetRuntime(uint16_t algoIdx, ALGO_RUNTIME_s *runtime) {
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+
+    if ((algoIdx < algo_length) && (runtime != NULL_PTR)) {
+        OS_TaskEnter_Critical();
+        *runtime = algo_algorithms[algoIdx].runtime;
+        OS_TaskExit_Critical();
+        retVal = E_OK;
+    }
+    return retVal;
 }
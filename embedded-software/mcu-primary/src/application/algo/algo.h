@@ -66,20 +66,63 @@
 /*================== Function Prototypes ==================================*/
 /**
  * @brief    initializes local variables and module internals needed to use the algorithm module.
- *           Until now no initialization is needed and thus the function does nothing.
+ *
+ * Sorts the algorithms by priority and sets the first call of each algorithm
+ * according to its phase. Called by ALGO_MainFunction() on its first call if
+ * not called before.
  */
 extern void ALGO_Init(void);
 
 /**
  * @brief    handles the call of different algorithm functions when cycle time has expired.
+ *
+ * Due algorithms are executed in order of priority as long as the tick budget
+ * ALGO_TICK_BUDGET_US is not used up, the remaining ones are deferred to the
+ * next tick. Suspended algorithms are continued in the next tick. The
+ * execution time of every job is measured and checked against the maximum
+ * calculation duration of the algorithm. With the FreeRTOS runtime statistics
+ * enabled, the time is the CPU time of the algorithm task, so preemption by
+ * tasks of higher priority is not counted. A blocked algorithm is enabled
+ * again after ALGO_BLOCKED_RETRY_MS.
  */
 extern void ALGO_MainFunction(void);
 
 /**
  * @brief    monitors the calculation duration of the different algorithms.
+ *
+ * Reports an algorithm that is still running after its cycle time to the
+ * diagnosis module, i.e., it hangs or is starved by tasks of higher priority.
+ * The maximum calculation duration is checked against the CPU time when the
+ * algorithm has finished. Must be called from a task with higher priority
+ * than the one calling ALGO_MainFunction().
  */
 extern void ALGO_MonitorExecutionTime(void);
 
+/**
+ * @brief    yield point of a resumable algorithm
+ *
+ * Long algorithms call this function between chunks of their work (e.g.,
+ * after a group of cells). If the slice ALGO_JOB_SLICE_US or the budget of
+ * the tick is used up, the state of the algorithm is set to ALGO_SUSPENDED
+ * and the algorithm must save its progress and return without resetting its
+ * state. It is called again in the next ALGO tick to continue the job.
+ *
+ * @param    algoIdx     index of the calling algorithm, as passed to its callback
+ *
+ * @return   TRUE if the algorithm has to yield, FALSE if it can continue
+ */
+extern uint8_t ALGO_YieldRequested(uint32_t algoIdx);
+
+/**
+ * @brief    gets the measured execution time statistics of an algorithm
+ *
+ * @param    algoIdx     index of the algorithm in algo_algorithms[]
+ * @param    runtime     pointer where the statistics are copied to
+ *
+ * @return   E_OK if algoIdx is valid, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e ALGO_GetRuntime(uint16_t algoIdx, ALGO_RUNTIME_s *runtime);
+
 
 /*================== Function Implementations =============================*/
 
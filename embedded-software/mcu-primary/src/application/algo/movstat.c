@@ -0,0 +1,216 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    movstat.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  MOVSTAT
+ *
+ * @brief   Moving statistics (mean, RMS, minimum, maximum) over several sliding windows
+ *
+ * When a sample is added, the sample leaving each window is read from the
+ * shared ring buffer and subtracted from the running sums of that window.
+ * Minimum and maximum are the fronts of monotonic deques of sample numbers,
+ * so no window has to be scanned.
+ */
+
+/*================== Includes =============================================*/
+#include "movstat.h"
+
+#include <math.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+static int32_t MOVSTAT_GetValue(const MOVSTAT_s *stat, uint32_t sampleNr);
+static void MOVSTAT_PushDeque(const MOVSTAT_s *stat, uint32_t *deque, uint16_t length,
+        uint16_t *first, uint16_t *count, int32_t value, uint8_t keepMaximum);
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   gets a sample from the ring buffer by its sample number
+ *
+ * @param   stat        moving statistics
+ * @param   sampleNr    number of the sample, must be one of the last bufferLength samples
+ *
+ * @return  value of the sample
+ */
+static int32_t MOVSTAT_GetValue(const MOVSTAT_s *stat, uint32_t sampleNr) {
+    uint32_t age = stat->sampleNr - sampleNr;   /* 1 for the last added sample */
+
+    return stat->buffer[(stat->head + stat->bufferLength - age) % stat->bufferLength];
+}
+
+
+/**
+ * @brief   adds the next sample to a monotonic deque
+ *
+ * Removes the expired sample at the front, then all samples at the back that
+ * can no longer become the extremum while the new sample is in the window.
+ *
+ * @param   stat            moving statistics
+ * @param   deque           storage of the deque, capacity length
+ * @param   length          window length
+ * @param   first           index of the front of the deque
+ * @param   count           number of entries in the deque
+ * @param   value           value of the new sample
+ * @param   keepMaximum     TRUE for the maximum deque, FALSE for the minimum deque
+ */
+static void MOVSTAT_PushDeque(const MOVSTAT_s *stat, uint32_t *deque, uint16_t length,
+        uint16_t *first, uint16_t *count, int32_t value, uint8_t keepMaximum) {
+    int32_t back = 0;
+
+    if ((*count > 0) && ((stat->sampleNr - deque[*first]) >= length)) {
+        *first = (*first + 1u) % length;
+        (*count)--;
+    }
+
+    while (*count > 0) {
+        back = MOVSTAT_GetValue(stat, deque[(*first + *count - 1u) % length]);
+        if (((keepMaximum == TRUE) && (back > value)) || ((keepMaximum == FALSE) && (back < value))) {
+            break;
+        }
+        (*count)--;
+    }
+
+    deque[(*first + *count) % length] = stat->sampleNr;
+    (*count)++;
+}
+
+
+STD_RETURN_TYPE_e MOVSTAT_Init(MOVSTAT_s *stat) {
+    uint32_t offset = 0;
+    uint16_t maxLength = 0;
+    MOVSTAT_WINDOW_s *window = NULL_PTR;
+
+    stat->initialized = FALSE;
+
+    for (uint8_t i = 0; i < stat->nrOfWindows; i++) {
+        if (stat->windows[i].length == 0) {
+            return E_NOT_OK;
+        }
+        if (stat->windows[i].length > maxLength) {
+            maxLength = stat->windows[i].length;
+        }
+        offset += MOVSTAT_DEQUE_STORAGE_LENGTH((uint32_t)stat->windows[i].length);
+    }
+    if ((maxLength > stat->bufferLength) || (offset > stat->dequeStorageLength)) {
+        return E_NOT_OK;
+    }
+
+    offset = 0;
+    for (uint8_t i = 0; i < stat->nrOfWindows; i++) {
+        window = &stat->windows[i];
+        window->maxDeque = &stat->dequeStorage[offset];
+        offset += window->length;
+        window->minDeque = &stat->dequeStorage[offset];
+        offset += window->length;
+        window->sum = 0;
+        window->sumSquares = 0;
+        window->maxFirst = 0;
+        window->maxCount = 0;
+        window->minFirst = 0;
+        window->minCount = 0;
+    }
+
+    stat->head = 0;
+    stat->sampleNr = 0;
+    stat->nrOfSamples = 0;
+    stat->initialized = TRUE;
+    return E_OK;
+}
+
+
+void MOVSTAT_AddSample(MOVSTAT_s *stat, int32_t value) {
+    MOVSTAT_WINDOW_s *window = NULL_PTR;
+    int32_t oldest = 0;
+
+    if (stat->initialized == FALSE) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < stat->nrOfWindows; i++) {
+        window = &stat->windows[i];
+
+        if (stat->nrOfSamples >= window->length) {
+            /* oldest sample leaves the window, its slot is not yet overwritten */
+            oldest = MOVSTAT_GetValue(stat, stat->sampleNr - window->length);
+            window->sum -= oldest;
+            window->sumSquares -= (uint64_t)((int64_t)oldest * oldest);
+        }
+        window->sum += value;
+        window->sumSquares += (uint64_t)((int64_t)value * value);
+
+        MOVSTAT_PushDeque(stat, window->maxDeque, window->length, &window->maxFirst, &window->maxCount, value, TRUE);
+        MOVSTAT_PushDeque(stat, window->minDeque, window->length, &window->minFirst, &window->minCount, value, FALSE);
+    }
+
+    stat->buffer[stat->head] = value;
+    stat->head = (stat->head + 1u) % stat->bufferLength;
+    stat->sampleNr++;
+    if (stat->nrOfSamples < stat->bufferLength) {
+        stat->nrOfSamples++;
+    }
+}
+
+
+STD_RETURN_TYPE_e MOVSTAT_GetWindow(const MOVSTAT_s *stat, uint8_t windowIdx, MOVSTAT_RESULT_s *result) {
+    const MOVSTAT_WINDOW_s *window = NULL_PTR;
+    float count = 0.0f;
+
+    if ((stat->initialized == FALSE) || (windowIdx >= stat->nrOfWindows) || (stat->nrOfSamples == 0)) {
+        return E_NOT_OK;
+    }
+    window = &stat->windows[windowIdx];
+
+    result->count = (stat->nrOfSamples < window->length) ? stat->nrOfSamples : window->length;
+    count = (float)result->count;
+    result->mean = (float)window->sum / count;
+    result->rms = sqrtf((float)window->sumSquares / count);
+    result->max = MOVSTAT_GetValue(stat, window->maxDeque[window->maxFirst]);
+    result->min = MOVSTAT_GetValue(stat, window->minDeque[window->minFirst]);
+    return E_OK;
+}
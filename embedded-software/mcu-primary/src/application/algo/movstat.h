@@ -0,0 +1,156 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    movstat.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  MOVSTAT
+ *
+ * @brief   Header for the moving statistics over several sliding windows
+ *
+ */
+
+#ifndef MOVSTAT_H_
+#define MOVSTAT_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * length of the deque storage needed for windows with a total length of
+ * sumOfWindowLengths samples (one minimum and one maximum deque per window)
+ */
+#define MOVSTAT_DEQUE_STORAGE_LENGTH(sumOfWindowLengths)    (2u * (sumOfWindowLengths))
+
+/**
+ * state of one sliding window
+ *
+ * Only length is configured, all other members are set by MOVSTAT_Init().
+ */
+typedef struct {
+    uint16_t length;            /*!< window length in samples (configuration) */
+    int64_t sum;                /*!< sum of the samples in the window */
+    uint64_t sumSquares;        /*!< sum of the squared samples in the window */
+    uint32_t *maxDeque;         /*!< sample numbers with decreasing values, front is the maximum */
+    uint32_t *minDeque;         /*!< sample numbers with increasing values, front is the minimum */
+    uint16_t maxFirst;          /*!< index of the front of the maximum deque */
+    uint16_t maxCount;          /*!< number of entries in the maximum deque */
+    uint16_t minFirst;          /*!< index of the front of the minimum deque */
+    uint16_t minCount;          /*!< number of entries in the minimum deque */
+} MOVSTAT_WINDOW_s;
+
+/**
+ * moving statistics of one signal
+ *
+ * One ring buffer holds the samples of the longest window and serves all
+ * windows. The members up to nrOfWindows are configured, the others are set by
+ * MOVSTAT_Init(). The sums are kept in integers, so the statistics do not
+ * drift. The sum of squares is exact as long as the window length times the
+ * squared sample magnitude is below 2^64, e.g., |sample| < 7.8e7 for 3000
+ * samples.
+ */
+typedef struct {
+    int32_t *buffer;                /*!< ring buffer of the samples */
+    uint16_t bufferLength;          /*!< length of the ring buffer, at least the longest window */
+    uint32_t *dequeStorage;         /*!< storage of the deques, see MOVSTAT_DEQUE_STORAGE_LENGTH() */
+    uint32_t dequeStorageLength;    /*!< length of dequeStorage */
+    MOVSTAT_WINDOW_s *windows;      /*!< windows */
+    uint8_t nrOfWindows;            /*!< number of windows */
+    uint16_t head;                  /*!< ring buffer index of the next sample */
+    uint32_t sampleNr;              /*!< number of the next sample, wraps around */
+    uint16_t nrOfSamples;           /*!< number of samples in the ring buffer */
+    uint8_t initialized;            /*!< TRUE after successful MOVSTAT_Init() */
+} MOVSTAT_s;
+
+/**
+ * statistics of one window
+ */
+typedef struct {
+    float mean;         /*!< arithmetic mean */
+    float rms;          /*!< root mean square */
+    int32_t min;        /*!< minimum */
+    int32_t max;        /*!< maximum */
+    uint16_t count;     /*!< number of samples, less than the window length until the window is filled */
+} MOVSTAT_RESULT_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   checks the configuration, distributes the deque storage over the
+ *          windows and resets all statistics
+ *
+ * @param   stat    moving statistics to initialize
+ *
+ * @return  E_OK if the buffers are large enough for the windows, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e MOVSTAT_Init(MOVSTAT_s *stat);
+
+/**
+ * @brief   adds a sample to all windows
+ *
+ * The sums are updated in constant time per window, minimum and maximum in
+ * amortized constant time by monotonic deques.
+ *
+ * @param   stat    moving statistics
+ * @param   value   new sample
+ */
+extern void MOVSTAT_AddSample(MOVSTAT_s *stat, int32_t value);
+
+/**
+ * @brief   gets mean, RMS, minimum and maximum of a window
+ *
+ * @param   stat        moving statistics
+ * @param   windowIdx   index of the window
+ * @param   result      pointer where the statistics are written to
+ *
+ * @return  E_OK if the window contains samples, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e MOVSTAT_GetWindow(const MOVSTAT_s *stat, uint8_t windowIdx, MOVSTAT_RESULT_s *result);
+
+/*================== Function Implementations =============================*/
+
+#endif /* MOVSTAT_H_ */
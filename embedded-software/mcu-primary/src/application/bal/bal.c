@@ -57,7 +57,11 @@
 #include "bms.h"
 #include "database.h"
 #include "FreeRTOS.h"
+#include "foxmath.h"
+#include "nvramhandler.h"
 #include "sox.h"
+#include "sox_ekf.h"
+#include "sox_soh.h"
 #include "task.h"
 
 /*================== Macros and Definitions ===============================*/
@@ -68,11 +72,46 @@
 #define BAL_SAVELASTSTATES()    bal_state.laststate = bal_state.state; \
                                 bal_state.lastsubstate = bal_state.substate
 
+#if BALANCING_VOLTAGE_BASED == FALSE
+/**
+ * balancing resistance in mOhm, used for the integer calculation of the
+ * balancing current and power
+ */
+#define BAL_RESISTANCE_MOHM     ((uint32_t)(BS_BALANCING_RESISTANCE_OHM * 1000.0))
+
+/**
+ * value of BAL_GetModuleTemperature() if no temperature of the module is valid
+ */
+#define BAL_NO_VALID_TEMPERATURE    INT16_MIN
+#endif
 
 /*================== Constant and Variable Definitions ====================*/
 static DATA_BLOCK_MINMAX_s bal_minmax;
 static DATA_BLOCK_BALANCING_CONTROL_s bal_balancing;
 static DATA_BLOCK_CELLVOLTAGE_s bal_cellvoltage;
+#if BALANCING_VOLTAGE_BASED == FALSE
+static DATA_BLOCK_CELLTEMPERATURE_s bal_celltemperature;
+static DATA_BLOCK_BALANCING_FEEDBACK_s bal_feedback;
+/* discharged charge of the balancing feedback already subtracted from delta_charge, unit: mAs */
+static uint32_t bal_discharged_charge[BS_NR_OF_BAT_CELLS];
+/* remainder of the energy calculation per cell, unit: mAs*mV */
+static uint32_t bal_energy_remainder[BS_NR_OF_BAT_CELLS];
+/* charge and energy of each cell balanced since startup, kept in RAM only, unit: mAs and mJ */
+static uint32_t bal_cell_charge[BS_NR_OF_BAT_CELLS];
+static uint32_t bal_cell_energy[BS_NR_OF_BAT_CELLS];
+/* energy dissipated per module since the last update of the slave board temperature, unit: mJ */
+static uint32_t bal_module_energy[BS_NR_OF_MODULES];
+/* charge and energy per module not yet added to the statistics, unit: mAs and mJ */
+static uint32_t bal_statistics_charge_remainder[BS_NR_OF_MODULES];
+static uint32_t bal_statistics_energy_remainder[BS_NR_OF_MODULES];
+/* estimated temperature difference between slave board and cells per module, unit: mK */
+static int32_t bal_pcb_overtemperature[BS_NR_OF_MODULES];
+static uint32_t bal_pcb_timestamp = 0;
+static BAL_STATISTICS_s bal_statistics;
+static uint8_t bal_statistics_changed = FALSE;   /* backup SRAM not up to date */
+static uint8_t bal_statistics_unsaved = FALSE;   /* EEPROM not up to date */
+static uint32_t bal_statistics_timestamp = 0;
+#endif
 DATA_BLOCK_STATEREQUEST_s bal_request;
 
 /**
@@ -111,6 +150,14 @@ static uint8_t BAL_Activate_Balancing_Voltage(void);
 static uint8_t BAL_Check_Imbalances(void);
 static void BAL_Compute_Imbalances(void);
 static void BAL_Activate_Balancing_History(void);
+static STD_RETURN_TYPE_e BAL_GetCellSoc(uint16_t cellIdx, float *soc);
+static uint32_t BAL_GetModulePowerBudget(uint16_t module);
+static uint8_t BAL_IsCellSelectable(uint16_t cellIdx, uint16_t cellInModule);
+static void BAL_PlanModule(uint16_t module);
+static uint32_t BAL_GetDischargedCharge(uint16_t cellIdx);
+static int16_t BAL_GetModuleTemperature(uint16_t module);
+static void BAL_UpdatePcbTemperature(void);
+static void BAL_StoreStatistics(uint8_t force);
 #endif
 
 
@@ -119,6 +166,10 @@ static void BAL_Init(void) {
     DB_ReadBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
     bal_balancing.enable_balancing = 0;
     DB_WriteBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
+#if BALANCING_VOLTAGE_BASED == FALSE
+    /* statistics start from zero if the stored data is invalid */
+    (void)NVM_getBalancingStatistics(&bal_statistics);
+#endif
 }
 
 static void BAL_Deactivate(void) {
@@ -157,7 +208,7 @@ static uint8_t BAL_Activate_Balancing_Voltage(void) {
         if (bal_cellvoltage.voltage[i] > min+bal_state.balancing_threshold) {
             bal_balancing.balancing_state[i] = 1;
             finished = FALSE;
-            bal_state.balancing_threshold = BAL_THRESHOLD_MV;
+            bal_state.balancing_threshold = bal_threshold_mV;
             bal_state.active = TRUE;
             bal_balancing.enable_balancing = 1;
         } else {
@@ -189,37 +240,43 @@ static uint8_t BAL_Check_Imbalances(void) {
     return retVal;
 }
 
+/**
+ * @brief   computes the charge to be discharged from every cell
+ *
+ * The charge excess of a cell is the difference of its SOC to the lowest
+ * SOC of all cells multiplied with the estimated capacity. Cells closer than
+ * bal_threshold_soc to the lowest SOC and cells without valid voltage are
+ * not balanced. The SOC of a cell is taken from the cell model if available,
+ * otherwise from the open circuit voltage, so this function must be called
+ * while the battery system is at rest.
+ */
 static void BAL_Compute_Imbalances(void) {
     uint16_t i = 0;
-    uint16_t voltageMin = 0;
-    uint16_t minVoltageIndex = 0;
-    float SOC = 0.0;
-    uint32_t DOD = 0.0;
-    uint32_t maxDOD = 0.0;
+    float soc = 0.0f;
+    float socMin = 100.0f;
+    float excess = 0.0f;
+    /* SOC difference in % to charge in mAs: capacity in mAh * 3600 s/h / 100 % */
+    float chargePerSoc = SOX_SOH_GetCapacity() * 36.0f;
 
     DB_ReadBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
     DB_ReadBlock(&bal_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
-
-    voltageMin = bal_cellvoltage.voltage[0];
-    minVoltageIndex = 0;
+    DB_ReadBlock(&bal_feedback, DATA_BLOCK_ID_BALANCING_FEEDBACK_VALUES);
 
     for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
-        if (bal_cellvoltage.voltage[i] <= voltageMin) {
-            voltageMin = bal_cellvoltage.voltage[i];
-            minVoltageIndex = i;
+        /* charge discharged before is already contained in the SOC */
+        (void)BAL_GetDischargedCharge(i);
+        if ((BAL_GetCellSoc(i, &soc) == E_OK) && (soc < socMin)) {
+            socMin = soc;
         }
     }
 
-    SOC = SOC_GetFromVoltage(((float)(bal_cellvoltage.voltage[minVoltageIndex]))/1000.0);
-    maxDOD = BC_CAPACITY * (uint32_t)((1.0 - SOC) * 3600.0);
-    bal_balancing.delta_charge[minVoltageIndex] = 0;
-
     for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
-        if (i != minVoltageIndex) {
-            if (bal_cellvoltage.voltage[i] >= voltageMin + bal_state.balancing_threshold) {
-                SOC = SOC_GetFromVoltage(((float)(bal_cellvoltage.voltage[i]))/1000.0);
-                DOD = BC_CAPACITY * (uint32_t)((1.0 - SOC) * 3600.0);
-                bal_balancing.delta_charge[i] = (maxDOD - DOD);
+        bal_balancing.delta_charge[i] = 0;
+        if (BAL_GetCellSoc(i, &soc) == E_OK) {
+            if ((soc - socMin) >= bal_threshold_soc) {
+                /* rounded, not truncated */
+                excess = (soc - socMin) * chargePerSoc + 0.5f;
+                bal_balancing.delta_charge[i] = (uint32_t)excess;
             }
         }
     }
@@ -227,37 +284,342 @@ static void BAL_Compute_Imbalances(void) {
     DB_WriteBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
 }
 
+/**
+ * @brief   plans the cells balanced in the next balancing period
+ *
+ * The charge the LTC driver accounted as discharged since the last call is
+ * subtracted from the excess of every cell, then each module is planned on
+ * its own.
+ */
 static void BAL_Activate_Balancing_History(void) {
     uint16_t i;
-    float cellBalancingCurrent;
     uint32_t difference;
 
     DB_ReadBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
     DB_ReadBlock(&bal_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+    DB_ReadBlock(&bal_celltemperature, DATA_BLOCK_ID_CELLTEMPERATURE);
+    DB_ReadBlock(&bal_feedback, DATA_BLOCK_ID_BALANCING_FEEDBACK_VALUES);
 
     for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
-        if (bal_state.balancing_allowed == FALSE) {
-            bal_balancing.balancing_state[i] = 0;
+        difference = BAL_GetDischargedCharge(i);
+        /* we are working with unsigned integers */
+        if (difference > bal_balancing.delta_charge[i]) {
+            bal_balancing.delta_charge[i] = 0;
         } else {
-            if (bal_balancing.delta_charge[i] > 0) {
-                bal_balancing.balancing_state[i] = 1;
-                cellBalancingCurrent = ((float)(bal_cellvoltage.voltage[i]))/BS_BALANCING_RESISTANCE_OHM;
-                difference = (BAL_STATEMACH_BALANCINGTIME_100MS/10) * (uint32_t)(cellBalancingCurrent);
-                bal_state.active = TRUE;
-                bal_balancing.enable_balancing = 1;
-                /* we are working with unsigned integers */
-                if (difference > bal_balancing.delta_charge[i]) {
-                    bal_balancing.delta_charge[i] = 0;
-                } else {
-                bal_balancing.delta_charge[i] -= difference;
-                }
+            bal_balancing.delta_charge[i] -= difference;
+        }
+    }
+
+    BAL_UpdatePcbTemperature();
+    BAL_StoreStatistics(FALSE);
+
+    for (i=0; i < BS_NR_OF_MODULES; i++) {
+        BAL_PlanModule(i);
+    }
+
+    for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
+        if (bal_balancing.balancing_state[i] == 1) {
+            bal_state.active = TRUE;
+            bal_balancing.enable_balancing = 1;
+        }
+    }
+
+    DB_WriteBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
+}
+
+/**
+ * @brief   gets the charge discharged by one cell since the last call
+ *
+ * The LTC driver accounts the discharged charge per cell as free running
+ * counter in the balancing feedback, so the difference is also valid after a
+ * wrap around. The charge and the dissipated energy E[mJ] = Q[mAs] * U[mV] / 1000
+ * are added to the totals of the cell in RAM and to the statistics and the
+ * energy of the module of the cell.
+ * bal_feedback and bal_cellvoltage have to be read from the database before.
+ *
+ * @param   cellIdx     index of the cell
+ *
+ * @return  discharged charge in mAs
+ */
+static uint32_t BAL_GetDischargedCharge(uint16_t cellIdx) {
+    uint32_t charge = bal_feedback.discharged_charge[cellIdx] - bal_discharged_charge[cellIdx];
+    uint64_t energy = 0;
+    uint16_t module = cellIdx / BS_NR_OF_BAT_CELLS_PER_MODULE;
+
+    bal_discharged_charge[cellIdx] = bal_feedback.discharged_charge[cellIdx];
+    if (charge > 0) {
+        energy = (uint64_t)charge * bal_cellvoltage.voltage[cellIdx] + bal_energy_remainder[cellIdx];
+        bal_energy_remainder[cellIdx] = (uint32_t)(energy % 1000u);
+        energy = energy / 1000u;
+
+        bal_cell_charge[cellIdx] += charge;
+        bal_cell_energy[cellIdx] += (uint32_t)energy;
+        bal_module_energy[module] += (uint32_t)energy;
+
+        bal_statistics_charge_remainder[module] += charge;
+        bal_statistics_energy_remainder[module] += (uint32_t)energy;
+        if ((bal_statistics_charge_remainder[module] >= 1000u) || (bal_statistics_energy_remainder[module] >= 1000u)) {
+            bal_statistics.charge_As[module] += bal_statistics_charge_remainder[module] / 1000u;
+            bal_statistics.energy_J[module] += bal_statistics_energy_remainder[module] / 1000u;
+            bal_statistics_charge_remainder[module] %= 1000u;
+            bal_statistics_energy_remainder[module] %= 1000u;
+            bal_statistics_changed = TRUE;
+        }
+    }
+    return charge;
+}
+
+/**
+ * @brief   updates the estimated slave board temperature of every module
+ *
+ * The power dissipated since the last call is computed from the energy of the
+ * module. The temperature difference between slave board and cells follows
+ * the steady state value P * BAL_PCB_THERMAL_RESISTANCE_K_PER_W with the
+ * first order time constant BAL_PCB_THERMAL_TIME_CONSTANT_MS.
+ *
+ * The filter coefficient is computed once per call in Q31, so the filter of
+ * each module needs a multiplication instead of a 64 bit division.
+ */
+static void BAL_UpdatePcbTemperature(void) {
+    uint16_t i = 0;
+    uint32_t timestamp = OS_getOSSysTick();
+    uint32_t elapsed_ms = timestamp - bal_pcb_timestamp;
+    uint32_t power_mW = 0;
+    int32_t target_mK = 0;
+    int32_t alpha = MATH_Q31_MAX;
+    int16_t temperature = 0;
+    int16_t pcbTemperature = 0;
+
+    bal_pcb_timestamp = timestamp;
+
+    /* filter coefficient elapsed_ms / BAL_PCB_THERMAL_TIME_CONSTANT_MS in Q31 */
+    if (elapsed_ms < BAL_PCB_THERMAL_TIME_CONSTANT_MS) {
+        alpha = (int32_t)(((uint64_t)elapsed_ms << 31) / BAL_PCB_THERMAL_TIME_CONSTANT_MS);
+    }
+
+    for (i=0; i < BS_NR_OF_MODULES; i++) {
+        power_mW = 0;
+        if (elapsed_ms > 0) {
+            power_mW = (uint32_t)(((uint64_t)bal_module_energy[i] * 1000u) / elapsed_ms);
+        }
+        bal_module_energy[i] = 0;
+
+        /* K/W is equal to mK/mW */
+        target_mK = (int32_t)(power_mW * BAL_PCB_THERMAL_RESISTANCE_K_PER_W);
+        bal_pcb_overtemperature[i] = MATH_addSat_q31(bal_pcb_overtemperature[i],
+                MATH_mulSat_q31(MATH_subSat_q31(target_mK, bal_pcb_overtemperature[i]), alpha));
+
+        temperature = BAL_GetModuleTemperature(i);
+        if (temperature != BAL_NO_VALID_TEMPERATURE) {
+            pcbTemperature = temperature + (int16_t)(bal_pcb_overtemperature[i] / 1000);
+            if (pcbTemperature > bal_statistics.max_pcb_temperature[i]) {
+                bal_statistics.max_pcb_temperature[i] = pcbTemperature;
+                bal_statistics_changed = TRUE;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   stores the balancing statistics in the nonvolatile memory
+ *
+ * The backup SRAM is updated each time the statistics changed, the EEPROM
+ * every BAL_STATISTICS_STORE_PERIOD_MS while balancing or when requested.
+ *
+ * @param   force   TRUE to request the EEPROM write regardless of the period
+ */
+static void BAL_StoreStatistics(uint8_t force) {
+    uint32_t timestamp = OS_getOSSysTick();
+
+    if (bal_statistics_changed == TRUE) {
+        bal_statistics_changed = FALSE;
+        bal_statistics_unsaved = TRUE;
+        NVM_setBalancingStatistics(&bal_statistics);
+    }
+    if ((bal_statistics_unsaved == TRUE) &&
+        ((force == TRUE) || ((timestamp - bal_statistics_timestamp) >= BAL_STATISTICS_STORE_PERIOD_MS))) {
+        bal_statistics_unsaved = FALSE;
+        bal_statistics_timestamp = timestamp;
+        NVRAM_setWriteRequest(NVRAM_BLOCK_ID_BALANCING);
+    }
+}
+
+/**
+ * @brief   selects the cells of one module to balance in the next balancing period
+ *
+ * Greedy schedule: the cell with the largest remaining charge excess is
+ * selected first, as long as the module limits allow it. The time until the
+ * last cell is balanced is determined by the largest excess, so discharging
+ * the largest excesses first minimizes the total balancing time. The work is
+ * bounded by BAL_MAX_CELLS_PER_MODULE * BS_NR_OF_BAT_CELLS_PER_MODULE.
+ *
+ * @param   module  index of the module
+ */
+static void BAL_PlanModule(uint16_t module) {
+    uint16_t first = module * BS_NR_OF_BAT_CELLS_PER_MODULE;
+    uint16_t i = 0;
+    uint16_t selected = 0;
+    uint16_t nrOfSelected = 0;
+    uint32_t maxCharge = 0;
+    uint32_t budget_mW = BAL_GetModulePowerBudget(module);
+    uint32_t power_mW = 0;
+    uint32_t cellPower_mW = 0;
+    uint8_t planning = TRUE;
+
+    for (i=0; i < BS_NR_OF_BAT_CELLS_PER_MODULE; i++) {
+        bal_balancing.balancing_state[first + i] = 0;
+    }
+    if (bal_state.balancing_allowed == FALSE) {
+        planning = FALSE;
+    }
+
+    while ((planning == TRUE) && (nrOfSelected < BAL_MAX_CELLS_PER_MODULE)) {
+        maxCharge = 0;
+        selected = BS_NR_OF_BAT_CELLS_PER_MODULE;
+        for (i=0; i < BS_NR_OF_BAT_CELLS_PER_MODULE; i++) {
+            if ((bal_balancing.delta_charge[first + i] > maxCharge) && (BAL_IsCellSelectable(first + i, i) == TRUE)) {
+                maxCharge = bal_balancing.delta_charge[first + i];
+                selected = i;
+            }
+        }
+
+        if (selected == BS_NR_OF_BAT_CELLS_PER_MODULE) {
+            /* no further cell to balance */
+            planning = FALSE;
+        } else {
+            /* P[mW] = U[mV]^2 / R[mOhm] */
+            cellPower_mW = ((uint32_t)bal_cellvoltage.voltage[first + selected] * bal_cellvoltage.voltage[first + selected]) / BAL_RESISTANCE_MOHM;
+            if ((power_mW + cellPower_mW) > budget_mW) {
+                planning = FALSE;
             } else {
-                bal_balancing.balancing_state[i] = 0;
+                bal_balancing.balancing_state[first + selected] = 1;
+                power_mW += cellPower_mW;
+                nrOfSelected++;
             }
         }
     }
+}
 
-    DB_WriteBlock(&bal_balancing, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
+/**
+ * @brief   checks if a cell can be added to the cells balanced in the next period
+ *
+ * @param   cellIdx         index of the cell in the battery system
+ * @param   cellInModule    index of the cell in its module
+ *
+ * @return  TRUE if the cell has a valid voltage, is not selected yet and, if
+ *          BAL_ADJACENT_CELLS_ALLOWED is FALSE, no neighbor is selected
+ */
+static uint8_t BAL_IsCellSelectable(uint16_t cellIdx, uint16_t cellInModule) {
+    uint8_t retVal = TRUE;
+    uint16_t module = cellIdx / BS_NR_OF_BAT_CELLS_PER_MODULE;
+
+    if (bal_balancing.balancing_state[cellIdx] == 1) {
+        retVal = FALSE;
+    }
+    if ((bal_cellvoltage.valid_volt[module] & (1u << cellInModule)) != 0) {
+        retVal = FALSE;
+    }
+#if BAL_ADJACENT_CELLS_ALLOWED == FALSE
+    if ((cellInModule > 0) && (bal_balancing.balancing_state[cellIdx - 1] == 1)) {
+        retVal = FALSE;
+    }
+    if ((cellInModule < (BS_NR_OF_BAT_CELLS_PER_MODULE - 1)) && (bal_balancing.balancing_state[cellIdx + 1] == 1)) {
+        retVal = FALSE;
+    }
+#endif
+    return retVal;
+}
+
+/**
+ * @brief   computes the balancing power allowed for one module
+ *
+ * The power is BAL_MAX_MODULE_POWER_MW up to BAL_DERATING_TEMPERATURE_DEG and
+ * decreases linearly to zero at BAL_UPPER_TEMPERATURE_LIMIT_DEG, based on the
+ * highest valid temperature of the module. It is also reduced linearly between
+ * BAL_PCB_DERATING_TEMPERATURE_DEG and BAL_PCB_MAX_TEMPERATURE_DEG of the
+ * estimated slave board temperature, the lower of both limits applies.
+ *
+ * @param   module  index of the module
+ *
+ * @return  allowed power in mW
+ */
+static uint32_t BAL_GetModulePowerBudget(uint16_t module) {
+    int16_t maxTemperature = BAL_GetModuleTemperature(module);
+    int32_t pcbTemperature_mK = 0;
+    uint32_t budget_mW = BAL_MAX_MODULE_POWER_MW;
+    uint32_t pcbBudget_mW = BAL_MAX_MODULE_POWER_MW;
+
+    if (maxTemperature >= BAL_UPPER_TEMPERATURE_LIMIT_DEG) {
+        budget_mW = 0;
+    } else if (maxTemperature > BAL_DERATING_TEMPERATURE_DEG) {
+        budget_mW = (BAL_MAX_MODULE_POWER_MW * (uint32_t)(BAL_UPPER_TEMPERATURE_LIMIT_DEG - maxTemperature)) /
+                    (uint32_t)(BAL_UPPER_TEMPERATURE_LIMIT_DEG - BAL_DERATING_TEMPERATURE_DEG);
+    }
+
+    /* without valid temperature, the cells are assumed at the derating temperature */
+    if (maxTemperature == BAL_NO_VALID_TEMPERATURE) {
+        maxTemperature = BAL_DERATING_TEMPERATURE_DEG;
+    }
+    pcbTemperature_mK = (int32_t)maxTemperature * 1000 + bal_pcb_overtemperature[module];
+    if (pcbTemperature_mK >= (BAL_PCB_MAX_TEMPERATURE_DEG * 1000)) {
+        pcbBudget_mW = 0;
+    } else if (pcbTemperature_mK > (BAL_PCB_DERATING_TEMPERATURE_DEG * 1000)) {
+        pcbBudget_mW = (BAL_MAX_MODULE_POWER_MW * (uint32_t)((BAL_PCB_MAX_TEMPERATURE_DEG * 1000) - pcbTemperature_mK)) /
+                       (uint32_t)((BAL_PCB_MAX_TEMPERATURE_DEG - BAL_PCB_DERATING_TEMPERATURE_DEG) * 1000);
+    }
+
+    if (pcbBudget_mW < budget_mW) {
+        budget_mW = pcbBudget_mW;
+    }
+    return budget_mW;
+}
+
+/**
+ * @brief   gets the highest valid temperature of one module
+ *
+ * @param   module  index of the module
+ *
+ * @return  temperature in Celsius, BAL_NO_VALID_TEMPERATURE if no sensor is valid
+ */
+static int16_t BAL_GetModuleTemperature(uint16_t module) {
+    uint16_t i = 0;
+    int16_t temperature = 0;
+    int16_t maxTemperature = BAL_NO_VALID_TEMPERATURE;
+
+    for (i=0; i < BS_NR_OF_TEMP_SENSORS_PER_MODULE; i++) {
+        if ((bal_celltemperature.valid_temperature[module] & (1u << i)) == 0) {
+            temperature = bal_celltemperature.temperature[module * BS_NR_OF_TEMP_SENSORS_PER_MODULE + i];
+            if (temperature > maxTemperature) {
+                maxTemperature = temperature;
+            }
+        }
+    }
+    return maxTemperature;
+}
+
+/**
+ * @brief   gets the SOC of one cell
+ *
+ * @param   cellIdx     index of the cell
+ * @param   soc         pointer where the SOC in % is written to
+ *
+ * @return  E_OK if the voltage of the cell is valid, otherwise E_NOT_OK
+ */
+static STD_RETURN_TYPE_e BAL_GetCellSoc(uint16_t cellIdx, float *soc) {
+    STD_RETURN_TYPE_e retVal = E_OK;
+    uint16_t module = cellIdx / BS_NR_OF_BAT_CELLS_PER_MODULE;
+    uint16_t cellInModule = cellIdx % BS_NR_OF_BAT_CELLS_PER_MODULE;
+    float v1 = 0.0f;
+    float v2 = 0.0f;
+
+    if ((bal_cellvoltage.valid_volt[module] & (1u << cellInModule)) != 0) {
+        retVal = E_NOT_OK;
+    } else if (SOX_EKF_GetCellState(cellIdx, soc, &v1, &v2) == E_OK) {
+        *soc = *soc * 100.0f;
+    } else {
+        *soc = SOC_GetFromVoltage(bal_cellvoltage.voltage[cellIdx]);
+    }
+    return retVal;
 }
 
 #endif
@@ -319,6 +681,20 @@ STD_RETURN_TYPE_e BAL_GetInitializationState(void) {
 }
 
 
+STD_RETURN_TYPE_e BAL_GetCellStatistics(uint16_t cellIdx, uint32_t *charge_mAs, uint32_t *energy_mJ) {
+#if BALANCING_VOLTAGE_BASED == FALSE
+    if (cellIdx < BS_NR_OF_BAT_CELLS) {
+        *charge_mAs = bal_cell_charge[cellIdx];
+        *energy_mJ = bal_cell_energy[cellIdx];
+        return E_OK;
+    }
+#endif
+    *charge_mAs = 0;
+    *energy_mJ = 0;
+    return E_NOT_OK;
+}
+
+
 /**
  * @brief   transfers the current state request to the state machine.
  *
@@ -402,7 +778,9 @@ static BAL_RETURN_TYPE_e BAL_CheckStateRequest(BAL_STATE_REQUEST_e statereq) {
 
 void BAL_Trigger(void) {
     BAL_STATE_REQUEST_e statereq = BAL_STATE_NO_REQUEST;
+#if BALANCING_VOLTAGE_BASED == TRUE
     uint8_t finished = FALSE;
+#endif
 
     /* Check re-entrance of function */
     if (BAL_CheckReEntrance()) {
@@ -462,6 +840,14 @@ void BAL_Trigger(void) {
         case BAL_STATEMACH_CHECK_BALANCING:
             BAL_SAVELASTSTATES();
 
+            statereq = BAL_TransferStateRequest();
+            if (statereq == BAL_STATE_NOBALANCING_REQUEST) {
+                bal_state.balancing_allowed = FALSE;
+            }
+            if (statereq == BAL_STATE_ALLOWBALANCING_REQUEST) {
+                bal_state.balancing_allowed = TRUE;
+            }
+
             if (bal_state.substate == BAL_ENTRY) {
                 if (bal_state.balancing_global_allowed == FALSE) {
                     if (bal_state.active == TRUE) {
@@ -483,6 +869,8 @@ void BAL_Trigger(void) {
                     bal_state.state = BAL_STATEMACH_BALANCE;
                     bal_state.substate = BAL_ENTRY;
                 } else {
+                    /* balancing finished */
+                    BAL_StoreStatistics(TRUE);
                     bal_state.substate = BAL_COMPUTE_IMBALANCES;
                 }
                 bal_state.timer = BAL_STATEMACH_SHORTTIME_100MS;
@@ -505,13 +893,23 @@ void BAL_Trigger(void) {
             case BAL_STATEMACH_BALANCE:
                 BAL_SAVELASTSTATES();
 
+                /* Check if balancing is still allowed */
+                statereq = BAL_TransferStateRequest();
+                if (statereq == BAL_STATE_NOBALANCING_REQUEST) {
+                    bal_state.balancing_allowed = FALSE;
+                }
+                if (statereq == BAL_STATE_ALLOWBALANCING_REQUEST) {
+                    bal_state.balancing_allowed = TRUE;
+                }
+
                 if (bal_state.substate == BAL_ENTRY) {
                     if (bal_state.balancing_global_allowed == FALSE) {
                         if (bal_state.active == TRUE) {
                             BAL_Deactivate();
                         }
                         bal_state.active = FALSE;
-                        bal_state.substate = BAL_STATEMACH_CHECK_BALANCING;
+                        bal_state.state = BAL_STATEMACH_CHECK_BALANCING;
+                        bal_state.substate = BAL_ENTRY;
                     } else {
                         bal_state.substate = BAL_ACTIVATE_BALANCING;
                     }
@@ -640,7 +1038,7 @@ void BAL_Trigger(void) {
                 } else {
                     finished = BAL_Activate_Balancing_Voltage();
                     if (finished == TRUE) {
-                        bal_state.balancing_threshold = BAL_THRESHOLD_MV + BAL_HYSTERESIS_MV;
+                        bal_state.balancing_threshold = bal_threshold_mV + bal_hysteresis_mV;
                         bal_state.state = BAL_STATEMACH_CHECK_BALANCING;
                         bal_state.substate = BAL_ENTRY;
                     } else {
@@ -56,8 +56,21 @@
 /*================== Includes =============================================*/
 #include "bal_cfg.h"
 
+#include "batterysystem_cfg.h"
+
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * balancing statistics accumulated over the lifetime of the battery system.
+ * Stored in the nonvolatile memory, so the totals are kept per module and
+ * in As and J to fit one EEPROM channel also for large battery systems.
+ */
+typedef struct {
+    uint32_t charge_As[BS_NR_OF_MODULES];               /*!< charge discharged by the balancing resistors of each module in As */
+    uint32_t energy_J[BS_NR_OF_MODULES];                /*!< energy dissipated by the balancing resistors of each module in J */
+    int16_t max_pcb_temperature[BS_NR_OF_MODULES];      /*!< highest estimated slave board temperature of each module in Celsius */
+} BAL_STATISTICS_s;
+
 /*================== Constant and Variable Definitions ====================*/
 
 /*================== Function Prototypes ==================================*/
@@ -188,6 +201,20 @@ extern  BAL_STATEMACH_e BAL_GetState(void);
  */
 extern  STD_RETURN_TYPE_e BAL_GetInitializationState(void);
 
+/**
+ * @brief   gets the charge and energy balanced on one cell since startup.
+ *
+ * The per cell totals are kept in RAM only, the nonvolatile statistics
+ * (BAL_STATISTICS_s) hold the totals per module.
+ *
+ * @param   cellIdx     index of the cell
+ * @param   charge_mAs  pointer where the discharged charge in mAs is written to
+ * @param   energy_mJ   pointer where the dissipated energy in mJ is written to
+ *
+ * @return  E_OK if the cell index is valid and the balancing is charge based, otherwise E_NOT_OK
+ */
+extern STD_RETURN_TYPE_e BAL_GetCellStatistics(uint16_t cellIdx, uint32_t *charge_mAs, uint32_t *energy_mJ);
+
 /**
  * @brief   trigger function for the BAL driver state machine.
  *
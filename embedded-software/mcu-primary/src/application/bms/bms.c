@@ -53,6 +53,7 @@
 /*================== Includes =============================================*/
 #include "bms.h"
 
+#include "algo_cfg.h"
 #include "bal.h"
 #include "batterycell_cfg.h"
 #include "batterysystem_cfg.h"
@@ -60,7 +61,9 @@
 #include "diag.h"
 #include "interlock.h"
 #include "ltc_cfg.h"
+#include "lut.h"
 #include "meas.h"
+#include "movstat.h"
 #include "os.h"
 #include "plausibility.h"
 
@@ -73,6 +76,51 @@
 #define BMS_SAVELASTSTATES()    bms_state.laststate = bms_state.state; \
                                 bms_state.lastsubstate = bms_state.substate;
 
+#if BS_NR_OF_FUSE_CURVE_POINTS != 4
+#error "Fuse curve windows in bms.c do not match BS_NR_OF_FUSE_CURVE_POINTS"
+#endif
+
+/**
+ * number of current samples in a window of the fuse curve
+ */
+#define BMS_FUSE_WINDOW_LENGTH(window_ms)   ((window_ms) / ISA_CURRENT_CYCLE_TIME_MS)
+
+#define BMS_FUSE_BUFFER_LENGTH              BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_3_MS)
+#define BMS_FUSE_WINDOWS_LENGTH             (BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_0_MS) + \
+                                             BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_1_MS) + \
+                                             BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_2_MS) + \
+                                             BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_3_MS))
+
+/**
+ * I2t in A^2.s of percent of the limit current over a whole window
+ */
+#define BMS_FUSE_I2T(current_mA, window_ms, percent) \
+    (((float)(current_mA) * (float)(percent) / 100000.0f) * \
+     ((float)(current_mA) * (float)(percent) / 100000.0f) * ((float)(window_ms) / 1000.0f))
+
+/**
+ * I2t of the recommended safety limit and the maximum operating limit in
+ * relation to the I2t of the fuse curve
+ */
+#define BMS_FUSE_RSL_FACTOR     ((float)(BS_FUSE_CURVE_RSL_PERCENT * BS_FUSE_CURVE_RSL_PERCENT) / 10000.0f)
+#define BMS_FUSE_MOL_FACTOR     ((float)(BS_FUSE_CURVE_MOL_PERCENT * BS_FUSE_CURVE_MOL_PERCENT) / 10000.0f)
+
+/**
+ * point of the fuse curve
+ */
+typedef struct {
+    float window_ms;    /*!< unit: ms, length of the window */
+    float i2t;          /*!< unit: A^2.s, I2t of the limit current over the whole window */
+} BMS_FUSE_CURVE_POINT_s;
+
+#if BS_CHECK_FUSE_CURVE == TRUE
+/**
+ * maximum safety limit of the I2t over a time in ms, interpolated linearly
+ * between the points of the fuse curve
+ */
+LUT_DEFINE_SEARCH_FLOAT(BMS_GetFuseI2tLimit, BMS_FUSE_CURVE_POINT_s, .window_ms, .i2t, LUT_CLAMP)
+#endif /* BS_CHECK_FUSE_CURVE == TRUE */
+
 /*================== Constant and Variable Definitions ====================*/
 
 /**
@@ -99,6 +147,38 @@ static DATA_BLOCK_MINMAX_s bms_tab_minmax;
 static DATA_BLOCK_OPENWIRE_s bms_ow_tab;
 static DATA_BLOCK_SOF_s bms_tab_sof;
 
+/* Ring buffer and deques in extern SDRAM for the windows of the fuse curve (current in mA) */
+static int32_t MEM_EXT_SDRAM bms_fuseCurrents[BMS_FUSE_BUFFER_LENGTH];
+static uint32_t MEM_EXT_SDRAM bms_fuseDeques[MOVSTAT_DEQUE_STORAGE_LENGTH(BMS_FUSE_WINDOWS_LENGTH)];
+
+static MOVSTAT_WINDOW_s bms_fuseWindows[BS_NR_OF_FUSE_CURVE_POINTS] = {
+    {.length = BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_0_MS)},
+    {.length = BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_1_MS)},
+    {.length = BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_2_MS)},
+    {.length = BMS_FUSE_WINDOW_LENGTH(BS_FUSE_CURVE_WINDOW_3_MS)},
+};
+
+static MOVSTAT_s bms_fuseCurrent = {
+    .buffer = bms_fuseCurrents,
+    .bufferLength = BMS_FUSE_BUFFER_LENGTH,
+    .dequeStorage = bms_fuseDeques,
+    .dequeStorageLength = MOVSTAT_DEQUE_STORAGE_LENGTH(BMS_FUSE_WINDOWS_LENGTH),
+    .windows = bms_fuseWindows,
+    .nrOfWindows = BS_NR_OF_FUSE_CURVE_POINTS,
+};
+
+/* Time in ms since the last sample was added to the windows of the fuse curve */
+static uint32_t bms_fuseElapsed_ms = 0;
+
+#if BS_CHECK_FUSE_CURVE == TRUE
+static const BMS_FUSE_CURVE_POINT_s bms_fuseCurve[BS_NR_OF_FUSE_CURVE_POINTS] = {
+    {(float)BS_FUSE_CURVE_WINDOW_0_MS, BMS_FUSE_I2T(BS_FUSE_CURVE_CURRENT_0_mA, BS_FUSE_CURVE_WINDOW_0_MS, 100u)},
+    {(float)BS_FUSE_CURVE_WINDOW_1_MS, BMS_FUSE_I2T(BS_FUSE_CURVE_CURRENT_1_mA, BS_FUSE_CURVE_WINDOW_1_MS, 100u)},
+    {(float)BS_FUSE_CURVE_WINDOW_2_MS, BMS_FUSE_I2T(BS_FUSE_CURVE_CURRENT_2_mA, BS_FUSE_CURVE_WINDOW_2_MS, 100u)},
+    {(float)BS_FUSE_CURVE_WINDOW_3_MS, BMS_FUSE_I2T(BS_FUSE_CURVE_CURRENT_3_mA, BS_FUSE_CURVE_WINDOW_3_MS, 100u)},
+};
+#endif /* BS_CHECK_FUSE_CURVE == TRUE */
+
 
 /*================== Function Prototypes ==================================*/
 
@@ -113,6 +193,9 @@ static void BMS_GetMeasurementValues(void);
 static void BMS_CheckVoltages(void);
 static void BMS_CheckTemperatures(void);
 static void BMS_CheckCurrent(void);
+#if BS_CHECK_FUSE_CURVE == TRUE
+static void BMS_CheckFuseCurve(void);
+#endif /* BS_CHECK_FUSE_CURVE == TRUE */
 static void BMS_CheckSlaveTemperatures(void);
 static void BMS_CheckOpenSenseWire(void);
 
@@ -1229,8 +1312,71 @@ static void BMS_CheckCurrent(void) {
         DIAG_Handler(DIAG_CH_OVERCURRENT_DISCHARGE_CELL_MOL, DIAG_EVENT_OK, 0);
     }
 #endif /* MEAS_TEST_CELL_SOF_LIMITS == TRUE */
+
+#if BS_CHECK_FUSE_CURVE == TRUE
+    BMS_CheckFuseCurve();
+#endif /* BS_CHECK_FUSE_CURVE == TRUE */
 }
 
+#if BS_CHECK_FUSE_CURVE == TRUE
+/**
+ * @brief   checks the current against the fuse curve
+ *
+ * @details The I2t over each window of the fuse curve is compared against the
+ *          I2t limit of the time the window covers, interpolated on the fuse
+ *          curve. A full window is thereby checked against its own point of
+ *          the curve, a window that is still filled after startup against
+ *          the limit of the shorter time. The worst window sets the events.
+ */
+static void BMS_CheckFuseCurve(void) {
+    uint8_t msl_violated = FALSE;
+    uint8_t rsl_violated = FALSE;
+    uint8_t mol_violated = FALSE;
+    float limit = 0.0f;
+
+    for (uint8_t i = 0; i < BS_NR_OF_FUSE_CURVE_POINTS; i++) {
+        if (bms_tab_cur_sensor.current_window_ms[i] == 0) {
+            continue;
+        }
+        limit = BMS_GetFuseI2tLimit(bms_fuseCurve, BS_NR_OF_FUSE_CURVE_POINTS, (float)bms_tab_cur_sensor.current_window_ms[i]);
+        if (bms_tab_cur_sensor.current_i2t[i] >= limit) {
+            msl_violated = TRUE;
+        }
+        if (bms_tab_cur_sensor.current_i2t[i] >= (limit * BMS_FUSE_RSL_FACTOR)) {
+            rsl_violated = TRUE;
+        }
+        if (bms_tab_cur_sensor.current_i2t[i] >= (limit * BMS_FUSE_MOL_FACTOR)) {
+            mol_violated = TRUE;
+        }
+    }
+
+    if (mol_violated == TRUE) {
+        /* Fuse curve maximum operating limit violated */
+        DIAG_Handler(DIAG_CH_FUSE_OVERLOAD_MOL, DIAG_EVENT_NOK, 0);
+        if (rsl_violated == TRUE) {
+            /* Fuse curve recommended safety limit violated */
+            DIAG_Handler(DIAG_CH_FUSE_OVERLOAD_RSL, DIAG_EVENT_NOK, 0);
+            if (msl_violated == TRUE) {
+                /* Fuse curve maximum safety limit violated */
+                DIAG_Handler(DIAG_CH_FUSE_OVERLOAD_MSL, DIAG_EVENT_NOK, 0);
+            }
+        }
+    }
+    if (msl_violated == FALSE) {
+        /* Fuse curve maximum safety limit NOT violated */
+        DIAG_Handler(DIAG_CH_FUSE_OVERLOAD_MSL, DIAG_EVENT_OK, 0);
+        if (rsl_violated == FALSE) {
+            /* Fuse curve recommended safety limit NOT violated */
+            DIAG_Handler(DIAG_CH_FUSE_OVERLOAD_RSL, DIAG_EVENT_OK, 0);
+            if (mol_violated == FALSE) {
+                /* Fuse curve maximum operating limit NOT violated */
+                DIAG_Handler(DIAG_CH_FUSE_OVERLOAD_MOL, DIAG_EVENT_OK, 0);
+            }
+        }
+    }
+}
+#endif /* BS_CHECK_FUSE_CURVE == TRUE */
+
 /**
  * @brief   FOR FUTURE COMPATIBILITY; DUMMY FUNCTION; DO NOT USE
  *
@@ -1295,7 +1441,11 @@ static STD_RETURN_TYPE_e BMS_CheckAnyErrorFlagSet(void) {
         msl_flags.over_temperature_charge     == 1 ||
         msl_flags.over_temperature_discharge  == 1 ||
         msl_flags.under_temperature_charge    == 1 ||
-        msl_flags.under_temperature_discharge == 1) {
+        msl_flags.under_temperature_discharge == 1
+#if BS_CHECK_FUSE_CURVE == TRUE
+        || msl_flags.fuse_overload            == 1
+#endif /* BS_CHECK_FUSE_CURVE == TRUE */
+        ) {
         /* error detected */
         retVal = E_NOT_OK;
     }
@@ -1383,3 +1533,44 @@ static void BMS_UpdateBatsysState(DATA_BLOCK_CURRENT_SENSOR_s *curSensor) {
 BMS_CURRENT_FLOW_STATE_e BMS_GetBatterySystemState(void) {
     return bms_state.currentFlowState;
 }
+
+
+void BMS_AddCurrentSample(DATA_BLOCK_CURRENT_SENSOR_s *curSensor) {
+    MOVSTAT_RESULT_s window;
+    uint32_t nrOfSamples = 0;
+
+    if (bms_fuseCurrent.initialized == FALSE) {
+        (void)MOVSTAT_Init(&bms_fuseCurrent);
+    }
+
+    /* Time of invalid measurements is accumulated and weighted with the next valid one */
+    bms_fuseElapsed_ms += curSensor->timestep_cur;
+    if (curSensor->state_current != 0) {
+        return;
+    }
+
+    /* The windows hold one sample per sensor cycle, a longer interval is filled with the new sample */
+    nrOfSamples = bms_fuseElapsed_ms / ISA_CURRENT_CYCLE_TIME_MS;
+    bms_fuseElapsed_ms -= nrOfSamples * ISA_CURRENT_CYCLE_TIME_MS;
+    if (nrOfSamples > BMS_FUSE_BUFFER_LENGTH) {
+        nrOfSamples = BMS_FUSE_BUFFER_LENGTH;
+    }
+    for (uint32_t i = 0; i < nrOfSamples; i++) {
+        MOVSTAT_AddSample(&bms_fuseCurrent, curSensor->current);
+    }
+
+    for (uint8_t i = 0; i < BS_NR_OF_FUSE_CURVE_POINTS; i++) {
+        if (MOVSTAT_GetWindow(&bms_fuseCurrent, i, &window) == E_OK) {
+            float rms_A = window.rms / 1000.0f;
+
+            curSensor->current_rms[i] = window.rms;
+            curSensor->current_window_ms[i] = window.count * ISA_CURRENT_CYCLE_TIME_MS;
+            if (-window.min > window.max) {
+                curSensor->current_peak[i] = -window.min;
+            } else {
+                curSensor->current_peak[i] = window.max;
+            }
+            curSensor->current_i2t[i] = rms_A * rms_A * (float)window.count * ((float)ISA_CURRENT_CYCLE_TIME_MS / 1000.0f);
+        }
+    }
+}
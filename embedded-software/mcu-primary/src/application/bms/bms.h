@@ -57,6 +57,8 @@
 /*================== Includes =============================================*/
 #include "bms_cfg.h"
 
+#include "database.h"
+
 /*================== Macros and Definitions ===============================*/
 
 /**
@@ -222,4 +224,17 @@ extern void BMS_Trigger(void);
  */
 extern BMS_CURRENT_FLOW_STATE_e BMS_GetBatterySystemState(void);
 
+/**
+ * @brief   adds a current sensor sample to the windows of the fuse curve
+ *
+ * Must be called for every received current measurement, before the data
+ * block is written to the database. Updates RMS, peak and I2t of every window
+ * and writes them to curSensor. Each sample is weighted with the measured
+ * sampling interval timestep_cur, including the interval of preceding
+ * invalid measurements.
+ *
+ * @param   curSensor   current sensor data block with the new sample
+ */
+extern void BMS_AddCurrentSample(DATA_BLOCK_CURRENT_SENSOR_s *curSensor);
+
 #endif /* BMS_H_ */
@@ -53,117 +53,138 @@
 /*================== Includes =============================================*/
 #include "algo_cfg.h"
 
+#include "algo.h"
 #include "database.h"
+#include "movstat.h"
+#include "sox_ekf.h"
+#include "sox_rls.h"
+
+#include <math.h>
 
 /*================== Macros and Definitions ===============================*/
 #if ALGO_TICK_MS > ISA_CURRENT_CYCLE_TIME_MS
-#define NMBR_AVERAGES_CUR_1s           1000/ALGO_TICK_MS
-#define NMBR_AVERAGES_CUR_5s           5000/ALGO_TICK_MS
-#define NMBR_AVERAGES_CUR_10s          10000/ALGO_TICK_MS
-#define NMBR_AVERAGES_CUR_30s          30000/ALGO_TICK_MS
-#define NMBR_AVERAGES_CUR_60s          60000/ALGO_TICK_MS
-#define NMBR_AVERAGES_CUR_cfg          MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ALGO_TICK_MS
+#define NMBR_AVERAGES_CUR_1s           (1000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_CUR_5s           (5000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_CUR_10s          (10000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_CUR_30s          (30000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_CUR_60s          (60000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_CUR_cfg          (MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ALGO_TICK_MS)
 #else
-#define NMBR_AVERAGES_CUR_1s           1000/ISA_CURRENT_CYCLE_TIME_MS
-#define NMBR_AVERAGES_CUR_5s           5000/ISA_CURRENT_CYCLE_TIME_MS
-#define NMBR_AVERAGES_CUR_10s          10000/ISA_CURRENT_CYCLE_TIME_MS
-#define NMBR_AVERAGES_CUR_30s          30000/ISA_CURRENT_CYCLE_TIME_MS
-#define NMBR_AVERAGES_CUR_60s          60000/ISA_CURRENT_CYCLE_TIME_MS
-#define NMBR_AVERAGES_CUR_cfg          MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ISA_CURRENT_CYCLE_TIME_MS
+#define NMBR_AVERAGES_CUR_1s           (1000/ISA_CURRENT_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_CUR_5s           (5000/ISA_CURRENT_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_CUR_10s          (10000/ISA_CURRENT_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_CUR_30s          (30000/ISA_CURRENT_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_CUR_60s          (60000/ISA_CURRENT_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_CUR_cfg          (MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ISA_CURRENT_CYCLE_TIME_MS)
 #endif
 
 #if ALGO_TICK_MS > ISA_POWER_CYCLE_TIME_MS
-#define NMBR_AVERAGES_POW_1s           1000/ALGO_TICK_MS
-#define NMBR_AVERAGES_POW_5s           5000/ALGO_TICK_MS
-#define NMBR_AVERAGES_POW_10s          10000/ALGO_TICK_MS
-#define NMBR_AVERAGES_POW_30s          30000/ALGO_TICK_MS
-#define NMBR_AVERAGES_POW_60s          60000/ALGO_TICK_MS
-#define NMBR_AVERAGES_POW_cfg          MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ALGO_TICK_MS
+#define NMBR_AVERAGES_POW_1s           (1000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_POW_5s           (5000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_POW_10s          (10000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_POW_30s          (30000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_POW_60s          (60000/ALGO_TICK_MS)
+#define NMBR_AVERAGES_POW_cfg          (MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ALGO_TICK_MS)
 #else
-#define NMBR_AVERAGES_POW_1s           1000/ISA_POWER_CYCLE_TIME_MS
-#define NMBR_AVERAGES_POW_5s           5000/ISA_POWER_CYCLE_TIME_MS
-#define NMBR_AVERAGES_POW_10s          10000/ISA_POWER_CYCLE_TIME_MS
-#define NMBR_AVERAGES_POW_30s          30000/ISA_POWER_CYCLE_TIME_MS
-#define NMBR_AVERAGES_POW_60s          60000/ISA_POWER_CYCLE_TIME_MS
-#define NMBR_AVERAGES_POW_cfg          MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ISA_POWER_CYCLE_TIME_MS
+#define NMBR_AVERAGES_POW_1s           (1000/ISA_POWER_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_POW_5s           (5000/ISA_POWER_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_POW_10s          (10000/ISA_POWER_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_POW_30s          (30000/ISA_POWER_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_POW_60s          (60000/ISA_POWER_CYCLE_TIME_MS)
+#define NMBR_AVERAGES_POW_cfg          (MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ISA_POWER_CYCLE_TIME_MS)
 #endif
 
-/*================== Constant and Variable Definitions ====================*/
-
-/* Arrays in extern SDRAM to calculate moving mean current and power */
-
-/* Check if minimum algo cycle time > current sensor sample time */
-#if ALGO_TICK_MS > ISA_CURRENT_CYCLE_TIME_MS
-#if MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ALGO_TICK_MS > 60000/ALGO_TICK_MS
-/* If array length of configured time > 60s array take this array size */
-static float MEM_EXT_SDRAM curValues[(MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ALGO_TICK_MS)+1] = {};
-static uint32_t movMeanCurLength = (MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ALGO_TICK_MS)+1;
-#else
-/* Take array size of 60s moving average */
-static float MEM_EXT_SDRAM curValues[(60000/ALGO_TICK_MS)+1] = {};
-static uint32_t movMeanCurLength = (60000/ALGO_TICK_MS)+1;
-#endif
-#else
-/* If array length of configured time > 60s array take this array size */
-#if MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ISA_CURRENT_CYCLE_TIME_MS > 60000/ISA_CURRENT_CYCLE_TIME_MS
-static float MEM_EXT_SDRAM curValues[(MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ISA_CURRENT_CYCLE_TIME_MS)+1] = {};
-static uint32_t movMeanCurLength = (MOVING_AVERAGE_DURATION_CURRENT_CONFIG_MS/ISA_CURRENT_CYCLE_TIME_MS)+1;
+/* Ring buffer length: longest window, i.e., the configured time if longer than 60s */
+#if NMBR_AVERAGES_CUR_cfg > NMBR_AVERAGES_CUR_60s
+#define MOVMEAN_CUR_LENGTH              NMBR_AVERAGES_CUR_cfg
 #else
-/* Take array size of 60s moving average */
-static float MEM_EXT_SDRAM curValues[(60000/ISA_CURRENT_CYCLE_TIME_MS)+1] = {};
-static uint32_t movMeanCurLength = (60000/ISA_CURRENT_CYCLE_TIME_MS)+1;
-#endif
+#define MOVMEAN_CUR_LENGTH              NMBR_AVERAGES_CUR_60s
 #endif
 
-/* Check if minimum algo cycle time > current sensor sample time */
-#if ALGO_TICK_MS > ISA_POWER_CYCLE_TIME_MS
-#if MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ALGO_TICK_MS > 60000/ALGO_TICK_MS
-/* If array length of configured time > 60s array take this array size */
-static float MEM_EXT_SDRAM powValues[(MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ALGO_TICK_MS)+1] = {};
-static uint32_t movMeanPowLength = (MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ALGO_TICK_MS)+1;
+#if NMBR_AVERAGES_POW_cfg > NMBR_AVERAGES_POW_60s
+#define MOVMEAN_POW_LENGTH              NMBR_AVERAGES_POW_cfg
 #else
-/* Take array size of 60s moving average */
-static float MEM_EXT_SDRAM powValues[(60000/ALGO_TICK_MS)+1] = {};
-static uint32_t movMeanPowLength = (60000/ALGO_TICK_MS)+1;
-#endif
-#else
-#if MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ISA_POWER_CYCLE_TIME_MS > 60000/ISA_POWER_CYCLE_TIME_MS
-/* If array length of configured time > 60s array take this array size */
-static float MEM_EXT_SDRAM powValues[(MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ISA_POWER_CYCLE_TIME_MS)+1] = {};
-static uint32_t movMeanPowLength = (MOVING_AVERAGE_DURATION_POWER_CONFIG_MS/ISA_POWER_CYCLE_TIME_MS)+1;
-#else
-/* Take array size of 60s moving average */
-static float MEM_EXT_SDRAM powValues[(60000/ISA_POWER_CYCLE_TIME_MS)+1] = {};
-static uint32_t movMeanPowLength = (60000/ISA_POWER_CYCLE_TIME_MS)+1;
-#endif
+#define MOVMEAN_POW_LENGTH              NMBR_AVERAGES_POW_60s
 #endif
 
+#define MOVMEAN_CUR_WINDOWS_LENGTH      (NMBR_AVERAGES_CUR_1s + NMBR_AVERAGES_CUR_5s + NMBR_AVERAGES_CUR_10s + \
+                                         NMBR_AVERAGES_CUR_30s + NMBR_AVERAGES_CUR_60s + NMBR_AVERAGES_CUR_cfg)
+#define MOVMEAN_POW_WINDOWS_LENGTH      (NMBR_AVERAGES_POW_1s + NMBR_AVERAGES_POW_5s + NMBR_AVERAGES_POW_10s + \
+                                         NMBR_AVERAGES_POW_30s + NMBR_AVERAGES_POW_60s + NMBR_AVERAGES_POW_cfg)
 
-/* Pointer for current moving mean calculation */
-static float *ptrMovMeanCur_new = &curValues[0];
-static float *ptrMovMeanCur_1s = &curValues[0];
-static float *ptrMovMeanCur_5s = &curValues[0];
-static float *ptrMovMeanCur_10s = &curValues[0];
-static float *ptrMovMeanCur_30s = &curValues[0];
-static float *ptrMovMeanCur_60s = &curValues[0];
-static float *ptrMovMeanCur_cfg = &curValues[0];
-
-/* Pointer for power moving mean calculation */
-static float *ptrMovMeanPow_new = &powValues[0];
-static float *ptrMovMeanPow_1s = &powValues[0];
-static float *ptrMovMeanPow_5s = &powValues[0];
-static float *ptrMovMeanPow_10s = &powValues[0];
-static float *ptrMovMeanPow_30s = &powValues[0];
-static float *ptrMovMeanPow_60s = &powValues[0];
-static float *ptrMovMeanPow_cfg = &powValues[0];
+/**
+ * windows of the moving means of current and power
+ */
+typedef enum {
+    MOVMEAN_WINDOW_1s     = 0,
+    MOVMEAN_WINDOW_5s     = 1,
+    MOVMEAN_WINDOW_10s    = 2,
+    MOVMEAN_WINDOW_30s    = 3,
+    MOVMEAN_WINDOW_60s    = 4,
+    MOVMEAN_WINDOW_cfg    = 5,
+    MOVMEAN_NR_OF_WINDOWS = 6,
+} MOVMEAN_WINDOW_e;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/* Ring buffers and deques in extern SDRAM to calculate moving mean current (in mA) and power (in W) */
+static int32_t MEM_EXT_SDRAM curValues[MOVMEAN_CUR_LENGTH];
+static uint32_t MEM_EXT_SDRAM curDeques[MOVSTAT_DEQUE_STORAGE_LENGTH(MOVMEAN_CUR_WINDOWS_LENGTH)];
+static int32_t MEM_EXT_SDRAM powValues[MOVMEAN_POW_LENGTH];
+static uint32_t MEM_EXT_SDRAM powDeques[MOVSTAT_DEQUE_STORAGE_LENGTH(MOVMEAN_POW_WINDOWS_LENGTH)];
+
+static MOVSTAT_WINDOW_s curWindows[MOVMEAN_NR_OF_WINDOWS] = {
+    [MOVMEAN_WINDOW_1s]  = {.length = NMBR_AVERAGES_CUR_1s},
+    [MOVMEAN_WINDOW_5s]  = {.length = NMBR_AVERAGES_CUR_5s},
+    [MOVMEAN_WINDOW_10s] = {.length = NMBR_AVERAGES_CUR_10s},
+    [MOVMEAN_WINDOW_30s] = {.length = NMBR_AVERAGES_CUR_30s},
+    [MOVMEAN_WINDOW_60s] = {.length = NMBR_AVERAGES_CUR_60s},
+    [MOVMEAN_WINDOW_cfg] = {.length = NMBR_AVERAGES_CUR_cfg},
+};
+
+static MOVSTAT_WINDOW_s powWindows[MOVMEAN_NR_OF_WINDOWS] = {
+    [MOVMEAN_WINDOW_1s]  = {.length = NMBR_AVERAGES_POW_1s},
+    [MOVMEAN_WINDOW_5s]  = {.length = NMBR_AVERAGES_POW_5s},
+    [MOVMEAN_WINDOW_10s] = {.length = NMBR_AVERAGES_POW_10s},
+    [MOVMEAN_WINDOW_30s] = {.length = NMBR_AVERAGES_POW_30s},
+    [MOVMEAN_WINDOW_60s] = {.length = NMBR_AVERAGES_POW_60s},
+    [MOVMEAN_WINDOW_cfg] = {.length = NMBR_AVERAGES_POW_cfg},
+};
+
+static MOVSTAT_s movMeanCur = {
+    .buffer = curValues,
+    .bufferLength = MOVMEAN_CUR_LENGTH,
+    .dequeStorage = curDeques,
+    .dequeStorageLength = MOVSTAT_DEQUE_STORAGE_LENGTH(MOVMEAN_CUR_WINDOWS_LENGTH),
+    .windows = curWindows,
+    .nrOfWindows = MOVMEAN_NR_OF_WINDOWS,
+};
+
+static MOVSTAT_s movMeanPow = {
+    .buffer = powValues,
+    .bufferLength = MOVMEAN_POW_LENGTH,
+    .dequeStorage = powDeques,
+    .dequeStorageLength = MOVSTAT_DEQUE_STORAGE_LENGTH(MOVMEAN_POW_WINDOWS_LENGTH),
+    .windows = powWindows,
+    .nrOfWindows = MOVMEAN_NR_OF_WINDOWS,
+};
 
 /*================== Function Prototypes ==================================*/
 static void algo_movAverage(uint32_t algoIdx);
+static float algo_getMovMean(const MOVSTAT_s *stat, MOVMEAN_WINDOW_e window);
+static void algo_socEkf(uint32_t algoIdx);
+static void algo_resistanceRls(uint32_t algoIdx);
 
 /*================== Function Implementations =============================*/
 
+/*
+ * The estimators run with priority over the moving average, so that the
+ * latter is deferred first when the tick budget ALGO_TICK_BUDGET_US is used up.
+ */
 ALGO_TASKS_s algo_algorithms[] = {
-    {ALGO_READY, 100, 1000, 0, &algo_movAverage },
+    {.state = ALGO_READY, .cycleTime_ms = 100, .maxCalcDuration_ms = 1000, .func = &algo_movAverage,    .priority = 2, .phase_ms = 0},
+    {.state = ALGO_READY, .cycleTime_ms = 100, .maxCalcDuration_ms = 10,   .func = &algo_socEkf,        .priority = 0, .phase_ms = 0},
+    {.state = ALGO_READY, .cycleTime_ms = 100, .maxCalcDuration_ms = 5,    .func = &algo_resistanceRls, .priority = 1, .phase_ms = 0},
 };
 
 const uint16_t algo_length = sizeof(algo_algorithms)/sizeof(algo_algorithms[0]);
@@ -172,15 +193,18 @@ const uint16_t algo_length = sizeof(algo_algorithms)/sizeof(algo_algorithms[0]);
 static void algo_movAverage(uint32_t algoIdx) {
     static uint8_t curCounter = 0;
     static uint8_t powCounter = 0;
+    static uint8_t movMeanInitialized = FALSE;
     static DATA_BLOCK_CURRENT_SENSOR_s curPow_tab;
     static DATA_BLOCK_MOVING_AVERAGE_s movMean_tab;
-    static uint8_t curInit = 0;     /* bit0: 1s, bit1: 5s, bit2: 10s, bit3: 30s, bit4: 60s, bit5: cfg */
-    static uint8_t powInit = 0;     /* bit0: 1s, bit1: 5s, bit2: 10s, bit3: 30s, bit4: 60s, bit5: cfg */
-    static uint8_t newValues = 0;
-    float divider = 0;
+    uint8_t newValues = FALSE;
+
+    if (movMeanInitialized == FALSE) {
+        (void)MOVSTAT_Init(&movMeanCur);
+        (void)MOVSTAT_Init(&movMeanPow);
+        movMeanInitialized = TRUE;
+    }
 
     DB_ReadBlock(&curPow_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
-    DB_ReadBlock(&movMean_tab, DATA_BLOCK_ID_MOV_AVERAGE);
 
     /* Check if new current value */
     if (curCounter != curPow_tab.newCurrent) {
@@ -188,92 +212,8 @@ static void algo_movAverage(uint32_t algoIdx) {
 
         /* Check if valid value */
         if (curPow_tab.state_current == 0) {
-            /* new Values -> Save later in database */
-            newValues = 1;
-
-            /* Add value to array and calculate new moving mean values */
-            *ptrMovMeanCur_new = curPow_tab.current;
-
-            /* Calculate new moving means - first add new value */
-            divider = NMBR_AVERAGES_CUR_1s;
-            movMean_tab.movAverage_current_1s += (*ptrMovMeanCur_new)/divider;
-            divider = NMBR_AVERAGES_CUR_5s;
-            movMean_tab.movAverage_current_5s += (*ptrMovMeanCur_new)/divider;
-            divider = NMBR_AVERAGES_CUR_10s;
-            movMean_tab.movAverage_current_10s += (*ptrMovMeanCur_new)/divider;
-            divider = NMBR_AVERAGES_CUR_30s;
-            movMean_tab.movAverage_current_30s += (*ptrMovMeanCur_new)/divider;
-            divider = NMBR_AVERAGES_CUR_60s;
-            movMean_tab.movAverage_current_60s += (*ptrMovMeanCur_new)/divider;
-            divider = NMBR_AVERAGES_CUR_cfg;
-            movMean_tab.movAverage_current_config += (*ptrMovMeanCur_new)/divider;
-
-            /* Then, increment pointer and substract oldest value when respective window is filled with data */
-            ptrMovMeanCur_new++;
-            if ((curInit & 0x01) == 0x01) {
-                divider = NMBR_AVERAGES_CUR_1s;
-                movMean_tab.movAverage_current_1s -= ((*ptrMovMeanCur_1s)/divider);
-                ptrMovMeanCur_1s++;
-            } else {
-                if (ptrMovMeanCur_new == &curValues[NMBR_AVERAGES_CUR_1s])
-                    curInit |= 0x01;
-            }
-            if ((curInit & 0x02) == 0x02) {
-                divider = NMBR_AVERAGES_CUR_5s;
-                movMean_tab.movAverage_current_5s -= (*ptrMovMeanCur_5s)/divider;
-                ptrMovMeanCur_5s++;
-            } else {
-                if (ptrMovMeanCur_new == &curValues[NMBR_AVERAGES_CUR_5s])
-                    curInit |= 0x02;
-            }
-            if ((curInit & 0x04) == 0x04) {
-                divider = NMBR_AVERAGES_CUR_10s;
-                movMean_tab.movAverage_current_10s -= (*ptrMovMeanCur_10s)/divider;
-                ptrMovMeanCur_10s++;
-            } else {
-                if (ptrMovMeanCur_new == &curValues[NMBR_AVERAGES_CUR_10s])
-                    curInit |= 0x04;
-            }
-            if ((curInit & 0x08) == 0x08) {
-                divider = NMBR_AVERAGES_CUR_30s;
-                movMean_tab.movAverage_current_30s -= (*ptrMovMeanCur_30s)/divider;
-                ptrMovMeanCur_30s++;
-            } else {
-                if (ptrMovMeanCur_new == &curValues[NMBR_AVERAGES_CUR_30s])
-                    curInit |= 0x08;
-            }
-            if ((curInit & 0x10) == 0x10) {
-                divider = NMBR_AVERAGES_CUR_60s;
-                movMean_tab.movAverage_current_60s -= (*ptrMovMeanCur_60s)/divider;
-                ptrMovMeanCur_60s++;
-            } else {
-                if (ptrMovMeanCur_new == &curValues[NMBR_AVERAGES_CUR_60s])
-                    curInit |= 0x10;
-            }
-            if ((curInit & 0x20) == 0x20) {
-                divider = NMBR_AVERAGES_CUR_cfg;
-                movMean_tab.movAverage_current_config -= (*ptrMovMeanCur_cfg)/divider;
-                ptrMovMeanCur_cfg++;
-            } else {
-                if (ptrMovMeanCur_new == &curValues[NMBR_AVERAGES_CUR_cfg])
-                    curInit |= 0x20;
-            }
-
-            /* Check pointer for buffer overflow */
-            if (ptrMovMeanCur_new > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_new = &curValues[0];
-            if (ptrMovMeanCur_1s > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_1s = &curValues[0];
-            if (ptrMovMeanCur_5s > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_5s = &curValues[0];
-            if (ptrMovMeanCur_10s > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_10s = &curValues[0];
-            if (ptrMovMeanCur_30s > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_30s = &curValues[0];
-            if (ptrMovMeanCur_60s > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_60s = &curValues[0];
-            if (ptrMovMeanCur_cfg > &curValues[movMeanCurLength-1])
-                ptrMovMeanCur_cfg = &curValues[0];
+            MOVSTAT_AddSample(&movMeanCur, curPow_tab.current);
+            newValues = TRUE;
         }
     }
 
@@ -283,96 +223,24 @@ static void algo_movAverage(uint32_t algoIdx) {
 
         /* Check if valid value */
         if (curPow_tab.state_power == 0) {
-            newValues = 1;
-
-            /* Add value to array and calculate new moving mean values */
-            *ptrMovMeanPow_new = curPow_tab.power;
-
-            /* Calculate new moving means - first add new value */
-            divider = NMBR_AVERAGES_POW_1s;
-            movMean_tab.movAverage_power_1s += (*ptrMovMeanPow_new)/divider;
-            divider = NMBR_AVERAGES_POW_5s;
-            movMean_tab.movAverage_power_5s += (*ptrMovMeanPow_new)/divider;
-            divider = NMBR_AVERAGES_POW_10s;
-            movMean_tab.movAverage_power_10s += (*ptrMovMeanPow_new)/divider;
-            divider = NMBR_AVERAGES_POW_30s;
-            movMean_tab.movAverage_power_30s += (*ptrMovMeanPow_new)/divider;
-            divider = NMBR_AVERAGES_POW_60s;
-            movMean_tab.movAverage_power_60s += (*ptrMovMeanPow_new)/divider;
-            divider = NMBR_AVERAGES_POW_cfg;
-            movMean_tab.movAverage_power_config += (*ptrMovMeanPow_new)/divider;
-
-            /* Then, increment pointer and substract oldest value when respective window is filled with data */
-            ptrMovMeanPow_new++;
-            if ((powInit & 0x01) == 0x01) {
-                divider = NMBR_AVERAGES_POW_1s;
-                movMean_tab.movAverage_power_1s -= ((*ptrMovMeanPow_1s)/divider);
-                ptrMovMeanPow_1s++;
-            } else {
-                if (ptrMovMeanPow_new == &powValues[NMBR_AVERAGES_POW_1s])
-                    powInit |= 0x01;
-            }
-            if ((powInit & 0x02) == 0x02) {
-                divider = NMBR_AVERAGES_POW_5s;
-                movMean_tab.movAverage_power_5s -= ((*ptrMovMeanPow_5s)/divider);
-                ptrMovMeanPow_5s++;
-            } else {
-                if (ptrMovMeanPow_new == &powValues[NMBR_AVERAGES_POW_5s])
-                    powInit |= 0x02;
-            }
-            if ((powInit & 0x04) == 0x04) {
-                divider = NMBR_AVERAGES_POW_10s;
-                movMean_tab.movAverage_power_10s -= ((*ptrMovMeanPow_10s)/divider);
-                ptrMovMeanPow_10s++;
-            } else {
-                if (ptrMovMeanPow_new == &powValues[NMBR_AVERAGES_POW_10s])
-                    powInit |= 0x04;
-            }
-            if ((powInit & 0x08) == 0x08) {
-                divider = NMBR_AVERAGES_POW_30s;
-                movMean_tab.movAverage_power_30s -= ((*ptrMovMeanPow_30s)/divider);
-                ptrMovMeanPow_30s++;
-            } else {
-                if (ptrMovMeanPow_new == &powValues[NMBR_AVERAGES_POW_30s])
-                    powInit |= 0x08;
-            }
-            if ((powInit & 0x10) == 0x10) {
-                divider = NMBR_AVERAGES_POW_60s;
-                movMean_tab.movAverage_power_60s -= ((*ptrMovMeanPow_60s)/divider);
-                ptrMovMeanPow_60s++;
-            } else {
-                if (ptrMovMeanPow_new == &powValues[NMBR_AVERAGES_POW_60s])
-                    powInit |= 0x10;
-            }
-            if ((powInit & 0x20) == 0x20) {
-                divider = NMBR_AVERAGES_POW_cfg;
-                movMean_tab.movAverage_power_config -= ((*ptrMovMeanPow_cfg)/divider);
-                ptrMovMeanPow_cfg++;
-            } else {
-                if (ptrMovMeanPow_new == &powValues[NMBR_AVERAGES_POW_cfg])
-                    powInit |= 0x20;
-            }
-
-            /* Check pointer for buffer overflow */
-            if (ptrMovMeanPow_new > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_new = &powValues[0];
-            if (ptrMovMeanPow_1s > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_1s = &powValues[0];
-            if (ptrMovMeanPow_5s > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_5s = &powValues[0];
-            if (ptrMovMeanPow_10s > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_10s = &powValues[0];
-            if (ptrMovMeanPow_30s > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_30s = &powValues[0];
-            if (ptrMovMeanPow_60s > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_60s = &powValues[0];
-            if (ptrMovMeanPow_cfg > &powValues[movMeanPowLength-1])
-                ptrMovMeanPow_cfg = &powValues[0];
+            MOVSTAT_AddSample(&movMeanPow, (int32_t)lroundf(curPow_tab.power));
+            newValues = TRUE;
         }
     }
 
-    if (newValues == 1) {
-        newValues = 0;
+    if (newValues == TRUE) {
+        movMean_tab.movAverage_current_1s = algo_getMovMean(&movMeanCur, MOVMEAN_WINDOW_1s);
+        movMean_tab.movAverage_current_5s = algo_getMovMean(&movMeanCur, MOVMEAN_WINDOW_5s);
+        movMean_tab.movAverage_current_10s = algo_getMovMean(&movMeanCur, MOVMEAN_WINDOW_10s);
+        movMean_tab.movAverage_current_30s = algo_getMovMean(&movMeanCur, MOVMEAN_WINDOW_30s);
+        movMean_tab.movAverage_current_60s = algo_getMovMean(&movMeanCur, MOVMEAN_WINDOW_60s);
+        movMean_tab.movAverage_current_config = algo_getMovMean(&movMeanCur, MOVMEAN_WINDOW_cfg);
+        movMean_tab.movAverage_power_1s = algo_getMovMean(&movMeanPow, MOVMEAN_WINDOW_1s);
+        movMean_tab.movAverage_power_5s = algo_getMovMean(&movMeanPow, MOVMEAN_WINDOW_5s);
+        movMean_tab.movAverage_power_10s = algo_getMovMean(&movMeanPow, MOVMEAN_WINDOW_10s);
+        movMean_tab.movAverage_power_30s = algo_getMovMean(&movMeanPow, MOVMEAN_WINDOW_30s);
+        movMean_tab.movAverage_power_60s = algo_getMovMean(&movMeanPow, MOVMEAN_WINDOW_60s);
+        movMean_tab.movAverage_power_config = algo_getMovMean(&movMeanPow, MOVMEAN_WINDOW_cfg);
 
         DB_WriteBlock(&movMean_tab, DATA_BLOCK_ID_MOV_AVERAGE);
     }
@@ -383,3 +251,47 @@ static void algo_movAverage(uint32_t algoIdx) {
     }
     return;
 }
+
+
+/**
+ * @brief   gets the moving mean of a window, 0 as long as no sample was added
+ *
+ * @param   stat    moving statistics of current or power
+ * @param   window  window
+ *
+ * @return  mean value over the window
+ */
+static float algo_getMovMean(const MOVSTAT_s *stat, MOVMEAN_WINDOW_e window) {
+    MOVSTAT_RESULT_s result = {.mean = 0.0f};
+
+    (void)MOVSTAT_GetWindow(stat, (uint8_t)window, &result);
+    return result.mean;
+}
+
+
+static void algo_socEkf(uint32_t algoIdx) {
+    /* resumable: the cells are processed in chunks, yield between chunks if requested */
+    while (SOX_EKF_Update(SOX_EKF_CELLS_PER_CALL) == FALSE) {
+        if (ALGO_YieldRequested(algoIdx) == TRUE) {
+            /* state is ALGO_SUSPENDED, the remaining cells are processed in the next ALGO tick */
+            return;
+        }
+    }
+
+    /* Only set task to ready state if it isn't blocked by the monitoring unit because of a runtime violation */
+    if (algo_algorithms[algoIdx].state != ALGO_BLOCKED) {
+        algo_algorithms[algoIdx].state = ALGO_READY;
+    }
+    return;
+}
+
+
+static void algo_resistanceRls(uint32_t algoIdx) {
+    SOX_RLS_Update();
+
+    /* Only set task to ready state if it isn't blocked by the monitoring unit because of a runtime violation */
+    if (algo_algorithms[algoIdx].state != ALGO_BLOCKED) {
+        algo_algorithms[algoIdx].state = ALGO_READY;
+    }
+    return;
+}
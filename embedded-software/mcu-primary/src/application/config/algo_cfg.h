@@ -66,7 +66,7 @@
 
 /**
  * @ingroup CONFIG_ALGO
- * task timeslot where the ALGO main function is called. Repetition time of algorithm cycle time must be multiple of this
+ * cycle time of the algorithm task (appl_tskdef_algo) which calls the ALGO main function. Repetition time of algorithm cycle time must be multiple of this
  * \par Type:
  * select(3)
  * \par Default:
@@ -76,6 +76,80 @@
 /* #define ALGO_TICK_MS 10 */
 #define ALGO_TICK_MS 100
 
+/**
+ * @ingroup CONFIG_ALGO
+ * computation time in us that the algorithms may use in total in one ALGO
+ * tick. Algorithms that are due when the budget is used up are deferred to
+ * the next tick, starting with the lowest priority. Resumable algorithms
+ * yield at the latest when the budget is used up (see ALGO_YieldRequested()).
+ * \par Type:
+ * int
+ * \par Unit:
+ * us
+ * \par Range:
+ * [1000,ALGO_TICK_MS*1000]
+ * \par Default:
+ * 20000
+*/
+#define ALGO_TICK_BUDGET_US 20000
+
+/**
+ * @ingroup CONFIG_ALGO
+ * number of consecutive calls exceeding maxCalcDuration_ms after which an
+ * algorithm is blocked from further execution. Every single overrun is
+ * reported to the diagnosis module.
+ * \par Type:
+ * int
+ * \par Range:
+ * [1,255]
+ * \par Default:
+ * 3
+*/
+#define ALGO_MAX_CONSECUTIVE_OVERRUNS 3
+
+/**
+ * @ingroup CONFIG_ALGO
+ * time after which an algorithm blocked because of repeated overruns is
+ * executed again. The block and the release are reported to the diagnosis
+ * module.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Range:
+ * [ALGO_TICK_MS,]
+ * \par Default:
+ * 10000
+*/
+#define ALGO_BLOCKED_RETRY_MS 10000
+
+/**
+ * @ingroup CONFIG_ALGO
+ * computation time in us after which a resumable algorithm is requested to
+ * yield by ALGO_YieldRequested(). It is continued in the next ALGO tick, so
+ * the other algorithms get their share of the tick budget.
+ * \par Type:
+ * int
+ * \par Unit:
+ * us
+ * \par Range:
+ * [100,ALGO_TICK_BUDGET_US]
+ * \par Default:
+ * 5000
+*/
+#define ALGO_JOB_SLICE_US 5000
+
+/**
+ * @ingroup CONFIG_ALGO
+ * maximum number of algorithms that can be scheduled, size of the internal
+ * table of execution order
+ * \par Type:
+ * int
+ * \par Default:
+ * 16
+*/
+#define ALGO_MAX_NR_OF_ALGORITHMS 16
+
 
 typedef enum ALGO_STATE {
     ALGO_READY           = 0,
@@ -84,14 +158,35 @@ typedef enum ALGO_STATE {
     ALGO_RDY_BUT_WAITING = 3,
     ALGO_EXECUTE_ASAP    = 4,
     ALGO_BLOCKED         = 5,
+    ALGO_SUSPENDED       = 6,    /*!< algorithm yielded, continued in the next ALGO tick */
 } ALGO_STATE_e;
 
+/**
+ * measured execution time statistics of an algorithm
+ */
+typedef struct ALGO_RUNTIME {
+    uint32_t min_us;        /*!< shortest measured execution time */
+    uint32_t max_us;        /*!< longest measured execution time */
+    uint32_t avg_us;        /*!< average execution time, exponentially weighted with 1/8 */
+    uint32_t calls;         /*!< number of executions */
+    uint32_t overruns;      /*!< number of executions longer than maxCalcDuration_ms */
+    uint32_t deferrals;     /*!< number of ALGO ticks the execution was postponed because the tick budget was used up */
+} ALGO_RUNTIME_s;
+
 typedef struct ALGO_TASKS {
     ALGO_STATE_e state;              /* !< current execution state */
-    uint32_t cycleTime_ms;           /* !< cycle time of algorithm */
-    uint32_t maxCalcDuration_ms;     /* !< maximum allowed calculation duration for task */
+    uint32_t cycleTime_ms;           /* !< cycle time of algorithm, multiple of ALGO_TICK_MS */
+    uint32_t maxCalcDuration_ms;     /* !< maximum allowed calculation duration for task (deadline) */
     uint32_t startTime;              /* !< start time when executing algorithm */
     void (*func)(uint32_t algoIdx);  /*!< callback function */
+    uint8_t priority;                /*!< scheduling priority, 0 is the highest priority */
+    uint32_t phase_ms;               /*!< offset of the calls within the cycle time, multiple of ALGO_TICK_MS, spreads the load of algorithms with equal cycle time */
+    uint32_t nextCall_ms;            /*!< internal: ALGO time of the next call */
+    uint8_t consecutiveOverruns;     /*!< internal: number of consecutive deadline overruns */
+    uint8_t overrunReported;         /*!< internal: overrun of the current execution already reported */
+    uint32_t jobTime_us;             /*!< internal: execution time of the current job, summed up over all slices */
+    uint32_t blockedUntil_ms;        /*!< internal: ALGO time at which a blocked algorithm is executed again */
+    ALGO_RUNTIME_s runtime;          /*!< measured execution times */
 } ALGO_TASKS_s;
 
 /*================== Constant and Variable Definitions ====================*/
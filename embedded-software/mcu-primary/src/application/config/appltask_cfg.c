@@ -63,6 +63,8 @@
 #include "database.h"
 #include "meas.h"
 #include "algo.h"
+#include "plausibility.h"
+#include "xcp.h"
 
 /*================== Macros and Definitions ===============================*/
 
@@ -71,6 +73,7 @@ OS_Task_Definition_s appl_tskdef_cyclic_1ms   = { 0,      1,  OS_PRIORITY_NORMAL
 OS_Task_Definition_s appl_tskdef_cyclic_10ms  = { 4,     10,  OS_PRIORITY_BELOW_NORMAL, APPL_TSK_C_10MS_STACKSIZE};
 OS_Task_Definition_s appl_tskdef_cyclic_100ms = { 58,   100,  OS_PRIORITY_LOW,          APPL_TSK_C_100MS_STACKSIZE};
 OS_Task_Definition_s appl_tskdef_aperiodic =    { 0,     10,  OS_PRIORITY_IDLE,         APPL_TSK_APERIODIC_STACKSIZE};
+OS_Task_Definition_s appl_tskdef_algo =         { 62, ALGO_TICK_MS, OS_PRIORITY_ABOVE_IDLE, APPL_TSK_ALGO_STACKSIZE};
 
 static uint8_t io_initialized = FALSE;
 static uint8_t io_direction = 1;
@@ -89,6 +92,8 @@ void APPL_Cyclic_1ms(void) {
     /*   ...                            */
     /*   ...                            */
     BMS_Trigger();
+
+    XCP_Event(XCP_EVENT_1MS);
 }
 
 void APPL_Cyclic_10ms(void) {
@@ -105,6 +110,8 @@ void APPL_Cyclic_10ms(void) {
     SOF_Calculation();
 
     ALGO_MonitorExecutionTime();
+
+    XCP_Event(XCP_EVENT_10MS);
 }
 
 void APPL_Cyclic_100ms(void) {
@@ -117,8 +124,7 @@ void APPL_Cyclic_100ms(void) {
     /*   ...                            */
     /*   ...                            */
     BAL_Trigger();
-
-    ALGO_MainFunction();
+    PL_CheckCellResistance();
 
 
     if (first_cycle < 10) {
@@ -199,9 +205,17 @@ void APPL_Cyclic_100ms(void) {
 
         io_counter++;
     }
+
+    XCP_Event(XCP_EVENT_100MS);
 }
 
 void APPL_Aperiodic(void) {
     COM_Decoder();
     COM_printHelpCommand();
 }
+
+void APPL_Algo(void) {
+    DIAG_SysMonNotify(DIAG_SYSMON_APPL_ALGO, 0);        /* task is running, state = ok */
+
+    ALGO_MainFunction();
+}
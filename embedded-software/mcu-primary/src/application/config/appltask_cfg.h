@@ -82,6 +82,11 @@
  */
 #define APPL_TSK_APERIODIC_STACKSIZE   (1024u/4u)
 
+/**
+ * @brief Stack size of algorithm task
+ */
+#define APPL_TSK_ALGO_STACKSIZE        (2048u/4u)
+
 /*================== Constant and Variable Definitions ====================*/
 
 /**
@@ -120,6 +125,16 @@ extern OS_Task_Definition_s appl_tskdef_cyclic_100ms;
  */
 extern OS_Task_Definition_s appl_tskdef_aperiodic;
 
+/**
+ * @brief   Task configuration of the algorithm task
+ *
+ * @details Runs the algorithm module with lowest priority, so that long
+ *          calculations are preempted by all other tasks
+ *
+ * @ingroup API_OS
+ */
+extern OS_Task_Definition_s appl_tskdef_algo;
+
 /*================== Function Prototypes ==================================*/
 
 /**
@@ -150,6 +165,13 @@ extern void APPL_Cyclic_100ms(void);
  */
 extern void APPL_Aperiodic(void);
 
+/**
+ * @brief   user application task for the algorithms, called every ALGO_TICK_MS
+ *
+ * @ingroup API_OS
+ */
+extern void APPL_Algo(void);
+
 /*================== Function Implementations =============================*/
 
 #endif /* APPLTASK_CFG_H_ */
@@ -56,6 +56,9 @@
 /*================== Macros and Definitions ===============================*/
 
 /*================== Constant and Variable Definitions ====================*/
+uint16_t MEM_XCP_CAL bal_threshold_mV = BAL_THRESHOLD_MV;
+uint16_t MEM_XCP_CAL bal_hysteresis_mV = BAL_HYSTERESIS_MV;
+float MEM_XCP_CAL bal_threshold_soc = BAL_THRESHOLD_SOC;
 
 /*================== Function Prototypes ==================================*/
 
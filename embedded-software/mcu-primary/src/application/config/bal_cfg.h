@@ -76,13 +76,14 @@
 #define BAL_STATEMACH_BALANCINGTIME_100MS     10
 
 /**
- * BAL voltage threshold for balancing in mV
+ * BAL voltage threshold for balancing in mV, initial value of bal_threshold_mV
  */
 
 #define BAL_THRESHOLD_MV     200
 
 /**
- * BAL hysteresis for voltage threshold when balancing was finished in mV
+ * BAL hysteresis for voltage threshold when balancing was finished in mV,
+ * initial value of bal_hysteresis_mV
  */
 
 #define BAL_HYSTERESIS_MV     200
@@ -100,16 +101,100 @@
 #define BAL_UPPER_TEMPERATURE_LIMIT_DEG     70
 
 /**
- * If set to FALSE, SOC-history based balancing is used.
- * An open-circuit-voltage/SOC look-up table is needed.
+ * If set to FALSE, SOC-history based balancing is used: the charge excess of
+ * every cell is computed from its SOC (cell model or open-circuit-voltage/SOC
+ * look-up table) and the estimated capacity and discharged by a planner.
  * If set to TRUE, voltage-based balancing is used.
  *
 */
-#define BALANCING_VOLTAGE_BASED           TRUE
+#define BALANCING_VOLTAGE_BASED           FALSE
+
+/**
+ * BAL SOC difference to the cell with the lowest SOC above which a cell is
+ * balanced in %, initial value of bal_threshold_soc
+ */
+
+#define BAL_THRESHOLD_SOC     1.0f
+
+/**
+ * BAL maximum number of cells of one module balanced at the same time
+ */
+
+#define BAL_MAX_CELLS_PER_MODULE     6
+
+/**
+ * BAL maximum power dissipated by the balancing resistors of one module in mW
+ */
+
+#define BAL_MAX_MODULE_POWER_MW     2500
+
+/**
+ * BAL module temperature in Celsius above which the power of the module is
+ * reduced linearly, to zero at BAL_UPPER_TEMPERATURE_LIMIT_DEG
+ */
+
+#define BAL_DERATING_TEMPERATURE_DEG     55
+
+/**
+ * If set to FALSE, two adjacent cells of one module are never balanced at the
+ * same time, so the heat on the slave board is spread.
+ */
+
+#define BAL_ADJACENT_CELLS_ALLOWED     FALSE
+
+/**
+ * BAL thermal resistance between the balancing resistors of one module and
+ * the cells in K/W, used to estimate the slave board temperature from the
+ * dissipated power
+ */
+
+#define BAL_PCB_THERMAL_RESISTANCE_K_PER_W     15
+
+/**
+ * BAL thermal time constant of the slave board in ms
+ */
+
+#define BAL_PCB_THERMAL_TIME_CONSTANT_MS     180000
+
+/**
+ * BAL estimated slave board temperature in Celsius above which the power of
+ * the module is reduced linearly, to zero at BAL_PCB_MAX_TEMPERATURE_DEG
+ */
+
+#define BAL_PCB_DERATING_TEMPERATURE_DEG     85
+
+/**
+ * BAL maximum estimated slave board temperature in Celsius
+ */
+
+#define BAL_PCB_MAX_TEMPERATURE_DEG     105
+
+/**
+ * BAL period in ms in which the balancing statistics are written to the
+ * EEPROM while balancing, they are also written when balancing stops
+ */
+
+#define BAL_STATISTICS_STORE_PERIOD_MS     600000
 
 
 /*================== Constant and Variable Definitions ====================*/
 
+/**
+ * voltage threshold for balancing in mV, calibration parameter
+ */
+extern uint16_t bal_threshold_mV;
+
+/**
+ * hysteresis for the voltage threshold when balancing was finished in mV, calibration parameter
+ */
+extern uint16_t bal_hysteresis_mV;
+
+/**
+ * SOC difference to the cell with the lowest SOC above which a cell is balanced in %,
+ * calibration parameter
+ */
+extern float bal_threshold_soc;
+
 /*================== Function Prototypes ==================================*/
 
 /*================== Function Implementations =============================*/
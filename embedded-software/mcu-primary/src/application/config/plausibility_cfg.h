@@ -70,6 +70,19 @@
 */
 #define PL_PACK_VOLTAGE_TOLERANCE_mV            (3000)
 
+/**
+ * @ingroup CONFIG_PLAUSIBILITY
+ * Defines the maximum deviation of the estimated series resistance of a cell
+ * from the mean series resistance of all cells with a valid estimate
+ * \par Type:
+ * int
+ * \par Unit:
+ * uOhm
+ * \par Default:
+ * 1000
+*/
+#define PL_CELL_RESISTANCE_TOLERANCE_uOhm       (1000)
+
 /*================== Extern Constant and Variable Declarations ==============*/
 
 /*================== Extern Function Prototypes =============================*/
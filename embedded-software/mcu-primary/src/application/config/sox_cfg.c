@@ -58,7 +58,7 @@
 
 /*================== Constant and Variable Definitions ====================*/
 
-const SOX_SOF_CONFIG_s sox_sof_config_maxAllowedCurrent = {
+SOX_SOF_CONFIG_s MEM_XCP_CAL sox_sof_config_maxAllowedCurrent = {
         .I_ChargeMax_Cont       = SOX_CURRENT_MAX_CONTINUOUS_CHARGE,
         .I_DischaMax_Cont       = SOX_CURRENT_MAX_CONTINUOUS_DISCHARGE,
         .I_Limphome             = SOX_CURRENT_LIMP_HOME,
@@ -80,7 +80,7 @@ const SOX_SOF_CONFIG_s sox_sof_config_maxAllowedCurrent = {
         .Cutoff_Voltage_Discha  = SOX_VOLT_CUTOFF_DISCHARGE
 };
 
-const SOX_SOF_CONFIG_s sox_sof_config_MOL = {
+SOX_SOF_CONFIG_s MEM_XCP_CAL sox_sof_config_MOL = {
         .I_ChargeMax_Cont       = SOX_MOL_CURRENT_MAX_CONTINUOUS_CHARGE,
         .I_DischaMax_Cont       = SOX_MOL_CURRENT_MAX_CONTINUOUS_DISCHARGE,
         .I_Limphome             = SOX_MOL_CURRENT_LIMP_HOME,
@@ -103,7 +103,7 @@ const SOX_SOF_CONFIG_s sox_sof_config_MOL = {
 };
 
 
-const SOX_SOF_CONFIG_s sox_sof_config_RSL = {
+SOX_SOF_CONFIG_s MEM_XCP_CAL sox_sof_config_RSL = {
         .I_ChargeMax_Cont       = SOX_RSL_CURRENT_MAX_CONTINUOUS_CHARGE,
         .I_DischaMax_Cont       = SOX_RSL_CURRENT_MAX_CONTINUOUS_DISCHARGE,
         .I_Limphome             = SOX_RSL_CURRENT_LIMP_HOME,
@@ -125,7 +125,7 @@ const SOX_SOF_CONFIG_s sox_sof_config_RSL = {
         .Cutoff_Voltage_Discha  = SOX_RSL_VOLT_CUTOFF_DISCHARGE
 };
 
-const SOX_SOF_CONFIG_s sox_sof_config_MSL = {
+SOX_SOF_CONFIG_s MEM_XCP_CAL sox_sof_config_MSL = {
         .I_ChargeMax_Cont       = SOX_MSL_CURRENT_MAX_CONTINUOUS_CHARGE,
         .I_DischaMax_Cont       = SOX_MSL_CURRENT_MAX_CONTINUOUS_DISCHARGE,
         .I_Limphome             = SOX_MSL_CURRENT_LIMP_HOME,
@@ -147,6 +147,19 @@ const SOX_SOF_CONFIG_s sox_sof_config_MSL = {
         .Cutoff_Voltage_Discha  = SOX_MSL_VOLT_CUTOFF_DISCHARGE
 };
 
+const uint16_t sox_ocv_voltage_mV[SOX_OCV_NR_OF_POINTS] = {
+    3000,   /*   0% */
+    3450,   /*  10% */
+    3550,   /*  20% */
+    3610,   /*  30% */
+    3660,   /*  40% */
+    3720,   /*  50% */
+    3800,   /*  60% */
+    3880,   /*  70% */
+    3960,   /*  80% */
+    4060,   /*  90% */
+    4180,   /* 100% */
+};
 
 /*================== Function Prototypes ==================================*/
 
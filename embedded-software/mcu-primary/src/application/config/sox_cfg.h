@@ -114,6 +114,21 @@
 */
 #define SOX_CELL_CAPACITY               20000.0f
 
+/**
+ * @ingroup CONFIG_SOX
+ * maximum time between two consecutive current sensor samples that is still
+ * integrated by the coulomb counter. Longer gaps (e.g., first sample after
+ * startup or sensor timeout) are not integrated, as the held current value
+ * would not be representative for the whole interval.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 500
+*/
+#define SOX_CC_MAX_SAMPLE_INTERVAL_MS   500
+
 /**
  * @ingroup CONFIG_SOX
  * the maximum current in charge direction that the battery pack can sustain.
@@ -557,6 +572,243 @@
 #define SOX_RSL_VOLT_LIMIT_DISCHARGE                 1750
 #define SOX_MSL_VOLT_LIMIT_DISCHARGE                 1750
 
+/**
+ * @ingroup CONFIG_SOX
+ * if TRUE, the SOC estimated by the extended Kalman filter (EKF) is used to
+ * correct the SOC obtained by coulomb counting. If FALSE, the EKF only runs
+ * as observer and its estimate can be read with SOX_EKF_GetSoc().
+ * Keep FALSE until the cell model (OCV, R0, RC) is fitted to the used cells
+ * and the estimate is validated on a recorded profile with tools/hosttest.
+ * \par Type:
+ * toggle
+ * \par Default:
+ * FALSE
+*/
+#define SOX_EKF_CORRECT_SOC                 FALSE
+
+/**
+ * @ingroup CONFIG_SOX
+ * variance of the SOC estimate (in (SOC/100%)^2) below which the EKF is
+ * considered converged and its estimate is used to correct the SOC
+ * \par Type:
+ * float
+ * \par Default:
+ * 0.0004 (i.e., standard deviation of 2%)
+*/
+#define SOX_EKF_CONVERGED_VARIANCE          0.0004f
+
+/**
+ * @ingroup CONFIG_SOX
+ * equivalent circuit model of the cell used by the EKF: series resistance
+ * R0 and two RC elements (R1 || C1, R2 || C2). A model with one RC element
+ * is obtained by setting SOX_EKF_R2_OHM to 0. R0 and R1 are the initial
+ * values of the online resistance estimation of every cell.
+ * \par Unit:
+ * Ohm, s
+ */
+#define SOX_EKF_R0_OHM                      0.0015f
+#define SOX_EKF_R1_OHM                      0.0008f
+#define SOX_EKF_TAU1_S                      10.0f
+#define SOX_EKF_R2_OHM                      0.0006f
+#define SOX_EKF_TAU2_S                      200.0f
+
+/**
+ * @ingroup CONFIG_SOX
+ * EKF process noise variances of the states SOC (in (SOC/100%)^2), V1 and
+ * V2 (in V^2) per filter step and measurement noise variance of the cell
+ * voltage (in V^2)
+ */
+#define SOX_EKF_PROCESS_NOISE_SOC           1.0e-7f
+#define SOX_EKF_PROCESS_NOISE_V1            1.0e-8f
+#define SOX_EKF_PROCESS_NOISE_V2            1.0e-8f
+#define SOX_EKF_MEASUREMENT_NOISE           1.0e-4f
+
+/**
+ * @ingroup CONFIG_SOX
+ * initial variance of the EKF SOC estimate (in (SOC/100%)^2)
+ */
+#define SOX_EKF_INITIAL_VARIANCE_SOC        0.01f
+
+/**
+ * @ingroup CONFIG_SOX
+ * number of cells processed per call of SOX_EKF_Update(). The algorithm
+ * module can yield between two calls, so one filter step is spread over
+ * several ALGO ticks if the tick budget is used up.
+ * \par Type:
+ * int
+ * \par Default:
+ * 12
+*/
+#define SOX_EKF_CELLS_PER_CALL              12
+
+/**
+ * @ingroup CONFIG_SOX
+ * number of points of the open circuit voltage (OCV) curve. The points are
+ * equally spaced over SOC from 0% to 100%.
+ */
+#define SOX_OCV_NR_OF_POINTS                11
+
+/**
+ * @ingroup CONFIG_SOX
+ * prediction horizons of the state of power (SOP) calculation. The
+ * recommended peak currents are valid for the peak horizon, the recommended
+ * continuous currents for the continuous horizon.
+ * \par Type:
+ * float
+ * \par Unit:
+ * s
+ * \par Default:
+ * 2.0, 10.0
+*/
+#define SOX_SOP_HORIZON_PEAK_S              2.0f
+#define SOX_SOP_HORIZON_CONTINUOUS_S        10.0f
+
+/**
+ * @ingroup CONFIG_SOX
+ * minimum change of the pack current between two cell voltage samples that
+ * starts an identification event of the online resistance estimation
+ * \par Type:
+ * int
+ * \par Unit:
+ * mA
+ * \par Default:
+ * 20000
+*/
+#define SOX_RLS_MIN_CURRENT_STEP_mA         20000
+
+/**
+ * @ingroup CONFIG_SOX
+ * maximum deviation of the current from its value after the step. The
+ * identification event ends as soon as the current leaves this band or the
+ * event duration elapsed.
+ * \par Unit:
+ * mA, ms
+ * \par Default:
+ * 5000, 10000
+*/
+#define SOX_RLS_CURRENT_TOLERANCE_mA        5000
+#define SOX_RLS_EVENT_DURATION_MS           10000
+
+/**
+ * @ingroup CONFIG_SOX
+ * forgetting factor of the recursive least squares (RLS) resistance
+ * estimation, applied per update
+ * \par Type:
+ * float
+ * \par Range:
+ * ]0,1]
+ * \par Default:
+ * 0.995
+*/
+#define SOX_RLS_FORGETTING_FACTOR           0.995f
+
+/**
+ * @ingroup CONFIG_SOX
+ * variance of the voltage difference of one cell (in V^2) and initial
+ * variance of the resistance estimates (in Ohm^2). The initial variance is
+ * also the upper bound of the variance while no events occur.
+ */
+#define SOX_RLS_MEASUREMENT_NOISE           4.0e-6f
+#define SOX_RLS_INITIAL_VARIANCE            1.0e-6f
+
+/**
+ * @ingroup CONFIG_SOX
+ * range to which the estimated resistances R0 and R1 are limited
+ * \par Unit:
+ * Ohm
+ */
+#define SOX_RLS_RESISTANCE_MIN_OHM          0.0001f
+#define SOX_RLS_RESISTANCE_MAX_OHM          0.02f
+
+/**
+ * @ingroup CONFIG_SOX
+ * number of updates after which the estimate of a cell is considered valid
+ * \par Type:
+ * int
+ * \par Default:
+ * 20
+*/
+#define SOX_RLS_MIN_NR_OF_UPDATES           20
+
+/**
+ * @ingroup CONFIG_SOX
+ * maximum number of cells updated per call of the resistance estimation.
+ * One voltage sample is processed over several calls if the battery system
+ * has more cells.
+ * \par Type:
+ * int
+ * \par Default:
+ * 12
+*/
+#define SOX_RLS_CELLS_PER_CALL              12
+
+/**
+ * @ingroup CONFIG_SOX
+ * lower limit of the factor the SOF currents are derated with when the
+ * estimated cell resistance (R0 + R1) rises above the model resistance
+ * (SOX_EKF_R0_OHM + SOX_EKF_R1_OHM). The currents are scaled with
+ * sqrt(R_model / R_estimated), which keeps the dissipated power at the value
+ * the SOF curves were designed for.
+ * \par Type:
+ * float
+ * \par Range:
+ * 0.0 < x <= 1.0
+ * \par Default:
+ * 0.5
+*/
+#define SOX_SOF_MIN_RESISTANCE_FACTOR       0.5f
+
+/**
+ * @ingroup CONFIG_SOX
+ * minimum SOC difference between two rest points for a capacity measurement.
+ * The SOC at a rest point is derived from the open circuit voltage.
+ * \par Type:
+ * float
+ * \par Unit:
+ * %
+ * \par Default:
+ * 20.0
+*/
+#define SOX_SOH_MIN_DELTA_SOC               20.0f
+
+/**
+ * @ingroup CONFIG_SOX
+ * standard deviation of the SOC derived from the open circuit voltage at a
+ * rest point
+ * \par Type:
+ * float
+ * \par Unit:
+ * %
+ * \par Default:
+ * 2.0
+*/
+#define SOX_SOH_REST_SOC_UNCERTAINTY        2.0f
+
+/**
+ * @ingroup CONFIG_SOX
+ * variance added to the capacity estimate per capacity measurement (aging
+ * between two measurements) and variance of the capacity at first startup
+ * \par Unit:
+ * mAh^2
+ * \par Default:
+ * 10000.0, 4000000.0
+*/
+#define SOX_SOH_PROCESS_NOISE               10000.0f
+#define SOX_SOH_INITIAL_VARIANCE            4000000.0f
+
+/**
+ * @ingroup CONFIG_SOX
+ * range of plausible cell capacities. Measurements outside this range are
+ * discarded, stored values outside this range are replaced by
+ * SOX_CELL_CAPACITY.
+ * \par Unit:
+ * mAh
+ * \par Default:
+ * 50% and 120% of SOX_CELL_CAPACITY
+*/
+#define SOX_SOH_CAPACITY_MIN_mAh            (0.5f * SOX_CELL_CAPACITY)
+#define SOX_SOH_CAPACITY_MAX_mAh            (1.2f * SOX_CELL_CAPACITY)
+
 /*================== Constant and Variable Definitions ====================*/
 
 /**
@@ -592,10 +844,15 @@ typedef struct {
     float Limit_Voltage_Discha;
 } SOX_SOF_CONFIG_s;
 
-extern const SOX_SOF_CONFIG_s sox_sof_config_maxAllowedCurrent;
-extern const SOX_SOF_CONFIG_s sox_sof_config_MOL;
-extern const SOX_SOF_CONFIG_s sox_sof_config_RSL;
-extern const SOX_SOF_CONFIG_s sox_sof_config_MSL;
+extern SOX_SOF_CONFIG_s sox_sof_config_maxAllowedCurrent;
+extern SOX_SOF_CONFIG_s sox_sof_config_MOL;
+extern SOX_SOF_CONFIG_s sox_sof_config_RSL;
+extern SOX_SOF_CONFIG_s sox_sof_config_MSL;
+
+/**
+ * open circuit voltage of the cell in mV at equally spaced SOC points from 0% to 100%
+ */
+extern const uint16_t sox_ocv_voltage_mV[SOX_OCV_NR_OF_POINTS];
 
 /*================== Function Prototypes ==================================*/
 
@@ -61,6 +61,12 @@
 
 /*================== Static Constant and Variable Definitions ===============*/
 
+/**
+ * estimated cell resistances, static as the block is too large for the stack of the calling task
+ */
+static DATA_BLOCK_CELL_RESISTANCE_s pl_cell_resistance;
+static uint32_t pl_cell_resistance_timestamp = 0;
+
 /*================== Extern Constant and Variable Definitions ===============*/
 
 /*================== Static Function Prototypes =============================*/
@@ -85,3 +91,41 @@ extern void PL_CheckPackvoltage(DATA_BLOCK_CELLVOLTAGE_s* ptrCellvolt, DATA_BLOC
         /* Invalid pointer -> TODO: error handling */
     }
 }
+
+
+extern void PL_CheckCellResistance(void) {
+    uint32_t mask = 0;
+    uint16_t nrOfValid = 0;
+    float mean = 0.0f;
+    STD_RETURN_TYPE_e result = E_OK;
+
+    DB_ReadBlock(&pl_cell_resistance, DATA_BLOCK_ID_CELL_RESISTANCE);
+    if (pl_cell_resistance.timestamp == pl_cell_resistance_timestamp) {
+        /* no new estimates */
+        return;
+    }
+    pl_cell_resistance_timestamp = pl_cell_resistance.timestamp;
+
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        mask = 1u << (i % BS_NR_OF_BAT_CELLS_PER_MODULE);
+        if ((pl_cell_resistance.valid_r0[i / BS_NR_OF_BAT_CELLS_PER_MODULE] & mask) == 0) {
+            mean += pl_cell_resistance.r0[i];
+            nrOfValid++;
+        }
+    }
+
+    /* A deviation can only be detected with at least two estimates */
+    if (nrOfValid < 2) {
+        return;
+    }
+    mean /= (float)nrOfValid;
+
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        mask = 1u << (i % BS_NR_OF_BAT_CELLS_PER_MODULE);
+        if (((pl_cell_resistance.valid_r0[i / BS_NR_OF_BAT_CELLS_PER_MODULE] & mask) == 0) &&
+                (fabsf(pl_cell_resistance.r0[i] - mean) > ((float)PL_CELL_RESISTANCE_TOLERANCE_uOhm / 1000000.0f))) {
+            result = E_NOT_OK;
+        }
+    }
+    DIAG_checkEvent(result, DIAG_CH_PLAUSIBILITY_CELL_RESISTANCE, 0);
+}
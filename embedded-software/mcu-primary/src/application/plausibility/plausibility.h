@@ -68,4 +68,11 @@
  */
 extern void PL_CheckPackvoltage(DATA_BLOCK_CELLVOLTAGE_s* tab_cellvolt, DATA_BLOCK_CURRENT_SENSOR_s* tab_curSensor);
 
+/**
+ * @brief Cell resistance plausibility check between the online estimates of all cells
+ *
+ * Evaluates the snapshot of the estimates in the database, only if it has been updated since the last call.
+ */
+extern void PL_CheckCellResistance(void);
+
 #endif /* PLAUSIBILITY_H_ */
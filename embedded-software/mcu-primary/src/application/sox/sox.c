@@ -59,9 +59,34 @@
 #include "database.h"
 #include "batterycell_cfg.h"
 #include "batterysystem_cfg.h"
+#include "lut.h"
 #include "nvramhandler.h"
+#include "os.h"
+#include "sox_rls.h"
+#include "sox_soh.h"
+#include "sox_sop.h"
+#include "xcp_cfg.h"
+
+#include <math.h>
 
 /*================== Macros and Definitions ===============================*/
+/**
+ * inputs of the SOF calculation, used to detect changes
+ */
+typedef struct {
+    int16_t maxtemp;    /*!< maximum cell temperature in &deg;C     */
+    int16_t mintemp;    /*!< minimum cell temperature in &deg;C     */
+    uint16_t maxvolt;   /*!< maximum cell voltage in mV             */
+    uint16_t minvolt;   /*!< minimum cell voltage in mV             */
+    uint16_t maxsoc;    /*!< maximum SOC with resolution 0.01%      */
+    uint16_t minsoc;    /*!< minimum SOC with resolution 0.01%      */
+    uint16_t resistanceFactor;  /*!< derating factor from the estimated cell resistance in 0.1% */
+} SOF_INPUTS_s;
+
+/**
+ * resolution of the SOC delta computed from the coulomb counter, in 1/x %
+ */
+#define SOC_DELTA_RESOLUTION            10000
 
 /*================== Constant and Variable Definitions ====================*/
 static SOX_STATE_s sox_state = {
@@ -70,6 +95,11 @@ static SOX_STATE_s sox_state = {
     .cc_scaling_min         = 0.0,
     .cc_scaling_max         = 0.0,
     .counter                = 0,
+    .charge_counter_mAms    = 0,
+    .charge_counter_samples = 0,
+    .soc_ref_min            = 50.0,
+    .soc_ref_max            = 50.0,
+    .soc_ref_mean           = 50.0,
 };
 
 static DATA_BLOCK_CURRENT_SENSOR_s sox_current_tab;
@@ -78,8 +108,12 @@ static DATA_BLOCK_SOX_s sox;
 static DATA_BLOCK_SOF_s sof;
 static DATA_BLOCK_CONTFEEDBACK_s contfeedbacktab;
 
-static uint32_t soc_previous_current_timestamp = 0;
+static uint32_t soc_previous_charge_counter_samples = 0;
+
+static SOX_SOC_s soc_correction;
+static uint8_t soc_correction_pending = FALSE;
 static uint32_t soc_previous_current_timestamp_cc = 0;
+static uint8_t soc_previous_at_rest = FALSE;
 
 
 /** @{
@@ -94,37 +128,48 @@ static SOX_SOF_s sof_recOperatingCurrent;
 static SOX_SOF_s sof_mol_Level;
 static SOX_SOF_s sof_rsl_Level;
 static SOX_SOF_s sof_msl_Level;
+/** @} */
+
+static SOF_INPUTS_s sof_inputs;
+static uint8_t sof_inputs_valid = FALSE;
 
 /*================== Function Prototypes ==================================*/
 static void SOF_CalculateCurves(const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues);
-static void SOF_Calculate(int16_t maxtemp, int16_t mintemp, uint16_t maxvolt, uint16_t minvolt, uint16_t maxsoc, uint16_t minsoc);
-static void SOF_CalculateVoltageBased(float MinVoltage, float MaxVoltage, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues);
-static void SOF_CalculateSocBased(float MinSoc, float MaxSoc, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues);
-static void SOF_CalculateTemperatureBased(float MinTemp, float MaxTemp, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues);
+static void SOF_Calculate(int16_t maxtemp, int16_t mintemp, uint16_t maxvolt, uint16_t minvolt, uint16_t maxsoc, uint16_t minsoc, uint16_t resistanceFactor);
+static uint16_t SOF_GetResistanceFactor(void);
+static void SOF_CalculateVoltageBased(float MinVoltage, float MaxVoltage, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues);
+static void SOF_CalculateSocBased(float MinSoc, float MaxSoc, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues);
+static void SOF_CalculateTemperatureBased(float MinTemp, float MaxTemp, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues);
+static void SOF_CalculateLevel(float minvolt, float maxvolt, float minsoc, float maxsoc, float mintemp, float maxtemp, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues, SOX_SOF_s *resultValues);
 static void SOF_MinimumOfThreeSofValues(SOX_SOF_s Ubased, SOX_SOF_s Sbased, SOX_SOF_s Tbased, SOX_SOF_s *resultValues);
 static float SOF_MinimumOfThreeValues(float value1, float value2, float value3);
-static float SOC_GetFromVoltage(uint16_t voltage_mV);
+static float SOF_EvaluateCurve(float x, float slope, float offset, float lowerLimit, float upperLimit);
+static void SOC_ResetChargeCounter(float soc_min, float soc_max, float soc_mean);
+static float SOC_GetDeltaFromChargeCounter(void);
 
 /*================== Function Implementations =============================*/
 
+LUT_DEFINE_FIND_SEGMENT(SOC_FindOcvSegment, uint16_t, , uint16_t)
+
 void SOC_Init(uint8_t cc_present) {
     SOX_SOC_s soc = {50.0, 50.0, 50.0, 0, 0, 0, 0};
 
     DB_ReadBlock(&sox_current_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
     NVM_getSOC(&soc);
+    SOX_SOH_Init();
 
     if (cc_present == TRUE) {
         soc_previous_current_timestamp_cc = sox_current_tab.timestamp_cc;
         sox_state.sensor_cc_used = TRUE;
 
         if (POSITIVE_DISCHARGE_CURRENT == TRUE) {
-            sox_state.cc_scaling = soc.mean + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_min = soc.min + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_max = soc.max + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
+            sox_state.cc_scaling = soc.mean + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_min = soc.min + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_max = soc.max + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
         } else {
-            sox_state.cc_scaling = soc.mean - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_min = soc.min - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_max = soc.max - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
+            sox_state.cc_scaling = soc.mean - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_min = soc.min - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_max = soc.max - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
         }
 
 
@@ -143,8 +188,8 @@ void SOC_Init(uint8_t cc_present) {
         sox.timestamp = 0;
         sox.previous_timestamp = 0;
     } else {
-        soc_previous_current_timestamp = sox_current_tab.timestamp_cur;
         sox_state.sensor_cc_used = FALSE;
+        SOC_ResetChargeCounter(soc.min, soc.max, soc.mean);
     }
     DB_WriteBlock(&sox, DATA_BLOCK_ID_SOX);
 }
@@ -181,6 +226,7 @@ void SOC_SetValue(float soc_value_min, float soc_value_max, float soc_value_mean
         sox.soc_mean = soc.mean;
         sox.soc_min = soc.min;
         sox.soc_max = soc.max;
+        SOC_ResetChargeCounter(soc.min, soc.max, soc.mean);
     } else {
         DB_ReadBlock(&sox_current_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
         soc.mean = soc_value_mean;
@@ -188,13 +234,13 @@ void SOC_SetValue(float soc_value_min, float soc_value_max, float soc_value_mean
         soc.max = soc_value_max;
 
         if (POSITIVE_DISCHARGE_CURRENT == TRUE) {
-            sox_state.cc_scaling = soc.mean + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_min = soc.min + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_max = soc.max + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
+            sox_state.cc_scaling = soc.mean + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_min = soc.min + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_max = soc.max + 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
         } else {
-            sox_state.cc_scaling = soc.mean - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_min = soc.min - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-            sox_state.cc_scaling_max = soc.max - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
+            sox_state.cc_scaling = soc.mean - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_min = soc.min - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+            sox_state.cc_scaling_max = soc.max - 100.0f*sox_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
         }
 
         sox.soc_mean = soc.mean;
@@ -219,23 +265,18 @@ void SOC_RecalibrateViaLookupTable(void) {
 
     DB_ReadBlock(&cellminmax, DATA_BLOCK_ID_MINMAX);
 
-    soc_mean = SOC_GetFromVoltage((float)(cellminmax.voltage_mean));
-    soc_min = SOC_GetFromVoltage((float)(cellminmax.voltage_min));
-    soc_max = SOC_GetFromVoltage((float)(cellminmax.voltage_max));
+    soc_mean = SOC_GetFromVoltage((uint16_t)cellminmax.voltage_mean);
+    soc_min = SOC_GetFromVoltage((uint16_t)cellminmax.voltage_min);
+    soc_max = SOC_GetFromVoltage((uint16_t)cellminmax.voltage_max);
 
     SOC_SetValue(soc_min, soc_max, soc_mean);
 }
 
 
 void SOC_Calculation(void) {
-    uint32_t timestamp = 0;
-    uint32_t previous_timestamp = 0;
-
     uint32_t timestamp_cc = 0;
     uint32_t previous_timestamp_cc = 0;
 
-    uint32_t timestep = 0;
-
     DATA_BLOCK_CURRENT_SENSOR_s cans_current_tab;
     SOX_SOC_s soc = {50.0, 50.0, 50.0, 0, 0, 0, 0};
     float deltaSOC = 0.0;
@@ -243,48 +284,49 @@ void SOC_Calculation(void) {
     if (BMS_GetBatterySystemState() == BMS_AT_REST) {
         /* Recalibrate SOC via LUT */
         SOC_RecalibrateViaLookupTable();
+        if (soc_previous_at_rest == FALSE) {
+            /* cells are relaxed, the SOC from the lookup table is a rest point for the capacity estimation */
+            soc_previous_at_rest = TRUE;
+            SOX_SOH_RestPoint(sox.soc_mean);
+        }
     } else {
+        soc_previous_at_rest = FALSE;
+
+        /* Apply SOC correction requested by an estimator running in another task */
+        if (soc_correction_pending == TRUE) {
+            OS_TaskEnter_Critical();
+            soc = soc_correction;
+            soc_correction_pending = FALSE;
+            OS_TaskExit_Critical();
+            SOC_SetValue(soc.min, soc.max, soc.mean);
+        }
+
         /* Use coulomb/current counting */
         if (sox_state.sensor_cc_used == FALSE) {
-            DB_ReadBlock(&sox_current_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
-
-            timestamp = sox_current_tab.timestamp_cur;
-            previous_timestamp = sox_current_tab.previous_timestamp_cur;
-
-            if (soc_previous_current_timestamp != timestamp) {  /* check if current measurement has been updated */
-                timestep = timestamp - previous_timestamp;
-                if (timestep > 0) {
-                    NVM_getSOC(&soc);
-                    /* Current in charge direction negative means SOC increasing --> BAT naming, not ROB */
-                    /* soc_mean = soc_mean - (sox_current_tab.current *mA* /(float)SOX_CELL_CAPACITY (*mAh*)) * (float)(timestep) * (10.0/3600.0); */ /*milliseconds*/
-
-                    if (POSITIVE_DISCHARGE_CURRENT == TRUE) {
-                        deltaSOC = (((sox_current_tab.current)*(float)(timestep)/10))/(3600.0f * SOX_CELL_CAPACITY); /* ((mA *ms *(1s/1000ms)) / (3600(s/h) *mAh)) *100% */
-                    } else {
-                        deltaSOC = -(((sox_current_tab.current)*(float)(timestep)/10))/(3600.0f * SOX_CELL_CAPACITY); /* ((mA *ms *(1s/1000ms)) / (3600(s/h) *mAh)) *100% */
-                    }
-                    soc.mean = soc.mean - deltaSOC;
-                    soc.min = soc.min - deltaSOC;
-                    soc.max = soc.max - deltaSOC;
-                    if (soc.mean > 100.0f) { soc.mean = 100.0; }
-                    if (soc.mean < 0.0f)   { soc.mean = 0.0;   }
-                    if (soc.min > 100.0f)  { soc.min = 100.0;  }
-                    if (soc.min < 0.0f)    { soc.min = 0.0;    }
-                    if (soc.max > 100.0f)  { soc.max = 100.0;  }
-                    if (soc.max < 0.0f)    { soc.max = 0.0;    }
-
-                    sox.soc_mean = soc.mean;
-                    sox.soc_min = soc.min;
-                    sox.soc_max = soc.max;
-
-                    NVM_setSOC(&soc);
-                    sox.state++;
-                    DB_WriteBlock(&sox, DATA_BLOCK_ID_SOX);
-                }
-            } /* end check if current measurement has been updated */
-            /* update the variable for the next check */
-            soc_previous_current_timestamp = sox_current_tab.timestamp;
+            /* the charge counter is fed by SOC_AddCurrentSample() on every current measurement */
+            if (soc_previous_charge_counter_samples != sox_state.charge_counter_samples) {
+                soc_previous_charge_counter_samples = sox_state.charge_counter_samples;
+
+                /* Current in discharge direction positive means SOC decreasing */
+                deltaSOC = SOC_GetDeltaFromChargeCounter();
+                soc.mean = sox_state.soc_ref_mean - deltaSOC;
+                soc.min = sox_state.soc_ref_min - deltaSOC;
+                soc.max = sox_state.soc_ref_max - deltaSOC;
+                if (soc.mean > 100.0f) { soc.mean = 100.0; }
+                if (soc.mean < 0.0f)   { soc.mean = 0.0;   }
+                if (soc.min > 100.0f)  { soc.min = 100.0;  }
+                if (soc.min < 0.0f)    { soc.min = 0.0;    }
+                if (soc.max > 100.0f)  { soc.max = 100.0;  }
+                if (soc.max < 0.0f)    { soc.max = 0.0;    }
+
+                sox.soc_mean = soc.mean;
+                sox.soc_min = soc.min;
+                sox.soc_max = soc.max;
 
+                NVM_setSOC(&soc);
+                sox.state++;
+                DB_WriteBlock(&sox, DATA_BLOCK_ID_SOX);
+            }
         } else {
             DB_ReadBlock(&sox_current_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
 
@@ -295,13 +337,13 @@ void SOC_Calculation(void) {
                 DB_ReadBlock(&cans_current_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
 
                 if (POSITIVE_DISCHARGE_CURRENT == TRUE) {
-                    sox.soc_mean = sox_state.cc_scaling - 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-                    sox.soc_min = sox_state.cc_scaling_min - 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-                    sox.soc_max = sox_state.cc_scaling_max - 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
+                    sox.soc_mean = sox_state.cc_scaling - 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+                    sox.soc_min = sox_state.cc_scaling_min - 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+                    sox.soc_max = sox_state.cc_scaling_max - 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
                 } else {
-                    sox.soc_mean = sox_state.cc_scaling + 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-                    sox.soc_min = sox_state.cc_scaling_min + 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
-                    sox.soc_max = sox_state.cc_scaling_max + 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_CELL_CAPACITY/1000.0f));
+                    sox.soc_mean = sox_state.cc_scaling + 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+                    sox.soc_min = sox_state.cc_scaling_min + 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
+                    sox.soc_max = sox_state.cc_scaling_max + 100.0f*cans_current_tab.current_counter/(3600.0f*(SOX_SOH_GetCapacity()/1000.0f));
                 }
 
                 soc.mean = sox.soc_mean;
@@ -322,6 +364,68 @@ void SOC_Calculation(void) {
     }
 }
 
+void SOC_RequestCorrection(float soc_value_min, float soc_value_max, float soc_value_mean) {
+    OS_TaskEnter_Critical();
+    soc_correction.min = soc_value_min;
+    soc_correction.max = soc_value_max;
+    soc_correction.mean = soc_value_mean;
+    soc_correction_pending = TRUE;
+    OS_TaskExit_Critical();
+}
+
+
+void SOC_AddCurrentSample(int32_t current_mA, uint32_t timestep_ms) {
+    int64_t charge_mAms = 0;
+
+    /* First sample after startup or sensor timeout: no valid interval to integrate */
+    if ((timestep_ms == 0) || (timestep_ms > SOX_CC_MAX_SAMPLE_INTERVAL_MS)) {
+        return;
+    }
+
+    /* charge counter is positive in discharge direction */
+    charge_mAms = (int64_t)current_mA * (int64_t)timestep_ms;
+    if (POSITIVE_DISCHARGE_CURRENT == FALSE) {
+        charge_mAms = -charge_mAms;
+    }
+    sox_state.charge_counter_mAms += charge_mAms;
+    sox_state.charge_counter_samples++;
+    SOX_SOH_AddCharge(charge_mAms);
+}
+
+
+/**
+ * @brief   sets the SOC reference values and clears the charge integrated since then
+ *
+ * @param   soc_min     SOC min reference value
+ * @param   soc_max     SOC max reference value
+ * @param   soc_mean    SOC mean reference value
+ */
+static void SOC_ResetChargeCounter(float soc_min, float soc_max, float soc_mean) {
+    sox_state.soc_ref_min = soc_min;
+    sox_state.soc_ref_max = soc_max;
+    sox_state.soc_ref_mean = soc_mean;
+    sox_state.charge_counter_mAms = 0;
+}
+
+
+/**
+ * @brief   converts the charge integrated since the last SOC reference into a SOC delta
+ *
+ * The conversion is done in integer arithmetic with a resolution of
+ * 1/SOC_DELTA_RESOLUTION % and only once per read, so no error accumulates
+ * over time.
+ *
+ * @return  SOC delta in %, positive in discharge direction
+ */
+static float SOC_GetDeltaFromChargeCounter(void) {
+    /* estimated cell capacity in mA*ms, the unit of the integer coulomb counter */
+    int64_t capacity_mAms = (int64_t)SOX_SOH_GetCapacity() * 3600000;
+    int64_t delta = (sox_state.charge_counter_mAms * 100 * SOC_DELTA_RESOLUTION) / capacity_mAms;
+
+    return (float)delta / (float)SOC_DELTA_RESOLUTION;
+}
+
+
 void SOF_Init(void) {
     /* Calculating SOF curve for the recommended operating current */
     SOF_CalculateCurves(&sox_sof_config_maxAllowedCurrent, &sofCurveRecOperatingCurrent);
@@ -335,7 +439,16 @@ void SOF_Init(void) {
 
     /* Calculating SOF curve for maximum safety limit */
     SOF_CalculateCurves(&sox_sof_config_MSL, &sofCurve_MSL);
-#endif
+#else
+    /* Cell SOF limits not tested: use the constant cell current limits (mA -> A) */
+    sof_mol_Level.current_Charge_cont_max = BC_CURRENTMAX_CHARGE_MOL / 1000.0f;
+    sof_mol_Level.current_Discha_cont_max = BC_CURRENTMAX_DISCHARGE_MOL / 1000.0f;
+    sof_rsl_Level.current_Charge_cont_max = BC_CURRENTMAX_CHARGE_RSL / 1000.0f;
+    sof_rsl_Level.current_Discha_cont_max = BC_CURRENTMAX_DISCHARGE_RSL / 1000.0f;
+    sof_msl_Level.current_Charge_cont_max = BC_CURRENTMAX_CHARGE_MSL / 1000.0f;
+    sof_msl_Level.current_Discha_cont_max = BC_CURRENTMAX_DISCHARGE_MSL / 1000.0f;
+#endif /* BMS_TEST_CELL_SOF_LIMITS == TRUE */
+    sof_inputs_valid = FALSE;
 }
 
 static void SOF_CalculateCurves(const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues) {
@@ -359,21 +472,39 @@ static void SOF_CalculateCurves(const SOX_SOF_CONFIG_s *configLimitValues, SOF_c
     calcCurveValues->Offset_SocCharge = 0 - calcCurveValues->Slope_SocCharge * configLimitValues->Limit_Soc_Charge;
 
     calcCurveValues->Slope_VoltageDischa = (configLimitValues->I_DischaMax_Cont - 0) / (configLimitValues->Cutoff_Voltage_Discha - configLimitValues->Limit_Voltage_Discha);
-    calcCurveValues->Offset_VoltageDischa = 0 - calcCurveValues->Slope_SocDischa * configLimitValues->Limit_Soc_Discha;
+    calcCurveValues->Offset_VoltageDischa = 0 - calcCurveValues->Slope_VoltageDischa * configLimitValues->Limit_Voltage_Discha;
 
     calcCurveValues->Slope_VoltageCharge = (configLimitValues->I_ChargeMax_Cont - 0) / (configLimitValues->Cutoff_Voltage_Charge - configLimitValues->Limit_Voltage_Charge);
-    calcCurveValues->Offset_VoltageCharge = 0 - calcCurveValues->Slope_VoltageCharge * configLimitValues->Limit_Soc_Discha;
+    calcCurveValues->Offset_VoltageCharge = 0 - calcCurveValues->Slope_VoltageCharge * configLimitValues->Limit_Voltage_Charge;
 }
 
 
 void SOF_Calculation(void) {
+    SOF_INPUTS_s inputs;
+
     DB_ReadBlock(&cellminmax, DATA_BLOCK_ID_MINMAX);
     DB_ReadBlock(&sox, DATA_BLOCK_ID_SOX);
     DB_ReadBlock(&sof, DATA_BLOCK_ID_SOF);
     DB_ReadBlock(&contfeedbacktab, DATA_BLOCK_ID_CONTFEEDBACK);
 
-    /* Calculate SOF limits */
-    SOF_Calculate(cellminmax.temperature_max, cellminmax.temperature_min, cellminmax.voltage_max, cellminmax.voltage_min, (uint16_t)(100.0f*sox.soc_max), (uint16_t)(100.0f*sox.soc_min));
+    inputs.maxtemp = cellminmax.temperature_max;
+    inputs.mintemp = cellminmax.temperature_min;
+    inputs.maxvolt = cellminmax.voltage_max;
+    inputs.minvolt = cellminmax.voltage_min;
+    inputs.maxsoc = (uint16_t)(100.0f*sox.soc_max);
+    inputs.minsoc = (uint16_t)(100.0f*sox.soc_min);
+    inputs.resistanceFactor = SOF_GetResistanceFactor();
+
+    /* Calculate SOF limits only if an input changed, the result is published every call */
+    if ((sof_inputs_valid == FALSE) ||
+            (inputs.maxtemp != sof_inputs.maxtemp) || (inputs.mintemp != sof_inputs.mintemp) ||
+            (inputs.maxvolt != sof_inputs.maxvolt) || (inputs.minvolt != sof_inputs.minvolt) ||
+            (inputs.maxsoc != sof_inputs.maxsoc) || (inputs.minsoc != sof_inputs.minsoc) ||
+            (inputs.resistanceFactor != sof_inputs.resistanceFactor)) {
+        SOF_Calculate(inputs.maxtemp, inputs.mintemp, inputs.maxvolt, inputs.minvolt, inputs.maxsoc, inputs.minsoc, inputs.resistanceFactor);
+        sof_inputs = inputs;
+        sof_inputs_valid = TRUE;
+    }
 
     /* Write MOL level */
     sof.continuous_charge_MOL = sof_mol_Level.current_Charge_cont_max;
@@ -395,27 +526,35 @@ void SOF_Calculation(void) {
         sof.recommended_continuous_discharge = 0.0;
         sof.recommended_peak_charge = 0.0;
         sof.recommended_peak_discharge = 0.0;
+        sof.recommended_continuous_charge_power = 0.0;
+        sof.recommended_continuous_discharge_power = 0.0;
+        sof.recommended_peak_charge_power = 0.0;
+        sof.recommended_peak_discharge_power = 0.0;
     } else {
         sof.recommended_continuous_charge = sof_recOperatingCurrent.current_Charge_cont_max;
         sof.recommended_continuous_discharge = sof_recOperatingCurrent.current_Discha_cont_max;
         sof.recommended_peak_charge = sof_recOperatingCurrent.current_Charge_peak_max;
         sof.recommended_peak_discharge = sof_recOperatingCurrent.current_Discha_peak_max;
+        /* Limit recommended currents with the predicted state of power */
+        SOX_SOP_Calculate(&cellminmax, &sof);
     }
     DB_WriteBlock(&sof, DATA_BLOCK_ID_SOF);
 }
 
-/**
- * @brief   look-up table for SOC initialization (mean, min and max).
- *
- * @param   voltage: voltage of battery cell
- *
- * @return  SOC value from 0.00% - 100.0%
- */
-
 float SOC_GetFromVoltage(uint16_t voltage_mV) {
-    float SOC = 50.0f;
-
-    return SOC;
+    float soc = 100.0f;
+    uint16_t i = 0;
+
+    if (voltage_mV <= sox_ocv_voltage_mV[0]) {
+        soc = 0.0f;
+    } else if (voltage_mV < sox_ocv_voltage_mV[SOX_OCV_NR_OF_POINTS - 1]) {
+        /* invert the OCV curve, points equally spaced over SOC */
+        i = SOC_FindOcvSegment(sox_ocv_voltage_mV, SOX_OCV_NR_OF_POINTS, voltage_mV);
+        soc = (float)i + (float)(voltage_mV - sox_ocv_voltage_mV[i]) /
+                         (float)(sox_ocv_voltage_mV[i + 1] - sox_ocv_voltage_mV[i]);
+        soc = soc * 100.0f / (float)(SOX_OCV_NR_OF_POINTS - 1);
+    }
+    return soc;
 }
 
 
@@ -428,44 +567,91 @@ float SOC_GetFromVoltage(uint16_t voltage_mV) {
  * @param   minvolt       minimum voltage in system in mV
  * @param   maxsoc        maximum soc in system with resolution 0.01% (0..10000)
  * @param   minsoc        minimum soc in system with resolution 0.01% (0..10000)
+ * @param   resistanceFactor    derating factor of the recommended currents in 0.1% (0..1000)
  */
-static void SOF_Calculate(int16_t maxtemp, int16_t mintemp, uint16_t maxvolt, uint16_t minvolt, uint16_t maxsoc, uint16_t minsoc) {
-    SOX_SOF_s UbasedSof = {0.0, 0.0, 0.0, 0.0};
-    SOX_SOF_s SbasedSof = {0.0, 0.0, 0.0, 0.0};
-    SOX_SOF_s TbasedSof = {0.0, 0.0, 0.0, 0.0};
+static void SOF_Calculate(int16_t maxtemp, int16_t mintemp, uint16_t maxvolt, uint16_t minvolt, uint16_t maxsoc, uint16_t minsoc, uint16_t resistanceFactor) {
+    float factor = (float)resistanceFactor / 1000.0f;
+
+#if XCP_CALIBRATION_ENABLE == TRUE
+    /* the configurations are calibration parameters, the curves follow changes of the XCP master */
+    SOF_CalculateCurves(&sox_sof_config_maxAllowedCurrent, &sofCurveRecOperatingCurrent);
+#if BMS_TEST_CELL_SOF_LIMITS == TRUE
+    SOF_CalculateCurves(&sox_sof_config_MOL, &sofCurve_MOL);
+    SOF_CalculateCurves(&sox_sof_config_RSL, &sofCurve_RSL);
+    SOF_CalculateCurves(&sox_sof_config_MSL, &sofCurve_MSL);
+#endif /* BMS_TEST_CELL_SOF_LIMITS == TRUE */
+#endif /* XCP_CALIBRATION_ENABLE == TRUE */
 
     /* Calculate maximum allowed current depending on current values */
-    SOF_CalculateVoltageBased((float)minvolt, (float)maxvolt, &UbasedSof, &sox_sof_config_maxAllowedCurrent, &sofCurveRecOperatingCurrent);
-    SOF_CalculateSocBased((float)minsoc, (float)maxsoc, &SbasedSof, &sox_sof_config_maxAllowedCurrent, &sofCurveRecOperatingCurrent);
-    SOF_CalculateTemperatureBased((float)mintemp, (float)maxtemp, &TbasedSof, &sox_sof_config_maxAllowedCurrent, &sofCurveRecOperatingCurrent);
-    SOF_MinimumOfThreeSofValues(UbasedSof, SbasedSof, TbasedSof, &sof_recOperatingCurrent);
+    SOF_CalculateLevel((float)minvolt, (float)maxvolt, (float)minsoc, (float)maxsoc, (float)mintemp, (float)maxtemp,
+            &sox_sof_config_maxAllowedCurrent, &sofCurveRecOperatingCurrent, &sof_recOperatingCurrent);
+
+    /* Derate the recommended currents with the estimated cell resistance, the limit levels stay fixed */
+    sof_recOperatingCurrent.current_Charge_cont_max *= factor;
+    sof_recOperatingCurrent.current_Charge_peak_max *= factor;
+    sof_recOperatingCurrent.current_Discha_cont_max *= factor;
+    sof_recOperatingCurrent.current_Discha_peak_max *= factor;
 
 #if BMS_TEST_CELL_SOF_LIMITS == TRUE
     /* Calculate maximum allowed current MOL level */
-    SOF_CalculateVoltageBased((float)minvolt, (float)maxvolt, &UbasedSof, &sox_sof_config_MOL, &sofCurve_MOL);
-    SOF_CalculateSocBased((float)minsoc, (float)maxsoc, &SbasedSof, &sox_sof_config_MOL, &sofCurve_MOL);
-    SOF_CalculateTemperatureBased((float)mintemp, (float)maxtemp, &TbasedSof, &sox_sof_config_MOL, &sofCurve_MOL);
-    SOF_MinimumOfThreeSofValues(UbasedSof, SbasedSof, TbasedSof, &sof_mol_Level);
+    SOF_CalculateLevel((float)minvolt, (float)maxvolt, (float)minsoc, (float)maxsoc, (float)mintemp, (float)maxtemp,
+            &sox_sof_config_MOL, &sofCurve_MOL, &sof_mol_Level);
 
     /* Calculate maximum allowed current RSL level */
-    SOF_CalculateVoltageBased((float)minvolt, (float)maxvolt, &UbasedSof, &sox_sof_config_RSL, &sofCurve_RSL);
-    SOF_CalculateSocBased((float)minsoc, (float)maxsoc, &SbasedSof, &sox_sof_config_RSL, &sofCurve_RSL);
-    SOF_CalculateTemperatureBased((float)mintemp, (float)maxtemp, &TbasedSof, &sox_sof_config_RSL, &sofCurve_RSL);
-    SOF_MinimumOfThreeSofValues(UbasedSof, SbasedSof, TbasedSof, &sof_rsl_Level);
+    SOF_CalculateLevel((float)minvolt, (float)maxvolt, (float)minsoc, (float)maxsoc, (float)mintemp, (float)maxtemp,
+            &sox_sof_config_RSL, &sofCurve_RSL, &sof_rsl_Level);
 
     /* Calculate maximum allowed current MSL level */
-    SOF_CalculateVoltageBased((float)minvolt, (float)maxvolt, &UbasedSof, &sox_sof_config_MSL, &sofCurve_MSL);
-    SOF_CalculateSocBased((float)minsoc, (float)maxsoc, &SbasedSof, &sox_sof_config_MSL, &sofCurve_MSL);
-    SOF_CalculateTemperatureBased((float)mintemp, (float)maxtemp, &TbasedSof, &sox_sof_config_MSL, &sofCurve_MSL);
-    SOF_MinimumOfThreeSofValues(UbasedSof, SbasedSof, TbasedSof, &sof_msl_Level);
-#else
-    sof_mol_Level.current_Charge_cont_max = BC_CURRENTMAX_CHARGE_MOL;
-    sof_mol_Level.current_Discha_cont_max = BC_CURRENTMAX_DISCHARGE_MOL;
-    sof_rsl_Level.current_Charge_cont_max = BC_CURRENTMAX_CHARGE_MOL;
-    sof_rsl_Level.current_Discha_cont_max = BC_CURRENTMAX_DISCHARGE_MOL;
-    sof_msl_Level.current_Charge_cont_max = BC_CURRENTMAX_CHARGE_MOL;
-    sof_msl_Level.current_Discha_cont_max = BC_CURRENTMAX_DISCHARGE_MOL;
-#endif
+    SOF_CalculateLevel((float)minvolt, (float)maxvolt, (float)minsoc, (float)maxsoc, (float)mintemp, (float)maxtemp,
+            &sox_sof_config_MSL, &sofCurve_MSL, &sof_msl_Level);
+#endif /* BMS_TEST_CELL_SOF_LIMITS == TRUE */
+}
+
+/**
+ * @brief   gets the derating factor of the SOF currents from the estimated cell resistance
+ *
+ * The currents are scaled with sqrt(R_model / R_estimated), so the power
+ * dissipated in the cell with the highest resistance stays at the value of
+ * the cell model. A resistance below the model does not raise the currents.
+ *
+ * @return  derating factor in 0.1% (SOX_SOF_MIN_RESISTANCE_FACTOR*1000..1000)
+ */
+static uint16_t SOF_GetResistanceFactor(void) {
+    float modelResistance = SOX_EKF_R0_OHM + SOX_EKF_R1_OHM;
+    float maxResistance = SOX_RLS_GetMaxResistance();
+    float factor = 1.0f;
+
+    if (maxResistance > modelResistance) {
+        factor = sqrtf(modelResistance / maxResistance);
+        if (factor < SOX_SOF_MIN_RESISTANCE_FACTOR) {
+            factor = SOX_SOF_MIN_RESISTANCE_FACTOR;
+        }
+    }
+    return (uint16_t)(1000.0f * factor);
+}
+
+/**
+ * @brief   calculates the SoF of one limit level as minimum of the voltage, SoC and temperature based derating
+ *
+ * @param   minvolt             minimum cell voltage in mV
+ * @param   maxvolt             maximum cell voltage in mV
+ * @param   minsoc              minimum SoC with resolution 0.01%
+ * @param   maxsoc              maximum SoC with resolution 0.01%
+ * @param   mintemp             minimum cell temperature in &deg;C
+ * @param   maxtemp             maximum cell temperature in &deg;C
+ * @param   configLimitValues   limits of the level
+ * @param   calcCurveValues     derating curves of the level, precomputed by SOF_CalculateCurves()
+ * @param   resultValues        pointer where to store the results
+ */
+static void SOF_CalculateLevel(float minvolt, float maxvolt, float minsoc, float maxsoc, float mintemp, float maxtemp, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues, SOX_SOF_s *resultValues) {
+    SOX_SOF_s UbasedSof = {0.0, 0.0, 0.0, 0.0};
+    SOX_SOF_s SbasedSof = {0.0, 0.0, 0.0, 0.0};
+    SOX_SOF_s TbasedSof = {0.0, 0.0, 0.0, 0.0};
+
+    SOF_CalculateVoltageBased(minvolt, maxvolt, &UbasedSof, configLimitValues, calcCurveValues);
+    SOF_CalculateSocBased(minsoc, maxsoc, &SbasedSof, configLimitValues, calcCurveValues);
+    SOF_CalculateTemperatureBased(mintemp, maxtemp, &TbasedSof, configLimitValues, calcCurveValues);
+    SOF_MinimumOfThreeSofValues(UbasedSof, SbasedSof, TbasedSof, resultValues);
 }
 
 /**
@@ -475,33 +661,16 @@ static void SOF_Calculate(int16_t maxtemp, int16_t mintemp, uint16_t maxvolt, ui
  *  @param  MaxVoltage maximum cell voltage
  *  @param  ResultValues Voltage-based SOF
  */
-static void SOF_CalculateVoltageBased(float MinVoltage, float MaxVoltage, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues) {
-    /* min voltage issues */
-    if (MinVoltage <= configLimitValues->Limit_Voltage_Discha) {
-        ResultValues->current_Discha_cont_max = 0;
-        ResultValues->current_Discha_peak_max = 0;
-    } else {
-        if (MinVoltage <= configLimitValues->Cutoff_Voltage_Discha) {
-            ResultValues->current_Discha_cont_max = (calcCurveValues->Slope_VoltageDischa * (MinVoltage-configLimitValues->Limit_Voltage_Discha));
-            ResultValues->current_Discha_peak_max = ResultValues->current_Discha_cont_max;
-        } else {
-            ResultValues->current_Discha_cont_max = configLimitValues->I_DischaMax_Cont;
-            ResultValues->current_Discha_peak_max = configLimitValues->I_DischaMax_Cont;
-        }
-    }
-    /* max voltage issues */
-    if (MaxVoltage >= configLimitValues->Limit_Voltage_Charge) {
-        ResultValues->current_Charge_cont_max = 0;
-        ResultValues->current_Charge_peak_max = 0;
-    } else {
-        if (MaxVoltage >= configLimitValues->Cutoff_Voltage_Charge) {
-            ResultValues->current_Charge_cont_max =  (calcCurveValues->Slope_VoltageCharge * (MaxVoltage- configLimitValues->Limit_Voltage_Charge));
-            ResultValues->current_Charge_peak_max = ResultValues->current_Charge_cont_max;
-        } else {
-            ResultValues->current_Charge_cont_max = configLimitValues->I_ChargeMax_Cont;
-            ResultValues->current_Charge_peak_max = configLimitValues->I_ChargeMax_Cont;
-        }
-    }
+static void SOF_CalculateVoltageBased(float MinVoltage, float MaxVoltage, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues) {
+    /* min voltage issues: 0 below limit, linear up to full current at cutoff */
+    ResultValues->current_Discha_cont_max = SOF_EvaluateCurve(MinVoltage, calcCurveValues->Slope_VoltageDischa, calcCurveValues->Offset_VoltageDischa,
+            0.0f, configLimitValues->I_DischaMax_Cont);
+    ResultValues->current_Discha_peak_max = ResultValues->current_Discha_cont_max;
+
+    /* max voltage issues: full current below cutoff, linear down to 0 at limit */
+    ResultValues->current_Charge_cont_max = SOF_EvaluateCurve(MaxVoltage, calcCurveValues->Slope_VoltageCharge, calcCurveValues->Offset_VoltageCharge,
+            0.0f, configLimitValues->I_ChargeMax_Cont);
+    ResultValues->current_Charge_peak_max = ResultValues->current_Charge_cont_max;
 }
 
 /**
@@ -511,34 +680,16 @@ static void SOF_CalculateVoltageBased(float MinVoltage, float MaxVoltage, SOX_SO
  * @param   MaxSoc maximum State of Charge
  * @param   ResultValues pointer where to store the results
  */
-static void SOF_CalculateSocBased(float MinSoc, float MaxSoc, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues) {
-    /* min voltage issues */
-    if (MinSoc <= configLimitValues->Limit_Soc_Discha) {
-        ResultValues->current_Discha_cont_max = configLimitValues->I_Limphome;
-        ResultValues->current_Discha_peak_max = configLimitValues->I_Limphome;
-    } else {
-        if (MinSoc <= configLimitValues->Cutoff_Soc_Discha) {
-            ResultValues->current_Discha_cont_max =  calcCurveValues->Slope_SocDischa * MinSoc + calcCurveValues->Offset_SocDischa;
-            ResultValues->current_Discha_peak_max =  ResultValues->current_Discha_cont_max;
-        } else {
-            ResultValues->current_Discha_cont_max =  configLimitValues->I_DischaMax_Cont;
-            ResultValues->current_Discha_peak_max =  configLimitValues->I_DischaMax_Cont;
-        }
-    }
-
-    /* max voltage issues */
-    if (MaxSoc >= configLimitValues->Limit_Soc_Charge) {
-        ResultValues->current_Charge_cont_max = 0;
-        ResultValues->current_Charge_peak_max = 0;
-    } else {
-        if (MaxSoc >= configLimitValues->Cutoff_Soc_Charge) {
-            ResultValues->current_Charge_cont_max =  calcCurveValues->Slope_SocCharge * MaxSoc + calcCurveValues->Offset_SocCharge;
-            ResultValues->current_Charge_peak_max = ResultValues->current_Charge_cont_max;
-        } else {
-            ResultValues->current_Charge_cont_max = configLimitValues->I_ChargeMax_Cont;
-            ResultValues->current_Charge_peak_max = configLimitValues->I_ChargeMax_Cont;
-        }
-    }
+static void SOF_CalculateSocBased(float MinSoc, float MaxSoc, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues) {
+    /* min SoC issues: limp home current below limit, linear up to full current at cutoff */
+    ResultValues->current_Discha_cont_max = SOF_EvaluateCurve(MinSoc, calcCurveValues->Slope_SocDischa, calcCurveValues->Offset_SocDischa,
+            configLimitValues->I_Limphome, configLimitValues->I_DischaMax_Cont);
+    ResultValues->current_Discha_peak_max = ResultValues->current_Discha_cont_max;
+
+    /* max SoC issues: full current below cutoff, linear down to 0 at limit */
+    ResultValues->current_Charge_cont_max = SOF_EvaluateCurve(MaxSoc, calcCurveValues->Slope_SocCharge, calcCurveValues->Offset_SocCharge,
+            0.0f, configLimitValues->I_ChargeMax_Cont);
+    ResultValues->current_Charge_peak_max = ResultValues->current_Charge_cont_max;
 }
 
 /**
@@ -548,76 +699,47 @@ static void SOF_CalculateSocBased(float MinSoc, float MaxSoc, SOX_SOF_s *ResultV
  * @param   MaxTemp maximum temperature of cells
  * @param   ResultValues pointer where to store the results
  */
-static void  SOF_CalculateTemperatureBased(float MinTemp, float MaxTemp, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, SOF_curve_s* calcCurveValues) {
-    SOX_SOF_s dummyResultValues = {0.0, 0.0, 0.0, 0.0};
-    /* Temperature low Discharge */
-    if (MinTemp <= configLimitValues->Limit_TLow_Discha) {
-        ResultValues->current_Discha_cont_max = configLimitValues->I_Limphome;
-        ResultValues->current_Discha_peak_max = configLimitValues->I_Limphome;
-    } else {
-        if (MinTemp <= configLimitValues->Cutoff_TLow_Discha) {
-            ResultValues->current_Discha_cont_max = calcCurveValues->Slope_TLowDischa * MinTemp + calcCurveValues->Offset_TLowDischa;
-            ResultValues->current_Discha_peak_max = ResultValues->current_Discha_cont_max;
-        } else {
-            ResultValues->current_Discha_cont_max = configLimitValues->I_DischaMax_Cont;
-            ResultValues->current_Discha_peak_max = configLimitValues->I_DischaMax_Cont;
-        }
-    }
-    /* Temperature low charge */
-    if (MinTemp <= configLimitValues->Limit_TLow_Charge) {
-        ResultValues->current_Charge_cont_max = 0;
-        ResultValues->current_Charge_peak_max = 0;
-    } else {
-        if (MinTemp <= configLimitValues->Cutoff_TLow_Charge) {
-            ResultValues->current_Charge_cont_max = calcCurveValues->Slope_TLowCharge * MinTemp + calcCurveValues->Offset_TLowCharge;
-            ResultValues->current_Charge_peak_max = ResultValues->current_Charge_cont_max;
-        } else {
-            ResultValues->current_Charge_cont_max =  configLimitValues->I_ChargeMax_Cont;
-            ResultValues->current_Charge_peak_max =  configLimitValues->I_ChargeMax_Cont;
-        }
-    }
-    /* Temperature high discharge */
-    if (MaxTemp >= configLimitValues->Limit_THigh_Discha) {
-        ResultValues->current_Discha_cont_max = 0;
-        ResultValues->current_Discha_peak_max = 0;
-        dummyResultValues.current_Discha_cont_max = 0;
-        dummyResultValues.current_Discha_peak_max = 0;
-    } else {
-        if (MaxTemp >= configLimitValues->Cutoff_THigh_Discha) {
-            dummyResultValues.current_Discha_cont_max = (calcCurveValues->Slope_THighDischa * MaxTemp + calcCurveValues->Offset_THighDischa);
-            dummyResultValues.current_Discha_peak_max = dummyResultValues.current_Discha_cont_max;
-        } else {
-            /* do nothing because this situation is handled with MinTemp */
-            dummyResultValues.current_Discha_cont_max = configLimitValues->I_DischaMax_Cont;
-            dummyResultValues.current_Discha_peak_max = configLimitValues->I_DischaMax_Cont;
-        }
-        /* take the smaller current as limit */
-        if (dummyResultValues.current_Discha_cont_max < ResultValues->current_Discha_cont_max)
-            ResultValues->current_Discha_cont_max = dummyResultValues.current_Discha_cont_max;
-        if (dummyResultValues.current_Discha_peak_max < ResultValues->current_Discha_peak_max)
-            ResultValues->current_Discha_peak_max = dummyResultValues.current_Discha_peak_max;
-    }
-    /* Temperature high Charge */
-    if (MaxTemp >= configLimitValues->Limit_THigh_Charge) {
-        ResultValues->current_Charge_cont_max = 0;
-        ResultValues->current_Charge_peak_max = 0;
-        dummyResultValues.current_Charge_cont_max = 0;
-        dummyResultValues.current_Charge_peak_max = 0;
-    } else {
-        if (MaxTemp >= configLimitValues->Cutoff_THigh_Charge) {
-            dummyResultValues.current_Charge_cont_max = (calcCurveValues->Slope_THighCharge * MaxTemp + calcCurveValues->Offset_THighCharge);
-            dummyResultValues.current_Charge_peak_max = dummyResultValues.current_Charge_cont_max;
-        } else {
-            /* do nothing because this situation is handled with MinTemp */
-            dummyResultValues.current_Charge_cont_max = configLimitValues->I_ChargeMax_Cont;
-            dummyResultValues.current_Charge_peak_max = configLimitValues->I_ChargeMax_Cont;
-        }
-        /* take the smaller current as limit */
-        if (dummyResultValues.current_Charge_cont_max < ResultValues->current_Charge_cont_max)
-            ResultValues->current_Charge_cont_max = dummyResultValues.current_Charge_cont_max;
-        if (dummyResultValues.current_Charge_peak_max < ResultValues->current_Charge_peak_max)
-            ResultValues->current_Charge_peak_max = dummyResultValues.current_Charge_peak_max;
-    }
+static void  SOF_CalculateTemperatureBased(float MinTemp, float MaxTemp, SOX_SOF_s *ResultValues, const SOX_SOF_CONFIG_s *configLimitValues, const SOF_curve_s* calcCurveValues) {
+    float lowTempCurrent = 0.0f;
+    float highTempCurrent = 0.0f;
+
+    /* Discharge: derating at low temperature down to limp home current, at high temperature down to 0 */
+    lowTempCurrent = SOF_EvaluateCurve(MinTemp, calcCurveValues->Slope_TLowDischa, calcCurveValues->Offset_TLowDischa,
+            configLimitValues->I_Limphome, configLimitValues->I_DischaMax_Cont);
+    highTempCurrent = SOF_EvaluateCurve(MaxTemp, calcCurveValues->Slope_THighDischa, calcCurveValues->Offset_THighDischa,
+            0.0f, configLimitValues->I_DischaMax_Cont);
+    ResultValues->current_Discha_cont_max = (lowTempCurrent < highTempCurrent) ? lowTempCurrent : highTempCurrent;
+    ResultValues->current_Discha_peak_max = ResultValues->current_Discha_cont_max;
+
+    /* Charge: derating at low and at high temperature down to 0 */
+    lowTempCurrent = SOF_EvaluateCurve(MinTemp, calcCurveValues->Slope_TLowCharge, calcCurveValues->Offset_TLowCharge,
+            0.0f, configLimitValues->I_ChargeMax_Cont);
+    highTempCurrent = SOF_EvaluateCurve(MaxTemp, calcCurveValues->Slope_THighCharge, calcCurveValues->Offset_THighCharge,
+            0.0f, configLimitValues->I_ChargeMax_Cont);
+    ResultValues->current_Charge_cont_max = (lowTempCurrent < highTempCurrent) ? lowTempCurrent : highTempCurrent;
+    ResultValues->current_Charge_peak_max = ResultValues->current_Charge_cont_max;
+}
+
+/**
+ * @brief   evaluates a derating curve, i.e., a straight line limited to a lower and an upper value
+ *
+ * Written with conditional assignments only, so that the compiler can
+ * generate code without branches.
+ *
+ * @param   x           input value
+ * @param   slope       slope of the curve, precomputed by SOF_CalculateCurves()
+ * @param   offset      offset of the curve, precomputed by SOF_CalculateCurves()
+ * @param   lowerLimit  minimum value of the result
+ * @param   upperLimit  maximum value of the result
+ *
+ * @return  limited value of the curve at x
+ */
+static float SOF_EvaluateCurve(float x, float slope, float offset, float lowerLimit, float upperLimit) {
+    float result = slope * x + offset;
+
+    result = (result < lowerLimit) ? lowerLimit : result;
+    result = (result > upperLimit) ? upperLimit : result;
+    return result;
 }
 
 /**
@@ -645,19 +767,9 @@ static void SOF_MinimumOfThreeSofValues(SOX_SOF_s Ubased, SOX_SOF_s Sbased, SOX_
  * @return minimum of the 3 parameters
  */
 static float SOF_MinimumOfThreeValues(float value1, float value2, float value3) {
-    float result = 0.0;
-    if (value1 <= value2) {
-        if (value3 <= value1) {
-            result = value3;
-        } else {
-            result = value1;
-        }
-    } else {
-        if (value3 <= value2) {
-            result = value3;
-        } else {
-            result = value2;
-        }
-    }
+    float result = value1;
+
+    result = (value2 < result) ? value2 : result;
+    result = (value3 < result) ? value3 : result;
     return result;
 }
@@ -67,6 +67,11 @@ typedef struct {
     float cc_scaling_min;    /*!< scaling for the C-C value from sensor for min value */
     float cc_scaling_max;    /*!< scaling for the C-C value from sensor for max value */
     uint8_t counter;                        /*!< general purpose counter */
+    int64_t charge_counter_mAms;    /*!< charge integrated since last SOC reference, in mA*ms, positive in discharge direction */
+    uint32_t charge_counter_samples;        /*!< number of current samples integrated into charge_counter_mAms */
+    float soc_ref_min;       /*!< SOC min value at the time charge_counter_mAms was reset */
+    float soc_ref_max;       /*!< SOC max value at the time charge_counter_mAms was reset */
+    float soc_ref_mean;      /*!< SOC mean value at the time charge_counter_mAms was reset */
 } SOX_STATE_s;
 
 
@@ -94,6 +99,16 @@ typedef struct {
     float reserved4;/*!< reserved for future use */
 } SOX_SOC_s;
 
+/**
+ * state of health (SOH) related values learned during operation. Stored in
+ * the nonvolatile memory.
+ */
+typedef struct {
+    float capacity_mAh;     /*!< estimated cell capacity in mAh */
+    float variance;         /*!< variance of the capacity estimate in mAh^2 */
+    uint32_t nr_of_updates; /*!< number of capacity measurements */
+} SOX_SOH_s;
+
 /**
  * struct definition for calculating the linear SOF curve. The SOF curve is SOC,
  * voltage, temperature and charge/discharge dependent.
@@ -154,6 +169,40 @@ extern void SOC_SetValue(float soc_value_min, float soc_value_max, float soc_val
  */
 extern void SOC_RecalibrateViaLookupTable(void);
 
+/**
+ * @brief   gets the SOC of a relaxed cell by inverting the open circuit
+ *          voltage curve sox_ocv_voltage_mV
+ *
+ * @param   voltage_mV  open circuit voltage of the cell in mV
+ *
+ * @return  SOC value from 0.0% - 100.0%
+ */
+extern float SOC_GetFromVoltage(uint16_t voltage_mV);
+
+/**
+ * @brief   requests a correction of the SOC values, e.g., by a model based estimator
+ *
+ * The correction is applied with SOC_SetValue() at the next call of
+ * SOC_Calculation(), so this function can be called from any task.
+ *
+ * @param   soc_value_min   SOC min value to set
+ * @param   soc_value_max   SOC max value to set
+ * @param   soc_value_mean  SOC mean value to set
+ */
+extern void SOC_RequestCorrection(float soc_value_min, float soc_value_max, float soc_value_mean);
+
+/**
+ * @brief   integrates one current sensor sample into the coulomb counter
+ *
+ * Called on every received current measurement. The charge is accumulated as
+ * integer in mA*ms, so no precision is lost regardless of the run duration.
+ * The conversion to SOC is done on read in SOC_Calculation().
+ *
+ * @param   current_mA      measured current in mA (sign as delivered by the sensor)
+ * @param   timestep_ms     time since the previous current sample in ms
+ */
+extern void SOC_AddCurrentSample(int32_t current_mA, uint32_t timestep_ms);
+
 /**
  * @brief   integrates current over time to calculate SOC.
  */
@@ -0,0 +1,388 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_ekf.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Extended Kalman filter (EKF) SOC estimator
+ *
+ * Every cell is modeled by an equivalent circuit consisting of the open
+ * circuit voltage OCV(SOC), a series resistance R0 and two RC elements. The
+ * state vector is x = [SOC, V1, V2] with SOC in the range [0,1] and the RC
+ * voltages in V. As the state transition matrix is diagonal and only the cell
+ * voltage is measured, the filter needs neither a matrix multiplication of
+ * full matrices nor a matrix inversion. All kernels work on fixed-size
+ * arrays in single precision to use the FPU of the Cortex-M4.
+ */
+
+/*================== Includes =============================================*/
+#include "sox_ekf.h"
+
+#include "batterysystem_cfg.h"
+#include "database.h"
+#include "foxmath.h"
+#include "lut.h"
+#include "sox_rls.h"
+#include "sox_soh.h"
+
+#include <math.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * number of states of the cell model: SOC, V1, V2
+ */
+#define SOX_EKF_NR_OF_STATES            3
+
+/**
+ * indexes of the states in the state vector
+ */
+#define SOX_EKF_STATE_SOC               0
+#define SOX_EKF_STATE_V1                1
+#define SOX_EKF_STATE_V2                2
+
+/**
+ * voltage sampling intervals longer than this are not used for a filter
+ * step, the filter restarts its prediction with the next sample
+ */
+#define SOX_EKF_MAX_TIMESTEP_MS         2000
+
+/**
+ * state of the EKF of one cell
+ */
+typedef struct {
+    float x[SOX_EKF_NR_OF_STATES];                          /*!< state vector [SOC, V1, V2]  */
+    float P[SOX_EKF_NR_OF_STATES][SOX_EKF_NR_OF_STATES];    /*!< state covariance matrix     */
+} SOX_EKF_CELL_s;
+
+/**
+ * filter step in progress, processed in chunks of cells
+ */
+typedef struct {
+    uint8_t pending;        /*!< TRUE while cells of the step are left                  */
+    uint16_t nextCell;      /*!< next cell to process                                   */
+    float current;          /*!< cell current in A, discharge direction positive        */
+    float socFactor;        /*!< SOC change per A of the cell current                   */
+} SOX_EKF_STEP_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static SOX_EKF_CELL_s sox_ekf_cell[BS_NR_OF_BAT_CELLS];
+
+static DATA_BLOCK_CELLVOLTAGE_s sox_ekf_cellvoltage;
+static DATA_BLOCK_CURRENT_SENSOR_s sox_ekf_current;
+
+static uint8_t sox_ekf_initialized = FALSE;
+static uint32_t sox_ekf_previous_timestamp = 0;
+static SOX_EKF_STEP_s sox_ekf_step = {.pending = FALSE};
+
+/** @{
+ * discrete time RC element coefficients, cached for the last used time step
+ */
+static uint32_t sox_ekf_cached_timestep_ms = 0;
+static float sox_ekf_a1 = 0.0f;
+static float sox_ekf_a2 = 0.0f;
+static float sox_ekf_b2 = 0.0f;
+/** @} */
+
+/*================== Function Prototypes ==================================*/
+static void SOX_EKF_Init(void);
+static void SOX_EKF_UpdateCoefficients(uint32_t timestep_ms);
+static void SOX_EKF_Predict(SOX_EKF_CELL_s *cell, float current, float socFactor, float r1);
+static void SOX_EKF_Correct(SOX_EKF_CELL_s *cell, float current, float voltage, float r0);
+
+/*================== Function Implementations =============================*/
+
+/* OCV points are equally spaced over SOC 0 ... 1, the EKF may leave this range slightly */
+LUT_DEFINE_GRID_FLOAT(SOX_EKF_InterpolateOcv, uint16_t, , 0.0f, 1.0f / (float)(SOX_OCV_NR_OF_POINTS - 1), LUT_EXTRAPOLATE)
+
+uint8_t SOX_EKF_Update(uint16_t maxNrOfCells) {
+    uint32_t timestep_ms = 0;
+    uint32_t module = 0;
+    uint32_t cellInModule = 0;
+    uint16_t lastCell = 0;
+    float r0 = 0.0f;
+    float r1 = 0.0f;
+#if SOX_EKF_CORRECT_SOC == TRUE
+    SOX_SOC_s soc;
+    float maxVariance = 0.0f;
+#endif /* SOX_EKF_CORRECT_SOC == TRUE */
+
+    if (sox_ekf_step.pending == FALSE) {
+        DB_ReadBlock(&sox_ekf_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+        DB_ReadBlock(&sox_ekf_current, DATA_BLOCK_ID_CURRENT_SENSOR);
+
+        if (sox_ekf_cellvoltage.timestamp == sox_ekf_previous_timestamp) {
+            /* no new cell voltages */
+            return TRUE;
+        }
+        timestep_ms = sox_ekf_cellvoltage.timestamp - sox_ekf_previous_timestamp;
+        sox_ekf_previous_timestamp = sox_ekf_cellvoltage.timestamp;
+
+        if (sox_ekf_initialized == FALSE) {
+            SOX_EKF_Init();
+            return TRUE;
+        }
+
+        if ((timestep_ms > SOX_EKF_MAX_TIMESTEP_MS) || (sox_ekf_current.state_current != 0)) {
+            /* no valid input for the prediction step */
+            return TRUE;
+        }
+
+        SOX_EKF_UpdateCoefficients(timestep_ms);
+
+        /* model works with current in discharge direction positive, in A */
+        if (POSITIVE_DISCHARGE_CURRENT == TRUE) {
+            sox_ekf_step.current = (float)sox_ekf_current.current / 1000.0f;
+        } else {
+            sox_ekf_step.current = -(float)sox_ekf_current.current / 1000.0f;
+        }
+        /* SOC change per A of the cell current, based on the estimated capacity */
+        sox_ekf_step.socFactor = ((float)timestep_ms / 1000.0f) / (SOX_SOH_GetCapacity() * 3.6f);
+        sox_ekf_step.nextCell = 0;
+        sox_ekf_step.pending = TRUE;
+    }
+
+    lastCell = sox_ekf_step.nextCell + maxNrOfCells;
+    if (lastCell > BS_NR_OF_BAT_CELLS) {
+        lastCell = BS_NR_OF_BAT_CELLS;
+    }
+
+    for (uint16_t i = sox_ekf_step.nextCell; i < lastCell; i++) {
+        (void)SOX_RLS_GetCellResistance(i, &r0, &r1);
+        SOX_EKF_Predict(&sox_ekf_cell[i], sox_ekf_step.current, sox_ekf_step.socFactor, r1);
+
+        module = i / BS_NR_OF_BAT_CELLS_PER_MODULE;
+        cellInModule = i % BS_NR_OF_BAT_CELLS_PER_MODULE;
+        if ((sox_ekf_cellvoltage.valid_volt[module] & (1u << cellInModule)) == 0) {
+            SOX_EKF_Correct(&sox_ekf_cell[i], sox_ekf_step.current, (float)sox_ekf_cellvoltage.voltage[i] / 1000.0f, r0);
+        }
+    }
+
+    sox_ekf_step.nextCell = lastCell;
+    if (lastCell < BS_NR_OF_BAT_CELLS) {
+        return FALSE;
+    }
+    sox_ekf_step.pending = FALSE;
+
+#if SOX_EKF_CORRECT_SOC == TRUE
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        if (sox_ekf_cell[i].P[SOX_EKF_STATE_SOC][SOX_EKF_STATE_SOC] > maxVariance) {
+            maxVariance = sox_ekf_cell[i].P[SOX_EKF_STATE_SOC][SOX_EKF_STATE_SOC];
+        }
+    }
+    if ((maxVariance < SOX_EKF_CONVERGED_VARIANCE) && (SOX_EKF_GetSoc(&soc) == E_OK)) {
+        SOC_RequestCorrection(soc.min, soc.max, soc.mean);
+    }
+#endif /* SOX_EKF_CORRECT_SOC == TRUE */
+    return TRUE;
+}
+
+
+STD_RETURN_TYPE_e SOX_EKF_GetSoc(SOX_SOC_s *dest_ptr) {
+    float soc = 0.0f;
+    float soc_min = 1.0f;
+    float soc_max = 0.0f;
+    float soc_sum = 0.0f;
+
+    if (sox_ekf_initialized == FALSE) {
+        return E_NOT_OK;
+    }
+
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        soc = sox_ekf_cell[i].x[SOX_EKF_STATE_SOC];
+        soc_sum += soc;
+        if (soc < soc_min) {
+            soc_min = soc;
+        }
+        if (soc > soc_max) {
+            soc_max = soc;
+        }
+    }
+
+    dest_ptr->min = 100.0f * soc_min;
+    dest_ptr->max = 100.0f * soc_max;
+    dest_ptr->mean = 100.0f * soc_sum / (float)BS_NR_OF_BAT_CELLS;
+
+    return E_OK;
+}
+
+
+STD_RETURN_TYPE_e SOX_EKF_GetCellState(uint16_t cellIdx, float *soc, float *v1, float *v2) {
+    if ((sox_ekf_initialized == FALSE) || (cellIdx >= BS_NR_OF_BAT_CELLS)) {
+        return E_NOT_OK;
+    }
+
+    *soc = sox_ekf_cell[cellIdx].x[SOX_EKF_STATE_SOC];
+    *v1 = sox_ekf_cell[cellIdx].x[SOX_EKF_STATE_V1];
+    *v2 = sox_ekf_cell[cellIdx].x[SOX_EKF_STATE_V2];
+
+    return E_OK;
+}
+
+
+/**
+ * @brief   initializes the state of every cell from its voltage, assuming the cell is relaxed
+ */
+static void SOX_EKF_Init(void) {
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        for (uint8_t r = 0; r < SOX_EKF_NR_OF_STATES; r++) {
+            sox_ekf_cell[i].x[r] = 0.0f;
+            for (uint8_t c = 0; c < SOX_EKF_NR_OF_STATES; c++) {
+                sox_ekf_cell[i].P[r][c] = 0.0f;
+            }
+        }
+        sox_ekf_cell[i].x[SOX_EKF_STATE_SOC] = SOC_GetFromVoltage(sox_ekf_cellvoltage.voltage[i]) / 100.0f;
+        sox_ekf_cell[i].P[SOX_EKF_STATE_SOC][SOX_EKF_STATE_SOC] = SOX_EKF_INITIAL_VARIANCE_SOC;
+        sox_ekf_cell[i].P[SOX_EKF_STATE_V1][SOX_EKF_STATE_V1] = SOX_EKF_PROCESS_NOISE_V1;
+        sox_ekf_cell[i].P[SOX_EKF_STATE_V2][SOX_EKF_STATE_V2] = SOX_EKF_PROCESS_NOISE_V2;
+    }
+    sox_ekf_initialized = TRUE;
+}
+
+
+/**
+ * @brief   computes the discrete time coefficients of the RC elements
+ *
+ * V(k+1) = a * V(k) + b * I(k) with a = exp(-dt/tau) and b = R * (1 - a).
+ * The exponential is only evaluated if the time step changes. The factor b
+ * of the first RC element depends on the estimated R1 of the cell and is
+ * computed in the prediction step.
+ *
+ * @param   timestep_ms     time step in ms
+ */
+static void SOX_EKF_UpdateCoefficients(uint32_t timestep_ms) {
+    float timestep = 0.0f;
+
+    if (timestep_ms != sox_ekf_cached_timestep_ms) {
+        sox_ekf_cached_timestep_ms = timestep_ms;
+        timestep = (float)timestep_ms / 1000.0f;
+        sox_ekf_a1 = expf(-timestep / SOX_EKF_TAU1_S);
+        sox_ekf_a2 = expf(-timestep / SOX_EKF_TAU2_S);
+        sox_ekf_b2 = SOX_EKF_R2_OHM * (1.0f - sox_ekf_a2);
+    }
+}
+
+
+float SOX_EKF_GetOcv(float soc, float *slope) {
+    float ocv_mV = SOX_EKF_InterpolateOcv(sox_ocv_voltage_mV, SOX_OCV_NR_OF_POINTS, soc, slope);
+
+    *slope = *slope / 1000.0f;
+    return ocv_mV / 1000.0f;
+}
+
+
+/**
+ * @brief   EKF prediction step: x = A*x + B*I, P = A*P*A' + Q
+ *
+ * A = diag(1, a1, a2), so A*P*A' reduces to scaling P(r,c) with A(r)*A(c).
+ *
+ * @param   cell        filter state of the cell
+ * @param   current     cell current in A, positive in discharge direction
+ * @param   socFactor   SOC change per A over the time step, i.e. dt/Q
+ * @param   r1          resistance of the first RC element of the cell in Ohm
+ */
+static void SOX_EKF_Predict(SOX_EKF_CELL_s *cell, float current, float socFactor, float r1) {
+    const float a[SOX_EKF_NR_OF_STATES] = {1.0f, sox_ekf_a1, sox_ekf_a2};
+
+    cell->x[SOX_EKF_STATE_SOC] -= current * socFactor;
+    cell->x[SOX_EKF_STATE_V1] = sox_ekf_a1 * cell->x[SOX_EKF_STATE_V1] + r1 * (1.0f - sox_ekf_a1) * current;
+    cell->x[SOX_EKF_STATE_V2] = sox_ekf_a2 * cell->x[SOX_EKF_STATE_V2] + sox_ekf_b2 * current;
+
+    for (uint8_t r = 0; r < SOX_EKF_NR_OF_STATES; r++) {
+        for (uint8_t c = 0; c < SOX_EKF_NR_OF_STATES; c++) {
+            cell->P[r][c] *= a[r] * a[c];
+        }
+    }
+    cell->P[SOX_EKF_STATE_SOC][SOX_EKF_STATE_SOC] += SOX_EKF_PROCESS_NOISE_SOC;
+    cell->P[SOX_EKF_STATE_V1][SOX_EKF_STATE_V1] += SOX_EKF_PROCESS_NOISE_V1;
+    cell->P[SOX_EKF_STATE_V2][SOX_EKF_STATE_V2] += SOX_EKF_PROCESS_NOISE_V2;
+}
+
+
+/**
+ * @brief   EKF correction step with the measured cell voltage
+ *
+ * Measurement model: v = OCV(SOC) - V1 - V2 - R0*I, linearized with
+ * H = [dOCV/dSOC, -1, -1]. The innovation covariance is a scalar, so the
+ * Kalman gain is obtained by a single division.
+ *
+ * @param   cell        filter state of the cell
+ * @param   current     cell current in A, positive in discharge direction
+ * @param   voltage     measured cell voltage in V
+ * @param   r0          series resistance of the cell in Ohm
+ */
+static void SOX_EKF_Correct(SOX_EKF_CELL_s *cell, float current, float voltage, float r0) {
+    float H[SOX_EKF_NR_OF_STATES];
+    float PHt[SOX_EKF_NR_OF_STATES];
+    float K[SOX_EKF_NR_OF_STATES];
+    float S = SOX_EKF_MEASUREMENT_NOISE;
+    float ocv = 0.0f;
+    float innovation = 0.0f;
+
+    ocv = SOX_EKF_GetOcv(cell->x[SOX_EKF_STATE_SOC], &H[SOX_EKF_STATE_SOC]);
+    H[SOX_EKF_STATE_V1] = -1.0f;
+    H[SOX_EKF_STATE_V2] = -1.0f;
+
+    innovation = voltage - (ocv - cell->x[SOX_EKF_STATE_V1] - cell->x[SOX_EKF_STATE_V2] - r0 * current);
+
+    for (uint8_t r = 0; r < SOX_EKF_NR_OF_STATES; r++) {
+        PHt[r] = cell->P[r][0] * H[0] + cell->P[r][1] * H[1] + cell->P[r][2] * H[2];
+        S += H[r] * PHt[r];
+    }
+
+    for (uint8_t r = 0; r < SOX_EKF_NR_OF_STATES; r++) {
+        K[r] = PHt[r] / S;
+        cell->x[r] += K[r] * innovation;
+    }
+
+    /* P = P - K*(H*P), evaluated on the upper triangle to keep P symmetric */
+    for (uint8_t r = 0; r < SOX_EKF_NR_OF_STATES; r++) {
+        for (uint8_t c = r; c < SOX_EKF_NR_OF_STATES; c++) {
+            cell->P[r][c] -= K[r] * PHt[c];
+            cell->P[c][r] = cell->P[r][c];
+        }
+    }
+
+    cell->x[SOX_EKF_STATE_SOC] = MATH_clamp_float(cell->x[SOX_EKF_STATE_SOC], 0.0f, 1.0f);
+}
@@ -0,0 +1,117 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_ekf.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Header for the extended Kalman filter (EKF) SOC estimator
+ *
+ */
+
+#ifndef SOX_EKF_H_
+#define SOX_EKF_H_
+
+/*================== Includes =============================================*/
+#include "sox.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   runs the EKF step (prediction and correction) for the next cells
+ *
+ * Called cyclically by the algorithm module. A filter step is only started
+ * if new cell voltages are available in the database. The step is then
+ * processed in chunks of at most maxNrOfCells cells, the following calls
+ * continue with the remaining cells before a new voltage sample is read.
+ * While a step is in progress, the states of the cells are partially updated.
+ *
+ * @param   maxNrOfCells    maximum number of cells to process in this call
+ *
+ * @return  TRUE if no step is in progress anymore, FALSE if cells are left
+ */
+extern uint8_t SOX_EKF_Update(uint16_t maxNrOfCells);
+
+/**
+ * @brief   gets the minimum, maximum and mean SOC estimated by the EKF over all cells
+ *
+ * @param   dest_ptr    pointer where the SOC values are written to
+ *
+ * @return  E_OK if the filter is initialized, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e SOX_EKF_GetSoc(SOX_SOC_s *dest_ptr);
+
+/**
+ * @brief   gets the estimated model state of one cell
+ *
+ * The states are updated by another task, each value is read atomically.
+ *
+ * @param   cellIdx     index of the cell
+ * @param   soc         pointer where the SOC in the range [0,1] is written to
+ * @param   v1          pointer where the voltage of the first RC element in V is written to
+ * @param   v2          pointer where the voltage of the second RC element in V is written to
+ *
+ * @return  E_OK if the filter is initialized and the index is valid, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e SOX_EKF_GetCellState(uint16_t cellIdx, float *soc, float *v1, float *v2);
+
+/**
+ * @brief   gets the open circuit voltage and its derivative for a SOC
+ *
+ * The OCV points are equally spaced, so the segment is found without search.
+ *
+ * @param   soc     SOC in the range [0,1]
+ * @param   slope   pointer where dOCV/dSOC in V is written to
+ *
+ * @return  open circuit voltage in V
+ */
+extern float SOX_EKF_GetOcv(float soc, float *slope);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOX_EKF_H_ */
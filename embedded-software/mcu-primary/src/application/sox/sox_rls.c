@@ -0,0 +1,410 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_rls.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Online estimation of the cell resistances from current steps
+ *
+ * A step of the pack current by more than SOX_RLS_MIN_CURRENT_STEP_mA between
+ * two cell voltage samples starts an identification event. The voltages of
+ * the sample before the step are kept as reference. As long as the current
+ * stays within SOX_RLS_CURRENT_TOLERANCE_mA of its value after the step, every
+ * further voltage sample gives for each cell
+ *
+ *  Vref - V(t) - dOCV/dSOC * I*t/Q = dI * R0 + dI * (1 - exp(-t/tau1)) * R1
+ *
+ * with t the time since the step and dI the current step. R0 and R1 are
+ * solved with a recursive least squares (RLS) estimator with forgetting
+ * factor. The estimator assumes the RC elements to be settled before the
+ * step; the slow second RC element is neglected.
+ *
+ * The expensive part, the RLS update of the cells, is spread over several
+ * calls: a latched voltage sample is processed SOX_RLS_CELLS_PER_CALL cells
+ * at a time and new samples are only taken once it is done.
+ */
+
+/*================== Includes =============================================*/
+#include "sox_rls.h"
+
+#include "batterysystem_cfg.h"
+#include "database.h"
+#include "sox_ekf.h"
+#include "sox_soh.h"
+
+#include <math.h>
+#include <string.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * number of estimated parameters: R0, R1
+ */
+#define SOX_RLS_NR_OF_PARAMETERS        2
+
+/**
+ * voltage sampling intervals longer than this are not used to detect a current step
+ */
+#define SOX_RLS_MAX_TIMESTEP_MS         2000
+
+/**
+ * state of the estimator of one cell
+ */
+typedef struct {
+    float theta[SOX_RLS_NR_OF_PARAMETERS];                          /*!< estimated parameters [R0, R1] in Ohm   */
+    float P[SOX_RLS_NR_OF_PARAMETERS][SOX_RLS_NR_OF_PARAMETERS];    /*!< covariance matrix of the estimate      */
+    uint16_t updates;                                               /*!< number of updates, saturated           */
+} SOX_RLS_CELL_s;
+
+/**
+ * state of the event detection
+ */
+typedef enum {
+    SOX_RLS_STATE_IDLE  = 0,    /*!< waiting for a current step          */
+    SOX_RLS_STATE_EVENT = 1,    /*!< current step detected, collecting   */
+} SOX_RLS_STATE_e;
+
+/**
+ * voltage sample latched for the update of the cells
+ */
+typedef struct {
+    uint16_t voltage[BS_NR_OF_BAT_CELLS];       /*!< cell voltages in mV                        */
+    uint32_t valid_volt[BS_NR_OF_MODULES];      /*!< bitmask of invalid voltages                */
+    float step;                                 /*!< current step dI in A                       */
+    float rcFactor;                             /*!< 1 - exp(-t/tau1)                           */
+    float socChange;                            /*!< SOC change since the step, I*t/Q           */
+    uint16_t nextCell;                          /*!< next cell to update                        */
+    uint8_t pending;                            /*!< TRUE while not all cells are updated       */
+} SOX_RLS_SAMPLE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static SOX_RLS_CELL_s sox_rls_cell[BS_NR_OF_BAT_CELLS];
+static SOX_RLS_SAMPLE_s sox_rls_sample;
+
+/** @{
+ * voltages of the sample before the current step, updated with every sample while idle
+ */
+static uint16_t sox_rls_reference_voltage[BS_NR_OF_BAT_CELLS];
+static uint32_t sox_rls_reference_valid_volt[BS_NR_OF_MODULES];
+/** @} */
+
+static DATA_BLOCK_CELLVOLTAGE_s sox_rls_cellvoltage;
+static DATA_BLOCK_CURRENT_SENSOR_s sox_rls_current;
+static DATA_BLOCK_CELL_RESISTANCE_s sox_rls_resistance;
+
+static SOX_RLS_STATE_e sox_rls_state = SOX_RLS_STATE_IDLE;
+static uint8_t sox_rls_initialized = FALSE;
+static uint8_t sox_rls_previous_valid = FALSE;
+static uint32_t sox_rls_previous_timestamp = 0;
+static float sox_rls_previous_current = 0.0f;
+static uint32_t sox_rls_step_timestamp = 0;
+static float sox_rls_step_current = 0.0f;
+static float sox_rls_max_resistance = SOX_EKF_R0_OHM + SOX_EKF_R1_OHM;
+
+/*================== Function Prototypes ==================================*/
+static void SOX_RLS_Init(void);
+static void SOX_RLS_ProcessSample(void);
+static void SOX_RLS_LatchReference(void);
+static void SOX_RLS_LatchSample(float step, uint32_t time_ms, float current);
+static void SOX_RLS_UpdateCells(void);
+static void SOX_RLS_UpdateCell(SOX_RLS_CELL_s *cell, float phi0, float phi1, float y);
+static void SOX_RLS_WriteResistances(void);
+
+/*================== Function Implementations =============================*/
+
+void SOX_RLS_Update(void) {
+    if (sox_rls_initialized == FALSE) {
+        SOX_RLS_Init();
+    }
+
+    if (sox_rls_sample.pending == TRUE) {
+        SOX_RLS_UpdateCells();
+        return;
+    }
+
+    DB_ReadBlock(&sox_rls_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+    if (sox_rls_cellvoltage.timestamp != sox_rls_previous_timestamp) {
+        DB_ReadBlock(&sox_rls_current, DATA_BLOCK_ID_CURRENT_SENSOR);
+        SOX_RLS_ProcessSample();
+    }
+}
+
+
+STD_RETURN_TYPE_e SOX_RLS_GetCellResistance(uint16_t cellIdx, float *r0, float *r1) {
+    if ((sox_rls_initialized == FALSE) || (cellIdx >= BS_NR_OF_BAT_CELLS)) {
+        *r0 = SOX_EKF_R0_OHM;
+        *r1 = SOX_EKF_R1_OHM;
+        return E_NOT_OK;
+    }
+
+    *r0 = sox_rls_cell[cellIdx].theta[0];
+    *r1 = sox_rls_cell[cellIdx].theta[1];
+
+    if (sox_rls_cell[cellIdx].updates < SOX_RLS_MIN_NR_OF_UPDATES) {
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+
+float SOX_RLS_GetMaxResistance(void) {
+    return sox_rls_max_resistance;
+}
+
+
+/**
+ * @brief   initializes the estimates of all cells with the resistances of the cell model
+ */
+static void SOX_RLS_Init(void) {
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        sox_rls_cell[i].theta[0] = SOX_EKF_R0_OHM;
+        sox_rls_cell[i].theta[1] = SOX_EKF_R1_OHM;
+        sox_rls_cell[i].P[0][0] = SOX_RLS_INITIAL_VARIANCE;
+        sox_rls_cell[i].P[0][1] = 0.0f;
+        sox_rls_cell[i].P[1][0] = 0.0f;
+        sox_rls_cell[i].P[1][1] = SOX_RLS_INITIAL_VARIANCE;
+        sox_rls_cell[i].updates = 0;
+    }
+    sox_rls_sample.pending = FALSE;
+    sox_rls_initialized = TRUE;
+}
+
+
+/**
+ * @brief   runs the event detection for a new cell voltage sample
+ *
+ * Only copies the voltages, the update of the cells is done by SOX_RLS_UpdateCells().
+ */
+static void SOX_RLS_ProcessSample(void) {
+    uint32_t timestep_ms = sox_rls_cellvoltage.timestamp - sox_rls_previous_timestamp;
+    uint32_t time_ms = 0;
+    uint8_t valid = (sox_rls_current.state_current == 0) ? TRUE : FALSE;
+    float current = 0.0f;
+    float step = 0.0f;
+
+    /* estimator works with current in discharge direction positive, in A */
+    if (POSITIVE_DISCHARGE_CURRENT == TRUE) {
+        current = (float)sox_rls_current.current / 1000.0f;
+    } else {
+        current = -(float)sox_rls_current.current / 1000.0f;
+    }
+
+    if (sox_rls_state == SOX_RLS_STATE_EVENT) {
+        time_ms = sox_rls_cellvoltage.timestamp - sox_rls_step_timestamp;
+        if ((valid == FALSE) || (time_ms > SOX_RLS_EVENT_DURATION_MS) ||
+                (fabsf(current - sox_rls_step_current) > ((float)SOX_RLS_CURRENT_TOLERANCE_mA / 1000.0f))) {
+            /* current left the tolerance band: event ends, sample is the new reference */
+            sox_rls_state = SOX_RLS_STATE_IDLE;
+            SOX_RLS_LatchReference();
+            sox_rls_previous_current = current;
+        } else {
+            SOX_RLS_LatchSample(sox_rls_step_current - sox_rls_previous_current, time_ms, current);
+        }
+    } else {
+        step = current - sox_rls_previous_current;
+        if ((valid == TRUE) && (sox_rls_previous_valid == TRUE) && (timestep_ms <= SOX_RLS_MAX_TIMESTEP_MS) &&
+                (fabsf(step) >= ((float)SOX_RLS_MIN_CURRENT_STEP_mA / 1000.0f))) {
+            /* step is assumed in the middle of the sampling interval, reference stays the previous sample */
+            sox_rls_state = SOX_RLS_STATE_EVENT;
+            sox_rls_step_timestamp = sox_rls_previous_timestamp + timestep_ms / 2u;
+            sox_rls_step_current = current;
+            SOX_RLS_LatchSample(step, timestep_ms - timestep_ms / 2u, current);
+        } else {
+            SOX_RLS_LatchReference();
+            sox_rls_previous_current = current;
+        }
+    }
+
+    sox_rls_previous_valid = valid;
+    sox_rls_previous_timestamp = sox_rls_cellvoltage.timestamp;
+}
+
+
+/**
+ * @brief   keeps the voltages of the actual sample as reference for the next current step
+ */
+static void SOX_RLS_LatchReference(void) {
+    memcpy(sox_rls_reference_voltage, sox_rls_cellvoltage.voltage, sizeof(sox_rls_reference_voltage));
+    memcpy(sox_rls_reference_valid_volt, sox_rls_cellvoltage.valid_volt, sizeof(sox_rls_reference_valid_volt));
+}
+
+
+/**
+ * @brief   latches the actual sample for the update of the cells
+ *
+ * @param   step        current step in A, positive in discharge direction
+ * @param   time_ms     time since the current step in ms
+ * @param   current     actual current in A, positive in discharge direction
+ */
+static void SOX_RLS_LatchSample(float step, uint32_t time_ms, float current) {
+    float time_s = (float)time_ms / 1000.0f;
+
+    memcpy(sox_rls_sample.voltage, sox_rls_cellvoltage.voltage, sizeof(sox_rls_sample.voltage));
+    memcpy(sox_rls_sample.valid_volt, sox_rls_cellvoltage.valid_volt, sizeof(sox_rls_sample.valid_volt));
+    sox_rls_sample.step = step;
+    sox_rls_sample.rcFactor = 1.0f - expf(-time_s / SOX_EKF_TAU1_S);
+    sox_rls_sample.socChange = current * time_s / (SOX_SOH_GetCapacity() * 3.6f);
+    sox_rls_sample.nextCell = 0;
+    sox_rls_sample.pending = TRUE;
+}
+
+
+/**
+ * @brief   updates the estimates of the next SOX_RLS_CELLS_PER_CALL cells with the latched sample
+ */
+static void SOX_RLS_UpdateCells(void) {
+    uint16_t lastCell = sox_rls_sample.nextCell + SOX_RLS_CELLS_PER_CALL;
+    uint32_t module = 0;
+    uint32_t mask = 0;
+    float soc = 0.0f;
+    float v1 = 0.0f;
+    float v2 = 0.0f;
+    float slope = 0.0f;
+    float y = 0.0f;
+
+    if (lastCell > BS_NR_OF_BAT_CELLS) {
+        lastCell = BS_NR_OF_BAT_CELLS;
+    }
+
+    for (uint16_t i = sox_rls_sample.nextCell; i < lastCell; i++) {
+        module = i / BS_NR_OF_BAT_CELLS_PER_MODULE;
+        mask = 1u << (i % BS_NR_OF_BAT_CELLS_PER_MODULE);
+        if (((sox_rls_sample.valid_volt[module] & mask) == 0) && ((sox_rls_reference_valid_volt[module] & mask) == 0)) {
+            /* remove the change of the open circuit voltage since the step, if the SOC is known */
+            slope = 0.0f;
+            if (SOX_EKF_GetCellState(i, &soc, &v1, &v2) == E_OK) {
+                (void)SOX_EKF_GetOcv(soc, &slope);
+            }
+            y = ((float)sox_rls_reference_voltage[i] - (float)sox_rls_sample.voltage[i]) / 1000.0f - slope * sox_rls_sample.socChange;
+            SOX_RLS_UpdateCell(&sox_rls_cell[i], sox_rls_sample.step, sox_rls_sample.step * sox_rls_sample.rcFactor, y);
+        }
+    }
+
+    sox_rls_sample.nextCell = lastCell;
+    if (lastCell == BS_NR_OF_BAT_CELLS) {
+        sox_rls_sample.pending = FALSE;
+        SOX_RLS_WriteResistances();
+    }
+}
+
+
+/**
+ * @brief   writes the resistances of all cells after an update to the database
+ *
+ * The data block is a consistent snapshot for the other tasks, e.g. the
+ * plausibility check of the resistances. The highest R0 + R1 of the cells with
+ * a settled estimate is kept for the derating of the SOF currents.
+ */
+static void SOX_RLS_WriteResistances(void) {
+    uint32_t module = 0;
+    float maxResistance = 0.0f;
+
+    for (module = 0; module < BS_NR_OF_MODULES; module++) {
+        sox_rls_resistance.valid_r0[module] = 0;
+    }
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        module = i / BS_NR_OF_BAT_CELLS_PER_MODULE;
+        sox_rls_resistance.r0[i] = sox_rls_cell[i].theta[0];
+        if (sox_rls_cell[i].updates < SOX_RLS_MIN_NR_OF_UPDATES) {
+            sox_rls_resistance.valid_r0[module] |= 1u << (i % BS_NR_OF_BAT_CELLS_PER_MODULE);
+        } else if ((sox_rls_cell[i].theta[0] + sox_rls_cell[i].theta[1]) > maxResistance) {
+            maxResistance = sox_rls_cell[i].theta[0] + sox_rls_cell[i].theta[1];
+        }
+    }
+    if (maxResistance > 0.0f) {
+        sox_rls_max_resistance = maxResistance;
+    }
+    DB_WriteBlock(&sox_rls_resistance, DATA_BLOCK_ID_CELL_RESISTANCE);
+}
+
+
+/**
+ * @brief   RLS update of one cell: y = phi0 * R0 + phi1 * R1
+ *
+ * K = P*phi / (r + phi'*P*phi), theta = theta + K*(y - phi'*theta),
+ * P = (P - K*phi'*P) / lambda. The forgetting is only applied while the
+ * variances are below the initial variance, so P stays bounded if the
+ * excitation is poor.
+ *
+ * @param   cell    estimator state of the cell
+ * @param   phi0    regressor of R0 (current step) in A
+ * @param   phi1    regressor of R1 in A
+ * @param   y       voltage drop caused by the current step in V
+ */
+static void SOX_RLS_UpdateCell(SOX_RLS_CELL_s *cell, float phi0, float phi1, float y) {
+    float Pphi0 = cell->P[0][0] * phi0 + cell->P[0][1] * phi1;
+    float Pphi1 = cell->P[1][0] * phi0 + cell->P[1][1] * phi1;
+    float S = SOX_RLS_MEASUREMENT_NOISE + phi0 * Pphi0 + phi1 * Pphi1;
+    float K0 = Pphi0 / S;
+    float K1 = Pphi1 / S;
+    float error = y - (phi0 * cell->theta[0] + phi1 * cell->theta[1]);
+    float lambda = SOX_RLS_FORGETTING_FACTOR;
+
+    cell->theta[0] += K0 * error;
+    cell->theta[1] += K1 * error;
+
+    cell->P[0][0] -= K0 * Pphi0;
+    cell->P[0][1] -= K0 * Pphi1;
+    cell->P[1][1] -= K1 * Pphi1;
+    if ((cell->P[0][0] > SOX_RLS_INITIAL_VARIANCE) || (cell->P[1][1] > SOX_RLS_INITIAL_VARIANCE)) {
+        lambda = 1.0f;
+    }
+    cell->P[0][0] /= lambda;
+    cell->P[0][1] /= lambda;
+    cell->P[1][1] /= lambda;
+    cell->P[1][0] = cell->P[0][1];
+
+    for (uint8_t r = 0; r < SOX_RLS_NR_OF_PARAMETERS; r++) {
+        if (cell->theta[r] < SOX_RLS_RESISTANCE_MIN_OHM) {
+            cell->theta[r] = SOX_RLS_RESISTANCE_MIN_OHM;
+        }
+        if (cell->theta[r] > SOX_RLS_RESISTANCE_MAX_OHM) {
+            cell->theta[r] = SOX_RLS_RESISTANCE_MAX_OHM;
+        }
+    }
+
+    if (cell->updates < UINT16_MAX) {
+        cell->updates++;
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_rls.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Header for the online estimation of the cell resistances
+ *
+ */
+
+#ifndef SOX_RLS_H_
+#define SOX_RLS_H_
+
+/*================== Includes =============================================*/
+#include "sox.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   runs the online estimation of the series resistance R0 and the
+ *          resistance R1 of the first RC element of every cell
+ *
+ * Called cyclically by the algorithm module. At most SOX_RLS_CELLS_PER_CALL
+ * cells are updated per call.
+ */
+extern void SOX_RLS_Update(void);
+
+/**
+ * @brief   gets the estimated resistances of one cell
+ *
+ * Until the first events have been processed, the resistances of the cell
+ * model (SOX_EKF_R0_OHM, SOX_EKF_R1_OHM) are returned. The estimates are
+ * updated by another task, each value is read atomically.
+ *
+ * @param   cellIdx     index of the cell
+ * @param   r0          pointer where the series resistance in Ohm is written to
+ * @param   r1          pointer where the resistance of the first RC element in Ohm is written to
+ *
+ * @return  E_OK if the estimate of the cell is based on at least
+ *          SOX_RLS_MIN_NR_OF_UPDATES updates, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e SOX_RLS_GetCellResistance(uint16_t cellIdx, float *r0, float *r1);
+
+/**
+ * @brief   gets the highest estimated resistance R0 + R1 of all cells
+ *
+ * Only cells with at least SOX_RLS_MIN_NR_OF_UPDATES updates are taken into
+ * account. Until the first cell is settled, the resistance of the cell model
+ * (SOX_EKF_R0_OHM + SOX_EKF_R1_OHM) is returned. The value is read atomically.
+ *
+ * @return  resistance in Ohm
+ */
+extern float SOX_RLS_GetMaxResistance(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOX_RLS_H_ */
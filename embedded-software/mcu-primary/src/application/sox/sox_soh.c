@@ -0,0 +1,182 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_soh.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Estimation of the cell capacity from rest points
+ *
+ * At a rest point the SOC is known from the open circuit voltage. Between two
+ * rest points the charge is integrated with every current sample. If the SOC
+ * changed by at least SOX_SOH_MIN_DELTA_SOC, the pair gives a capacity
+ * measurement
+ *
+ *  C = dQ * 100% / dSOC
+ *
+ * which is fused into the capacity estimate with a scalar Kalman filter. The
+ * uncertainty of a measurement grows with decreasing SOC difference, so long
+ * discharges are weighted more than short ones. The estimate is stored in the
+ * nonvolatile memory and used by the SOC and SOP calculation instead of the
+ * nominal capacity SOX_CELL_CAPACITY.
+ */
+
+/*================== Includes =============================================*/
+#include "sox_soh.h"
+
+#include "nvramhandler.h"
+
+#include <math.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * conversion factor from mA*ms to mAh
+ */
+#define SOX_SOH_MAMS_PER_MAH            3600000.0f
+
+/*================== Constant and Variable Definitions ====================*/
+static SOX_SOH_s sox_soh = {
+    .capacity_mAh   = SOX_CELL_CAPACITY,
+    .variance       = SOX_SOH_INITIAL_VARIANCE,
+    .nr_of_updates  = 0,
+};
+
+static int64_t sox_soh_charge_mAms = 0;
+static float sox_soh_rest_soc = 0.0f;
+static uint8_t sox_soh_rest_soc_valid = FALSE;
+
+/*================== Function Prototypes ==================================*/
+static void SOX_SOH_Update(float measurement, float deltaSoc);
+
+/*================== Function Implementations =============================*/
+
+void SOX_SOH_Init(void) {
+    SOX_SOH_s soh;
+
+    if (NVM_getSOH(&soh) == E_OK) {
+        if ((soh.capacity_mAh >= SOX_SOH_CAPACITY_MIN_mAh) && (soh.capacity_mAh <= SOX_SOH_CAPACITY_MAX_mAh) &&
+            (soh.variance > 0.0f) && (soh.variance <= SOX_SOH_INITIAL_VARIANCE)) {
+            sox_soh = soh;
+        }
+    }
+    sox_soh_charge_mAms = 0;
+    sox_soh_rest_soc_valid = FALSE;
+}
+
+
+void SOX_SOH_AddCharge(int64_t charge_mAms) {
+    sox_soh_charge_mAms += charge_mAms;
+}
+
+
+void SOX_SOH_RestPoint(float soc) {
+    float deltaSoc = 0.0f;
+    float measurement = 0.0f;
+
+    if (sox_soh_rest_soc_valid == TRUE) {
+        /* discharge direction positive, like the integrated charge */
+        deltaSoc = sox_soh_rest_soc - soc;
+        if (fabsf(deltaSoc) >= SOX_SOH_MIN_DELTA_SOC) {
+            measurement = ((float)sox_soh_charge_mAms / SOX_SOH_MAMS_PER_MAH) * 100.0f / deltaSoc;
+            /* sign mismatch of charge and SOC difference results in a negative measurement */
+            if ((measurement >= SOX_SOH_CAPACITY_MIN_mAh) && (measurement <= SOX_SOH_CAPACITY_MAX_mAh)) {
+                SOX_SOH_Update(measurement, deltaSoc);
+                NVM_setSOH(&sox_soh);
+                NVRAM_setWriteRequest(NVRAM_BLOCK_ID_SOH);
+            }
+        }
+    }
+
+    sox_soh_charge_mAms = 0;
+    sox_soh_rest_soc = soc;
+    sox_soh_rest_soc_valid = TRUE;
+}
+
+
+float SOX_SOH_GetCapacity(void) {
+    return sox_soh.capacity_mAh;
+}
+
+
+float SOX_SOH_GetStateOfHealth(void) {
+    return 100.0f * sox_soh.capacity_mAh / SOX_CELL_CAPACITY;
+}
+
+
+/**
+ * @brief   fuses one capacity measurement into the estimate
+ *
+ * Both SOC values of the measurement have the standard deviation
+ * SOX_SOH_REST_SOC_UNCERTAINTY, so the relative variance of the measurement
+ * is 2*sigma^2/dSOC^2. The error of the integrated charge is neglected.
+ *
+ * @param   measurement     measured capacity in mAh
+ * @param   deltaSoc        SOC difference of the measurement in %
+ */
+static void SOX_SOH_Update(float measurement, float deltaSoc) {
+    float measurementVariance = 0.0f;
+    float gain = 0.0f;
+
+    measurementVariance = measurement * measurement * 2.0f * SOX_SOH_REST_SOC_UNCERTAINTY * SOX_SOH_REST_SOC_UNCERTAINTY /
+                          (deltaSoc * deltaSoc);
+
+    sox_soh.variance += SOX_SOH_PROCESS_NOISE;
+    if (sox_soh.variance > SOX_SOH_INITIAL_VARIANCE) {
+        sox_soh.variance = SOX_SOH_INITIAL_VARIANCE;
+    }
+
+    gain = sox_soh.variance / (sox_soh.variance + measurementVariance);
+    sox_soh.capacity_mAh += gain * (measurement - sox_soh.capacity_mAh);
+    sox_soh.variance *= (1.0f - gain);
+
+    if (sox_soh.capacity_mAh < SOX_SOH_CAPACITY_MIN_mAh) {
+        sox_soh.capacity_mAh = SOX_SOH_CAPACITY_MIN_mAh;
+    }
+    if (sox_soh.capacity_mAh > SOX_SOH_CAPACITY_MAX_mAh) {
+        sox_soh.capacity_mAh = SOX_SOH_CAPACITY_MAX_mAh;
+    }
+    if (sox_soh.nr_of_updates < UINT32_MAX) {
+        sox_soh.nr_of_updates++;
+    }
+}
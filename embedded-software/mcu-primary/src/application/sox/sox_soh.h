@@ -0,0 +1,110 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_soh.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Header for the estimation of the cell capacity (state of health)
+ *
+ */
+
+#ifndef SOX_SOH_H_
+#define SOX_SOH_H_
+
+/*================== Includes =============================================*/
+#include "sox.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   loads the learned capacity from the nonvolatile memory
+ *
+ * Invalid or implausible stored values are replaced by SOX_CELL_CAPACITY.
+ */
+extern void SOX_SOH_Init(void);
+
+/**
+ * @brief   adds charge to the charge integrated since the last rest point
+ *
+ * Called on every current sample, the work per call is constant.
+ *
+ * @param   charge_mAms     charge in mA*ms, positive in discharge direction
+ */
+extern void SOX_SOH_AddCharge(int64_t charge_mAms);
+
+/**
+ * @brief   processes a rest point of the battery system
+ *
+ * Called once when the battery system enters the rest state. If the SOC
+ * changed enough since the previous rest point, the ratio of the charge
+ * integrated in between and the SOC difference is used as capacity
+ * measurement and the updated estimate is stored in the nonvolatile memory.
+ *
+ * @param   soc     SOC in % derived from the open circuit voltage
+ */
+extern void SOX_SOH_RestPoint(float soc);
+
+/**
+ * @brief   gets the estimated cell capacity
+ *
+ * @return  cell capacity in mAh
+ */
+extern float SOX_SOH_GetCapacity(void);
+
+/**
+ * @brief   gets the state of health as ratio of the estimated and the
+ *          nominal cell capacity
+ *
+ * @return  SOH in %
+ */
+extern float SOX_SOH_GetStateOfHealth(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOX_SOH_H_ */
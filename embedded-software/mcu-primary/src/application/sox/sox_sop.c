@@ -0,0 +1,233 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sox_sop.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOX
+ *
+ * @brief   Model based state of power (SOP) prediction
+ *
+ * The cell is described by the equivalent circuit model of the EKF SOC
+ * estimator. For a constant current I applied over the horizon T, the
+ * terminal voltage at the end of the horizon is
+ *
+ *  V(T) = OCV(SOC) - a1*V1 - a2*V2 - I * (R0 + R1*(1-a1) + R2*(1-a2) + dOCV/dSOC * T/Q)
+ *
+ * with a = exp(-T/tau). Solving V(T) for the voltage limits of the maximum
+ * operating level gives the maximum charge and discharge currents. R0 and R1
+ * are the online estimates of the evaluated cell.
+ */
+
+/*================== Includes =============================================*/
+#include "sox_sop.h"
+
+#include "batterycell_cfg.h"
+#include "batterysystem_cfg.h"
+#include "sox_ekf.h"
+#include "sox_rls.h"
+#include "sox_soh.h"
+
+#include <math.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * prediction horizons
+ */
+typedef enum {
+    SOX_SOP_PEAK        = 0,
+    SOX_SOP_CONTINUOUS  = 1,
+    SOX_SOP_NR_OF_HORIZONS,
+} SOX_SOP_HORIZON_e;
+
+/**
+ * model coefficients for one prediction horizon, constant at runtime
+ */
+typedef struct {
+    float a1;           /*!< decay of the first RC voltage over the horizon      */
+    float a2;           /*!< decay of the second RC voltage over the horizon     */
+    float r2Resistance; /*!< effective resistance of the second RC element R2*(1-a2) in Ohm */
+    float length_s;     /*!< length of the horizon T in s                        */
+} SOX_SOP_HORIZON_s;
+
+/**
+ * predicted limits of one horizon
+ */
+typedef struct {
+    float chargeCurrent;        /*!< maximum charge current in A     */
+    float dischargeCurrent;     /*!< maximum discharge current in A  */
+    float chargeVoltage;        /*!< cell voltage at maximum charge current at the end of the horizon in V */
+    float dischargeVoltage;     /*!< cell voltage at maximum discharge current at the end of the horizon in V */
+} SOX_SOP_LIMITS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static SOX_SOP_HORIZON_s sox_sop_horizon[SOX_SOP_NR_OF_HORIZONS];
+static uint8_t sox_sop_initialized = FALSE;
+
+/*================== Function Prototypes ==================================*/
+static void SOX_SOP_Init(void);
+static void SOX_SOP_InitHorizon(SOX_SOP_HORIZON_s *horizon, float horizon_s);
+static STD_RETURN_TYPE_e SOX_SOP_Predict(const SOX_SOP_HORIZON_s *horizon, uint16_t chargeCell, uint16_t dischargeCell, float recChargeCurrent, float recDischargeCurrent, SOX_SOP_LIMITS_s *limits);
+
+/*================== Function Implementations =============================*/
+
+void SOX_SOP_Calculate(const DATA_BLOCK_MINMAX_s *minmax, DATA_BLOCK_SOF_s *sof) {
+    SOX_SOP_LIMITS_s peak;
+    SOX_SOP_LIMITS_s continuous;
+    uint16_t chargeCell = minmax->voltage_module_number_max * BS_NR_OF_BAT_CELLS_PER_MODULE + minmax->voltage_cell_number_max;
+    uint16_t dischargeCell = minmax->voltage_module_number_min * BS_NR_OF_BAT_CELLS_PER_MODULE + minmax->voltage_cell_number_min;
+    STD_RETURN_TYPE_e retVal = E_OK;
+
+    if (sox_sop_initialized == FALSE) {
+        SOX_SOP_Init();
+    }
+
+    retVal = SOX_SOP_Predict(&sox_sop_horizon[SOX_SOP_PEAK], chargeCell, dischargeCell,
+            sof->recommended_peak_charge, sof->recommended_peak_discharge, &peak);
+    if (retVal == E_OK) {
+        retVal = SOX_SOP_Predict(&sox_sop_horizon[SOX_SOP_CONTINUOUS], chargeCell, dischargeCell,
+                sof->recommended_continuous_charge, sof->recommended_continuous_discharge, &continuous);
+    }
+
+    if (retVal != E_OK) {
+        /* No model state available: keep SOF currents, power with present cell voltages */
+        peak.chargeCurrent = sof->recommended_peak_charge;
+        peak.dischargeCurrent = sof->recommended_peak_discharge;
+        peak.chargeVoltage = (float)minmax->voltage_max / 1000.0f;
+        peak.dischargeVoltage = (float)minmax->voltage_min / 1000.0f;
+        continuous.chargeCurrent = sof->recommended_continuous_charge;
+        continuous.dischargeCurrent = sof->recommended_continuous_discharge;
+        continuous.chargeVoltage = peak.chargeVoltage;
+        continuous.dischargeVoltage = peak.dischargeVoltage;
+    }
+
+    sof->recommended_peak_charge = peak.chargeCurrent;
+    sof->recommended_peak_discharge = peak.dischargeCurrent;
+    sof->recommended_continuous_charge = continuous.chargeCurrent;
+    sof->recommended_continuous_discharge = continuous.dischargeCurrent;
+
+    /* Power of the pack, assuming all cells at the voltage of the weakest cell (conservative) */
+    sof->recommended_peak_charge_power = peak.chargeCurrent * peak.chargeVoltage * (float)BS_NR_OF_BAT_CELLS;
+    sof->recommended_peak_discharge_power = peak.dischargeCurrent * peak.dischargeVoltage * (float)BS_NR_OF_BAT_CELLS;
+    sof->recommended_continuous_charge_power = continuous.chargeCurrent * continuous.chargeVoltage * (float)BS_NR_OF_BAT_CELLS;
+    sof->recommended_continuous_discharge_power = continuous.dischargeCurrent * continuous.dischargeVoltage * (float)BS_NR_OF_BAT_CELLS;
+}
+
+
+/**
+ * @brief   computes the model coefficients of all horizons
+ */
+static void SOX_SOP_Init(void) {
+    SOX_SOP_InitHorizon(&sox_sop_horizon[SOX_SOP_PEAK], SOX_SOP_HORIZON_PEAK_S);
+    SOX_SOP_InitHorizon(&sox_sop_horizon[SOX_SOP_CONTINUOUS], SOX_SOP_HORIZON_CONTINUOUS_S);
+    sox_sop_initialized = TRUE;
+}
+
+
+/**
+ * @brief   computes the model coefficients of one horizon
+ *
+ * @param   horizon     coefficients to compute
+ * @param   horizon_s   length of the horizon in s
+ */
+static void SOX_SOP_InitHorizon(SOX_SOP_HORIZON_s *horizon, float horizon_s) {
+    horizon->a1 = expf(-horizon_s / SOX_EKF_TAU1_S);
+    horizon->a2 = expf(-horizon_s / SOX_EKF_TAU2_S);
+    horizon->r2Resistance = SOX_EKF_R2_OHM * (1.0f - horizon->a2);
+    horizon->length_s = horizon_s;
+}
+
+
+/**
+ * @brief   predicts the maximum charge and discharge currents for one horizon
+ *
+ * @param   horizon                 model coefficients of the horizon
+ * @param   chargeCell              index of the cell limiting the charge current
+ * @param   dischargeCell           index of the cell limiting the discharge current
+ * @param   recChargeCurrent        charge current recommended by SOF, upper bound of the result
+ * @param   recDischargeCurrent     discharge current recommended by SOF, upper bound of the result
+ * @param   limits                  pointer where the predicted limits are written to
+ *
+ * @return  E_OK if the model state is available, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e SOX_SOP_Predict(const SOX_SOP_HORIZON_s *horizon, uint16_t chargeCell, uint16_t dischargeCell, float recChargeCurrent, float recDischargeCurrent, SOX_SOP_LIMITS_s *limits) {
+    float soc = 0.0f;
+    float v1 = 0.0f;
+    float v2 = 0.0f;
+    float slope = 0.0f;
+    float r0 = 0.0f;
+    float r1 = 0.0f;
+    float freeVoltage = 0.0f;
+    float resistance = 0.0f;
+    float current = 0.0f;
+    /* SOC change per A over the horizon (T/Q), the capacity is learned at runtime */
+    float socFactor = horizon->length_s / (SOX_SOH_GetCapacity() * 3.6f);
+
+    /* Discharge: cell with minimum voltage must stay above minimum operating voltage */
+    if (SOX_EKF_GetCellState(dischargeCell, &soc, &v1, &v2) != E_OK) {
+        return E_NOT_OK;
+    }
+    (void)SOX_RLS_GetCellResistance(dischargeCell, &r0, &r1);
+    freeVoltage = SOX_EKF_GetOcv(soc, &slope) - horizon->a1 * v1 - horizon->a2 * v2;
+    resistance = r0 + r1 * (1.0f - horizon->a1) + horizon->r2Resistance + slope * socFactor;
+    current = (freeVoltage - ((float)BC_VOLTMIN_MOL / 1000.0f)) / resistance;
+    current = (current < 0.0f) ? 0.0f : current;
+    current = (current > recDischargeCurrent) ? recDischargeCurrent : current;
+    limits->dischargeCurrent = current;
+    limits->dischargeVoltage = freeVoltage - current * resistance;
+
+    /* Charge: cell with maximum voltage must stay below maximum operating voltage */
+    if (SOX_EKF_GetCellState(chargeCell, &soc, &v1, &v2) != E_OK) {
+        return E_NOT_OK;
+    }
+    (void)SOX_RLS_GetCellResistance(chargeCell, &r0, &r1);
+    freeVoltage = SOX_EKF_GetOcv(soc, &slope) - horizon->a1 * v1 - horizon->a2 * v2;
+    resistance = r0 + r1 * (1.0f - horizon->a1) + horizon->r2Resistance + slope * socFactor;
+    current = (((float)BC_VOLTMAX_MOL / 1000.0f) - freeVoltage) / resistance;
+    current = (current < 0.0f) ? 0.0f : current;
+    current = (current > recChargeCurrent) ? recChargeCurrent : current;
+    limits->chargeCurrent = current;
+    limits->chargeVoltage = freeVoltage + current * resistance;
+
+    return E_OK;
+}
@@ -118,6 +118,21 @@ StaticTask_t xAppl_aperiodic_TaskStruct;
  */
 StackType_t xAppl_aperiodic_Stack[ APPL_TSK_APERIODIC_STACKSIZE ];
 
+/**
+ *  Definition of task handle algorithm task
+ */
+static TaskHandle_t appl_handle_tsk_algo;
+
+/**
+ * @brief Task Struct for #appl_handle_tsk_algo.
+ */
+StaticTask_t xAppl_algo_TaskStruct;
+
+/**
+ * Stack of #appl_handle_tsk_algo.
+ */
+StackType_t xAppl_algo_Stack[ APPL_TSK_ALGO_STACKSIZE ];
+
 
 #if BUILD_DIAG_ENABLE_TASK_STATISTICS
 static TASK_METRICS_s appl_metric_tsk_1ms = {
@@ -143,6 +158,12 @@ static TASK_METRICS_s appl_metric_tsk_aperiodic = {
         .jitter = 0,
         .lastCalltime = 0,
 };
+
+static TASK_METRICS_s appl_metric_tsk_algo = {
+        .call_period = 0,
+        .jitter = 0,
+        .lastCalltime = 0,
+};
 #endif /* BUILD_DIAG_ENABLE_TASK_STATISTICS */
 
 /*================== Function Prototypes ==================================*/
@@ -182,6 +203,14 @@ void APPL_CreateTask(void) {
             appl_tskdef_aperiodic.Stacksize, NULL,
             appl_tskdef_aperiodic.Priority, xAppl_aperiodic_Stack,
             &xAppl_aperiodic_TaskStruct);
+
+    /* Algorithm Task */
+    appl_handle_tsk_algo = xTaskCreateStatic(
+            (TaskFunction_t) APPL_TSK_Algo,
+            (const portCHAR *) "APPL_TSK_Algo",
+            appl_tskdef_algo.Stacksize, NULL,
+            appl_tskdef_algo.Priority, xAppl_algo_Stack,
+            &xAppl_algo_TaskStruct);
 }
 
 void APPL_CreateMutex(void) {
@@ -268,3 +297,22 @@ void APPL_TSK_Aperiodic(void) {
 #endif /* BUILD_DIAG_ENABLE_TASK_STATISTICS */
   }
 }
+
+void APPL_TSK_Algo(void) {
+    while (os_boot != OS_SYSTEM_RUNNING) {
+    }
+
+    OS_taskDelayUntil(&os_schedulerstarttime, appl_tskdef_algo.Phase);
+
+    while (1) {
+        uint32_t currentTime = OS_getOSSysTick();
+        APPL_Algo();
+#if BUILD_DIAG_ENABLE_TASK_STATISTICS
+        uint32_t time_entry_into_wait = OS_getOSSysTick();
+#endif /* BUILD_DIAG_ENABLE_TASK_STATISTICS */
+        OS_taskDelayUntil(&currentTime, appl_tskdef_algo.CycleTime);
+#if BUILD_DIAG_ENABLE_TASK_STATISTICS
+        diag_calc_runtime_stats(&appl_metric_tsk_algo, appl_tskdef_algo.CycleTime, time_entry_into_wait);
+#endif /* BUILD_DIAG_ENABLE_TASK_STATISTICS */
+    }
+}
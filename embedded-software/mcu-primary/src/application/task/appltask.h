@@ -101,6 +101,11 @@ extern void APPL_TSK_Cyclic_100ms(void);
  */
 extern void APPL_TSK_Aperiodic(void);
 
+/**
+ * @brief   algorithm task, lowest priority
+ */
+extern void APPL_TSK_Algo(void);
+
 /*================== Function Implementations =============================*/
 
 #endif /* APPLTASK_H_ */
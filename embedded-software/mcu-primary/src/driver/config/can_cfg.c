@@ -311,131 +311,131 @@ CAN_HandleTypeDef hcan1 = {
  ****************************************/
 
 const CAN_MSG_TX_TYPE_s can_CAN0_messages_tx[] = {
-        { 0x110, 8, 100, 0, NULL_PTR },  /*!< BMS system state 0 */
-        { 0x111, 8, 100, 0, NULL_PTR },  /*!< BMS system state 1 */
-        { 0x112, 8, 100, 0, NULL_PTR },  /*!< BMS system state 2 */
-
-        { 0x115, 8, 100, 0, NULL_PTR },  /*!< BMS slave state 0 */
-        { 0x116, 8, 100, 0, NULL_PTR },  /*!< BMS slave state 1 */
-
-        { 0x130, 8, 100, 30, NULL_PTR },  /*!< Maximum allowed current */
-        { 0x131, 8, 100, 30, NULL_PTR },  /*!< SOP */
-        { 0x140, 8, 1000, 30, NULL_PTR },  /*!< SOC */
-        { 0x150, 8, 5000, 30, NULL_PTR },  /*!< SOH */
-        { 0x160, 8, 1000, 30, NULL_PTR },  /*!< SOE */
-        { 0x170, 8, 100, 30, NULL_PTR },  /*!< Cell voltages Min Max Average */
-        { 0x171, 8, 100, 30, NULL_PTR },  /*!< SOV */
-        { 0x180, 8, 100, 30, NULL_PTR },  /*!< Cell temperatures Min Max Average */
-        { 0x190, 8, 1000, 30, NULL_PTR },  /*!< Tempering */
-        { 0x1A0, 8, 1000, 30, NULL_PTR },  /*!< Insulation */
-
-        { 0x1D0, 8, 1000, 40, NULL_PTR },  /*!< Running average power 0 */
-        { 0x1D1, 8, 1000, 40, NULL_PTR },  /*!< Running average power 1 */
-        { 0x1D2, 8, 1000, 40, NULL_PTR },  /*!< Running average power 2 */
-        { 0x1E0, 8, 1000, 40, NULL_PTR },  /*!< Running average current 0 */
-        { 0x1E1, 8, 1000, 40, NULL_PTR },  /*!< Running average current 1 */
-        { 0x1E2, 8, 1000, 40, NULL_PTR },  /*!< Running average current 2 */
-
-        { 0x1F0, 8, 1000, 40, NULL_PTR },  /*!< Pack voltage */
-
-        { 0x200, 8, 200, 20, NULL_PTR },  /*!< Cell voltages module 0 cells 0 1 2 */
-        { 0x201, 8, 200, 20, NULL_PTR },  /*!< Cell voltages module 0 cells 3 4 5 */
-        { 0x202, 8, 200, 20, NULL_PTR },  /*!< Cell voltages module 0 cells 6 7 8 */
-        { 0x203, 8, 200, 20, NULL_PTR },  /*!< Cell voltages module 0 cells 9 10 11 */
-        { 0x204, 8, 200, 20, NULL_PTR },  /*!< Cell voltages module 0 cells 12 13 14 */
-        { 0x205, 8, 200, 20, NULL_PTR },  /*!< Cell voltages module 0 cells 15 16 17 */
-
-        { 0x210, 8, 200, 30, NULL_PTR },  /*!< Cell temperatures module 0 cells 0 1 2 */
-        { 0x211, 8, 200, 30, NULL_PTR },  /*!< Cell temperatures module 0 cells 3 4 5 */
-        { 0x212, 8, 200, 30, NULL_PTR },  /*!< Cell temperatures module 0 cells 6 7 8 */
-        { 0x213, 8, 200, 30, NULL_PTR },  /*!< Cell temperatures module 0 cells 9 10 11 */
-
-        { 0x220, 8, 200, 40, NULL_PTR },  /*!< Cell voltages module 1 cells 0 1 2 */
-        { 0x221, 8, 200, 40, NULL_PTR },  /*!< Cell voltages module 1 cells 3 4 5 */
-        { 0x222, 8, 200, 40, NULL_PTR },  /*!< Cell voltages module 1 cells 6 7 8 */
-        { 0x223, 8, 200, 40, NULL_PTR },  /*!< Cell voltages module 1 cells 9 10 11 */
-        { 0x224, 8, 200, 40, NULL_PTR },  /*!< Cell voltages module 1 cells 12 13 14 */
-        { 0x225, 8, 200, 40, NULL_PTR },  /*!< Cell voltages module 1 cells 15 16 17 */
-
-        { 0x230, 8, 200, 50, NULL_PTR },  /*!< Cell temperatures module 1 cells 0 1 2 */
-        { 0x231, 8, 200, 50, NULL_PTR },  /*!< Cell temperatures module 1 cells 3 4 5 */
-        { 0x232, 8, 200, 50, NULL_PTR },  /*!< Cell temperatures module 1 cells 6 7 8 */
-        { 0x233, 8, 200, 50, NULL_PTR },  /*!< Cell temperatures module 1 cells 9 10 11 */
-
-        { 0x240, 8, 200, 60, NULL_PTR },  /*!< Cell voltages module 2 cells 0 1 2 */
-        { 0x241, 8, 200, 60, NULL_PTR },  /*!< Cell voltages module 2 cells 3 4 5 */
-        { 0x242, 8, 200, 60, NULL_PTR },  /*!< Cell voltages module 2 cells 6 7 8 */
-        { 0x243, 8, 200, 60, NULL_PTR },  /*!< Cell voltages module 2 cells 9 10 11 */
-        { 0x244, 8, 200, 60, NULL_PTR },  /*!< Cell voltages module 2 cells 12 13 14 */
-        { 0x245, 8, 200, 60, NULL_PTR },  /*!< Cell voltages module 2 cells 15 16 17 */
-
-        { 0x250, 8, 200, 70, NULL_PTR },  /*!< Cell temperatures module 2 cells 0 1 2 */
-        { 0x251, 8, 200, 70, NULL_PTR },  /*!< Cell temperatures module 2 cells 3 4 5 */
-        { 0x252, 8, 200, 70, NULL_PTR },  /*!< Cell temperatures module 2 cells 6 7 8 */
-        { 0x253, 8, 200, 70, NULL_PTR },  /*!< Cell temperatures module 2 cells 9 10 11 */
-
-        { 0x260, 8, 200, 80, NULL_PTR },  /*!< Cell voltages module 3 cells 0 1 2 */
-        { 0x261, 8, 200, 80, NULL_PTR },  /*!< Cell voltages module 3 cells 3 4 5 */
-        { 0x262, 8, 200, 80, NULL_PTR },  /*!< Cell voltages module 3 cells 6 7 8 */
-        { 0x263, 8, 200, 80, NULL_PTR },  /*!< Cell voltages module 3 cells 9 10 11 */
-        { 0x264, 8, 200, 80, NULL_PTR },  /*!< Cell voltages module 3 cells 12 13 14 */
-        { 0x265, 8, 200, 80, NULL_PTR },  /*!< Cell voltages module 3 cells 15 16 17 */
-
-        { 0x270, 8, 200, 90, NULL_PTR },  /*!< Cell temperatures module 3 cells 0 1 2 */
-        { 0x271, 8, 200, 90, NULL_PTR },  /*!< Cell temperatures module 3 cells 3 4 5 */
-        { 0x272, 8, 200, 90, NULL_PTR },  /*!< Cell temperatures module 3 cells 6 7 8 */
-        { 0x273, 8, 200, 90, NULL_PTR },  /*!< Cell temperatures module 3 cells 9 10 11 */
-
-        { 0x280, 8, 200, 100, NULL_PTR },  /*!< Cell voltages module 4 cells 0 1 2 */
-        { 0x281, 8, 200, 100, NULL_PTR },  /*!< Cell voltages module 4 cells 3 4 5 */
-        { 0x282, 8, 200, 100, NULL_PTR },  /*!< Cell voltages module 4 cells 6 7 8 */
-        { 0x283, 8, 200, 100, NULL_PTR },  /*!< Cell voltages module 4 cells 9 10 11 */
-        { 0x284, 8, 200, 100, NULL_PTR },  /*!< Cell voltages module 4 cells 12 13 14 */
-        { 0x285, 8, 200, 100, NULL_PTR },  /*!< Cell voltages module 4 cells 15 16 17 */
-
-        { 0x290, 8, 200, 110, NULL_PTR },  /*!< Cell temperatures module 4 cells 0 1 2 */
-        { 0x291, 8, 200, 110, NULL_PTR },  /*!< Cell temperatures module 4 cells 3 4 5 */
-        { 0x292, 8, 200, 110, NULL_PTR },  /*!< Cell temperatures module 4 cells 6 7 8 */
-        { 0x293, 8, 200, 110, NULL_PTR },  /*!< Cell temperatures module 4 cells 9 10 11 */
-
-        { 0x2A0, 8, 200, 120, NULL_PTR },  /*!< Cell voltages module 5 cells 0 1 2 */
-        { 0x2A1, 8, 200, 120, NULL_PTR },  /*!< Cell voltages module 5 cells 3 4 5 */
-        { 0x2A2, 8, 200, 120, NULL_PTR },  /*!< Cell voltages module 5 cells 6 7 8 */
-        { 0x2A3, 8, 200, 120, NULL_PTR },  /*!< Cell voltages module 5 cells 9 10 11 */
-        { 0x2A4, 8, 200, 120, NULL_PTR },  /*!< Cell voltages module 5 cells 12 13 14 */
-        { 0x2A5, 8, 200, 120, NULL_PTR },  /*!< Cell voltages module 5 cells 15 16 17 */
-
-        { 0x2B0, 8, 200, 130, NULL_PTR },  /*!< Cell temperatures module 5 cells 0 1 2 */
-        { 0x2B1, 8, 200, 130, NULL_PTR },  /*!< Cell temperatures module 5 cells 3 4 5 */
-        { 0x2B2, 8, 200, 130, NULL_PTR },  /*!< Cell temperatures module 5 cells 6 7 8 */
-        { 0x2B3, 8, 200, 130, NULL_PTR },  /*!< Cell temperatures module 5 cells 9 10 11 */
-
-        { 0x2C0, 8, 200, 140, NULL_PTR },  /*!< Cell voltages module 6 cells 0 1 2 */
-        { 0x2C1, 8, 200, 140, NULL_PTR },  /*!< Cell voltages module 6 cells 3 4 5 */
-        { 0x2C2, 8, 200, 140, NULL_PTR },  /*!< Cell voltages module 6 cells 6 7 8 */
-        { 0x2C3, 8, 200, 140, NULL_PTR },  /*!< Cell voltages module 6 cells 9 10 11 */
-        { 0x2C4, 8, 200, 140, NULL_PTR },  /*!< Cell voltages module 6 cells 12 13 14 */
-        { 0x2C5, 8, 200, 140, NULL_PTR },  /*!< Cell voltages module 6 cells 15 16 17 */
-
-        { 0x2D0, 8, 200, 150, NULL_PTR },  /*!< Cell temperatures module 6 cells 0 1 2 */
-        { 0x2D1, 8, 200, 150, NULL_PTR },  /*!< Cell temperatures module 6 cells 3 4 5 */
-        { 0x2D2, 8, 200, 150, NULL_PTR },  /*!< Cell temperatures module 6 cells 6 7 8 */
-        { 0x2D3, 8, 200, 150, NULL_PTR },  /*!< Cell temperatures module 6 cells 9 10 11 */
-
-        { 0x2E0, 8, 200, 160, NULL_PTR },  /*!< Cell voltages module 7 cells 0 1 2 */
-        { 0x2E1, 8, 200, 160, NULL_PTR },  /*!< Cell voltages module 7 cells 3 4 5 */
-        { 0x2E2, 8, 200, 160, NULL_PTR },  /*!< Cell voltages module 7 cells 6 7 8 */
-        { 0x2E3, 8, 200, 160, NULL_PTR },  /*!< Cell voltages module 7 cells 9 10 11 */
-        { 0x2E4, 8, 200, 160, NULL_PTR },  /*!< Cell voltages module 7 cells 12 13 14 */
-        { 0x2E5, 8, 200, 160, NULL_PTR },  /*!< Cell voltages module 7 cells 15 16 17 */
-
-        { 0x2F0, 8, 200, 170, NULL_PTR },  /*!< Cell temperatures module 7 cells 0 1 2 */
-        { 0x2F1, 8, 200, 170, NULL_PTR },  /*!< Cell temperatures module 7 cells 3 4 5 */
-        { 0x2F2, 8, 200, 170, NULL_PTR },  /*!< Cell temperatures module 7 cells 6 7 8 */
-        { 0x2F3, 8, 200, 170, NULL_PTR },  /*!< Cell temperatures module 7 cells 9 10 11 */
+        { 0x110, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< BMS system state 0 */
+        { 0x111, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< BMS system state 1 */
+        { 0x112, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< BMS system state 2 */
+
+        { 0x115, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< BMS slave state 0 */
+        { 0x116, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< BMS slave state 1 */
+
+        { 0x130, 8, 10, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Maximum allowed current */
+        { 0x131, 8, 10, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< SOP */
+        { 0x140, 8, 5000, 30, NULL_PTR, CAN_TX_ON_CHANGE, 100 },  /*!< SOC */
+        { 0x150, 8, 5000, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< SOH */
+        { 0x160, 8, 1000, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< SOE */
+        { 0x170, 8, 100, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell voltages Min Max Average */
+        { 0x171, 8, 100, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< SOV */
+        { 0x180, 8, 100, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures Min Max Average */
+        { 0x190, 8, 5000, 30, NULL_PTR, CAN_TX_ON_CHANGE, 100 },  /*!< Tempering */
+        { 0x1A0, 8, 5000, 30, NULL_PTR, CAN_TX_ON_CHANGE, 100 },  /*!< Insulation */
+
+        { 0x1D0, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Running average power 0 */
+        { 0x1D1, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Running average power 1 */
+        { 0x1D2, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Running average power 2 */
+        { 0x1E0, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Running average current 0 */
+        { 0x1E1, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Running average current 1 */
+        { 0x1E2, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Running average current 2 */
+
+        { 0x1F0, 8, 1000, 40, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Pack voltage */
+
+        { 0x200, 8, 200, 20, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 0 cells 0 1 2 */
+        { 0x201, 8, 200, 20, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 0 cells 3 4 5 */
+        { 0x202, 8, 200, 20, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 0 cells 6 7 8 */
+        { 0x203, 8, 200, 20, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 0 cells 9 10 11 */
+        { 0x204, 8, 200, 20, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 0 cells 12 13 14 */
+        { 0x205, 8, 200, 20, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 0 cells 15 16 17 */
+
+        { 0x210, 8, 200, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 0 cells 0 1 2 */
+        { 0x211, 8, 200, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 0 cells 3 4 5 */
+        { 0x212, 8, 200, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 0 cells 6 7 8 */
+        { 0x213, 8, 200, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 0 cells 9 10 11 */
+
+        { 0x220, 8, 200, 40, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 1 cells 0 1 2 */
+        { 0x221, 8, 200, 40, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 1 cells 3 4 5 */
+        { 0x222, 8, 200, 40, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 1 cells 6 7 8 */
+        { 0x223, 8, 200, 40, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 1 cells 9 10 11 */
+        { 0x224, 8, 200, 40, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 1 cells 12 13 14 */
+        { 0x225, 8, 200, 40, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 1 cells 15 16 17 */
+
+        { 0x230, 8, 200, 50, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 1 cells 0 1 2 */
+        { 0x231, 8, 200, 50, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 1 cells 3 4 5 */
+        { 0x232, 8, 200, 50, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 1 cells 6 7 8 */
+        { 0x233, 8, 200, 50, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 1 cells 9 10 11 */
+
+        { 0x240, 8, 200, 60, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 2 cells 0 1 2 */
+        { 0x241, 8, 200, 60, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 2 cells 3 4 5 */
+        { 0x242, 8, 200, 60, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 2 cells 6 7 8 */
+        { 0x243, 8, 200, 60, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 2 cells 9 10 11 */
+        { 0x244, 8, 200, 60, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 2 cells 12 13 14 */
+        { 0x245, 8, 200, 60, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 2 cells 15 16 17 */
+
+        { 0x250, 8, 200, 70, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 2 cells 0 1 2 */
+        { 0x251, 8, 200, 70, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 2 cells 3 4 5 */
+        { 0x252, 8, 200, 70, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 2 cells 6 7 8 */
+        { 0x253, 8, 200, 70, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 2 cells 9 10 11 */
+
+        { 0x260, 8, 200, 80, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 3 cells 0 1 2 */
+        { 0x261, 8, 200, 80, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 3 cells 3 4 5 */
+        { 0x262, 8, 200, 80, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 3 cells 6 7 8 */
+        { 0x263, 8, 200, 80, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 3 cells 9 10 11 */
+        { 0x264, 8, 200, 80, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 3 cells 12 13 14 */
+        { 0x265, 8, 200, 80, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 3 cells 15 16 17 */
+
+        { 0x270, 8, 200, 90, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 3 cells 0 1 2 */
+        { 0x271, 8, 200, 90, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 3 cells 3 4 5 */
+        { 0x272, 8, 200, 90, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 3 cells 6 7 8 */
+        { 0x273, 8, 200, 90, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 3 cells 9 10 11 */
+
+        { 0x280, 8, 200, 100, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 4 cells 0 1 2 */
+        { 0x281, 8, 200, 100, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 4 cells 3 4 5 */
+        { 0x282, 8, 200, 100, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 4 cells 6 7 8 */
+        { 0x283, 8, 200, 100, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 4 cells 9 10 11 */
+        { 0x284, 8, 200, 100, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 4 cells 12 13 14 */
+        { 0x285, 8, 200, 100, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 4 cells 15 16 17 */
+
+        { 0x290, 8, 200, 110, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 4 cells 0 1 2 */
+        { 0x291, 8, 200, 110, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 4 cells 3 4 5 */
+        { 0x292, 8, 200, 110, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 4 cells 6 7 8 */
+        { 0x293, 8, 200, 110, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 4 cells 9 10 11 */
+
+        { 0x2A0, 8, 200, 120, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 5 cells 0 1 2 */
+        { 0x2A1, 8, 200, 120, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 5 cells 3 4 5 */
+        { 0x2A2, 8, 200, 120, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 5 cells 6 7 8 */
+        { 0x2A3, 8, 200, 120, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 5 cells 9 10 11 */
+        { 0x2A4, 8, 200, 120, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 5 cells 12 13 14 */
+        { 0x2A5, 8, 200, 120, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 5 cells 15 16 17 */
+
+        { 0x2B0, 8, 200, 130, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 5 cells 0 1 2 */
+        { 0x2B1, 8, 200, 130, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 5 cells 3 4 5 */
+        { 0x2B2, 8, 200, 130, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 5 cells 6 7 8 */
+        { 0x2B3, 8, 200, 130, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 5 cells 9 10 11 */
+
+        { 0x2C0, 8, 200, 140, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 6 cells 0 1 2 */
+        { 0x2C1, 8, 200, 140, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 6 cells 3 4 5 */
+        { 0x2C2, 8, 200, 140, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 6 cells 6 7 8 */
+        { 0x2C3, 8, 200, 140, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 6 cells 9 10 11 */
+        { 0x2C4, 8, 200, 140, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 6 cells 12 13 14 */
+        { 0x2C5, 8, 200, 140, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 6 cells 15 16 17 */
+
+        { 0x2D0, 8, 200, 150, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 6 cells 0 1 2 */
+        { 0x2D1, 8, 200, 150, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 6 cells 3 4 5 */
+        { 0x2D2, 8, 200, 150, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 6 cells 6 7 8 */
+        { 0x2D3, 8, 200, 150, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 6 cells 9 10 11 */
+
+        { 0x2E0, 8, 200, 160, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 7 cells 0 1 2 */
+        { 0x2E1, 8, 200, 160, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 7 cells 3 4 5 */
+        { 0x2E2, 8, 200, 160, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 7 cells 6 7 8 */
+        { 0x2E3, 8, 200, 160, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 7 cells 9 10 11 */
+        { 0x2E4, 8, 200, 160, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 7 cells 12 13 14 */
+        { 0x2E5, 8, 200, 160, NULL_PTR, CAN_CELLVOLTAGE_TX_MODE, 0 },  /*!< Cell voltages module 7 cells 15 16 17 */
+
+        { 0x2F0, 8, 200, 170, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 7 cells 0 1 2 */
+        { 0x2F1, 8, 200, 170, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 7 cells 3 4 5 */
+        { 0x2F2, 8, 200, 170, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 7 cells 6 7 8 */
+        { 0x2F3, 8, 200, 170, NULL_PTR, CAN_TX_PERIODIC, 0 },  /*!< Cell temperatures module 7 cells 9 10 11 */
 
 #ifdef CURRENT_SENSOR_ISABELLENHUETTE_TRIGGERED
-        , { 0x35B, 8, 100, 20, NULL_PTR }  /*!< Current Sensor Trigger */
+        , { 0x35B, 8, 100, 20, NULL_PTR, CAN_TX_PERIODIC, 0 }  /*!< Current Sensor Trigger */
 #endif /* CURRENT_SENSOR_ISABELLENHUETTE_TRIGGERED */
 };
 
@@ -477,6 +477,8 @@ CAN_MSG_RX_TYPE_s can0_RxMsgs[] = {
 #endif /* CURRENT_SENSOR_ISABELLENHUETTE_TRIGGERED */
         { 0x100, 0xFFFF, 8, 0, CAN_FILTER_FIFO0, NULL },    /*!< debug message      */
         { 0x777, 0xFFFF, 8, 0, CAN_FILTER_FIFO0, NULL },    /*!< request SW version */
+        { CAN_ID_ISOTP_REQUEST, 0xFFFF, 8, 0, CAN_FILTER_FIFO0, NULL },    /*!< ISO-TP request, handled by ISOTP_ReceiveFrame() */
+        { CAN_ID_XCP_REQUEST, 0xFFFF, 8, 0, CAN_FILTER_FIFO0, NULL },    /*!< XCP command, handled by XCP_ReceiveFrame() */
 };
 
 
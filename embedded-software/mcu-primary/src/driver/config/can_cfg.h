@@ -208,11 +208,11 @@
 #define CAN0_USE_RECEIVE_BUFFER          (1U)
 /**
  * @ingroup CONFIG_CAN
- * Defines CAN0 receive buffer length
+ * Defines CAN0 receive buffer length, has to be a power of two
  * \par Type:
  * int
  * \par Range:
- * 0 < x
+ * 0 < x, x = 2^n
  * \par Default:
  * 16
 */
@@ -231,11 +231,11 @@
 #define CAN1_USE_RECEIVE_BUFFER          (1U)
 /**
  * @ingroup CONFIG_CAN
- * Defines CAN1 receive buffer length
+ * Defines CAN1 receive buffer length, has to be a power of two
  * \par Type:
  * int
  * \par Range:
- * 0 < x
+ * 0 < x, x = 2^n
  * \par Default:
  * 16
 */
@@ -271,6 +271,32 @@
 */
 #define CAN1_BUFFER_BYPASS_NUMBER_OF_IDs (0U)
 
+/**
+ * @ingroup CONFIG_CAN
+ * Defines the maximum number of RX messages of CAN0. The IDs are sorted
+ * into a lookup table of this size by CAN_Init().
+ * \par Type:
+ * int
+ * \par Range:
+ * 1 <= x <= 255
+ * \par Default:
+ * 32
+*/
+#define CAN0_RX_LOOKUP_LENGTH (32U)
+
+/**
+ * @ingroup CONFIG_CAN
+ * Defines the maximum number of RX messages of CAN1. The IDs are sorted
+ * into a lookup table of this size by CAN_Init().
+ * \par Type:
+ * int
+ * \par Range:
+ * 1 <= x <= 255
+ * \par Default:
+ * 8
+*/
+#define CAN1_RX_LOOKUP_LENGTH (8U)
+
 /**
  * @ingroup CONFIG_CAN
  * Defines CAN message ID to perform a software reset
@@ -281,6 +307,76 @@
 */
 #define CAN_ID_SOFTWARE_RESET_MSG                     (0x95U)
 
+/**
+ * @ingroup CONFIG_CAN
+ * If TRUE, the cell voltages are sent on CAN0 as multiplexed, delta encoded
+ * stream (see cansignal_stream.h) instead of the messages 0x200 - 0x2E5
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * TRUE
+*/
+#define CAN_CELLVOLTAGE_STREAM                        TRUE
+
+/**
+ * @ingroup CONFIG_CAN
+ * Defines CAN message ID of the cell voltage stream
+ * \par Type:
+ * int
+ * \par Default:
+ * 768
+*/
+#define CAN_ID_CELLVOLTAGE_STREAM                     (0x300U)
+
+/**
+ * @ingroup CONFIG_CAN
+ * Defines CAN message ID of the ISO-TP requests (and flow control frames) from the tester
+ * \par Type:
+ * int
+ * \par Default:
+ * 2016
+*/
+#define CAN_ID_ISOTP_REQUEST                          (0x7E0U)
+
+/**
+ * @ingroup CONFIG_CAN
+ * Defines CAN message ID of the ISO-TP responses (and flow control frames) of the BMS
+ * \par Type:
+ * int
+ * \par Default:
+ * 2024
+*/
+#define CAN_ID_ISOTP_RESPONSE                         (0x7E8U)
+
+/**
+ * @ingroup CONFIG_CAN
+ * Defines CAN message ID of the XCP commands of the master
+ * \par Type:
+ * int
+ * \par Default:
+ * 2032
+*/
+#define CAN_ID_XCP_REQUEST                            (0x7F0U)
+
+/**
+ * @ingroup CONFIG_CAN
+ * Defines CAN message ID of the XCP responses and DAQ data of the BMS
+ * \par Type:
+ * int
+ * \par Default:
+ * 2033
+*/
+#define CAN_ID_XCP_RESPONSE                           (0x7F1U)
+
+/**
+ * transmission mode of the cell voltage messages 0x200 - 0x2E5
+ */
+#if CAN_CELLVOLTAGE_STREAM == TRUE
+#define CAN_CELLVOLTAGE_TX_MODE                       CAN_TX_OFF
+#else
+#define CAN_CELLVOLTAGE_TX_MODE                       CAN_TX_PERIODIC
+#endif /* CAN_CELLVOLTAGE_STREAM == TRUE */
+
 /**
  * @ingroup CONFIG_CAN
  * When enabled unique device ID is need as can data to perform SW reset
@@ -306,13 +402,24 @@ typedef struct CAN_MSG_RX_TYPE {
 
 typedef uint32_t (*can_callback_funcPtr)(uint32_t idx, void * value);
 
+/**
+ * transmission mode of a TX message
+ */
+typedef enum {
+    CAN_TX_PERIODIC     = 0,    /*!< sent every repetition_time */
+    CAN_TX_ON_CHANGE    = 1,    /*!< sent when the content changed, at most every min_interval and at least every repetition_time */
+    CAN_TX_OFF          = 2,    /*!< not sent, e.g., replaced by another transmission */
+} CAN_TX_MODE_e;
+
 /**
  * type definition for structure of a CAN message with its
  *  ID,
  *  data length code,
  *  repetition rate (stated in number of calls of CANS mainfunction = ticks),
  *  the initial phase,
- *  a callback function if transfer of TX message to CAN module is successful
+ *  a callback function if transfer of TX message to CAN module is successful,
+ *  the transmission mode and the minimum interval for on change transmission.
+ *  Mode and minimum interval can be omitted for periodic messages.
  */
 typedef struct  {
     uint32_t ID;                    /*!< CAN message id */
@@ -320,6 +427,8 @@ typedef struct  {
     uint32_t repetition_time;       /*!< CAN message cycle time */
     uint32_t repetition_phase;      /*!< CAN message startup (first send) offset */
     can_callback_funcPtr cbk_func;  /*!< CAN message callback after message is sent or received */
+    CAN_TX_MODE_e mode;             /*!< CAN message transmission mode, with CAN_TX_ON_CHANGE repetition_time is the maximum interval */
+    uint32_t min_interval;          /*!< CAN_TX_ON_CHANGE: minimum interval between two transmissions in ms, content is checked at this rate */
 } CAN_MSG_TX_TYPE_s;
 
 typedef struct CanPdu {
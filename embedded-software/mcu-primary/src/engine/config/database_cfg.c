@@ -183,6 +183,11 @@ static DATA_BLOCK_ALLGPIOVOLTAGE_s data_block_ltc_allgpiovoltages;
  */
 static DATA_BLOCK_CONT_SOH_s data_block_contactor_soh;
 
+/**
+ * data block: estimated cell resistances
+ */
+static DATA_BLOCK_CELL_RESISTANCE_s data_block_cell_resistance;
+
 /**
  * @brief channel configuration of database (data blocks)
  *
@@ -290,6 +295,10 @@ static DATA_BASE_HEADER_s  data_base_header[] = {
         (void*)(&data_block_contactor_soh),
         sizeof(DATA_BLOCK_CONT_SOH_s)
     },
+    {
+        (void*)(&data_block_cell_resistance),
+        sizeof(DATA_BLOCK_CELL_RESISTANCE_s)
+    },
 };
 
 
@@ -67,7 +67,7 @@
  *
  * this value is extendible but limitation is done due to RAM consumption and performance
  */
-#define DATA_MAX_BLOCK_NR                25        /* max 25 Blocks currently supported*/
+#define DATA_MAX_BLOCK_NR                26        /* max 26 Blocks currently supported*/
 
 /**
  * @brief data block identification number
@@ -98,6 +98,7 @@ typedef enum {
     DATA_BLOCK_22       = 22,
     DATA_BLOCK_23       = 23,
     DATA_BLOCK_24       = 24,
+    DATA_BLOCK_25       = 25,
     DATA_BLOCK_MAX      = DATA_MAX_BLOCK_NR,
 } DATA_BLOCK_ID_TYPE_e;
 
@@ -157,6 +158,7 @@ typedef struct {
 #define DATA_BLOCK_ID_SOF                           DATA_BLOCK_22
 #define DATA_BLOCK_ID_ALLGPIOVOLTAGE                DATA_BLOCK_23
 #define DATA_BLOCK_ID_CONT_SOH                      DATA_BLOCK_24
+#define DATA_BLOCK_ID_CELL_RESISTANCE               DATA_BLOCK_25
 
 /**
  * data block struct of cell voltage
@@ -226,6 +228,10 @@ typedef struct {
     float continuous_discharge_RSL;         /*!< discharge current recommended safety level         */
     float continuous_charge_MSL;            /*!< charge current maximum safety level                */
     float continuous_discharge_MSL;         /*!< discharge current maximum safety level             */
+    float recommended_continuous_charge_power;      /*!< recommended continuous charge power in W       */
+    float recommended_continuous_discharge_power;   /*!< recommended continuous discharge power in W    */
+    float recommended_peak_charge_power;            /*!< recommended peak charge power in W             */
+    float recommended_peak_discharge_power;         /*!< recommended peak discharge power in W          */
 } DATA_BLOCK_SOF_s;
 
 
@@ -271,6 +277,7 @@ typedef struct {
     uint32_t timestamp;                         /*!< timestamp of database entry                */
     uint32_t previous_timestamp;                /*!< timestamp of last database entry           */
     uint16_t value[BS_NR_OF_MODULES];    /*!< unit: mV (opto-coupler output)     */
+    uint32_t discharged_charge[BS_NR_OF_BAT_CELLS];  /*!< unit: mAs, charge discharged by the balancing resistor since startup, wraps around */
     uint8_t state;                      /*!< for future use                     */
 } DATA_BLOCK_BALANCING_FEEDBACK_s;
 
@@ -310,8 +317,13 @@ typedef struct {
     uint8_t newPower;
     uint32_t previous_timestamp_cur;                       /*!< timestamp of current database entry   */
     uint32_t timestamp_cur;                                /*!< timestamp of current database entry   */
+    uint32_t timestep_cur;                                 /*!< unit: ms, sampling interval of current from the sensor message counter */
     uint32_t previous_timestamp_cc;                        /*!< timestamp of C-C database entry   */
     uint32_t timestamp_cc;                                 /*!< timestamp of C-C database entry   */
+    float current_rms[BS_NR_OF_FUSE_CURVE_POINTS];         /*!< unit: mA, RMS current over the windows of the fuse curve */
+    int32_t current_peak[BS_NR_OF_FUSE_CURVE_POINTS];      /*!< unit: mA, highest absolute current over the windows of the fuse curve */
+    float current_i2t[BS_NR_OF_FUSE_CURVE_POINTS];         /*!< unit: A^2.s, I2t over the windows of the fuse curve */
+    uint32_t current_window_ms[BS_NR_OF_FUSE_CURVE_POINTS]; /*!< unit: ms, time covered by the windows of the fuse curve */
 } DATA_BLOCK_CURRENT_SENSOR_s;
 
 /**
@@ -460,6 +472,7 @@ typedef struct {
     uint8_t over_current_discharge_pl1;     /*!< 0 -> MSL NOT violated, 1 -> MSL violated   */
     uint8_t pcb_over_temperature;           /*!< 0 -> MSL NOT violated, 1 -> MSL violated   */
     uint8_t pcb_under_temperature;          /*!< 0 -> MSL NOT violated, 1 -> MSL violated   */
+    uint8_t fuse_overload;                  /*!< 0 -> MSL NOT violated, 1 -> MSL violated   */
 } DATA_BLOCK_MSL_FLAG_s;
 
 typedef struct {
@@ -480,6 +493,7 @@ typedef struct {
     uint8_t over_current_discharge_pl1;     /*!< 0 -> RSL NOT violated, 1 -> RSL violated   */
     uint8_t pcb_over_temperature;           /*!< 0 -> RSL NOT violated, 1 -> RSL violated   */
     uint8_t pcb_under_temperature;          /*!< 0 -> RSL NOT violated, 1 -> RSL violated   */
+    uint8_t fuse_overload;                  /*!< 0 -> RSL NOT violated, 1 -> RSL violated   */
 } DATA_BLOCK_RSL_FLAG_s;
 
 typedef struct {
@@ -500,6 +514,7 @@ typedef struct {
     uint8_t over_current_discharge_pl1;     /*!< 0 -> MOL NOT violated, 1 -> MOL violated    */
     uint8_t pcb_over_temperature;           /*!< 0 -> MOL NOT violated, 1 -> MOL violated    */
     uint8_t pcb_under_temperature;          /*!< 0 -> MOL NOT violated, 1 -> MOL violated    */
+    uint8_t fuse_overload;                  /*!< 0 -> MOL NOT violated, 1 -> MOL violated    */
 } DATA_BLOCK_MOL_FLAG_s;
 
 typedef struct {
@@ -572,6 +587,17 @@ typedef struct {
     float contactor_soh[BS_NR_OF_CONTACTORS];  /*!< SOH of contactors */
 } DATA_BLOCK_CONT_SOH_s;
 
+/**
+ * data block struct of the estimated cell resistances
+ */
+typedef struct {
+    /* Timestamp info needs to be at the beginning. Automatically written on DB_WriteBlock */
+    uint32_t timestamp;                         /*!< timestamp of database entry                                 */
+    uint32_t previous_timestamp;                /*!< timestamp of last database entry                            */
+    float r0[BS_NR_OF_BAT_CELLS];               /*!< unit: Ohm, series resistance                                */
+    uint32_t valid_r0[BS_NR_OF_MODULES];        /*!< bitmask if resistances are learned. 0->valid, 1->invalid    */
+} DATA_BLOCK_CELL_RESISTANCE_s;
+
 /*================== Extern Constant and Variable Declarations ==============*/
 
 /**
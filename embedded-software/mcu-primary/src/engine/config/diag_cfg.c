@@ -107,6 +107,7 @@ static void DIAG_error_ltc(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
 static void DIAG_error_cancurrentsensor(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
 static void DIAG_cont_feedback(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
 static void DIAG_error_fuseState(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
+static void DIAG_fuseOverload(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
 static void DIAG_error_interlock(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
 static void DIAG_error_insulation(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
 static void DIAG_error_openWire(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event);
@@ -232,6 +233,7 @@ DIAG_CH_CFG_s  diag_ch_cfg[] = {
     {DIAG_CH_CAN_TIMING,                                "CAN_TIMING",                           DIAG_ERROR_CAN_TIMING_SENSITIVITY,        DIAG_RECORDING_ENABLED, DIAG_CAN_TIMING, DIAG_error_cantiming},
     {DIAG_CH_CAN_CC_RESPONDING,                         "CAN_CC_RESPONDING",                    DIAG_ERROR_CAN_TIMING_CC_SENSITIVITY,     DIAG_RECORDING_ENABLED, DIAG_CAN_SENSOR_PRESENT, DIAG_error_cantiming},
     {DIAG_CH_CURRENT_SENSOR_RESPONDING,                 "CURRENT_SENSOR_RESPONDING",            DIAG_ERROR_CAN_SENSOR_SENSITIVITY,        DIAG_RECORDING_ENABLED, DIAG_CAN_SENSOR_PRESENT, DIAG_error_cancurrentsensor},
+    {DIAG_CH_CAN_RX_QUEUE_FULL,                         "CAN_RX_QUEUE_FULL",                    DIAG_ERROR_SENSITIVITY_HIGH,              DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
 
 #if BUILD_MODULE_ENABLE_CONTACTOR == 1
     /* Contactor Damage Error */
@@ -292,11 +294,19 @@ DIAG_CH_CFG_s  diag_ch_cfg[] = {
 
     {DIAG_CH_OPEN_WIRE,       "OPEN_WIRE",         DIAG_ERROR_SENSITIVITY_HIGH, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_openWire},
     {DIAG_CH_DEEP_DISCHARGE_DETECTED,    "DEEP-DISCHARGE detected", DIAG_ERROR_SENSITIVITY_HIGH, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_deep_discharge_detected},
+    {DIAG_CH_ALGO_DEADLINE_VIOLATION,    "ALGO_DEADLINE_VIOLATION", DIAG_ERROR_SENSITIVITY_MID, DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
+    {DIAG_CH_ALGO_BLOCKED,               "ALGO_BLOCKED",            DIAG_ERROR_SENSITIVITY_HIGH, DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
+
+    /* Fuse curve */
+    {DIAG_CH_FUSE_OVERLOAD_MSL,    "FUSE_OVERLOAD_MSL",    DIAG_ERROR_FUSE_OVERLOAD_SENSITIVITY_MSL, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_fuseOverload},
+    {DIAG_CH_FUSE_OVERLOAD_RSL,    "FUSE_OVERLOAD_RSL",    DIAG_ERROR_FUSE_OVERLOAD_SENSITIVITY_RSL, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_fuseOverload},
+    {DIAG_CH_FUSE_OVERLOAD_MOL,    "FUSE_OVERLOAD_MOL",    DIAG_ERROR_FUSE_OVERLOAD_SENSITIVITY_MOL, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_fuseOverload},
 
     /* Plausibility checks */
     {DIAG_CH_PLAUSIBILITY_CELL_VOLTAGE,    "PL_CELL_VOLT",    DIAG_ERROR_SENSITIVITY_HIGH, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_plausibility_check},
     {DIAG_CH_PLAUSIBILITY_CELL_TEMP,       "PL_CELL_TEMP",    DIAG_ERROR_SENSITIVITY_HIGH, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_plausibility_check},
     {DIAG_CH_PLAUSIBILITY_PACK_VOLTAGE,    "PL_PACK_VOLT",    DIAG_ERROR_PLAUSIBILITY_PACK_SENSITIVITY, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_plausibility_check},
+    {DIAG_CH_PLAUSIBILITY_CELL_RESISTANCE, "PL_CELL_RES",     DIAG_ERROR_SENSITIVITY_HIGH, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_plausibility_check},
 };
 
 
@@ -328,6 +338,7 @@ DIAG_SYSMON_CH_CFG_s diag_sysmon_ch_cfg[] = {
     {DIAG_SYSMON_APPL_CYCLIC_1ms,   DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
     {DIAG_SYSMON_APPL_CYCLIC_10ms,  DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
     {DIAG_SYSMON_APPL_CYCLIC_100ms, DIAG_SYSMON_CYCLICTASK, 200, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_APPL_ALGO,         DIAG_SYSMON_CYCLICTASK, 1000, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_DONOTHING, DIAG_ENABLED, dummyfu2},
 };
 
 
@@ -852,6 +863,44 @@ void DIAG_error_fuseState(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event) {
     }
 }
 
+/**
+ * @brief  diagnosis callback function for fuse curve events
+ */
+static void DIAG_fuseOverload(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event) {
+    switch (ch_id) {
+    case DIAG_CH_FUSE_OVERLOAD_MSL:
+        if (event == DIAG_EVENT_RESET) {
+            msl_flags.fuse_overload = 0;
+        } else if (event == DIAG_EVENT_NOK) {
+            msl_flags.fuse_overload = 1;
+        } else {
+            /* no relevant event, do nothing */
+        }
+        break;
+    case DIAG_CH_FUSE_OVERLOAD_RSL:
+        if (event == DIAG_EVENT_RESET) {
+            rsl_flags.fuse_overload = 0;
+        } else if (event == DIAG_EVENT_NOK) {
+            rsl_flags.fuse_overload = 1;
+        } else {
+            /* no relevant event, do nothing */
+        }
+        break;
+    case DIAG_CH_FUSE_OVERLOAD_MOL:
+        if (event == DIAG_EVENT_RESET) {
+            mol_flags.fuse_overload = 0;
+        } else if (event == DIAG_EVENT_NOK) {
+            mol_flags.fuse_overload = 1;
+        } else {
+            /* no relevant event, do nothing */
+        }
+        break;
+    default:
+        /* no relevant channel, do nothing */
+        break;
+    }
+}
+
 /**
  * @brief  diagnosis callback function for interlock events
  */
@@ -940,6 +989,13 @@ void DIAG_error_plausibility_check(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event) {
         if (event == DIAG_EVENT_NOK) {
             error_flags.plausibilityCheck |= 0x04;
         }
+    } else if (ch_id == DIAG_CH_PLAUSIBILITY_CELL_RESISTANCE) {
+        if (event  ==  DIAG_EVENT_RESET) {
+            error_flags.plausibilityCheck &= 0xF7;
+        }
+        if (event == DIAG_EVENT_NOK) {
+            error_flags.plausibilityCheck |= 0x08;
+        }
     }
 }
 
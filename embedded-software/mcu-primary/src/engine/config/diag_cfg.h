@@ -83,6 +83,11 @@
 #define DIAG_ERROR_SLAVE_TEMP_SENSITIVITY_RSL   (500)   /*!< RSL level for event occurrence if slave PCB temperature event     */
 #define DIAG_ERROR_SLAVE_TEMP_SENSITIVITY_MOL   (500)   /*!< MOL level for event occurrence if slave PCB temperature event     */
 
+/* the fuse curve windows already filter the current, so these events are not debounced further */
+#define DIAG_ERROR_FUSE_OVERLOAD_SENSITIVITY_MSL (10)   /*!< MSL level for event occurrence if fuse overload event            */
+#define DIAG_ERROR_FUSE_OVERLOAD_SENSITIVITY_RSL (10)   /*!< RSL level for event occurrence if fuse overload event            */
+#define DIAG_ERROR_FUSE_OVERLOAD_SENSITIVITY_MOL (10)   /*!< MOL level for event occurrence if fuse overload event            */
+
 #define DIAG_ERROR_LTC_PEC_SENSITIVITY          (5)
 #define DIAG_ERROR_LTC_MUX_SENSITIVITY          (5)
 #define DIAG_ERROR_LTC_SPI_SENSITIVITY          (5)
@@ -211,7 +216,14 @@ typedef enum {
     DIAG_CH_PLAUSIBILITY_CELL_VOLTAGE, /* plausibility checks */
     DIAG_CH_PLAUSIBILITY_CELL_TEMP, /* plausibility checks */
     DIAG_CH_PLAUSIBILITY_PACK_VOLTAGE, /* plausibility checks */
+    DIAG_CH_PLAUSIBILITY_CELL_RESISTANCE, /* plausibility checks */
     DIAG_CH_DEEP_DISCHARGE_DETECTED, /* DoD was detected */
+    DIAG_CH_ALGO_DEADLINE_VIOLATION, /* algorithm exceeded its maximum calculation duration */
+    DIAG_CH_ALGO_BLOCKED, /* algorithm blocked after repeated deadline violations */
+    DIAG_CH_FUSE_OVERLOAD_MSL, /* I2t over a window of the fuse curve exceeded */
+    DIAG_CH_FUSE_OVERLOAD_RSL, /* I2t over a window of the fuse curve exceeded */
+    DIAG_CH_FUSE_OVERLOAD_MOL, /* I2t over a window of the fuse curve exceeded */
+    DIAG_CH_CAN_RX_QUEUE_FULL, /* CAN driver dropped received messages */
     DIAG_ID_MAX, /* MAX indicator - do not change */
 } DIAG_CH_ID_e;
 
@@ -286,6 +298,7 @@ typedef enum {
     DIAG_SYSMON_APPL_CYCLIC_1ms,    /*!< diag entry for application 10ms task  */
     DIAG_SYSMON_APPL_CYCLIC_10ms,   /*!< diag entry for application 10ms task  */
     DIAG_SYSMON_APPL_CYCLIC_100ms,  /*!< diag entry for application 100ms task */
+    DIAG_SYSMON_APPL_ALGO,          /*!< diag entry for algorithm task         */
     DIAG_SYSMON_MODULE_ID_MAX,      /*!< end marker do not delete              */
 } DIAG_SYSMON_MODULE_ID_e;
 
@@ -104,6 +104,12 @@ void ENG_PostOSInit(void) {
     if (retErrorCode != 0) {
         DIAG_Handler(DIAG_CH_CAN_INIT_FAILURE, DIAG_EVENT_NOK, retErrorCode);   /* error event in eeprom driver */
     }
+    CANS_Init();
+    /* the periodic TX messages of one tick have to fit in the TX buffer of the node */
+    if ((CANS_GetTxMaxSlotLoad(CAN_NODE0) > CAN0_TX_BUFFER_LENGTH) ||
+            (CANS_GetTxMaxSlotLoad(CAN_NODE1) > CAN1_TX_BUFFER_LENGTH)) {
+        DIAG_Handler(DIAG_CH_CAN_INIT_FAILURE, DIAG_EVENT_NOK, 0);
+    }
 
     os_boot = OS_EEPR_INIT;
 
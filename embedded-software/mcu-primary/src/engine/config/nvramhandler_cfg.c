@@ -69,17 +69,23 @@ NVRAM_CH_NVSOC_s MEM_BKP_SRAM bkpsram_nvsoc;
 NVRRAM_CH_CONT_COUNT_s MEM_BKP_SRAM bkpsram_contactors_count;
 NVRAM_CH_OP_HOURS_s MEM_BKP_SRAM bkpsram_operating_hours;
 NVRAM_OPERATING_HOURS_s MEM_BKP_SRAM bkpsram_op_hours;
+NVRAM_CH_SOH_s MEM_BKP_SRAM bkpsram_soh;
+NVRAM_CH_BALANCING_s MEM_BKP_SRAM bkpsram_balancing;
 #else
 NVRAM_CH_NVSOC_s bkpsram_nvsoc;
 NVRRAM_CH_CONT_COUNT_s bkpsram_contactors_count;
 NVRAM_CH_OP_HOURS_s bkpsram_operating_hours;
 NVRAM_OPERATING_HOURS_s bkpsram_op_hours;
+NVRAM_CH_SOH_s bkpsram_soh;
+NVRAM_CH_BALANCING_s bkpsram_balancing;
 #endif
 
 NVRAM_BLOCK_s nvram_dataHandlerBlocks[] = {
     { NVRAM_wait, 0, NVRAM_Cyclic, 30000, 100, &NVM_operatingHoursUpdateRAM, &NVM_operatingHoursUpdateNVRAM },
     { NVRAM_wait, 0, NVRAM_Cyclic, 60000, 1000, &NVM_socUpdateRAM, &NVM_socUpdateNVRAM },
     { NVRAM_wait, 0, NVRAM_Triggered, 0, 0, &NVM_contactorcountUpdateRAM, &NVM_contactorcountUpdateNVRAM },
+    { NVRAM_wait, 0, NVRAM_Triggered, 0, 0, &NVM_sohUpdateRAM, &NVM_sohUpdateNVRAM },
+    { NVRAM_wait, 0, NVRAM_Triggered, 0, 0, &NVM_balancingUpdateRAM, &NVM_balancingUpdateNVRAM },
 };
 
 const uint16_t nvram_number_of_blocks = sizeof(nvram_dataHandlerBlocks)/sizeof(nvram_dataHandlerBlocks[0]);
@@ -127,6 +133,86 @@ STD_RETURN_TYPE_e NVM_getSOC(SOX_SOC_s *dest_ptr) {
 }
 
 
+STD_RETURN_TYPE_e NVM_setSOH(SOX_SOH_s *ptr) {
+    STD_RETURN_TYPE_e retval = E_OK;
+
+    if (ptr != NULL_PTR) {
+        uint32_t interrupt_status = 0;
+
+        /* Disable interrupts */
+        interrupt_status = MCU_DisableINT();
+
+        bkpsram_soh.data = *ptr;
+        bkpsram_soh.previous_timestamp = bkpsram_soh.timestamp;
+        bkpsram_soh.timestamp = RTC_getUnixTime();
+        /* calculate checksum*/
+        bkpsram_soh.checksum = EEPR_CalcChecksum((uint8_t*)&bkpsram_soh, sizeof(bkpsram_soh) - 4);
+
+        /* Enable interrupts */
+        MCU_RestoreINT(interrupt_status);
+    } else {
+        retval = E_NOT_OK;
+    }
+
+    return retval;
+}
+
+
+STD_RETURN_TYPE_e NVM_getSOH(SOX_SOH_s *dest_ptr) {
+    STD_RETURN_TYPE_e ret_val;
+
+    if ((dest_ptr != NULL_PTR) &&
+        (EEPR_CalcChecksum((uint8_t*)&bkpsram_soh, sizeof(bkpsram_soh)-4) == bkpsram_soh.checksum)) {
+        /* data valid */
+        *dest_ptr = bkpsram_soh.data;
+        ret_val = E_OK;
+    } else {
+        ret_val = E_NOT_OK;
+    }
+    return ret_val;
+}
+
+
+STD_RETURN_TYPE_e NVM_setBalancingStatistics(BAL_STATISTICS_s *ptr) {
+    STD_RETURN_TYPE_e retval = E_OK;
+
+    if (ptr != NULL_PTR) {
+        uint32_t interrupt_status = 0;
+
+        /* Disable interrupts */
+        interrupt_status = MCU_DisableINT();
+
+        bkpsram_balancing.data = *ptr;
+        bkpsram_balancing.previous_timestamp = bkpsram_balancing.timestamp;
+        bkpsram_balancing.timestamp = RTC_getUnixTime();
+        /* calculate checksum*/
+        bkpsram_balancing.checksum = EEPR_CalcChecksum((uint8_t*)&bkpsram_balancing, sizeof(bkpsram_balancing) - 4);
+
+        /* Enable interrupts */
+        MCU_RestoreINT(interrupt_status);
+    } else {
+        retval = E_NOT_OK;
+    }
+
+    return retval;
+}
+
+
+STD_RETURN_TYPE_e NVM_getBalancingStatistics(BAL_STATISTICS_s *dest_ptr) {
+    STD_RETURN_TYPE_e ret_val;
+
+    if ((dest_ptr != NULL_PTR) &&
+        (EEPR_CalcChecksum((uint8_t*)&bkpsram_balancing, sizeof(bkpsram_balancing)-4) == bkpsram_balancing.checksum)) {
+        /* data valid */
+        *dest_ptr = bkpsram_balancing.data;
+        ret_val = E_OK;
+    } else {
+        ret_val = E_NOT_OK;
+    }
+    return ret_val;
+}
+
+
 STD_RETURN_TYPE_e NVM_Set_contactorcnt(DIAG_CONTACTOR_s *ptr) {
     STD_RETURN_TYPE_e retval = E_OK;
 
@@ -291,3 +377,31 @@ STD_RETURN_TYPE_e NVM_contactorcountUpdateRAM(void) {
     EEPR_SetChReadReqFlag(EEPR_CH_CONTACTOR);
     return retval;
 }
+
+
+STD_RETURN_TYPE_e NVM_sohUpdateNVRAM(void) {
+    STD_RETURN_TYPE_e retval = E_OK;
+    EEPR_SetChDirtyFlag(EEPR_CH_STATISTICS);
+    return retval;
+}
+
+
+STD_RETURN_TYPE_e NVM_sohUpdateRAM(void) {
+    STD_RETURN_TYPE_e retval = E_OK;
+    EEPR_SetChReadReqFlag(EEPR_CH_STATISTICS);
+    return retval;
+}
+
+
+STD_RETURN_TYPE_e NVM_balancingUpdateNVRAM(void) {
+    STD_RETURN_TYPE_e retval = E_OK;
+    EEPR_SetChDirtyFlag(EEPR_CH_BALANCING);
+    return retval;
+}
+
+
+STD_RETURN_TYPE_e NVM_balancingUpdateRAM(void) {
+    STD_RETURN_TYPE_e retval = E_OK;
+    EEPR_SetChReadReqFlag(EEPR_CH_BALANCING);
+    return retval;
+}
@@ -109,6 +109,8 @@ typedef enum {
 #define NVRAM_BLOCK_ID_OPERATING_HOURS         NVRAM_BLOCK_00
 #define NVRAM_BLOCK_ID_CELLTEMPERATURE         NVRAM_BLOCK_01
 #define NVRAM_BLOCK_ID_CONT_COUNTER            NVRAM_BLOCK_02
+#define NVRAM_BLOCK_ID_SOH                     NVRAM_BLOCK_03
+#define NVRAM_BLOCK_ID_BALANCING               NVRAM_BLOCK_04
 
 /*================== Constant and Variable Definitions ====================*/
 /*
@@ -167,6 +169,34 @@ extern STD_RETURN_TYPE_e NVM_contactorcountUpdateNVRAM(void);
  */
 extern STD_RETURN_TYPE_e NVM_contactorcountUpdateRAM(void);
 
+/**
+ * @brief   saves SOH data into the non-volatile memory (NVM)
+ *
+ * @return  E_OK if successful, otherwise E_NOT_OK
+ */
+extern STD_RETURN_TYPE_e NVM_sohUpdateNVRAM(void);
+
+/**
+ * @brief   reads SOH data from the non-volatile and writes to the volatile memory (RAM)
+ *
+ * @return  E_OK if successful, otherwise E_NOT_OK
+ */
+extern STD_RETURN_TYPE_e NVM_sohUpdateRAM(void);
+
+/**
+ * @brief   saves balancing statistics into the non-volatile memory (NVM)
+ *
+ * @return  E_OK if successful, otherwise E_NOT_OK
+ */
+extern STD_RETURN_TYPE_e NVM_balancingUpdateNVRAM(void);
+
+/**
+ * @brief   reads balancing statistics from the non-volatile and writes to the volatile memory (RAM)
+ *
+ * @return  E_OK if successful, otherwise E_NOT_OK
+ */
+extern STD_RETURN_TYPE_e NVM_balancingUpdateRAM(void);
+
 
 /** Interface functions writting to/ reading from volatile memory (RAM/BKPSRAM) */
 
@@ -218,6 +248,42 @@ extern STD_RETURN_TYPE_e NVM_getSOC(SOX_SOC_s *dest_ptr);
 */
 extern STD_RETURN_TYPE_e NVM_setSOC(SOX_SOC_s* ptr);
 
+/**
+ * @brief  Gets the SOH data saved in the non-volatile RAM
+ *
+ * @param  dest_ptr pointer where the soh data should be stored to
+ *
+ * @return E_OK if the stored data is valid, otherwise E_NOT_OK
+*/
+extern STD_RETURN_TYPE_e NVM_getSOH(SOX_SOH_s *dest_ptr);
+
+/**
+ * @brief  Sets the SOH data saved in the non-volatile RAM
+ *
+ * @param  ptr pointer where the soh data is stored
+ *
+ * @return E_OK if successful, otherwise E_NOT_OK
+*/
+extern STD_RETURN_TYPE_e NVM_setSOH(SOX_SOH_s *ptr);
+
+/**
+ * @brief  Gets the balancing statistics saved in the non-volatile RAM
+ *
+ * @param  dest_ptr pointer where the balancing statistics should be stored to
+ *
+ * @return E_OK if the stored data is valid, otherwise E_NOT_OK
+*/
+extern STD_RETURN_TYPE_e NVM_getBalancingStatistics(BAL_STATISTICS_s *dest_ptr);
+
+/**
+ * @brief  Sets the balancing statistics saved in the non-volatile RAM
+ *
+ * @param  ptr pointer where the balancing statistics are stored
+ *
+ * @return E_OK if successful, otherwise E_NOT_OK
+*/
+extern STD_RETURN_TYPE_e NVM_setBalancingStatistics(BAL_STATISTICS_s *ptr);
+
 /*================== Function Implementations =============================*/
 
 #endif /* NVRAMHANDLER_CFG_H_ */
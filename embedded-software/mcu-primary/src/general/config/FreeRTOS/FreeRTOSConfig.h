@@ -98,7 +98,7 @@
 
 /* Software timer definitions. */
 #define configUSE_TIMERS                    1
-#define configTIMER_TASK_PRIORITY           (2)
+#define configTIMER_TASK_PRIORITY           (3)     /* same level as OS_PRIORITY_BELOW_NORMAL */
 #define configTIMER_QUEUE_LENGTH            10
 #define configTIMER_TASK_STACK_DEPTH        (configMINIMAL_STACK_SIZE * 2)
 
@@ -163,6 +163,9 @@ extern void OS_ConfigureTimerForRuntimeStats(void);
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()   OS_ConfigureTimerForRuntimeStats()
 extern uint32_t OS_GetRuntimeCounterValue(void);
 #define portGET_RUN_TIME_COUNTER_VALUE()           OS_GetRuntimeCounterValue()
+/* Start of the time slice of the running task, see OS_GetTaskRunTime() */
+extern void OS_TaskSwitchedIn(void);
+#define traceTASK_SWITCHED_IN()                    OS_TaskSwitchedIn()
 #endif
 
 #endif /* FREERTOS_CONFIG_H */
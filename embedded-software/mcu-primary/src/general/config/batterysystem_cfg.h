@@ -407,6 +407,51 @@
  */
 #define BS_CHECK_FUSE_PLACED_IN_CHARGE_PATH          FALSE
 
+/**
+ * Set to TRUE to check the current against the fuse curve. A violation of
+ * the maximum safety limit of the fuse curve then opens the contactors.
+ * RMS, peak and I2t of the windows are computed in any case.
+ */
+#define BS_CHECK_FUSE_CURVE                         FALSE
+
+/**
+ * number of points of the fuse curve
+ *
+ * Each point is a sliding window over the current sensor samples and the
+ * RMS current the fuse (or the busbar) tolerates for the duration of this
+ * window. For every point the I2t of the last window is compared against
+ * the I2t limit of the time the window covers, interpolated linearly
+ * between the I2t of the points. This also covers the windows that are
+ * still being filled after startup. The points
+ * have to be sorted with increasing window length, the longest window sets
+ * the size of the sample buffer. The default points are placeholders above
+ * BC_CURRENTMAX_DISCHARGE_MSL, replace them with the datasheet values of the
+ * fuse used before setting BS_CHECK_FUSE_CURVE to TRUE.
+ */
+#define BS_NR_OF_FUSE_CURVE_POINTS                  4
+
+#define BS_FUSE_CURVE_WINDOW_0_MS                   (100u)
+#define BS_FUSE_CURVE_CURRENT_0_mA                  (600000u)
+
+#define BS_FUSE_CURVE_WINDOW_1_MS                   (1000u)
+#define BS_FUSE_CURVE_CURRENT_1_mA                  (400000u)
+
+#define BS_FUSE_CURVE_WINDOW_2_MS                   (10000u)
+#define BS_FUSE_CURVE_CURRENT_2_mA                  (280000u)
+
+#define BS_FUSE_CURVE_WINDOW_3_MS                   (60000u)
+#define BS_FUSE_CURVE_CURRENT_3_mA                  (220000u)
+
+/**
+ * recommended safety limit of the fuse curve in percent of the limit current
+ */
+#define BS_FUSE_CURVE_RSL_PERCENT                   (90u)
+
+/**
+ * maximum operating limit of the fuse curve in percent of the limit current
+ */
+#define BS_FUSE_CURVE_MOL_PERCENT                   (80u)
+
 /*================== Constant and Variable Definitions ====================*/
 
 /*================== Function Prototypes ==================================*/
@@ -233,6 +233,13 @@
  */
 #define MEM_EXT_SDRAM   __attribute__((section (".EXT_SDRAMSection")))
 
+/**
+ * A variable defined as ``(type) MEM_XCP_CAL (name)`` is a calibration parameter,
+ * the only memory the XCP master can write with DOWNLOAD. The variable has to be
+ * initialized, the section is copied from flash at startup like .data.
+ */
+#define MEM_XCP_CAL     __attribute__((section (".XCP_CALSection")))
+
 
 /*================== Constant and Variable Definitions ====================*/
 
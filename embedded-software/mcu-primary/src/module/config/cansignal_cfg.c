@@ -53,15 +53,29 @@
 /*================== Includes ===============================================*/
 #include "cansignal_cfg.h"
 
+#include "algo_cfg.h"
 #include "bal.h"
+#include "bms.h"
 #include "database.h"
 #include "diag.h"
 #include "sox.h"
+#include "sox_soh.h"
 #include "sys.h"
 
 /*================== Macros and Definitions =================================*/
 static DATA_BLOCK_CURRENT_SENSOR_s cans_current_tab;
 
+/**
+ * range of the 4 bit message counter in the low nibble of the IVT status byte
+ */
+#define CANS_ISA_MSG_COUNTER_RANGE  (16u)
+
+/**
+ * message counter of the last and of the previous IVT current message
+ */
+static uint8_t cans_currentMsgCounter = 0;
+static uint8_t cans_previousCurrentMsgCounter = 0;
+
 #define CANS_MODULSIGNALS_VOLT      (CAN0_SIG_Mod0_temp_valid_0_2 - CAN0_SIG_Mod0_volt_valid_0_2)
 #define CANS_MODULSIGNALS_TEMP      (CAN0_SIG_Mod1_volt_valid_0_2 - CAN0_SIG_Mod0_temp_valid_0_2)
 
@@ -76,6 +90,7 @@ static uint32_t cans_gettempering(uint32_t, void *);
 static uint32_t cans_getcanerr(uint32_t, void *);
 static uint32_t cans_gettemp(uint32_t, void *);
 static uint32_t cans_getsoc(uint32_t, void *);
+static uint32_t cans_getsoh(uint32_t, void *);
 static uint32_t cans_getRecommendedOperatingCurrent(uint32_t, void *);
 static uint32_t cans_getMaxAllowedPower(uint32_t, void *);
 static uint32_t cans_getpower(uint32_t, void *);
@@ -88,6 +103,7 @@ static uint32_t cans_getisoguard(uint32_t, void *);
 
 /* RX/Setter functions */
 static uint32_t cans_setcurr(uint32_t, void *);
+static uint32_t cans_getCurrentTimestep(uint32_t timestamp, uint32_t previousTimestamp);
 static uint32_t cans_setstaterequest(uint32_t, void *);
 static uint32_t cans_setdebug(uint32_t, void *);
 static uint32_t cans_setSWversion(uint32_t, void *);
@@ -148,9 +164,9 @@ const CANS_signal_s cans_CAN0_signals_tx[] = {
     { {CAN0_MSG_SOC}, 16, 16, 0, 100, 100, 0, littleEndian, &cans_getsoc },  /*!< CAN0_SIG_SOC_min */
     { {CAN0_MSG_SOC}, 32, 16, 0, 100, 100, 0, littleEndian, &cans_getsoc },  /*!< CAN0_SIG_SOC_max */
 
-    { {CAN0_MSG_SOH}, 0, 16, 0, 0, 100, 0, littleEndian, NULL_PTR },  /*!< CAN0_SIG_SOH_mean */
-    { {CAN0_MSG_SOH}, 16, 16, 0, 0, 100, 0, littleEndian, NULL_PTR },  /*!< CAN0_SIG_SOH_min */
-    { {CAN0_MSG_SOH}, 32, 16, 0, 0, 100, 0, littleEndian, NULL_PTR },  /*!< CAN0_SIG_SOH_max */
+    { {CAN0_MSG_SOH}, 0, 16, 0, 100, 100, 0, littleEndian, &cans_getsoh },  /*!< CAN0_SIG_SOH_mean */
+    { {CAN0_MSG_SOH}, 16, 16, 0, 100, 100, 0, littleEndian, &cans_getsoh },  /*!< CAN0_SIG_SOH_min */
+    { {CAN0_MSG_SOH}, 32, 16, 0, 100, 100, 0, littleEndian, &cans_getsoh },  /*!< CAN0_SIG_SOH_max */
 
     { {CAN0_MSG_SOE}, 0, 16, 0, 0, 100, 0, littleEndian, NULL_PTR },  /*!< CAN0_SIG_SOE */
     { {CAN0_MSG_SOE}, 16, 32, 0, UINT32_MAX, 1, 0, littleEndian, NULL_PTR },  /*!< CAN0_SIG_RemainingEnergy */
@@ -557,30 +573,30 @@ const CANS_signal_s cans_CAN1_signals_tx[] = {
 
 const CANS_signal_s cans_CAN0_signals_rx[] = {
     { {CAN0_MSG_StateRequest}, 8, 8, 0, UINT8_MAX, 1, 0, littleEndian, &cans_setstaterequest },
-    { {CAN0_MSG_IVT_Current}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS0_I_MuxID */
-    { {CAN0_MSG_IVT_Current}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS0_I_Status */
-    { {CAN0_MSG_IVT_Current}, 16, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS0_I_Measurement */
-    { {CAN0_MSG_IVT_Voltage_1}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS1_U1_MuxID */
-    { {CAN0_MSG_IVT_Voltage_1}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS1_U1_Status */
-    { {CAN0_MSG_IVT_Voltage_1}, 16, 32, 0, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS1_U1_Measurement */
-    { {CAN0_MSG_IVT_Voltage_2}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS2_U2_MuxID */
-    { {CAN0_MSG_IVT_Voltage_2}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS2_U2_Status */
-    { {CAN0_MSG_IVT_Voltage_2}, 16, 32, 0, INT32_MAX, 1, 0, bigEndian, &cans_setcurr, },  /* CAN0_SIG_ISENS2_U2_Measurement */
-    { {CAN0_MSG_IVT_Voltage_3}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS3_U3_MuxID */
-    { {CAN0_MSG_IVT_Voltage_3}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS3_U3_Status */
-    { {CAN0_MSG_IVT_Voltage_3}, 16, 32, 0, INT32_MAX, 1, 0, bigEndian, &cans_setcurr, },  /* CAN0_SIG_ISENS3_U3_Measurement */
-    { {CAN0_MSG_IVT_Temperature}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS4_T_MuxID */
-    { {CAN0_MSG_IVT_Temperature}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS4_T_Status */
-    { {CAN0_MSG_IVT_Temperature}, 16, 32, INT32_MIN, INT32_MAX, 0.1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS4_T_Measurement */
-    { {CAN0_MSG_IVT_Power}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS5_P_MuxID */
-    { {CAN0_MSG_IVT_Power}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS5_P_Status */
-    { {CAN0_MSG_IVT_Power}, 16, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS5_P_Measurement */
-    { {CAN0_MSG_IVT_CoulombCount}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS6_CC_MuxID */
-    { {CAN0_MSG_IVT_CoulombCount}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS6_CC_Status */
-    { {CAN0_MSG_IVT_CoulombCount}, 16, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS6_CC_Measurement */
-    { {CAN0_MSG_IVT_EnergyCount}, 0, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS7_EC_MuxID */
-    { {CAN0_MSG_IVT_EnergyCount}, 8, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS7_EC_Status */
-    { {CAN0_MSG_IVT_EnergyCount}, 16, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS7_EC_Measurement */
+    { {CAN0_MSG_IVT_Current}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS0_I_MuxID */
+    { {CAN0_MSG_IVT_Current}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS0_I_Status */
+    { {CAN0_MSG_IVT_Current}, 23, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS0_I_Measurement */
+    { {CAN0_MSG_IVT_Voltage_1}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS1_U1_MuxID */
+    { {CAN0_MSG_IVT_Voltage_1}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS1_U1_Status */
+    { {CAN0_MSG_IVT_Voltage_1}, 23, 32, 0, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS1_U1_Measurement */
+    { {CAN0_MSG_IVT_Voltage_2}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS2_U2_MuxID */
+    { {CAN0_MSG_IVT_Voltage_2}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS2_U2_Status */
+    { {CAN0_MSG_IVT_Voltage_2}, 23, 32, 0, INT32_MAX, 1, 0, bigEndian, &cans_setcurr, },  /* CAN0_SIG_ISENS2_U2_Measurement */
+    { {CAN0_MSG_IVT_Voltage_3}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS3_U3_MuxID */
+    { {CAN0_MSG_IVT_Voltage_3}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS3_U3_Status */
+    { {CAN0_MSG_IVT_Voltage_3}, 23, 32, 0, INT32_MAX, 1, 0, bigEndian, &cans_setcurr, },  /* CAN0_SIG_ISENS3_U3_Measurement */
+    { {CAN0_MSG_IVT_Temperature}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS4_T_MuxID */
+    { {CAN0_MSG_IVT_Temperature}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS4_T_Status */
+    { {CAN0_MSG_IVT_Temperature}, 23, 32, INT32_MIN, INT32_MAX, 0.1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS4_T_Measurement */
+    { {CAN0_MSG_IVT_Power}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS5_P_MuxID */
+    { {CAN0_MSG_IVT_Power}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS5_P_Status */
+    { {CAN0_MSG_IVT_Power}, 23, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS5_P_Measurement */
+    { {CAN0_MSG_IVT_CoulombCount}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS6_CC_MuxID */
+    { {CAN0_MSG_IVT_CoulombCount}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS6_CC_Status */
+    { {CAN0_MSG_IVT_CoulombCount}, 23, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS6_CC_Measurement */
+    { {CAN0_MSG_IVT_EnergyCount}, 7, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS7_EC_MuxID */
+    { {CAN0_MSG_IVT_EnergyCount}, 15, 8, 0, UINT8_MAX, 1, 0, bigEndian, NULL_PTR },  /* CAN0_SIG_ISENS7_EC_Status */
+    { {CAN0_MSG_IVT_EnergyCount}, 23, 32, INT32_MIN, INT32_MAX, 1, 0, bigEndian, &cans_setcurr },  /* CAN0_SIG_ISENS7_EC_Measurement */
     { {CAN0_MSG_DEBUG}, 0, 64, 0, UINT64_MAX, 1, 0, littleEndian, &cans_setdebug },  /* CAN0_SIG_DEBUG_Data */
     { {CAN0_MSG_GetReleaseVersion}, 0, 64, 0, UINT64_MAX, 1, 0, littleEndian, &cans_setSWversion }  /* CAN0_SIG_DEBUG_Data */
 };
@@ -1510,6 +1526,19 @@ uint32_t cans_getsoc(uint32_t sigIdx, void *value) {
 }
 
 
+static uint32_t cans_getsoh(uint32_t sigIdx, void *value) {
+    float canData = 0;
+
+    if (value != NULL_PTR) {
+        /* capacity is estimated for the pack, so mean, min and max are equal */
+        canData = cans_checkLimits(SOX_SOH_GetStateOfHealth(), sigIdx);
+        /* CAN signal resolution 0.01%, --> factor 100 */
+        *(uint32_t *)value = (uint32_t)(canData * cans_CAN0_signals_tx[sigIdx].factor);
+    }
+    return 0;
+}
+
+
 static uint32_t cans_getRecommendedOperatingCurrent(uint32_t sigIdx, void *value) {
     static DATA_BLOCK_SOF_s sof_tab;
     float canData = 0;
@@ -1557,8 +1586,43 @@ static uint32_t cans_getRecommendedOperatingCurrent(uint32_t sigIdx, void *value
 
 
 static uint32_t cans_getMaxAllowedPower(uint32_t sigIdx, void *value) {
+    static DATA_BLOCK_SOF_s sof_tab;
+    float canData = 0;
+
     if (value != NULL_PTR) {
+        /* values transmitted in resolution of 0.1kW, database values in W */
         switch (sigIdx) {
+            case CAN0_SIG_MaxChargePower:
+                /* first signal */
+                DB_ReadBlock(&sof_tab, DATA_BLOCK_ID_SOF);
+
+                /* Check limits */
+                canData = cans_checkLimits(sof_tab.recommended_continuous_charge_power / 1000.0f, sigIdx);
+                /* Apply offset and factor */
+                *(uint32_t *)value = (uint32_t)((canData + cans_CAN0_signals_tx[sigIdx].offset) * cans_CAN0_signals_tx[sigIdx].factor);
+                break;
+
+            case CAN0_SIG_MaxChargePower_Peak:
+                /* Check limits */
+                canData = cans_checkLimits(sof_tab.recommended_peak_charge_power / 1000.0f, sigIdx);
+                /* Apply offset and factor */
+                *(uint32_t *)value = (uint32_t)((canData + cans_CAN0_signals_tx[sigIdx].offset) * cans_CAN0_signals_tx[sigIdx].factor);
+                break;
+
+            case CAN0_SIG_MaxDischargePower:
+                /* Check limits */
+                canData = cans_checkLimits(sof_tab.recommended_continuous_discharge_power / 1000.0f, sigIdx);
+                /* Apply offset and factor */
+                *(uint32_t *)value = (uint32_t)((canData + cans_CAN0_signals_tx[sigIdx].offset) * cans_CAN0_signals_tx[sigIdx].factor);
+                break;
+
+            case CAN0_SIG_MaxDischargePower_Peak:
+                /* Check limits */
+                canData = cans_checkLimits(sof_tab.recommended_peak_discharge_power / 1000.0f, sigIdx);
+                /* Apply offset and factor */
+                *(uint32_t *)value = (uint32_t)((canData + cans_CAN0_signals_tx[sigIdx].offset) * cans_CAN0_signals_tx[sigIdx].factor);
+                break;
+
             default:
                 *(uint32_t *)value = 0;
                 break;
@@ -1833,6 +1897,41 @@ static uint32_t cans_getPackVoltage(uint32_t sigIdx, void *value) {
 }
 
 
+/**
+ * @brief   returns the sampling interval of the last IVT current message
+ *
+ * The sensor measures every ISA_CURRENT_CYCLE_TIME_MS and increments the message counter
+ * with each message, so the counter difference gives the interval independent of when the
+ * buffered messages are processed. Gaps the counter cannot resolve fall back to the OS tick.
+ *
+ * @param   timestamp           OS tick of the last current message
+ * @param   previousTimestamp   OS tick of the previous current message
+ *
+ * @return  sampling interval in ms, 0 for the first message
+ */
+static uint32_t cans_getCurrentTimestep(uint32_t timestamp, uint32_t previousTimestamp) {
+    uint32_t retVal = 0;
+    uint32_t elapsed_ms = timestamp - previousTimestamp;
+    uint8_t cycles = (uint8_t)(cans_currentMsgCounter - cans_previousCurrentMsgCounter) & 0x0F;
+
+    if (previousTimestamp == 0) {
+        /* first message, no interval yet */
+        retVal = 0;
+    } else if (elapsed_ms >= ((CANS_ISA_MSG_COUNTER_RANGE - 1) * ISA_CURRENT_CYCLE_TIME_MS)) {
+        /* counter may have wrapped, use the OS tick */
+        retVal = elapsed_ms;
+    } else {
+        if (cycles == 0) {
+            /* counter not incremented, assume one cycle */
+            cycles = 1;
+        }
+        retVal = cycles * ISA_CURRENT_CYCLE_TIME_MS;
+    }
+    cans_previousCurrentMsgCounter = cans_currentMsgCounter;
+    return retVal;
+}
+
+
 static uint32_t cans_setcurr(uint32_t sigIdx, void *value) {
     int32_t currentValue;
     int32_t temperatureValue;
@@ -1854,11 +1953,15 @@ static uint32_t cans_setcurr(uint32_t sigIdx, void *value) {
             case CAN0_SIG_IVT_CC_Status:
             case CAN0_SIG_IVT_EC_Status:
                 dummy = *(uint32_t *)value & 0x000000FF;
+                if (sigIdx == CAN0_SIG_IVT_Current_Status) {
+                    /* low nibble contains the message counter */
+                    cans_currentMsgCounter = dummy & 0x0F;
+                }
                 dummy &= 0xF0;   /* only high nibble contains diag info */
-                if ((dummy & 0x10) == TRUE) {
+                if ((dummy & 0x10) != 0u) {
                     /* Overcurrent detected. This feature is currently not supported. */
                 }
-                if ((dummy & 0x20) == TRUE) {
+                if ((dummy & 0x20) != 0u) {
                     if (sigIdx == CAN0_SIG_IVT_Current_Status) {
                         cans_current_tab.state_current = 1;
                     } else if (sigIdx == CAN0_SIG_IVT_Voltage_1_Status || sigIdx == CAN0_SIG_IVT_Voltage_2_Status || sigIdx == CAN0_SIG_IVT_Voltage_3_Status) {
@@ -1880,7 +1983,7 @@ static uint32_t cans_setcurr(uint32_t sigIdx, void *value) {
                     cans_current_tab.state_cc = 0;
                     cans_current_tab.state_ec = 0;
                 }
-                if ((dummy & 0x40) == TRUE || (dummy & 0x80) == TRUE) {
+                if (((dummy & 0x40) != 0u) || ((dummy & 0x80) != 0u)) {
                     cans_current_tab.state_current = 1;
                     cans_current_tab.state_voltage = 1;
                     cans_current_tab.state_temperature = 1;
@@ -1898,6 +2001,9 @@ static uint32_t cans_setcurr(uint32_t sigIdx, void *value) {
                     cans_current_tab.newCurrent++;
                     cans_current_tab.previous_timestamp_cur = cans_current_tab.timestamp_cur;
                     cans_current_tab.timestamp_cur = OS_getOSSysTick();
+                    cans_current_tab.timestep_cur = cans_getCurrentTimestep(cans_current_tab.timestamp_cur, cans_current_tab.previous_timestamp_cur);
+                    SOC_AddCurrentSample(currentValue, cans_current_tab.timestep_cur);
+                    BMS_AddCurrentSample(&cans_current_tab);
                     DB_WriteBlock(&cans_current_tab, DATA_BLOCK_ID_CURRENT_SENSOR);
                     break;
                 case CAN0_SIG_IVT_Voltage_1_Measurement:
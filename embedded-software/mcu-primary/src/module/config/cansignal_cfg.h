@@ -87,6 +87,57 @@
 #define CANS_TICK_MS 10
 /* #define CANS_TICK_MS 100 */
 
+/**
+ * @ingroup CONFIG_CANSIGNAL
+ * If TRUE, CANS_Init() replaces the configured repetition_phase of the periodic TX
+ * messages with phases that spread the messages equally over the CANS ticks
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * TRUE
+*/
+#define CANS_TX_AUTO_PHASE TRUE
+
+/**
+ * @ingroup CONFIG_CANSIGNAL
+ * maximum length of the TX schedule in ticks. The schedule of a CAN node repeats after the
+ * least common multiple of the repetition times of its TX messages. If this is longer,
+ * the configured phases are used.
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x
+ * \par Default:
+ * 500
+*/
+#define CANS_TX_SCHEDULE_MAX_TICKS 500
+
+/**
+ * @ingroup CONFIG_CANSIGNAL
+ * time in which all cell voltages are sent once by the cell voltage stream, has to be a
+ * multiple of CANS_TICK_MS. The groups of cells are spread over the ticks of this period.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 100
+*/
+#define CANS_STREAM_PERIOD_MS 100
+
+/**
+ * @ingroup CONFIG_CANSIGNAL
+ * every CANS_STREAM_KEYFRAME_CYCLES periods, a group of cells is sent with absolute values even
+ * if its changes fit in a delta frame, so a receiver synchronizes within this number of periods
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x
+ * \par Default:
+ * 10
+*/
+#define CANS_STREAM_KEYFRAME_CYCLES 10
+
 
 /**
  * symbolic names for TX CAN messages. Every used TX message needs to get an individual message name.
@@ -211,6 +262,8 @@ typedef enum {
 
 
     /* Insert here symbolic names for CAN1 messages */
+
+    CANS_MSG_TX_MAX,  /*!< MAX indicator - do not change */
 } CANS_messagesTx_e;
 
 /**
@@ -230,8 +283,12 @@ typedef enum {
     CAN0_MSG_IVT_EnergyCount,                /*!< current sensor E-C */
     CAN0_MSG_DEBUG,                          /*!< debug messages */
     CAN0_MSG_GetReleaseVersion,              /*!< Get SW release version */
+    CAN0_MSG_ISOTP_Request,                  /*!< ISO-TP request, not parsed by signals, see ISOTP_ReceiveFrame() */
+    CAN0_MSG_XCP_Request,                    /*!< XCP command, not parsed by signals, see XCP_ReceiveFrame() */
 
     /* Insert here symbolic names for CAN1 messages */
+
+    CANS_MSG_RX_MAX,  /*!< MAX indicator - do not change */
 } CANS_messagesRx_e;
 
 /**
@@ -748,6 +805,10 @@ typedef union {
  *
  * support for automatic scaling is planned, but not implemented yet,
  * so min, max, factor and offset are not relevant.
+ *
+ * bit_position is counted as in the dbc: for littleEndian signals it is the
+ * position of the least significant bit, for bigEndian (Motorola) signals the
+ * position of the most significant bit.
  */
 typedef struct  {
     CANS_messages_t msgIdx;
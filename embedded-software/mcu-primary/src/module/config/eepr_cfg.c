@@ -122,10 +122,11 @@ EEPR_CH_CFG_s eepr_ch_cfg[] = {
         {0x0080, sizeof(NVRAM_CH_OP_HOURS_s),       EEPR_CH_OPERATING_HOURS,    0x0080 + sizeof(NVRAM_CH_OP_HOURS_s) - 4,       EEPR_SW_WRITE_UNPROTECTED,  (uint8_t*)&bkpsram_operating_hours,     EEPR_NO_ERROR,  EEPR_ACCESS_UNPROTECTED},
         {0x0098, sizeof(NVRAM_CH_NVSOC_s),          EEPR_CH_NVSOC,              0x0098 + sizeof(NVRAM_CH_NVSOC_s) - 4,          EEPR_SW_WRITE_UNPROTECTED,  (uint8_t*)&bkpsram_nvsoc,               EEPR_NO_ERROR,  EEPR_ACCESS_UNPROTECTED},
         {0x00C0, sizeof(NVRRAM_CH_CONT_COUNT_s),    EEPR_CH_CONTACTOR,          0x00C0 + sizeof(NVRRAM_CH_CONT_COUNT_s) - 4,    EEPR_SW_WRITE_UNPROTECTED,  (uint8_t*)&bkpsram_contactors_count,    EEPR_NO_ERROR,  EEPR_ACCESS_UNPROTECTED},
-/*         {0x0110, sizeof(EEPR_CALIB_STATISTICS_s), EEPR_CH_STATISTICS,      0x0100 + sizeof(EEPR_CALIB_STATISTICS_s) - 4, EEPR_SW_WRITE_UNPROTECTED, (NULL_PTR)}, */
+        {0x0110, sizeof(NVRAM_CH_SOH_s),            EEPR_CH_STATISTICS,         0x0110 + sizeof(NVRAM_CH_SOH_s) - 4,            EEPR_SW_WRITE_UNPROTECTED,  (uint8_t*)&bkpsram_soh,                 EEPR_NO_ERROR,  EEPR_ACCESS_UNPROTECTED},
+        {0x0130, sizeof(NVRAM_CH_BALANCING_s),      EEPR_CH_BALANCING,          0x0130 + sizeof(NVRAM_CH_BALANCING_s) - 4,      EEPR_SW_WRITE_UNPROTECTED,  (uint8_t*)&bkpsram_balancing,           EEPR_NO_ERROR,  EEPR_ACCESS_UNPROTECTED},
         /*  FREE EEPRROMS CHANNELS (for future use) */
-/*         {0x0130, 0x70,                            EEPR_CH_USER_DATA,       0x0120 + 0x70 - 4,                            EEPR_SW_WRITE_UNPROTECTED, (NULL_PTR)}, */
-/*       {0x0180, ...}, */
+/*         {0x0200, 0x70,                            EEPR_CH_USER_DATA,       0x0200 + 0x70 - 4,                            EEPR_SW_WRITE_UNPROTECTED, (NULL_PTR)}, */
+/*       {0x0280, ...}, */
 };
 
 /* In case of compile errors in the following dummy-declarations,
@@ -144,8 +145,8 @@ extern uint8_t compiler_throw_an_error_3[(0x80 == 0x80)?1:-1];  /* EEPROM FORMAT
 extern uint8_t compiler_throw_an_error_4[(sizeof(NVRAM_CH_OP_HOURS_s) == 0x18)?1:-1];  /* EEPROM FORMAT ERROR! Change of data size. Please note comment above!!! */
 extern uint8_t compiler_throw_an_error_5[(sizeof(NVRAM_CH_NVSOC_s) == 0x28)?1:-1];  /* EEPROM FORMAT ERROR! Change of data size. Please note comment above!!! */
 extern uint8_t compiler_throw_an_error_6[(sizeof(NVRRAM_CH_CONT_COUNT_s) == 0x48)?1:-1];  /* EEPROM FORMAT ERROR! Change of data size. Please note comment above!!! */
-extern uint8_t compiler_throw_an_error_7[(sizeof(EEPR_CALIB_STATISTICS_s) == 0x20)?1:-1];  /* EEPROM FORMAT ERROR! Change of data size. Please note comment above!!! */
-extern uint8_t compiler_throw_an_error_8[(0x70 == 0x70)?1:-1];  /* EEPROM FORMAT ERROR! Change of data size. Please note comment above!!! */
+extern uint8_t compiler_throw_an_error_7[(sizeof(NVRAM_CH_SOH_s) == 0x18)?1:-1];  /* EEPROM FORMAT ERROR! Change of data size. Please note comment above!!! */
+extern uint8_t compiler_throw_an_error_8[(sizeof(NVRAM_CH_BALANCING_s) <= (0x0200 - 0x0130))?1:-1];  /* EEPROM FORMAT ERROR! Size depends on BS_NR_OF_MODULES, channel overlaps the next one */
 
 
 const uint8_t eepr_nr_of_channels = sizeof(eepr_ch_cfg)/sizeof(eepr_ch_cfg[0]);
@@ -282,6 +283,22 @@ void EEPR_SetDefaultValue(EEPR_CHANNEL_ID_TYPE_e eepr_channel) {
             EEPR_SetChDirtyFlag(EEPR_CH_OPERATING_HOURS);
             break;
 
+        case EEPR_CH_STATISTICS:
+            bkpsram_soh.data = default_soh.data;
+            bkpsram_soh.previous_timestamp = bkpsram_soh.timestamp;
+            bkpsram_soh.timestamp = RTC_getUnixTime();
+            bkpsram_soh.checksum = EEPR_CalcChecksum((uint8_t*)(&bkpsram_soh), sizeof(bkpsram_soh)-4);
+            EEPR_SetChDirtyFlag(EEPR_CH_STATISTICS);
+            break;
+
+        case EEPR_CH_BALANCING:
+            bkpsram_balancing.data = default_balancing.data;
+            bkpsram_balancing.previous_timestamp = bkpsram_balancing.timestamp;
+            bkpsram_balancing.timestamp = RTC_getUnixTime();
+            bkpsram_balancing.checksum = EEPR_CalcChecksum((uint8_t*)(&bkpsram_balancing), sizeof(bkpsram_balancing)-4);
+            EEPR_SetChDirtyFlag(EEPR_CH_BALANCING);
+            break;
+
         case EEPR_CH_HEADER:
             eepr_header = eepr_header_default;
             eepr_header.chksum = EEPR_CalcChecksum((uint8_t*)&eepr_header_default, sizeof(eepr_header_default)-4);
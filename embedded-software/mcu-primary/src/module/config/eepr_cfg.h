@@ -144,7 +144,8 @@ typedef enum {
 #define EEPR_CH_NVSOC             EEPR_CHANNEL_5
 #define EEPR_CH_CONTACTOR         EEPR_CHANNEL_6
 #define EEPR_CH_STATISTICS        EEPR_CHANNEL_7
-#define EEPR_CH_USER_DATA         EEPR_CHANNEL_8
+#define EEPR_CH_BALANCING         EEPR_CHANNEL_8
+#define EEPR_CH_USER_DATA         EEPR_CHANNEL_9
 
 
 /**
@@ -0,0 +1,216 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    isotp_cfg.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS_CONF
+ * @prefix  ISOTP
+ *
+ * @brief   Configuration of the services reachable over the ISO-TP transport
+ *
+ * The requests and responses follow the UDS format: the first byte of a request is the service ID,
+ * a positive response starts with the service ID + 0x40, a negative response is 0x7F, service ID,
+ * negative response code.
+ *
+ * ReadDataByIdentifier (0x22), request: 0x22, identifier (2 bytes, big endian)
+ *  - 0x0100 + n: RAM mirror of the EEPROM channel n of eepr_ch_cfg[]
+ *  - 0x0200: error memory of the diagnosis module (diag_memory[])
+ *
+ * ReadMemoryByAddress (0x23), request: 0x23, 0x24, address (4 bytes), size (2 bytes), big endian.
+ * Only the areas in isotp_memoryAreas[] can be read.
+ */
+
+/*================== Includes =============================================*/
+#include "isotp_cfg.h"
+
+#include "diag.h"
+#include "eepr_cfg.h"
+#include "os.h"
+#include <string.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * first data identifier of the EEPROM channels, identifier = ISOTP_DID_EEPROM_CHANNEL + channel
+ */
+#define ISOTP_DID_EEPROM_CHANNEL        0x0100
+
+/**
+ * data identifier of the error memory
+ */
+#define ISOTP_DID_ERROR_MEMORY          0x0200
+
+/**
+ * addressAndLengthFormatIdentifier of ReadMemoryByAddress: 2 bytes size, 4 bytes address
+ */
+#define ISOTP_ADDRESS_AND_LENGTH_FORMAT 0x24
+
+/**
+ * memory area that can be read with the service ReadMemoryByAddress
+ */
+typedef struct {
+    uint32_t start;     /*!< first address of the area */
+    uint32_t length;    /*!< length of the area in bytes */
+} ISOTP_MEMORY_AREA_s;
+
+/*================== Function Prototypes ==================================*/
+
+static uint8_t ISOTP_ReadDataByIdentifier(const uint8_t *request, uint16_t requestLength, uint8_t *response,
+        uint16_t *responseLength, uint16_t maxResponseLength);
+static uint8_t ISOTP_ReadMemoryByAddress(const uint8_t *request, uint16_t requestLength, uint8_t *response,
+        uint16_t *responseLength, uint16_t maxResponseLength);
+static uint8_t ISOTP_CopyData(const uint8_t *data, uint32_t length, uint8_t *response, uint16_t *responseLength,
+        uint16_t maxResponseLength);
+
+/*================== Constant and Variable Definitions ====================*/
+
+const ISOTP_SERVICE_s isotp_services[] = {
+        { 0x22, ISOTP_ReadDataByIdentifier },   /*!< EEPROM channels and error memory */
+        { 0x23, ISOTP_ReadMemoryByAddress },    /*!< memory dump */
+};
+
+const uint8_t isotp_nr_of_services = sizeof(isotp_services)/sizeof(isotp_services[0]);
+
+/**
+ * memory areas of the STM32F429 that can be read with ReadMemoryByAddress, no peripherals
+ */
+static const ISOTP_MEMORY_AREA_s isotp_memoryAreas[] = {
+        { 0x08000000, 0x200000 },   /*!< flash */
+        { 0x10000000, 0x10000 },    /*!< CCM RAM */
+        { 0x20000000, 0x30000 },    /*!< SRAM1 - SRAM3 */
+        { 0x40024000, 0x1000 },     /*!< backup SRAM */
+};
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   reads the RAM mirror of an EEPROM channel or the error memory
+ *
+ * See ISOTP_SERVICE_HANDLER_f for the parameters.
+ */
+static uint8_t ISOTP_ReadDataByIdentifier(const uint8_t *request, uint16_t requestLength, uint8_t *response,
+        uint16_t *responseLength, uint16_t maxResponseLength) {
+    uint8_t retVal = ISOTP_NRC_REQUEST_OUT_OF_RANGE;
+    uint16_t identifier = 0;
+
+    if ((requestLength != 2) || (maxResponseLength < 2)) {
+        retVal = ISOTP_NRC_INCORRECT_LENGTH;
+    } else {
+        identifier = (uint16_t)(((uint16_t)request[0] << 8) | request[1]);
+        /* the response repeats the identifier */
+        response[0] = request[0];
+        response[1] = request[1];
+
+        if ((identifier >= ISOTP_DID_EEPROM_CHANNEL) &&
+                (identifier < (ISOTP_DID_EEPROM_CHANNEL + eepr_nr_of_channels))) {
+            if (eepr_ch_cfg[identifier - ISOTP_DID_EEPROM_CHANNEL].bkpsramptr != NULL_PTR) {
+                retVal = ISOTP_CopyData(eepr_ch_cfg[identifier - ISOTP_DID_EEPROM_CHANNEL].bkpsramptr,
+                        eepr_ch_cfg[identifier - ISOTP_DID_EEPROM_CHANNEL].length,
+                        &response[2], responseLength, maxResponseLength - 2);
+            }
+        } else if (identifier == ISOTP_DID_ERROR_MEMORY) {
+            retVal = ISOTP_CopyData((const uint8_t *)&diag_memory[0], sizeof(diag_memory),
+                    &response[2], responseLength, maxResponseLength - 2);
+        }
+        *responseLength += 2;
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   reads a block of memory inside one of the areas of isotp_memoryAreas[]
+ *
+ * See ISOTP_SERVICE_HANDLER_f for the parameters.
+ */
+static uint8_t ISOTP_ReadMemoryByAddress(const uint8_t *request, uint16_t requestLength, uint8_t *response,
+        uint16_t *responseLength, uint16_t maxResponseLength) {
+    uint8_t retVal = ISOTP_NRC_REQUEST_OUT_OF_RANGE;
+    uint32_t address = 0;
+    uint32_t size = 0;
+
+    if ((requestLength != 7) || (request[0] != ISOTP_ADDRESS_AND_LENGTH_FORMAT)) {
+        retVal = ISOTP_NRC_INCORRECT_LENGTH;
+    } else {
+        address = ((uint32_t)request[1] << 24) | ((uint32_t)request[2] << 16) |
+                ((uint32_t)request[3] << 8) | (uint32_t)request[4];
+        size = ((uint32_t)request[5] << 8) | (uint32_t)request[6];
+
+        for (uint8_t i = 0; i < sizeof(isotp_memoryAreas)/sizeof(isotp_memoryAreas[0]); i++) {
+            /* written without overflow for blocks at the end of the address space */
+            if ((size > 0) && (address >= isotp_memoryAreas[i].start) && (size <= isotp_memoryAreas[i].length) &&
+                    ((address - isotp_memoryAreas[i].start) <= (isotp_memoryAreas[i].length - size))) {
+                retVal = ISOTP_CopyData((const uint8_t *)(uintptr_t)address, size, response, responseLength,
+                        maxResponseLength);
+            }
+        }
+    }
+    return retVal;
+}
+
+
+/**
+ * @brief   copies data into the response, consistent against changes by other tasks
+ *
+ * @param   data                data to copy
+ * @param   length              length of data in bytes
+ * @param   response            destination
+ * @param   responseLength      number of bytes copied
+ * @param   maxResponseLength   length of response in bytes
+ *
+ * @return  ISOTP_POSITIVE_RESPONSE, or ISOTP_NRC_RESPONSE_TOO_LONG
+ */
+static uint8_t ISOTP_CopyData(const uint8_t *data, uint32_t length, uint8_t *response, uint16_t *responseLength,
+        uint16_t maxResponseLength) {
+    uint8_t retVal = ISOTP_NRC_RESPONSE_TOO_LONG;
+
+    *responseLength = 0;
+    if (length <= maxResponseLength) {
+        OS_TaskEnter_Critical();
+        memcpy(response, data, length);
+        OS_TaskExit_Critical();
+        *responseLength = (uint16_t)length;
+        retVal = ISOTP_POSITIVE_RESPONSE;
+    }
+    return retVal;
+}
@@ -0,0 +1,204 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    isotp_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS_CONF
+ * @prefix  ISOTP
+ *
+ * @brief   Headers for the configuration of the ISO-TP transport and of its request/response services
+ *
+ */
+
+#ifndef ISOTP_CFG_H_
+#define ISOTP_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "can_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * block size sent to the tester in the flow control frames. The tester waits for the next flow
+ * control frame after this number of consecutive frames, 0 means no further flow control frame.
+ * Has to fit in the CAN0 receive buffer together with the other messages received in one CANS tick.
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 <= x <= 255
+ * \par Default:
+ * 8
+*/
+#define ISOTP_BLOCK_SIZE 8
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * minimum separation time sent to the tester in the flow control frames, i.e., the minimum time
+ * between two consecutive frames of a request
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Range:
+ * 0 <= x <= 127
+ * \par Default:
+ * 0
+*/
+#define ISOTP_STMIN_MS 0
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * time after which a segmented transfer is aborted if no flow control frame (N_Bs) or consecutive
+ * frame (N_Cr) is received, or if the frames cannot be sent (N_As, N_Cs)
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 1000
+*/
+#define ISOTP_TIMEOUT_MS 1000
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * maximum number of flow control frames with status wait accepted from the tester in a row
+ * \par Type:
+ * int
+ * \par Default:
+ * 10
+*/
+#define ISOTP_MAX_WAIT_FRAMES 10
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * maximum number of consecutive frames written to the CAN0 transmit buffer per call of
+ * ISOTP_MainFunction(), if the tester requests no separation time. Limits the response
+ * throughput together with the free space in the transmit buffer (CAN0_TRANSMIT_BUFFER_LENGTH).
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x
+ * \par Default:
+ * 16
+*/
+#define ISOTP_MAX_FRAMES_PER_CALL 16
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * maximum length of a request in bytes, longer requests are refused with a flow control overflow
+ * \par Type:
+ * int
+ * \par Range:
+ * 8 <= x <= 4095
+ * \par Default:
+ * 256
+*/
+#define ISOTP_RX_BUFFER_LENGTH 256
+
+/**
+ * @ingroup CONFIG_ISOTP
+ * maximum length of a response in bytes, including the response service ID
+ * \par Type:
+ * int
+ * \par Range:
+ * 8 <= x <= 4095
+ * \par Default:
+ * 4095
+*/
+#define ISOTP_TX_BUFFER_LENGTH 4095
+
+/**
+ * value of the unused bytes of single, consecutive and flow control frames
+ */
+#define ISOTP_PADDING_BYTE 0xCC
+
+/**
+ * negative response codes returned by the service handlers
+ */
+#define ISOTP_POSITIVE_RESPONSE                 0x00    /*!< request processed, positive response */
+#define ISOTP_NRC_SERVICE_NOT_SUPPORTED         0x11    /*!< no handler for the service ID */
+#define ISOTP_NRC_INCORRECT_LENGTH              0x13    /*!< length or format of the request is wrong */
+#define ISOTP_NRC_RESPONSE_TOO_LONG             0x14    /*!< response does not fit in ISOTP_TX_BUFFER_LENGTH */
+#define ISOTP_NRC_REQUEST_OUT_OF_RANGE          0x31    /*!< requested address, identifier or channel is not available */
+
+/**
+ * handler of a request/response service
+ *
+ * @param   request             request data following the service ID
+ * @param   requestLength       length of request in bytes
+ * @param   response            buffer for the response data following the response service ID
+ * @param   responseLength      length of the response data written in bytes
+ * @param   maxResponseLength   length of response in bytes
+ *
+ * @return  ISOTP_POSITIVE_RESPONSE, or the negative response code
+ */
+typedef uint8_t (*ISOTP_SERVICE_HANDLER_f)(const uint8_t *request, uint16_t requestLength, uint8_t *response,
+        uint16_t *responseLength, uint16_t maxResponseLength);
+
+/**
+ * entry of the service table
+ */
+typedef struct {
+    uint8_t serviceId;                  /*!< service ID, first byte of the request */
+    ISOTP_SERVICE_HANDLER_f handler;    /*!< function processing the request */
+} ISOTP_SERVICE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * table of the services processed by ISOTP_MainFunction()
+ */
+extern const ISOTP_SERVICE_s isotp_services[];
+
+/**
+ * number of entries in isotp_services[]
+ */
+extern const uint8_t isotp_nr_of_services;
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* ISOTP_CFG_H_ */
@@ -145,6 +145,25 @@
 #define LTC_OW_MEASUREMENT_MODE     LTC_ADCMODE_NORMAL_DCP0
 /* #define LTC_OW_MEASUREMENT_MODE     LTC_ADCMODE_FILTERED_DCP0 */
 
+/**
+ * If set to TRUE, the balancing is switched off for the duration of the cell
+ * voltage conversion and switched on again right after, so the balancing
+ * current does not distort the measured voltages. Only supported for up to 12
+ * cells per LTC, as only the configuration register group A is paused.
+ */
+#define LTC_PAUSE_BALANCING_DURING_MEASUREMENT     TRUE
+
+/**
+ * Time in ms between switching off the balancing and starting the cell voltage
+ * conversion, so the voltage at the input filter of the LTC can settle
+ */
+#define LTC_BALANCING_SETTLE_TIME_MS    2
+
+/**
+ * Balancing resistance in mOhm, used to account the charge discharged per cell
+ */
+#define LTC_BALANCING_RESISTANCE_MOHM   ((uint32_t)(BS_BALANCING_RESISTANCE_OHM * 1000.0))
+
 
 /**
  * Timeout added to the transmission time for interrupt-
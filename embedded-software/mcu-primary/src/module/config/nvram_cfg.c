@@ -76,6 +76,18 @@ const NVRAM_CH_OP_HOURS_s default_operating_hours = {
     .data = { 0, 0, 0, 0, 0, 0, 0 }
 };
 
+const NVRAM_CH_SOH_s default_soh = {
+    .data.capacity_mAh   = SOX_CELL_CAPACITY,
+    .data.variance       = SOX_SOH_INITIAL_VARIANCE,
+    .data.nr_of_updates  = 0
+};
+
+const NVRAM_CH_BALANCING_s default_balancing = {
+    .data.charge_As             = { 0 },
+    .data.energy_J              = { 0 },
+    .data.max_pcb_temperature   = { 0 }
+};
+
 /*================== Function Prototypes ==================================*/
 
 /*================== Function Implementations =============================*/
@@ -56,6 +56,7 @@
 /*================== Includes =============================================*/
 #include "general.h"
 #include "sox.h"
+#include "bal.h"
 #include "diag.h"
 
 /*================== Macros and Definitions ===============================*/
@@ -101,14 +102,38 @@ typedef struct {
     uint32_t checksum;
 } NVRAM_CH_OP_HOURS_s;
 
+/**
+ * learned state of health values, e.g., the estimated cell capacity
+ */
+typedef struct {
+    SOX_SOH_s data;
+    uint32_t previous_timestamp;
+    uint32_t timestamp;
+    uint32_t checksum;
+} NVRAM_CH_SOH_s;
+
+/**
+ * balancing charge, energy and temperature statistics
+ */
+typedef struct {
+    BAL_STATISTICS_s data;
+    uint32_t previous_timestamp;
+    uint32_t timestamp;
+    uint32_t checksum;
+} NVRAM_CH_BALANCING_s;
+
 /*================== Constant and Variable Definitions ====================*/
 extern NVRAM_CH_NVSOC_s MEM_BKP_SRAM bkpsram_nvsoc;
 extern NVRRAM_CH_CONT_COUNT_s MEM_BKP_SRAM bkpsram_contactors_count;
 extern NVRAM_CH_OP_HOURS_s MEM_BKP_SRAM bkpsram_operating_hours;
 extern NVRAM_OPERATING_HOURS_s MEM_BKP_SRAM bkpsram_op_hours;
+extern NVRAM_CH_SOH_s MEM_BKP_SRAM bkpsram_soh;
+extern NVRAM_CH_BALANCING_s MEM_BKP_SRAM bkpsram_balancing;
 extern const NVRAM_CH_NVSOC_s default_nvsoc;
 extern const NVRRAM_CH_CONT_COUNT_s default_contactors_count;
 extern const NVRAM_CH_OP_HOURS_s default_operating_hours;
+extern const NVRAM_CH_SOH_s default_soh;
+extern const NVRAM_CH_BALANCING_s default_balancing;
 
 
 /*================== Function Prototypes ==================================*/
@@ -0,0 +1,95 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    xcp_cfg.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS_CONF
+ * @prefix  XCP
+ *
+ * @brief   Configuration of the XCP slave: event channels and memory access
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "xcp_cfg.h"
+
+#include "contactor.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+const XCP_EVENT_CHANNEL_s xcp_eventChannels[XCP_EVENT_MAX] = {
+        { "APPL_1ms",   1 },
+        { "APPL_10ms",  10 },
+        { "APPL_100ms", 100 },
+};
+
+/**
+ * memory areas of the STM32F429, no peripherals
+ */
+const XCP_MEMORY_AREA_s xcp_readAreas[] = {
+        { 0x08000000, 0x200000 },   /*!< flash */
+        { 0x10000000, 0x10000 },    /*!< CCM RAM */
+        { 0x20000000, 0x30000 },    /*!< SRAM1 - SRAM3 */
+        { 0x40024000, 0x1000 },     /*!< backup SRAM */
+};
+
+const uint8_t xcp_nr_of_readAreas = sizeof(xcp_readAreas)/sizeof(xcp_readAreas[0]);
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+uint8_t XCP_IsCalibrationAllowed(void) {
+    uint8_t retVal = TRUE;
+
+    /* parameters used by the contactor and safety functions are only changed without current */
+    for (uint8_t i = 0; i < BS_NR_OF_CONTACTORS; i++) {
+        if ((CONT_GetContactorSetValue((CONT_NAMES_e)i) != CONT_SWITCH_OFF) ||
+                (CONT_GetContactorFeedback((CONT_NAMES_e)i) != CONT_SWITCH_OFF)) {
+            retVal = FALSE;
+        }
+    }
+    return retVal;
+}
@@ -0,0 +1,189 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    xcp_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS_CONF
+ * @prefix  XCP
+ *
+ * @brief   Headers for the configuration of the XCP slave: DAQ resources, event channels and memory access
+ *
+ */
+
+#ifndef XCP_CFG_H_
+#define XCP_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "can_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_XCP
+ * maximum number of DAQ lists the master can allocate
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x <= 255
+ * \par Default:
+ * 8
+*/
+#define XCP_MAX_DAQ_LISTS 8
+
+/**
+ * @ingroup CONFIG_XCP
+ * maximum number of ODTs of all DAQ lists. Every ODT is sent as one CAN frame per event.
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x <= 252
+ * \par Default:
+ * 32
+*/
+#define XCP_MAX_ODTS 32
+
+/**
+ * @ingroup CONFIG_XCP
+ * maximum number of ODT entries, i.e., sampled variables, of all ODTs
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x
+ * \par Default:
+ * 128
+*/
+#define XCP_MAX_ODT_ENTRIES 128
+
+/**
+ * @ingroup CONFIG_XCP
+ * maximum number of CAN frames sent per event, i.e., ODTs of the running DAQ lists of one event
+ * channel. The frames of the three event channels can be queued at the same time, at most a
+ * quarter of CAN0_TRANSMIT_BUFFER_LENGTH each leaves a quarter for the periodic messages and
+ * ISO-TP. START_STOP_DAQ_LIST and START_STOP_SYNCH reject DAQ lists that exceed it.
+ * \par Type:
+ * int
+ * \par Range:
+ * 0 < x <= CAN0_TRANSMIT_BUFFER_LENGTH / 4
+ * \par Default:
+ * 6
+*/
+#define XCP_MAX_FRAMES_PER_EVENT 6
+
+/**
+ * @ingroup CONFIG_XCP
+ * Enable/Disable switch for calibration with DOWNLOAD. The master can only write to variables
+ * defined with MEM_XCP_CAL and only while XCP_IsCalibrationAllowed() returns TRUE. If FALSE,
+ * DOWNLOAD is an unknown command and the master can only measure. The calibration parameters
+ * are the SOF configurations in sox_cfg.c and the balancing thresholds in bal_cfg.c.
+ * \par Type:
+ * toggle
+ * \par Default:
+ * FALSE
+*/
+#define XCP_CALIBRATION_ENABLE FALSE
+
+/**
+ * event channels of the DAQ lists, XCP_Event() is called at the end of the corresponding task
+ */
+typedef enum {
+    XCP_EVENT_1MS   = 0,    /*!< APPL_Cyclic_1ms() */
+    XCP_EVENT_10MS  = 1,    /*!< APPL_Cyclic_10ms() */
+    XCP_EVENT_100MS = 2,    /*!< APPL_Cyclic_100ms() */
+    XCP_EVENT_MAX   = 3,    /*!< number of event channels */
+} XCP_EVENT_CHANNEL_e;
+
+/**
+ * description of an event channel for the master
+ */
+typedef struct {
+    const char *name;       /*!< name of the event channel */
+    uint8_t cycleTime_ms;   /*!< cycle time of the task in ms */
+} XCP_EVENT_CHANNEL_s;
+
+/**
+ * memory area that can be accessed by the master
+ */
+typedef struct {
+    uint32_t start;     /*!< first address of the area */
+    uint32_t length;    /*!< length of the area in bytes */
+} XCP_MEMORY_AREA_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * event channels, in the order of XCP_EVENT_CHANNEL_e
+ */
+extern const XCP_EVENT_CHANNEL_s xcp_eventChannels[XCP_EVENT_MAX];
+
+/**
+ * memory areas that can be read with SHORT_UPLOAD, UPLOAD and sampled by DAQ lists
+ */
+extern const XCP_MEMORY_AREA_s xcp_readAreas[];
+
+/**
+ * number of entries in xcp_readAreas[]
+ */
+extern const uint8_t xcp_nr_of_readAreas;
+
+/**
+ * start and end of the variables defined with MEM_XCP_CAL, the only memory that can be written
+ * with DOWNLOAD (calibration)
+ */
+extern uint8_t _s_xcp_cal[];
+extern uint8_t _e_xcp_cal[];
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   checks if the master may write calibration parameters
+ *
+ * Called by DOWNLOAD in the task of CANS_MainFunction().
+ *
+ * @return  TRUE if all contactors are open, FALSE otherwise
+ */
+extern uint8_t XCP_IsCalibrationAllowed(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* XCP_CFG_H_ */
@@ -1260,6 +1260,18 @@ EEPR_ERRORTYPES_e EEPR_InitChannelData(void) {
             errtype = EEPR_NO_ERROR;
             EEPR_SetDefaultValue(EEPR_CH_OPERATING_HOURS);
         }
+        errtype |= EEPR_ReadChannelData(EEPR_CH_STATISTICS);
+        retval |= errtype;
+        if (errtype != EEPR_NO_ERROR) {
+            errtype = EEPR_NO_ERROR;
+            EEPR_SetDefaultValue(EEPR_CH_STATISTICS);
+        }
+        errtype |= EEPR_ReadChannelData(EEPR_CH_BALANCING);
+        retval |= errtype;
+        if (errtype != EEPR_NO_ERROR) {
+            errtype = EEPR_NO_ERROR;
+            EEPR_SetDefaultValue(EEPR_CH_BALANCING);
+        }
         RTC_NVMRAM_DATAVALID_VARIABLE = 1;      /* validate NVNRAM data */
     } else {
         /* @FIXME do set dirty flags for not double buffered channel (not in bkpsram) unless the ram is not cleared (warm reset) */
@@ -1289,6 +1301,24 @@ EEPR_ERRORTYPES_e EEPR_InitChannelData(void) {
             errtype = EEPR_NO_ERROR;
             EEPR_SetDefaultValue(EEPR_CH_OPERATING_HOURS);
         }
+
+        errtype |= EEPR_RefreshChannelData(EEPR_CH_STATISTICS);
+        retval |= errtype;
+        if (errtype == EEPR_ERR_RD || errtype == (EEPR_ERR_RD | EEPR_ERR_WR)) {
+            /* read error can only occur if checksum of bkpsram channel is corrupt -> set default values */
+            /* ignore possible write error because we definitely want to try writing to EEPROM */
+            errtype = EEPR_NO_ERROR;
+            EEPR_SetDefaultValue(EEPR_CH_STATISTICS);
+        }
+
+        errtype |= EEPR_RefreshChannelData(EEPR_CH_BALANCING);
+        retval |= errtype;
+        if (errtype == EEPR_ERR_RD || errtype == (EEPR_ERR_RD | EEPR_ERR_WR)) {
+            /* read error can only occur if checksum of bkpsram channel is corrupt -> set default values */
+            /* ignore possible write error because we definitely want to try writing to EEPROM */
+            errtype = EEPR_NO_ERROR;
+            EEPR_SetDefaultValue(EEPR_CH_BALANCING);
+        }
     }
     return retval;
 }
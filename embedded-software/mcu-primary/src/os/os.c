@@ -94,6 +94,18 @@ static StackType_t xTimerStack[configTIMER_TASK_STACK_DEPTH];
  */
 uint32_t os_schedulerstarttime;
 
+#if BUILD_MODULE_ENABLE_RUNTIMESTATS == 1
+/**
+ * frequency of the runtime counter TIM5
+ */
+static uint32_t os_runtimeCounterFrequency_Hz = 1;
+
+/**
+ * runtime counter at the switch in of the running task
+ */
+static volatile uint32_t os_taskSwitchedInTime = 0;
+#endif /* BUILD_MODULE_ENABLE_RUNTIMESTATS == 1 */
+
 /*================== Function Prototypes ==================================*/
 
 /*================== Function Implementations =============================*/
@@ -286,6 +298,7 @@ void OS_ConfigureTimerForRuntimeStats(void) {
 
     /* set prescaler */
     htim5.Init.Prescaler = prescaler;
+    os_runtimeCounterFrequency_Hz = timPeriphClock / ((uint32_t)prescaler + 1u);
 
     __TIM5_CLK_ENABLE();
 
@@ -300,4 +313,28 @@ void OS_ConfigureTimerForRuntimeStats(void) {
 uint32_t OS_GetRuntimeCounterValue(void) {
     return (uint32_t)(READ_REG(TIM5->CNT));
 }
+
+
+void OS_TaskSwitchedIn(void) {
+    os_taskSwitchedInTime = OS_GetRuntimeCounterValue();
+}
+
+
+uint32_t OS_GetTaskRunTime(void) {
+    TaskStatus_t taskStatus;
+    uint32_t runTime = 0;
+
+    /* the counter of the task is only updated when it is switched out, add the current time slice */
+    OS_TaskEnter_Critical();
+    vTaskGetInfo(NULL, &taskStatus, pdFALSE, eRunning);
+    runTime = taskStatus.ulRunTimeCounter + (OS_GetRuntimeCounterValue() - os_taskSwitchedInTime);
+    OS_TaskExit_Critical();
+
+    return runTime;
+}
+
+
+uint32_t OS_RunTimeToUs(uint32_t runTime) {
+    return (uint32_t)(((uint64_t)runTime * 1000000u) / os_runtimeCounterFrequency_Hz);
+}
 #endif
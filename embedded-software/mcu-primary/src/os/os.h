@@ -83,15 +83,16 @@
  */
 typedef enum  {
   OS_PRIORITY_IDLE           = 0,    /*!< priority: idle (lowest)       */
-  OS_PRIORITY_LOW            = 1,    /*!< priority: low                 */
-  OS_PRIORITY_BELOW_NORMAL   = 2,    /*!< priority: below normal        */
-  OS_PRIORITY_NORMAL         = 3,    /*!< priority: normal (default)    */
-  OS_PRIORITY_ABOVE_NORMAL   = 4,    /*!< priority: above normal        */
-  OS_PRIORITY_HIGH           = 5,    /*!< priority: high                */
-  OS_PRIORITY_ABOVE_HIGH     = 6,    /*!< priority: above high          */
-  OS_PRIORITY_VERY_HIGH      = 7,    /*!< priority: very high           */
-  OS_PRIORITY_BELOW_REALTIME = 8,    /*!< priority: below realtime      */
-  OS_PRIORITY_REALTIME       = 9,    /*!< priority: realtime (highest)  */
+  OS_PRIORITY_ABOVE_IDLE     = 1,    /*!< priority: above idle          */
+  OS_PRIORITY_LOW            = 2,    /*!< priority: low                 */
+  OS_PRIORITY_BELOW_NORMAL   = 3,    /*!< priority: below normal        */
+  OS_PRIORITY_NORMAL         = 4,    /*!< priority: normal (default)    */
+  OS_PRIORITY_ABOVE_NORMAL   = 5,    /*!< priority: above normal        */
+  OS_PRIORITY_HIGH           = 6,    /*!< priority: high                */
+  OS_PRIORITY_ABOVE_HIGH     = 7,    /*!< priority: above high          */
+  OS_PRIORITY_VERY_HIGH      = 8,    /*!< priority: very high           */
+  OS_PRIORITY_BELOW_REALTIME = 9,    /*!< priority: below realtime      */
+  OS_PRIORITY_REALTIME       = 10,   /*!< priority: realtime (highest)  */
 } OS_PRIORITY_e;
 
 /**
@@ -234,6 +235,35 @@ extern void OS_TimerTrigger(volatile OS_TIMER_s* timer);
  */
 extern uint32_t OS_getOSSysTick(void);
 
+#if BUILD_MODULE_ENABLE_RUNTIMESTATS == 1
+/**
+ * @brief   returns the time the calling task has been running, based on the
+ *          FreeRTOS runtime statistics
+ *
+ * Unlike the OS tick, the time during which the task was preempted by other
+ * tasks or interrupts is not included (interrupts only at the resolution of
+ * the context switches).
+ *
+ * @return  running time in counts of the runtime counter, wraps around
+ */
+extern uint32_t OS_GetTaskRunTime(void);
+
+/**
+ * @brief   converts a difference of OS_GetTaskRunTime() values to us
+ *
+ * @param   runTime     running time in counts of the runtime counter
+ *
+ * @return  running time in us
+ */
+extern uint32_t OS_RunTimeToUs(uint32_t runTime);
+
+/**
+ * @brief   keeps the runtime counter at the switch in of a task, called by
+ *          traceTASK_SWITCHED_IN()
+ */
+extern void OS_TaskSwitchedIn(void);
+#endif /* BUILD_MODULE_ENABLE_RUNTIMESTATS == 1 */
+
 /**
  * @brief   Delay in millisecond
  * @param   millisec      time delay value
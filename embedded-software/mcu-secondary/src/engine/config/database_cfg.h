@@ -270,6 +270,7 @@ typedef struct {
     uint32_t timestamp;                         /*!< timestamp of database entry                */
     uint32_t previous_timestamp;                /*!< timestamp of last database entry           */
     uint16_t value[BS_NR_OF_MODULES];    /*!< unit: mV (opto-coupler output)     */
+    uint32_t discharged_charge[BS_NR_OF_BAT_CELLS];  /*!< unit: mAs, charge discharged by the balancing resistor since startup, wraps around */
     uint8_t state;                      /*!< for future use                     */
 } DATA_BLOCK_BALANCING_FEEDBACK_s;
 
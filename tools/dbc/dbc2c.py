@@ -0,0 +1,411 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+#   angewandten Forschung e.V. All rights reserved.
+#
+# BSD 3-Clause License
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1.  Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+# 2.  Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+# 3.  Neither the name of the copyright holder nor the names of its
+#     contributors may be used to endorse or promote products derived from this
+#     software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# We kindly request you to use one or more of the following phrases to refer to
+# foxBMS in your hardware, software, documentation or advertising materials:
+#
+# &Prime;This product uses parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product includes parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product is derived from foxBMS&reg;&Prime;
+
+"""Generates C pack/unpack functions from a CAN data base (dbc)
+
+For every message of the dbc a struct with the raw signal values and a pair
+of pack/unpack functions is generated. The bit layout of the signals is
+resolved by the generator, so the generated functions only consist of byte
+accesses with constant shifts and masks. Additionally a table with the
+identifier, data length and cycle time of all messages is generated.
+"""
+import os
+import re
+import sys
+import argparse
+import logging
+import datetime
+
+import jinja2
+
+__version__ = 0.1
+__date__ = '2026-10-18'
+__updated__ = '2026-10-18'
+
+FILE_NAME = 'cansignal_dbc'
+PREFIX = 'CANS_DBC'
+
+RE_MESSAGE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+RE_SIGNAL = re.compile(
+    r'^\s*SG_\s+(\w+)\s*(M|m\d+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*'
+    r'\(([^,]+),([^)]+)\)\s*\[([^|]*)\|([^\]]*)\]\s*"([^"]*)"')
+RE_CYCLE_TIME = re.compile(r'^BA_\s+"GenMsgCycleTime"\s+BO_\s+(\d+)\s+(\d+)\s*;')
+
+
+class Signal(object):
+    """Signal of a CAN message as described in the dbc"""
+
+    def __init__(self, name, start, length, intel, signed, factor, offset, unit):
+        self.name = name
+        self.start = start
+        self.length = length
+        self.intel = intel
+        self.signed = signed
+        self.factor = factor
+        self.offset = offset
+        self.unit = unit
+
+    def segments(self, dlc):
+        """Splits the signal in the parts that are stored in one byte
+
+        Returns:
+            list of tuples (byte, lowest bit in byte, width, lowest value bit)
+        """
+        positions = []  # frame bit position of every value bit, LSB first
+        if self.intel:
+            positions = [self.start + i for i in range(self.length)]
+        else:
+            # start bit is the MSB, counted in the sawtooth numbering of the dbc
+            pos = self.start
+            for _ in range(self.length):
+                positions.insert(0, pos)
+                if pos % 8 == 0:
+                    pos += 15
+                else:
+                    pos -= 1
+        segments = []
+        for value_bit, pos in enumerate(positions):
+            byte, bit = divmod(pos, 8)
+            if byte >= dlc:
+                raise ValueError('signal {} exceeds the message length'.format(self.name))
+            last = segments[-1] if segments else None
+            if last and last[0] == byte and last[1] + last[2] == bit:
+                segments[-1] = (byte, last[1], last[2] + 1, last[3])
+            else:
+                segments.append((byte, bit, 1, value_bit))
+        return segments
+
+    def width(self):
+        """Returns the width of the smallest C integer type holding the signal"""
+        for width in (8, 16, 32, 64):
+            if self.length <= width:
+                return width
+        raise ValueError('signal {} is longer than 64 bit'.format(self.name))
+
+    def ctype(self):
+        """Returns the C type of the struct member"""
+        return '{}int{}_t'.format('' if self.signed else 'u', self.width())
+
+    def utype(self):
+        """Returns the unsigned C type used for the bit operations"""
+        return 'uint64_t' if self.length > 32 else 'uint32_t'
+
+
+class Message(object):
+    """CAN message as described in the dbc"""
+
+    def __init__(self, can_id, name, dlc):
+        self.can_id = can_id
+        self.name = name
+        self.dlc = dlc
+        self.cycle_time = 0
+        self.signals = []
+
+    def cname(self):
+        """Returns the message name without the CAN_ and CAN_MSG_ prefixes"""
+        return re.sub(r'^CAN_(MSG_)?', '', self.name)
+
+
+def signal_cname(name):
+    """Returns the signal name without the CAN_ and CAN_SIG_ prefixes
+
+    The prefix is kept if the name would start with a digit, e.g.
+    CAN_SIG_0_00_Cell_voltages_valid becomes SIG_0_00_Cell_voltages_valid.
+    """
+    short = re.sub(r'^CAN_(SIG_)?', '', name)
+    if short[:1].isdigit():
+        short = re.sub(r'^CAN_', '', name)
+    return short
+
+
+def parse_dbc(text):
+    """Parses messages, signals and cycle times of a dbc file"""
+    messages = []
+    by_id = {}
+    for line in text.splitlines():
+        match = RE_MESSAGE.match(line)
+        if match:
+            msg = Message(int(match.group(1)), match.group(2), int(match.group(3)))
+            messages.append(msg)
+            by_id[msg.can_id] = msg
+            continue
+        match = RE_SIGNAL.match(line)
+        if match:
+            if not messages:
+                raise ValueError('signal {} without message'.format(match.group(1)))
+            messages[-1].signals.append(Signal(
+                name=signal_cname(match.group(1)),
+                start=int(match.group(3)),
+                length=int(match.group(4)),
+                intel=match.group(5) == '1',
+                signed=match.group(6) == '-',
+                factor=match.group(7).strip(),
+                offset=match.group(8).strip(),
+                unit=match.group(11)))
+            continue
+        match = RE_CYCLE_TIME.match(line)
+        if match and int(match.group(1)) in by_id:
+            by_id[int(match.group(1))].cycle_time = int(match.group(2))
+    for msg in messages:
+        names = [sig.name for sig in msg.signals]
+        duplicates = set(x for x in names if names.count(x) > 1)
+        if duplicates:
+            raise ValueError('message {} has duplicate signals {}'.format(msg.name, ', '.join(sorted(duplicates))))
+    return messages
+
+
+def hexmask(width):
+    """Returns a C literal for a mask of width bits"""
+    return '0x{:X}u'.format((1 << width) - 1)
+
+
+def unpack_term(sig, segment):
+    """Returns the C expression for one byte of a signal read from data"""
+    byte, bit, width, value_bit = segment
+    term = '({})data[{}]'.format(sig.utype(), byte)
+    if bit > 0:
+        term = '({} >> {}u)'.format(term, bit)
+    if bit + width < 8:
+        term = '({} & {})'.format(term, hexmask(width))
+    if value_bit > 0:
+        term = '({} << {}u)'.format(term, value_bit)
+    return term
+
+
+def pack_term(sig, segment):
+    """Returns the C expression for the part of a signal written to one byte"""
+    byte, bit, width, value_bit = segment
+    term = '({})msg->{}'.format(sig.utype(), sig.name)
+    if value_bit > 0:
+        term = '({} >> {}u)'.format(term, value_bit)
+    if bit + width < 8:
+        # higher value bits would overwrite the neighbouring signals, all
+        # other bits are dropped by the conversion to uint8_t
+        term = '({} & {})'.format(term, hexmask(width))
+    if bit > 0:
+        term = '({} << {}u)'.format(term, bit)
+    return term
+
+
+def render_defs(messages):
+    """Returns the type definitions of the header"""
+    defs = []
+    enum = ['typedef enum {']
+    for i, msg in enumerate(messages):
+        enum.append('    {}_MSG_{} = {},  /*!< CAN ID 0x{:03X} */'.format(PREFIX, msg.cname(), i, msg.can_id))
+    enum.append('    {}_MSG_MAX,  /*!< number of messages */'.format(PREFIX))
+    enum.append('}} {}_messages_e;\n'.format(PREFIX))
+    defs.append('/**\n * symbolic names of the messages of the dbc\n */\n' + '\n'.join(enum))
+    defs.append('''\
+/**
+ * identifier, data length and cycle time of a message of the dbc
+ */
+typedef struct {{
+    uint32_t id;            /*!< CAN identifier */
+    uint8_t dlc;            /*!< data length in bytes */
+    uint16_t cycleTime_ms;  /*!< cycle time of the message in ms, 0 if not cyclic */
+}} {}_MESSAGE_s;
+'''.format(PREFIX))
+    for msg in messages:
+        if not msg.signals:
+            continue
+        lines = ['/**\n * raw signal values of message {} (CAN ID 0x{:03X})\n */'.format(msg.name, msg.can_id)]
+        lines.append('typedef struct {')
+        for sig in msg.signals:
+            scale = 'factor {}, offset {}'.format(sig.factor, sig.offset)
+            if sig.unit:
+                scale += ', unit {}'.format(sig.unit)
+            lines.append('    {} {};  /*!< {} bit, {} */'.format(sig.ctype(), sig.name, sig.length, scale))
+        lines.append('}} {}_{}_s;\n'.format(PREFIX, msg.cname()))
+        defs.append('\n'.join(lines))
+    return defs
+
+
+def render_prototypes(messages):
+    """Returns the prototypes of the pack/unpack functions"""
+    protos = []
+    for msg in messages:
+        if not msg.signals:
+            continue
+        protos.append('''\
+/**
+ * @brief   writes the signals of message {name} to the CAN data
+ *
+ * @param   msg     raw signal values
+ * @param   data    CAN data, {dlc} bytes are written
+ */
+extern void {prefix}_Pack_{cname}(const {prefix}_{cname}_s *msg, uint8_t data[]);
+
+/**
+ * @brief   reads the signals of message {name} from the CAN data
+ *
+ * @param   data    CAN data, {dlc} bytes are read
+ * @param   msg     raw signal values
+ */
+extern void {prefix}_Unpack_{cname}(const uint8_t data[], {prefix}_{cname}_s *msg);
+'''.format(name=msg.name, cname=msg.cname(), dlc=msg.dlc, prefix=PREFIX))
+    return protos
+
+
+def render_functions(messages):
+    """Returns the implementations of the pack/unpack functions"""
+    funs = []
+    for msg in messages:
+        if not msg.signals:
+            continue
+        by_byte = [[] for _ in range(msg.dlc)]
+        unpack = []
+        for sig in msg.signals:
+            segments = sig.segments(msg.dlc)
+            for segment in segments:
+                by_byte[segment[0]].append(pack_term(sig, segment))
+            expr = ' | '.join(unpack_term(sig, segment) for segment in segments)
+            if sig.signed and sig.length < sig.width():
+                sign = '0x{:X}u'.format(1 << (sig.length - 1))
+                expr = '(({}) ^ {}) - {}'.format(expr, sign, sign)
+            unpack.append('    msg->{} = ({})({});'.format(sig.name, sig.ctype(), expr))
+        pack = []
+        for byte, terms in enumerate(by_byte):
+            if terms:
+                pack.append('    data[{}] = (uint8_t)({});'.format(byte, ' | '.join(terms)))
+            else:
+                pack.append('    data[{}] = 0u;'.format(byte))
+        funs.append('void {prefix}_Pack_{cname}(const {prefix}_{cname}_s *msg, uint8_t data[]) {{\n{body}\n}}\n'.format(
+            prefix=PREFIX, cname=msg.cname(), body='\n'.join(pack)))
+        funs.append('void {prefix}_Unpack_{cname}(const uint8_t data[], {prefix}_{cname}_s *msg) {{\n{body}\n}}\n'.format(
+            prefix=PREFIX, cname=msg.cname(), body='\n'.join(unpack)))
+    return funs
+
+
+def render_table(messages):
+    """Returns the definition of the message table"""
+    lines = ['const {}_MESSAGE_s cans_dbc_messages[{}_MSG_MAX] = {{'.format(PREFIX, PREFIX)]
+    for msg in messages:
+        lines.append('    {{ 0x{:03X}u, {}u, {}u }},  /* {} */'.format(msg.can_id, msg.dlc, msg.cycle_time, msg.name))
+    lines.append('};\n')
+    return '\n'.join(lines)
+
+
+def generate(dbc_file, c_file, h_file, template_dir):
+    """Generates the C source and header from the dbc"""
+    with open(dbc_file, 'r', encoding='utf-8', errors='replace') as f:
+        messages = parse_dbc(f.read())
+    env = jinja2.Environment(loader=jinja2.FileSystemLoader(searchpath=template_dir),
+                             keep_trailing_newline=True)
+    _date = datetime.datetime.today().strftime('%d.%m.%Y')
+    brief = 'Pack/unpack functions of the CAN messages, generated from {}'.format(os.path.basename(dbc_file))
+    txt_h = env.get_template('template.h.jinja2').render(
+        filename=FILE_NAME,
+        add_author_info='(autogenerated)',
+        filecreation=_date,
+        ingroup='DRIVERS',
+        prefix=PREFIX,
+        brief=brief,
+        details='',
+        includes=['general.h'],
+        macros=[],
+        defs=render_defs(messages),
+        externvars=['/**\n * identifier, data length and cycle time of all messages\n */',
+                    'extern const {}_MESSAGE_s cans_dbc_messages[{}_MSG_MAX];\n'.format(PREFIX, PREFIX)],
+        externfunsproto=render_prototypes(messages))
+    txt_c = env.get_template('template.c.jinja2').render(
+        filename=FILE_NAME,
+        add_author_info='(autogenerated)',
+        inc_files=[],
+        filecreation=_date,
+        ingroup='DRIVERS',
+        prefix=PREFIX,
+        brief=brief,
+        details='',
+        macros=[],
+        defs=[],
+        staticvars=[],
+        externvars=[render_table(messages)],
+        staticfunsproto=[],
+        staticfunsimpl=[],
+        externfunsimpl=render_functions(messages))
+    with open(h_file, 'w') as f:
+        f.write(txt_h)
+    with open(c_file, 'w') as f:
+        f.write(txt_c)
+    logging.info('generated {} and {} from {} messages'.format(c_file, h_file, len(messages)))
+
+
+def main():
+    """Parses the command line and generates the files"""
+    program_name = os.path.basename(sys.argv[0])
+    program_version_message = '{} {}'.format(__version__, __updated__)
+    parser = argparse.ArgumentParser(
+        prog=program_name,
+        description='Generates C pack/unpack functions from a CAN data base (dbc)')
+    parser.add_argument('dbc', help='dbc file')
+    parser.add_argument('c_file', help='generated C source file')
+    parser.add_argument('h_file', help='generated C header file')
+    parser.add_argument(
+        '-t',
+        '--templates',
+        default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'styleguide', 'file-templates'),
+        help='directory of the C file templates')
+    parser.add_argument(
+        '-v',
+        '--verbosity',
+        dest='verbosity',
+        action='count',
+        default=0,
+        help='set verbosity level')
+    parser.add_argument(
+        '-V',
+        '--version',
+        action='version',
+        version=program_version_message)
+
+    args = parser.parse_args()
+
+    if args.verbosity == 1:
+        logging.basicConfig(level=logging.INFO)
+    elif args.verbosity > 1:
+        logging.basicConfig(level=logging.DEBUG)
+    else:
+        logging.basicConfig(level=logging.ERROR)
+
+    generate(args.dbc, args.c_file, args.h_file, args.templates)
+
+
+if __name__ == '__main__':
+    main()
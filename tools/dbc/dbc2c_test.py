@@ -0,0 +1,335 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+#   angewandten Forschung e.V. All rights reserved.
+#
+# BSD 3-Clause License
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1.  Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+# 2.  Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+# 3.  Neither the name of the copyright holder nor the names of its
+#     contributors may be used to endorse or promote products derived from this
+#     software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# We kindly request you to use one or more of the following phrases to refer to
+# foxBMS in your hardware, software, documentation or advertising materials:
+#
+# &Prime;This product uses parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product includes parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product is derived from foxBMS&reg;&Prime;
+
+"""Round-trip test of the C code generated by dbc2c.py
+
+The pack/unpack functions are generated from the dbc and from a small dbc
+with edge cases (Intel and Motorola signals crossing bytes, signed signals,
+a 64 bit signal). For every message random raw values, including the
+minimum and maximum of every signal, are packed by the generated code and
+compared against the frame computed by an independent reference in this
+script. The expected frame is then unpacked again, once as it is and once
+with all bits outside of the signals set, and the values are compared
+against the input. Both byte orders must be covered, otherwise the test
+fails.
+"""
+import os
+import sys
+import random
+import shutil
+import argparse
+import logging
+import tempfile
+import subprocess
+
+import dbc2c
+
+__version__ = 0.1
+__date__ = '2026-10-18'
+__updated__ = '2026-10-18'
+
+EDGE_CASE_DBC = '''\
+BO_ 1 EDGE_Intel: 8 Vector__XXX
+ SG_ EDGE_SIG_i_bit : 0|1@1+ (1,0) [0|1] "" Vector__XXX
+ SG_ EDGE_SIG_i_cross : 5|12@1+ (1,0) [0|4095] "" Vector__XXX
+ SG_ EDGE_SIG_i_signed : 17|15@1- (1,0) [-16384|16383] "" Vector__XXX
+ SG_ EDGE_SIG_i_long : 32|32@1+ (1,0) [0|4294967295] "" Vector__XXX
+
+BO_ 2 EDGE_Motorola: 8 Vector__XXX
+ SG_ EDGE_SIG_m_bit : 7|1@0+ (1,0) [0|1] "" Vector__XXX
+ SG_ EDGE_SIG_m_cross : 2|12@0+ (1,0) [0|4095] "" Vector__XXX
+ SG_ EDGE_SIG_m_signed : 22|15@0- (1,0) [-16384|16383] "" Vector__XXX
+ SG_ EDGE_SIG_m_long : 39|32@0+ (1,0) [0|4294967295] "" Vector__XXX
+
+BO_ 3 EDGE_Mixed: 7 Vector__XXX
+ SG_ EDGE_SIG_x_intel : 0|20@1- (1,0) [0|0] "" Vector__XXX
+ SG_ EDGE_SIG_x_motorola : 28|20@0- (1,0) [0|0] "" Vector__XXX
+ SG_ EDGE_SIG_x_tail : 48|4@1+ (1,0) [0|15] "" Vector__XXX
+
+BO_ 4 EDGE_Full: 8 Vector__XXX
+ SG_ EDGE_SIG_f_intel : 0|64@1- (1,0) [0|0] "" Vector__XXX
+
+BO_ 5 EDGE_FullMotorola: 8 Vector__XXX
+ SG_ EDGE_SIG_f_motorola : 7|64@0+ (1,0) [0|0] "" Vector__XXX
+'''
+
+HOST_GENERAL_H = '''\
+/* minimal general.h for the host build of the generated code */
+#include <stdint.h>
+'''
+
+
+def reference_bits(sig, dlc):
+    """Returns the frame bit positions (byte * 8 + bit) of a signal, LSB first
+
+    Intel signals are placed in the frame read as little endian integer,
+    Motorola signals in the frame read as big endian integer. This is
+    independent from the sawtooth walk in dbc2c.Signal.segments().
+    """
+    if sig.intel:
+        return [sig.start + i for i in range(sig.length)]
+    # position of the MSB counted from the MSB of byte 0
+    msb = (sig.start // 8) * 8 + (7 - sig.start % 8)
+    bits = []
+    for i in range(sig.length):
+        be_pos = msb + sig.length - 1 - i
+        bits.append((be_pos // 8) * 8 + (7 - be_pos % 8))
+    if any(pos >= dlc * 8 for pos in bits):
+        raise ValueError('signal {} exceeds the message length'.format(sig.name))
+    return bits
+
+
+def reference_pack(msg, values):
+    """Returns the frame of a message as list of bytes"""
+    frame = [0] * msg.dlc
+    for sig in msg.signals:
+        raw = values[sig.name] & ((1 << sig.length) - 1)
+        for value_bit, pos in enumerate(reference_bits(sig, msg.dlc)):
+            if (raw >> value_bit) & 1:
+                frame[pos // 8] |= 1 << (pos % 8)
+    return frame
+
+
+def used_mask(msg):
+    """Returns the bits of each byte that belong to a signal"""
+    mask = [0] * msg.dlc
+    for sig in msg.signals:
+        for pos in reference_bits(sig, msg.dlc):
+            mask[pos // 8] |= 1 << (pos % 8)
+    return mask
+
+
+def value_range(sig):
+    """Returns the smallest and largest raw value of a signal"""
+    if sig.signed:
+        return -(1 << (sig.length - 1)), (1 << (sig.length - 1)) - 1
+    return 0, (1 << sig.length) - 1
+
+
+def random_vectors(msg, count, rng):
+    """Returns count dicts of raw values, the first two are minimum and maximum"""
+    vectors = [{sig.name: value_range(sig)[0] for sig in msg.signals},
+               {sig.name: value_range(sig)[1] for sig in msg.signals}]
+    while len(vectors) < count:
+        vectors.append({sig.name: rng.randint(*value_range(sig)) for sig in msg.signals})
+    return vectors
+
+
+def c_value(sig, value):
+    """Returns a C literal of a raw value in the type of the struct member"""
+    if sig.signed and value < 0:
+        return '({})(-{}ll - 1)'.format(sig.ctype(), -value - 1)
+    return '({})0x{:X}ull'.format(sig.ctype(), value)
+
+
+def c_bytes(frame):
+    """Returns a C initializer of a frame"""
+    return '{' + ', '.join('0x{:02X}u'.format(b) for b in frame) + '}'
+
+
+def render_test(messages, count, rng):
+    """Returns the C source of the test program"""
+    lines = ['#include <stdio.h>',
+             '#include <string.h>',
+             '#include "cansignal_dbc.h"',
+             '',
+             'static unsigned int failures = 0u;',
+             '',
+             'static void check_frame(const char *msg, int vector, const uint8_t *data, const uint8_t *expected, int dlc) {',
+             '    if (memcmp(data, expected, dlc) != 0) {',
+             '        int i;',
+             '        failures++;',
+             '        printf("FAIL pack %s vector %d:", msg, vector);',
+             '        for (i = 0; i < dlc; i++) {',
+             '            printf(" %02X/%02X", data[i], expected[i]);',
+             '        }',
+             '        printf(" (packed/expected)\\n");',
+             '    }',
+             '}',
+             '',
+             'static void check_value(const char *msg, const char *sig, int vector, int noise, int equal) {',
+             '    if (!equal) {',
+             '        failures++;',
+             '        printf("FAIL unpack %s.%s vector %d%s\\n", msg, sig, vector, noise ? " with set unused bits" : "");',
+             '    }',
+             '}',
+             '']
+    main = ['int main(void) {']
+    for msg in messages:
+        if not msg.signals:
+            continue
+        cname = msg.cname()
+        stype = '{}_{}_s'.format(dbc2c.PREFIX, cname)
+        mask = used_mask(msg)
+        fn = 'test_{}'.format(cname)
+        lines.append('static void {}(void) {{'.format(fn))
+        lines.append('    {} in;'.format(stype))
+        lines.append('    {} out;'.format(stype))
+        lines.append('    uint8_t data[{}];'.format(msg.dlc))
+        for i, values in enumerate(random_vectors(msg, count, rng)):
+            frame = reference_pack(msg, values)
+            noisy = [b | (~m & 0xFF) for b, m in zip(frame, mask)]
+            lines.append('    {')
+            lines.append('        static const uint8_t expected[{}] = {};'.format(msg.dlc, c_bytes(frame)))
+            lines.append('        static const uint8_t noisy[{}] = {};'.format(msg.dlc, c_bytes(noisy)))
+            lines.append('        memset(&in, 0, sizeof(in));')
+            for sig in msg.signals:
+                lines.append('        in.{} = {};'.format(sig.name, c_value(sig, values[sig.name])))
+            lines.append('        memset(data, 0xA5, sizeof(data));')
+            lines.append('        {}_Pack_{}(&in, data);'.format(dbc2c.PREFIX, cname))
+            lines.append('        check_frame("{}", {}, data, expected, {});'.format(cname, i, msg.dlc))
+            for noise, source in ((0, 'expected'), (1, 'noisy')):
+                lines.append('        memset(&out, 0x5A, sizeof(out));')
+                lines.append('        {}_Unpack_{}({}, &out);'.format(dbc2c.PREFIX, cname, source))
+                for sig in msg.signals:
+                    lines.append('        check_value("{0}", "{1}", {2}, {3}, out.{1} == in.{1});'.format(
+                        cname, sig.name, i, noise))
+            lines.append('    }')
+        lines.append('}')
+        lines.append('')
+        main.append('    {}();'.format(fn))
+    main.append('    printf("%u failures\\n", failures);')
+    main.append('    return (failures == 0u) ? 0 : 1;')
+    main.append('}')
+    return '\n'.join(lines + main) + '\n'
+
+
+def run_dbc(name, dbc_file, work_dir, args, rng):
+    """Generates, builds and runs the test for one dbc
+
+    Returns:
+        tuple (passed, number of Intel signals, number of Motorola signals)
+    """
+    out_dir = os.path.join(work_dir, name)
+    os.makedirs(out_dir)
+    c_file = os.path.join(out_dir, 'cansignal_dbc.c')
+    h_file = os.path.join(out_dir, 'cansignal_dbc.h')
+    dbc2c.generate(dbc_file, c_file, h_file, args.templates)
+    with open(dbc_file, 'r', encoding='utf-8', errors='replace') as f:
+        messages = dbc2c.parse_dbc(f.read())
+    with open(os.path.join(out_dir, 'general.h'), 'w') as f:
+        f.write(HOST_GENERAL_H)
+    test_file = os.path.join(out_dir, 'test.c')
+    with open(test_file, 'w') as f:
+        f.write(render_test(messages, args.vectors, rng))
+    binary = os.path.join(out_dir, 'test')
+    cmd = [args.cc, '-std=c99', '-O1', '-Wall', '-Werror', '-I', out_dir, '-o', binary, test_file, c_file]
+    logging.debug(' '.join(cmd))
+    subprocess.check_call(cmd)
+    result = subprocess.run([binary], stdout=subprocess.PIPE, universal_newlines=True)
+    sys.stdout.write(result.stdout)
+    signals = [sig for msg in messages for sig in msg.signals]
+    intel = len([sig for sig in signals if sig.intel])
+    print('{}: {} messages, {} Intel and {} Motorola signals, {} vectors per message: {}'.format(
+        name, len(messages), intel, len(signals) - intel, args.vectors,
+        'PASS' if result.returncode == 0 else 'FAIL'))
+    return result.returncode == 0, intel, len(signals) - intel
+
+
+def main():
+    """Parses the command line and runs the test"""
+    program_name = os.path.basename(sys.argv[0])
+    program_version_message = '{} {}'.format(__version__, __updated__)
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(
+        prog=program_name,
+        description='Round-trip test of the C code generated by dbc2c.py')
+    parser.add_argument(
+        'dbc',
+        nargs='?',
+        default=os.path.join(here, 'foxbms.dbc'),
+        help='dbc file (default: foxbms.dbc)')
+    parser.add_argument(
+        '-t',
+        '--templates',
+        default=os.path.join(here, '..', 'styleguide', 'file-templates'),
+        help='directory of the C file templates')
+    parser.add_argument('--cc', default='cc', help='host C compiler')
+    parser.add_argument('-n', '--vectors', type=int, default=20, help='test vectors per message')
+    parser.add_argument('-s', '--seed', type=int, default=1, help='seed of the random values')
+    parser.add_argument('-k', '--keep', action='store_true', help='keep the generated files')
+    parser.add_argument(
+        '-v',
+        '--verbosity',
+        dest='verbosity',
+        action='count',
+        default=0,
+        help='set verbosity level')
+    parser.add_argument(
+        '-V',
+        '--version',
+        action='version',
+        version=program_version_message)
+
+    args = parser.parse_args()
+
+    if args.verbosity == 1:
+        logging.basicConfig(level=logging.INFO)
+    elif args.verbosity > 1:
+        logging.basicConfig(level=logging.DEBUG)
+    else:
+        logging.basicConfig(level=logging.ERROR)
+
+    rng = random.Random(args.seed)
+    work_dir = tempfile.mkdtemp(prefix='dbc2c_test_')
+    try:
+        edge_dbc = os.path.join(work_dir, 'edge_cases.dbc')
+        with open(edge_dbc, 'w') as f:
+            f.write(EDGE_CASE_DBC)
+        passed = True
+        intel = 0
+        motorola = 0
+        for name, dbc_file in (('edge_cases', edge_dbc), (os.path.basename(args.dbc), args.dbc)):
+            ok, n_intel, n_motorola = run_dbc(name, dbc_file, work_dir, args, rng)
+            passed = passed and ok
+            intel += n_intel
+            motorola += n_motorola
+        if intel == 0 or motorola == 0:
+            print('FAIL: both byte orders have to be covered')
+            passed = False
+    finally:
+        if args.keep:
+            print('generated files in {}'.format(work_dir))
+        else:
+            shutil.rmtree(work_dir)
+    sys.exit(0 if passed else 1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,312 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+#   angewandten Forschung e.V. All rights reserved.
+#
+# BSD 3-Clause License
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1.  Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+# 2.  Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+# 3.  Neither the name of the copyright holder nor the names of its
+#     contributors may be used to endorse or promote products derived from this
+#     software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# We kindly request you to use one or more of the following phrases to refer to
+# foxBMS in your hardware, software, documentation or advertising materials:
+#
+# &Prime;This product uses parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product includes parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product is derived from foxBMS&reg;&Prime;
+
+"""Checks the CAN configuration of the firmware against the dbc
+
+The TX and RX message tables (can_cfg.c) and the signal tables
+(cansignal_cfg.c) are written by hand. This script reads them and reports
+every difference to the dbc:
+
+- every message of the tables and every CAN_ID_ macro of can_cfg.h must be
+  in the dbc,
+- TX messages must have the data length of the dbc and, if the dbc defines
+  GenMsgCycleTime, the same period,
+- RX messages must not be longer in the dbc than in the table, RX signals
+  are only checked within the data length of the dbc,
+- every signal must have a signal in the dbc with the same start bit, length
+  and byte order, or its bits must hold only complete signals of the dbc
+  with the same byte order (e.g. a 3 bit error field with the MSL, RSL and
+  MOL flags).
+
+Preprocessor conditions are resolved with the macros defined without value
+in the given configuration headers (e.g. the current sensor mode in
+batterysystem_cfg.h). On success the stamp file is written, otherwise the
+differences are printed and the script fails.
+"""
+import os
+import re
+import sys
+import argparse
+import logging
+
+import dbc2c
+
+__version__ = 0.1
+__date__ = '2026-10-18'
+__updated__ = '2026-10-18'
+
+RE_FLAG_DEFINE = re.compile(r'^\s*#define\s+(\w+)\s*$')
+RE_ID_DEFINE = re.compile(r'^\s*#define\s+(CAN_ID_\w+)\s+\(?(0x[0-9A-Fa-f]+|\d+)[uU]?\)?')
+RE_TX_MSG = re.compile(
+    r'\{\s*(\w+)\s*,\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*,\s*\w+\s*,\s*(\w+)\s*,\s*(\d+)\s*\}')
+RE_RX_MSG = re.compile(r'\{\s*(\w+)\s*,\s*(\w+)\s*,\s*(\d+)\s*,\s*\d+\s*,\s*\w+\s*,\s*\w+\s*\}')
+RE_SIGNAL = re.compile(r'\{\s*\{\s*(\w+)\s*\}\s*,\s*(\d+)\s*,\s*(\d+)\s*,[^}]*?\b(littleEndian|bigEndian)\b')
+RE_ENUM_NAME = re.compile(r'^\s*(\w+)\s*(=\s*[^,]+)?,')
+
+
+def strip_comments(text):
+    """Removes C comments, line breaks of block comments are kept"""
+    text = re.sub(r'/\*.*?\*/', lambda m: '\n' * m.group(0).count('\n'), text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def preprocess(text, defines):
+    """Drops the lines of inactive #ifdef/#ifndef branches
+
+    Only #ifdef, #ifndef, #else and #endif are resolved, the tables do not
+    use other conditions.
+    """
+    lines = []
+    stack = []
+    for line in strip_comments(text).splitlines():
+        directive = line.strip()
+        if directive.startswith('#ifdef') or directive.startswith('#ifndef'):
+            name = directive.split()[1]
+            active = (name in defines) == directive.startswith('#ifdef')
+            stack.append(active and all(stack))
+        elif directive.startswith('#if'):
+            # conditions outside of the tables are evaluated as active
+            stack.append(all(stack))
+        elif directive.startswith('#else'):
+            enclosing = all(stack[:-1])
+            stack[-1] = enclosing and not stack[-1]
+        elif directive.startswith('#endif'):
+            stack.pop()
+        elif all(stack):
+            lines.append(line)
+    return '\n'.join(lines)
+
+
+def block(text, start):
+    """Returns the text between the braces following start"""
+    pos = text.find(start)
+    if pos < 0:
+        raise ValueError('{} not found'.format(start))
+    begin = text.index('{', pos + len(start))
+    depth = 0
+    for i in range(begin, len(text)):
+        if text[i] == '{':
+            depth += 1
+        elif text[i] == '}':
+            depth -= 1
+            if depth == 0:
+                return text[begin + 1:i]
+    raise ValueError('{} is not terminated'.format(start))
+
+
+def enum_names(text, name):
+    """Returns the names of a typedef enum in order of their value"""
+    body = text[:text.index('}} {};'.format(name))]
+    body = body[body.rindex('typedef enum {') + len('typedef enum {'):]
+    names = []
+    for line in body.splitlines():
+        match = RE_ENUM_NAME.match(line)
+        if match:
+            names.append(match.group(1))
+    return names
+
+
+def read(path, defines):
+    """Reads and preprocesses a C file"""
+    with open(path, 'r', encoding='utf-8', errors='replace') as f:
+        return preprocess(f.read(), defines)
+
+
+def flag_defines(paths):
+    """Returns the macros defined without value in the given headers"""
+    defines = set()
+    for path in paths:
+        with open(path, 'r', encoding='utf-8', errors='replace') as f:
+            for line in strip_comments(f.read()).splitlines():
+                match = RE_FLAG_DEFINE.match(line)
+                if match:
+                    defines.add(match.group(1))
+    return defines
+
+
+def bit_positions(start, length, intel):
+    """Returns the frame bit positions (byte * 8 + bit) of a signal"""
+    if intel:
+        return [start + i for i in range(length)]
+    # Motorola: start is the MSB, the following bits are walked in the
+    # sawtooth numbering of the dbc
+    positions = []
+    pos = start
+    for _ in range(length):
+        positions.append(pos)
+        pos = pos + 15 if pos % 8 == 0 else pos - 1
+    return positions
+
+
+def resolve_id(value, ids):
+    """Returns the CAN identifier of a literal or a CAN_ID_ macro"""
+    if value in ids:
+        return ids[value]
+    return int(value, 0)
+
+
+def check(dbc_file, can_cfg_c, can_cfg_h, cansignal_cfg_c, cansignal_cfg_h, config_headers):
+    """Returns the list of differences between the configuration and the dbc"""
+    with open(dbc_file, 'r', encoding='utf-8', errors='replace') as f:
+        messages = {msg.can_id: msg for msg in dbc2c.parse_dbc(f.read())}
+    defines = flag_defines(config_headers)
+    ids = {}
+    for line in read(can_cfg_h, defines).splitlines():
+        match = RE_ID_DEFINE.match(line)
+        if match:
+            ids[match.group(1)] = int(match.group(2), 0)
+    errors = []
+
+    for name, can_id in sorted(ids.items()):
+        if can_id not in messages:
+            errors.append('{} (0x{:03X}) is not in the dbc'.format(name, can_id))
+
+    cfg = read(can_cfg_c, defines)
+    tx = []
+    for match in RE_TX_MSG.finditer(block(cfg, 'can_CAN0_messages_tx[] =')):
+        can_id = resolve_id(match.group(1), ids)
+        dlc, period = int(match.group(2)), int(match.group(3))
+        tx.append(can_id)
+        msg = messages.get(can_id)
+        if msg is None:
+            errors.append('TX message 0x{:03X} is not in the dbc'.format(can_id))
+            continue
+        if msg.dlc != dlc:
+            errors.append('TX message 0x{:03X} has {} bytes, {} in the dbc'.format(can_id, dlc, msg.dlc))
+        if msg.cycle_time and msg.cycle_time != period:
+            errors.append('TX message 0x{:03X} has period {} ms, GenMsgCycleTime {} ms in the dbc'.format(
+                can_id, period, msg.cycle_time))
+    rx = []
+    for match in RE_RX_MSG.finditer(block(cfg, 'can0_RxMsgs[] =')):
+        can_id = resolve_id(match.group(1), ids)
+        dlc = int(match.group(3))
+        rx.append(can_id)
+        msg = messages.get(can_id)
+        if msg is None:
+            errors.append('RX message 0x{:03X} is not in the dbc'.format(can_id))
+        elif msg.dlc > dlc:
+            errors.append('RX message 0x{:03X} has {} bytes, {} in the dbc'.format(can_id, dlc, msg.dlc))
+
+    sig_h = read(cansignal_cfg_h, defines)
+    sig_c = read(cansignal_cfg_c, defines)
+    for direction, table, enum, frames in (('TX', 'cans_CAN0_signals_tx[] =', 'CANS_messagesTx_e', tx),
+                                           ('RX', 'cans_CAN0_signals_rx[] =', 'CANS_messagesRx_e', rx)):
+        names = enum_names(sig_h, enum)
+        for match in RE_SIGNAL.finditer(block(sig_c, table)):
+            msg_name, start, length = match.group(1), int(match.group(2)), int(match.group(3))
+            intel = match.group(4) == 'littleEndian'
+            if msg_name not in names or names.index(msg_name) >= len(frames):
+                errors.append('{} signal of {} has no message in can_cfg.c'.format(direction, msg_name))
+                continue
+            msg = messages.get(frames[names.index(msg_name)])
+            if msg is None:
+                continue
+            if any((sig.start, sig.length, sig.intel) == (start, length, intel) for sig in msg.signals):
+                continue
+            # a field of the firmware may hold several signals of the dbc,
+            # e.g. the MSL, RSL and MOL flags of one error
+            field = set(bit_positions(start, length, intel))
+            if direction == 'RX':
+                # bytes behind the data length of the dbc are not received
+                field = set(pos for pos in field if pos < 8 * msg.dlc)
+                if not field:
+                    continue
+            overlapping = [sig for sig in msg.signals
+                           if field & set(bit_positions(sig.start, sig.length, sig.intel))]
+            if not overlapping or any(sig.intel != intel or not set(bit_positions(
+                    sig.start, sig.length, sig.intel)) <= field for sig in overlapping):
+                errors.append('{} signal {}|{}@{} of {} (0x{:03X}) is not in the dbc'.format(
+                    direction, start, length, 1 if intel else 0, msg_name, msg.can_id))
+    return errors
+
+
+def main():
+    """Parses the command line and runs the check"""
+    program_name = os.path.basename(sys.argv[0])
+    program_version_message = '{} {}'.format(__version__, __updated__)
+    parser = argparse.ArgumentParser(
+        prog=program_name,
+        description='Checks the CAN configuration of the firmware against the dbc')
+    parser.add_argument('dbc', help='dbc file')
+    parser.add_argument('can_cfg_c', help='can_cfg.c with the message tables')
+    parser.add_argument('can_cfg_h', help='can_cfg.h with the CAN_ID_ macros')
+    parser.add_argument('cansignal_cfg_c', help='cansignal_cfg.c with the signal tables')
+    parser.add_argument('cansignal_cfg_h', help='cansignal_cfg.h with the message enums')
+    parser.add_argument('stamp', help='file written if the check passes')
+    parser.add_argument(
+        '-c',
+        '--config',
+        action='append',
+        default=[],
+        help='header with the macros used in the preprocessor conditions')
+    parser.add_argument(
+        '-v',
+        '--verbosity',
+        dest='verbosity',
+        action='count',
+        default=0,
+        help='set verbosity level')
+    parser.add_argument(
+        '-V',
+        '--version',
+        action='version',
+        version=program_version_message)
+
+    args = parser.parse_args()
+
+    if args.verbosity == 1:
+        logging.basicConfig(level=logging.INFO)
+    elif args.verbosity > 1:
+        logging.basicConfig(level=logging.DEBUG)
+    else:
+        logging.basicConfig(level=logging.ERROR)
+
+    errors = check(args.dbc, args.can_cfg_c, args.can_cfg_h, args.cansignal_cfg_c, args.cansignal_cfg_h,
+                   args.config)
+    for error in errors:
+        logging.error(error)
+    if errors:
+        sys.exit(1)
+    with open(args.stamp, 'w') as f:
+        f.write('{} matches {}\n'.format(', '.join(os.path.basename(x) for x in (
+            args.can_cfg_c, args.cansignal_cfg_c)), os.path.basename(args.dbc)))
+
+
+if __name__ == '__main__':
+    main()
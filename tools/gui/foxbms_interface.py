@@ -81,6 +81,9 @@ backgroundcolor = (0x66, 0x88, 0x98)
 backgroundcolor = (0x74, 0x9c, 0xb0)
 backgroundcolor = 'WHITE'
 
+# CAN ID of the cell voltage stream, CAN_ID_CELLVOLTAGE_STREAM in can_cfg.h
+CELL_VOLTAGE_STREAM_ID = 0x300
+
 
 class can_message():
 
@@ -186,6 +189,66 @@ def decode_CAN_data(message, bitstart, bitlength, factor,
     return data
 
 
+class cell_voltage_stream():
+    """Decoder of the multiplexed, delta encoded cell voltage stream.
+
+    The frame layout is described in cansignal_stream.h. Each group of 8 cells
+    keeps the last decoded voltages. A delta frame is only applied if both
+    absolute frames of the group were received and no frame of the group was
+    lost since then, i.e., the 4 bit sequence counter incremented by one.
+    """
+
+    CELLS_PER_GROUP = 8
+    CELLS_PER_ABSOLUTE = 4
+    ABSOLUTE_LOW = 0
+    ABSOLUTE_HIGH = 1
+    DELTA = 2
+
+    def __init__(self):
+        self.voltages = {}
+        self.sequence = {}
+        self.valid = {}
+
+    def decode(self, data):
+        """Decodes one frame of the stream.
+
+        Returns a list of (cell index, voltage in mV) with the cells updated
+        by this frame. The cell index counts over the whole battery system, a
+        voltage of 0 marks an invalid cell.
+        """
+        frame = 0
+        for i in range(len(data)):
+            frame |= int(data[i]) << (8 * i)
+        group = frame & 0x3F
+        frame_type = (frame >> 6) & 0x03
+        sequence = (frame >> 8) & 0x0F
+        payload = frame >> 12
+
+        if group not in self.voltages:
+            self.voltages[group] = [0] * self.CELLS_PER_GROUP
+            self.valid[group] = [False, False]
+        elif (self.sequence[group] + 1) % 16 != sequence:
+            # frames were lost, the base of the delta frames is unknown
+            self.valid[group] = [False, False]
+        self.sequence[group] = sequence
+
+        first = group * self.CELLS_PER_GROUP
+        updated = []
+        if frame_type in (self.ABSOLUTE_LOW, self.ABSOLUTE_HIGH):
+            offset = self.CELLS_PER_ABSOLUTE * frame_type
+            for i in range(self.CELLS_PER_ABSOLUTE):
+                voltage = (payload >> (13 * i)) & 0x1FFF
+                self.voltages[group][offset + i] = voltage
+                updated.append((first + offset + i, voltage))
+            self.valid[group][frame_type] = True
+        elif frame_type == self.DELTA and all(self.valid[group]):
+            for i in range(self.CELLS_PER_GROUP):
+                delta = decode_two_complement((payload >> (6 * i)) & 0x3F, 6)
+                self.voltages[group][i] += delta
+                updated.append((first + i, self.voltages[group][i]))
+        return updated
+
+
 class SelectionApp(wx.App):
     def __init__(self, parent=None):
         wx.App.__init__(self, False)
@@ -571,6 +634,8 @@ class MainFrame(wx.Frame):
         self.graph_started = 0
         self.plotting = 0
 
+        self.cell_voltage_stream = cell_voltage_stream()
+
         self.time_initial = datetime.datetime.now()
 
         self.old_display_time = [datetime.datetime.now()] * 4
@@ -1447,6 +1512,14 @@ class MainFrame(wx.Frame):
                                 self.panel_list[1 + module_number + 1].voltage_label_list[3 *
                                                                                           voltage_bank + i].SetValue(str(voltage[i]) + ' mV')
 
+            if decoded_can_data[0] == 'voltagestream':
+                for module_number, cell, voltage in decoded_can_data[1:]:
+                    if (module_number) < len(self.panel_list) - 1:
+                        if cell < len(self.panel_list[1 + module_number + 1].voltage_label_list):
+                            if voltage != 'NONE':
+                                self.panel_list[1 + module_number + 1].voltage_label_list[cell].SetValue(
+                                    str(voltage) + ' mV')
+
             if decoded_can_data[0] == 'voltageminmax':
                 self.min_voltage_label.SetValue(
                     str(decoded_can_data[2]) + ' mV')
@@ -1748,6 +1821,18 @@ class MainFrame(wx.Frame):
                 self.logfile = open(self.get_logfile_name(), "w")
 
         # CAN matrix foxBMS
+        # voltage stream
+        if can_data.id == CELL_VOLTAGE_STREAM_ID:
+            decoded_can_data = ['voltagestream']
+            for cell, voltage in self.cell_voltage_stream.decode(can_data.data[:can_data.dlc]):
+                module_number = cell // number_of_cells
+                if module_number < number_of_modules:
+                    if voltage == 0:
+                        voltage = 'NONE'
+                    decoded_can_data.append(
+                        (module_number, cell % number_of_cells, voltage))
+            return decoded_can_data
+
         # voltages
         if (can_data.id >= 0x200) and ((can_data.id - 0x200) % 0x20 == 0 or (can_data.id - 0x201) %
                                        0x20 == 0 or (can_data.id - 0x202) %
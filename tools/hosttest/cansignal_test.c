@@ -0,0 +1,593 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    cansignal_test.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup HOSTTEST
+ * @prefix  TEST
+ *
+ * @brief   Host test of the signal packing and the TX scheduling of cansignal
+ *
+ * cansignal.c is included in this file, so its static functions can be
+ * called directly. The message and signal tables are defined here instead of
+ * cansignal_cfg.c and can_cfg.c, the modules called by cansignal are stubbed.
+ *
+ * Covered: CANS_GetMotorolaSignal() and CANS_SetMotorolaSignal() against a
+ * reference that walks the dbc bit numbering one bit at a time, for every
+ * start bit and length that fits in a CAN message, byte-aligned and not
+ * aligned, with random values on random data. The bits outside of the signal
+ * must not change. Signals that do not fit must read as 0 and must not be
+ * written. CANS_GetSignalData() and CANS_SetSignalData() are checked for both
+ * byte orders.
+ *
+ * The TX scheduling is run one CANS_TICK_MS tick at a time on a table with
+ * two 10 ms messages, 100 ms messages and a block of 200 ms messages that
+ * all have the same configured phase, as the cell voltages in can_cfg.c.
+ * Every periodic message must be sent with its exact period, no tick may
+ * carry more frames than CANS_GetTxMaxSlotLoad() and the automatic phases
+ * must reach the lower bound of the load. A message sent on change must be
+ * sent once per repetition_time while its data is constant, a change must be
+ * sent within min_interval, changes in every tick must not be sent faster
+ * than min_interval and a failed transmission must be repeated at the next
+ * check. Configurations that cannot be scheduled must keep their configured
+ * phases.
+ *
+ * Usage: cansignal_test
+ */
+
+/*================== Includes =============================================*/
+#include "cansignal.c"
+
+#include <stdio.h>
+#include <string.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * random values per start bit and length
+ */
+#define TEST_NR_OF_RANDOM_VALUES        200u
+
+/**
+ * length of the TX schedule of the test table in ticks, least common
+ * multiple of the check times
+ */
+#define TEST_HYPERPERIOD_TICKS          (5000u / CANS_TICK_MS)
+
+/**
+ * number of 200 ms messages with the same configured phase
+ */
+#define TEST_NR_OF_CELL_MESSAGES        24u
+
+/**
+ * index of the message sent on change in the test table
+ */
+#define TEST_ON_CHANGE_MSG              (5u + TEST_NR_OF_CELL_MESSAGES)
+
+#define TEST_ON_CHANGE_ID               0x140u
+#define TEST_ON_CHANGE_REPETITION_MS    5000u
+#define TEST_ON_CHANGE_MIN_INTERVAL_MS  100u
+
+/**
+ * number of messages of the test table
+ */
+#define TEST_NR_OF_MESSAGES             (TEST_ON_CHANGE_MSG + 3u)
+
+/**
+ * transmissions of one message
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t firstTick;
+    uint32_t lastTick;
+    uint8_t irregular;              /*!< TRUE: two transmissions were not one period apart */
+} TEST_TX_LOG_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static uint32_t test_nrOfFailures = 0;
+static uint32_t test_random = 0x12345678u;
+
+static uint32_t test_tick = 0;
+static uint8_t test_framesInTick = 0;
+static uint8_t test_maxFramesInTick = 0;
+static uint8_t test_failNextOnChange = FALSE;
+static uint64_t test_onChangeValue = 0;
+static TEST_TX_LOG_s test_txLog[TEST_NR_OF_MESSAGES];
+
+/* message and signal tables of the tested configuration */
+#define TEST_CELL_MESSAGE(n)    { 0x200u + (n), 8, 200, 40, NULL_PTR, CAN_TX_PERIODIC, 0 }
+const CAN_MSG_TX_TYPE_s can_CAN0_messages_tx[] = {
+        { 0x130, 8, 10, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x131, 8, 10, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x110, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x111, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x112, 8, 100, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        TEST_CELL_MESSAGE(0), TEST_CELL_MESSAGE(1), TEST_CELL_MESSAGE(2), TEST_CELL_MESSAGE(3),
+        TEST_CELL_MESSAGE(4), TEST_CELL_MESSAGE(5), TEST_CELL_MESSAGE(6), TEST_CELL_MESSAGE(7),
+        TEST_CELL_MESSAGE(8), TEST_CELL_MESSAGE(9), TEST_CELL_MESSAGE(10), TEST_CELL_MESSAGE(11),
+        TEST_CELL_MESSAGE(12), TEST_CELL_MESSAGE(13), TEST_CELL_MESSAGE(14), TEST_CELL_MESSAGE(15),
+        TEST_CELL_MESSAGE(16), TEST_CELL_MESSAGE(17), TEST_CELL_MESSAGE(18), TEST_CELL_MESSAGE(19),
+        TEST_CELL_MESSAGE(20), TEST_CELL_MESSAGE(21), TEST_CELL_MESSAGE(22), TEST_CELL_MESSAGE(23),
+        { TEST_ON_CHANGE_ID, 8, TEST_ON_CHANGE_REPETITION_MS, 30, NULL_PTR, CAN_TX_ON_CHANGE, TEST_ON_CHANGE_MIN_INTERVAL_MS },
+        { 0x160, 8, 1000, 30, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x2E0, 8, 200, 160, NULL_PTR, CAN_TX_OFF, 0 },
+};
+const CAN_MSG_TX_TYPE_s can_CAN1_messages_tx[1];
+const uint8_t can_CAN0_tx_length = sizeof(can_CAN0_messages_tx)/sizeof(can_CAN0_messages_tx[0]);
+const uint8_t can_CAN1_tx_length = 0;
+const uint8_t can_CAN0_rx_length = 0;
+
+static uint32_t TEST_GetOnChangeValue(uint32_t idx, void *value);
+const CANS_signal_s cans_CAN0_signals_tx[] = {
+    { {TEST_ON_CHANGE_MSG}, 0, 16, 0, UINT16_MAX, 1, 0, littleEndian, &TEST_GetOnChangeValue },
+};
+const CANS_signal_s cans_CAN1_signals_tx[1];
+const CANS_signal_s cans_CAN0_signals_rx[1];
+const CANS_signal_s cans_CAN1_signals_rx[1];
+const uint16_t cans_CAN0_signals_tx_length = sizeof(cans_CAN0_signals_tx)/sizeof(cans_CAN0_signals_tx[0]);
+const uint16_t cans_CAN1_signals_tx_length = 0;
+const uint16_t cans_CAN0_signals_rx_length = 0;
+const uint16_t cans_CAN1_signals_rx_length = 0;
+
+/*================== Function Implementations =============================*/
+
+/* stubs of the modules called by cansignal */
+uint32_t OS_getOSSysTick(void) {
+    return 0;
+}
+
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+STD_RETURN_TYPE_e CAN_Send(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData,
+        uint32_t msgLength, uint32_t RTR) {
+    if ((msgID == TEST_ON_CHANGE_ID) && (test_failNextOnChange == TRUE)) {
+        test_failNextOnChange = FALSE;
+        return E_NOT_OK;
+    }
+    for (uint8_t i = 0; i < can_CAN0_tx_length; i++) {
+        if (can_CAN0_messages_tx[i].ID == msgID) {
+            TEST_TX_LOG_s *log = &test_txLog[i];
+            uint32_t period = can_CAN0_messages_tx[i].repetition_time / CANS_TICK_MS;
+            if ((log->count > 0u) && (can_CAN0_messages_tx[i].mode == CAN_TX_PERIODIC) &&
+                    ((test_tick - log->lastTick) != period)) {
+                log->irregular = TRUE;
+            }
+            if (log->count == 0u) {
+                log->firstTick = test_tick;
+            }
+            log->lastTick = test_tick;
+            log->count++;
+        }
+    }
+    test_framesInTick++;
+    return E_OK;
+}
+
+STD_RETURN_TYPE_e CAN_TxMsg(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData,
+        uint32_t msgLength, uint32_t RTR) {
+    return E_OK;
+}
+
+STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode) {
+    return E_OK;
+}
+
+uint8_t CAN_ReceiveBurst(CAN_NodeTypeDef_e canNode, Can_PduType* msgs, uint8_t maxNrOfMsgs) {
+    return 0;
+}
+
+uint32_t CAN_GetRxDroppedMsgs(CAN_NodeTypeDef_e canNode) {
+    return 0;
+}
+
+STD_RETURN_TYPE_e CAN_GetRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* rxIndex) {
+    return E_NOT_OK;
+}
+
+STD_RETURN_TYPE_e DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e  blockID) {
+    return E_OK;
+}
+
+DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint32_t item_nr) {
+    return DIAG_HANDLER_RETURN_OK;
+}
+
+STD_RETURN_TYPE_e DIAG_checkEvent(STD_RETURN_TYPE_e cond, DIAG_CH_ID_e diag_ch_id, uint32_t item_nr) {
+    return cond;
+}
+
+void DIAG_SysMonNotify(DIAG_SYSMON_MODULE_ID_e module_id, uint32_t state) {
+}
+
+void ISOTP_ReceiveFrame(const uint8_t *data, uint8_t dlc) {
+}
+
+void ISOTP_MainFunction(void) {
+}
+
+void XCP_ReceiveFrame(const uint8_t *data, uint8_t dlc) {
+}
+
+void CANS_StreamCellVoltages(void) {
+}
+
+uint8_t CANS_StreamGetMaxFramesPerTick(void) {
+    return 0;
+}
+
+
+static uint32_t TEST_GetOnChangeValue(uint32_t idx, void *value) {
+    *(uint64_t *)value = test_onChangeValue;
+    return 0;
+}
+
+
+static void TEST_Check(uint8_t condition, const char *description) {
+    if (condition == FALSE) {
+        printf("  FAIL: %s\n", description);
+        test_nrOfFailures++;
+    }
+}
+
+
+/**
+ * @brief   xorshift32 pseudo random numbers, the same sequence on every run
+ */
+static uint32_t TEST_Random(void) {
+    test_random ^= test_random << 13;
+    test_random ^= test_random >> 17;
+    test_random ^= test_random << 5;
+    return test_random;
+}
+
+
+static uint64_t TEST_Random64(void) {
+    uint64_t value = TEST_Random();
+    return (value << 32) | TEST_Random();
+}
+
+
+/**
+ * @brief   frame bit positions (byte * 8 + bit) of a Motorola signal, MSB first
+ *
+ * The positions are walked one bit at a time in the numbering of the dbc:
+ * from the start bit to the lower bits of the same byte, then from the MSB
+ * of the next byte.
+ *
+ * @return  TRUE if all bits are in the 8 bytes of a CAN message
+ */
+static uint8_t TEST_MotorolaPositions(uint8_t startBit, uint8_t bitLength, uint8_t *positions) {
+    uint16_t position = startBit;
+
+    for (uint8_t i = 0; i < bitLength; i++) {
+        if (position >= 64u) {
+            return FALSE;
+        }
+        positions[i] = (uint8_t)position;
+        if ((position % 8u) == 0u) {
+            position += 15u;
+        } else {
+            position--;
+        }
+    }
+    return TRUE;
+}
+
+
+static uint64_t TEST_ReferenceGet(const uint8_t *data, const uint8_t *positions, uint8_t bitLength) {
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; i < bitLength; i++) {
+        value = (value << 1) | ((data[positions[i] / 8u] >> (positions[i] % 8u)) & 1u);
+    }
+    return value;
+}
+
+
+static void TEST_ReferenceSet(uint8_t *data, const uint8_t *positions, uint8_t bitLength, uint64_t value) {
+    for (uint8_t i = 0; i < bitLength; i++) {
+        uint8_t bit = (uint8_t)((value >> (bitLength - 1u - i)) & 1u);
+        uint8_t mask = (uint8_t)(1u << (positions[i] % 8u));
+        data[positions[i] / 8u] = (uint8_t)((data[positions[i] / 8u] & ~mask) | (bit ? mask : 0u));
+    }
+}
+
+
+static void TEST_RandomData(uint8_t *data) {
+    for (uint8_t i = 0; i < 8u; i++) {
+        data[i] = (uint8_t)TEST_Random();
+    }
+}
+
+
+static void TEST_Motorola(void) {
+    uint8_t positions[64];
+    uint8_t data[8];
+    uint8_t expected[8];
+    char description[128];
+    uint32_t nrOfAligned = 0;
+    uint32_t nrOfUnaligned = 0;
+    uint32_t nrOfOutside = 0;
+
+    printf("Motorola signals against the bit-by-bit reference\n");
+    for (uint8_t startBit = 0; startBit < 64u; startBit++) {
+        for (uint8_t bitLength = 1; bitLength <= 64u; bitLength++) {
+            if (TEST_MotorolaPositions(startBit, bitLength, positions) == FALSE) {
+                /* the signal does not fit, it must read as 0 and must not be written */
+                nrOfOutside++;
+                TEST_RandomData(data);
+                memcpy(expected, data, sizeof(data));
+                CANS_SetMotorolaSignal(data, startBit, bitLength, TEST_Random64());
+                snprintf(description, sizeof(description), "start %u, length %u: not fitting signal",
+                        startBit, bitLength);
+                TEST_Check((memcmp(data, expected, sizeof(data)) == 0) &&
+                        (CANS_GetMotorolaSignal(data, startBit, bitLength) == 0u), description);
+                continue;
+            }
+            if (((startBit % 8u) == 7u) && ((bitLength % 8u) == 0u)) {
+                nrOfAligned++;
+            } else {
+                nrOfUnaligned++;
+            }
+            uint64_t mask = CANS_GetBitmask(bitLength);
+            uint32_t nrOfErrors = 0;
+            for (uint32_t n = 0; n < TEST_NR_OF_RANDOM_VALUES; n++) {
+                uint64_t value = TEST_Random64();
+                if (n == 0u) {
+                    value = 0;
+                } else if (n == 1u) {
+                    value = mask;
+                }
+                TEST_RandomData(data);
+                memcpy(expected, data, sizeof(data));
+                TEST_ReferenceSet(expected, positions, bitLength, value & mask);
+                /* bits above the signal length must be ignored */
+                CANS_SetMotorolaSignal(data, startBit, bitLength, value);
+                if (memcmp(data, expected, sizeof(data)) != 0) {
+                    nrOfErrors++;
+                }
+                TEST_RandomData(data);
+                if (CANS_GetMotorolaSignal(data, startBit, bitLength) != TEST_ReferenceGet(data, positions, bitLength)) {
+                    nrOfErrors++;
+                }
+            }
+            snprintf(description, sizeof(description), "start %u, length %u: %u errors",
+                    startBit, bitLength, (unsigned)nrOfErrors);
+            TEST_Check(nrOfErrors == 0u, description);
+        }
+    }
+    printf("  %u aligned, %u unaligned, %u not fitting signals\n",
+            (unsigned)nrOfAligned, (unsigned)nrOfUnaligned, (unsigned)nrOfOutside);
+    TEST_Check((nrOfAligned > 0u) && (nrOfUnaligned > 0u), "aligned and unaligned signals covered");
+}
+
+
+static void TEST_SignalData(void) {
+    uint8_t positions[64];
+    uint8_t data[8];
+    uint8_t expected[8];
+    uint64_t value = 0;
+    CANS_signal_s motorola = { {0}, 22, 13, 0, 0, 1, 0, bigEndian, NULL_PTR };
+    CANS_signal_s intel = { {0}, 19, 13, 0, 0, 1, 0, littleEndian, NULL_PTR };
+
+    printf("signal data of both byte orders\n");
+    (void)TEST_MotorolaPositions(motorola.bit_position, motorola.bit_length, positions);
+    TEST_RandomData(data);
+    memcpy(expected, data, sizeof(data));
+    TEST_ReferenceSet(expected, positions, motorola.bit_length, 0x1ABCu);
+    CANS_SetSignalData(motorola, 0x1ABCu, data);
+    TEST_Check(memcmp(data, expected, sizeof(data)) == 0, "Motorola signal set");
+    CANS_GetSignalData(&value, motorola, data);
+    TEST_Check(value == 0x1ABCu, "Motorola signal get");
+
+    TEST_RandomData(data);
+    memcpy(expected, data, sizeof(data));
+    for (uint8_t i = 0; i < intel.bit_length; i++) {
+        uint8_t position = intel.bit_position + i;
+        uint8_t mask = (uint8_t)(1u << (position % 8u));
+        expected[position / 8u] = (uint8_t)((expected[position / 8u] & ~mask) | (((0x0DEFu >> i) & 1u) ? mask : 0u));
+    }
+    CANS_SetSignalData(intel, 0x0DEFu, data);
+    TEST_Check(memcmp(data, expected, sizeof(data)) == 0, "Intel signal set");
+    CANS_GetSignalData(&value, intel, data);
+    TEST_Check(value == 0x0DEFu, "Intel signal get");
+}
+
+
+/**
+ * @brief   runs CANS_PeriodicTransmit() for a number of ticks
+ */
+static void TEST_Run(uint32_t nrOfTicks) {
+    for (uint32_t i = 0; i < nrOfTicks; i++) {
+        test_framesInTick = 0;
+        (void)CANS_PeriodicTransmit();
+        if (test_framesInTick > test_maxFramesInTick) {
+            test_maxFramesInTick = test_framesInTick;
+        }
+        test_tick++;
+    }
+}
+
+
+/**
+ * @brief   worst-case number of messages in one tick with the configured phases
+ */
+static uint32_t TEST_GetConfiguredMaxLoad(void) {
+    uint32_t maxLoad = 0;
+
+    for (uint32_t t = 0; t < TEST_HYPERPERIOD_TICKS; t++) {
+        uint32_t load = 0;
+        for (uint8_t i = 0; i < can_CAN0_tx_length; i++) {
+            uint32_t checkTime = CANS_GetTxCheckTime(&can_CAN0_messages_tx[i]);
+            if ((checkTime != 0u) &&
+                    (((t * CANS_TICK_MS) % checkTime) == (can_CAN0_messages_tx[i].repetition_phase % checkTime))) {
+                load++;
+            }
+        }
+        if (load > maxLoad) {
+            maxLoad = load;
+        }
+    }
+    return maxLoad;
+}
+
+
+static void TEST_Schedule(void) {
+    uint32_t nrOfChecks = 0;
+    uint32_t lowerBound = 0;
+    uint8_t periodicOk = TRUE;
+
+    printf("automatic phases of the TX messages\n");
+    CANS_Init();
+    TEST_Check(cans_state.tx_phase_ready == TRUE, "phases assigned");
+    for (uint8_t i = 0; i < can_CAN0_tx_length; i++) {
+        uint32_t checkTime = CANS_GetTxCheckTime(&can_CAN0_messages_tx[i]);
+        if (checkTime != 0u) {
+            nrOfChecks += TEST_HYPERPERIOD_TICKS / (checkTime / CANS_TICK_MS);
+        }
+    }
+    lowerBound = (nrOfChecks + TEST_HYPERPERIOD_TICKS - 1u) / TEST_HYPERPERIOD_TICKS;
+
+    /* the data of the message sent on change changes in every tick, so every
+     * check of the schedule carries a frame */
+    for (uint32_t i = 0; i < 2u * TEST_HYPERPERIOD_TICKS; i++) {
+        test_onChangeValue++;
+        TEST_Run(1);
+    }
+    printf("  max %u frames per tick, lower bound %u, %u with the configured phases\n",
+            (unsigned)CANS_GetTxMaxSlotLoad(CAN_NODE0), (unsigned)lowerBound, (unsigned)TEST_GetConfiguredMaxLoad());
+    TEST_Check(test_maxFramesInTick == CANS_GetTxMaxSlotLoad(CAN_NODE0), "frames per tick as reported");
+    TEST_Check(CANS_GetTxMaxSlotLoad(CAN_NODE0) == lowerBound, "load at the lower bound");
+    TEST_Check(CANS_GetTxMaxSlotLoad(CAN_NODE0) < TEST_GetConfiguredMaxLoad(), "load below the configured phases");
+
+    for (uint8_t i = 0; i < can_CAN0_tx_length; i++) {
+        const CAN_MSG_TX_TYPE_s *message = &can_CAN0_messages_tx[i];
+        if (message->mode == CAN_TX_PERIODIC) {
+            uint32_t period = message->repetition_time / CANS_TICK_MS;
+            if ((test_txLog[i].irregular == TRUE) || (test_txLog[i].firstTick >= period) ||
+                    (test_txLog[i].count != (2u * TEST_HYPERPERIOD_TICKS) / period)) {
+                printf("  message 0x%03X: %u frames, first in tick %u\n", (unsigned)message->ID,
+                        (unsigned)test_txLog[i].count, (unsigned)test_txLog[i].firstTick);
+                periodicOk = FALSE;
+            }
+        }
+    }
+    TEST_Check(periodicOk, "periodic messages sent with their period");
+    TEST_Check(test_txLog[TEST_NR_OF_MESSAGES - 1u].count == 0u, "message switched off not sent");
+}
+
+
+static void TEST_OnChange(void) {
+    TEST_TX_LOG_s *log = &test_txLog[TEST_ON_CHANGE_MSG];
+    const uint32_t minInterval = TEST_ON_CHANGE_MIN_INTERVAL_MS / CANS_TICK_MS;
+    const uint32_t repetition = TEST_ON_CHANGE_REPETITION_MS / CANS_TICK_MS;
+    uint32_t count = 0;
+    uint32_t changeTick = 0;
+
+    printf("messages sent on change\n");
+    TEST_Check(log->count == (2u * TEST_HYPERPERIOD_TICKS) / minInterval, "changes in every tick sent every min_interval");
+
+    /* constant data is repeated after repetition_time */
+    test_onChangeValue++;
+    TEST_Run(minInterval);
+    count = log->count;
+    TEST_Run(3u * repetition);
+    TEST_Check(log->count == count + 3u, "constant data sent once per repetition_time");
+
+    /* a change is sent at the next check */
+    TEST_Run(repetition / 2u);
+    count = log->count;
+    changeTick = test_tick;
+    test_onChangeValue++;
+    TEST_Run(minInterval);
+    TEST_Check((log->count == count + 1u) && (log->lastTick >= changeTick) &&
+            (log->lastTick < changeTick + minInterval), "change sent within min_interval");
+
+    /* a failed transmission is repeated at the next check */
+    count = log->count;
+    test_failNextOnChange = TRUE;
+    test_onChangeValue++;
+    TEST_Run(minInterval);
+    TEST_Check(log->count == count, "failed transmission not counted");
+    TEST_Run(minInterval);
+    TEST_Check(log->count == count + 1u, "failed transmission repeated at the next check");
+}
+
+
+static void TEST_ScheduleFallback(void) {
+    const CAN_MSG_TX_TYPE_s offTick[] = {
+        { 0x300, 8, 10, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x301, 8, CANS_TICK_MS + 5u, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+    };
+    const CAN_MSG_TX_TYPE_s tooLong[] = {
+        { 0x300, 8, (CANS_TX_SCHEDULE_MAX_TICKS - 1u) * CANS_TICK_MS, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+        { 0x301, 8, (CANS_TX_SCHEDULE_MAX_TICKS - 3u) * CANS_TICK_MS, 0, NULL_PTR, CAN_TX_PERIODIC, 0 },
+    };
+    uint8_t maxSlotLoad = 0;
+
+    printf("configurations that cannot be scheduled\n");
+    TEST_Check(CANS_ScheduleTx(offTick, 2, 0, &maxSlotLoad) == E_NOT_OK, "period not a multiple of the tick");
+    TEST_Check(CANS_ScheduleTx(tooLong, 2, 0, &maxSlotLoad) == E_NOT_OK, "schedule longer than the maximum");
+    TEST_Check(CANS_ScheduleTx(offTick, 2, CANS_MSG_TX_MAX - 1u, &maxSlotLoad) == E_NOT_OK, "index behind the messages");
+}
+
+
+int main(void) {
+    TEST_Motorola();
+    TEST_SignalData();
+    TEST_Schedule();
+    TEST_OnChange();
+    TEST_ScheduleFallback();
+
+    if (test_nrOfFailures > 0) {
+        printf("FAIL: %u checks failed\n", (unsigned)test_nrOfFailures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
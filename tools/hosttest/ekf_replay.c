@@ -0,0 +1,326 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    ekf_replay.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup HOSTTEST
+ * @prefix  TEST
+ *
+ * @brief   Host replay benchmark of the EKF SOC estimator
+ *
+ * Feeds a current/voltage profile through SOX_EKF_Update() and compares the
+ * estimate with a reference SOC. The profile is either read from a CSV file
+ * with the columns time_ms, current_mA, voltage_mV, soc_perc (one cell,
+ * discharge current positive, voltage samples at the rate of the measurement)
+ * or generated: a coulomb-counted 2RC cell driven by a pulse profile. The
+ * generated cell deviates from the parameters of sox_cfg.h by the mismatch
+ * factors below, the voltage has 2 mV measurement noise and the filter
+ * starts with a wrong SOC.
+ *
+ * Prints the RMS and maximum SOC error after convergence and the time per
+ * filter update of one cell. The time is measured on the host and only
+ * comparable between runs on the same machine.
+ *
+ * Usage: ekf_replay [profile.csv]
+ */
+
+/*================== Includes =============================================*/
+#include "sox_ekf.h"
+
+#include "bms.h"
+#include "database.h"
+#include "nvramhandler.h"
+#include "os.h"
+#include "sox.h"
+#include "sox_rls.h"
+#include "sox_soh.h"
+#include "sox_sop.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * sample interval of the generated profile in ms, cell voltage measurement cycle
+ */
+#define TEST_SAMPLE_INTERVAL_MS         100
+
+/**
+ * duration of the generated profile in ms
+ */
+#define TEST_PROFILE_DURATION_MS        (3600u * 1000u)
+
+/**
+ * error of the estimate is evaluated after this time in ms, the filter starts with a wrong SOC
+ */
+#define TEST_CONVERGENCE_TIME_MS        (600u * 1000u)
+
+/**
+ * capacity and resistances of the generated cell relative to the EKF model
+ */
+#define TEST_CAPACITY_MISMATCH          0.95f
+#define TEST_RESISTANCE_MISMATCH        1.2f
+
+/**
+ * pass criteria in % SOC
+ */
+#define TEST_MAX_RMS_ERROR_PERC         2.0f
+#define TEST_MAX_ERROR_PERC             5.0f
+
+/*================== Constant and Variable Definitions ====================*/
+static DATA_BLOCK_CELLVOLTAGE_s test_cellvoltage;
+static DATA_BLOCK_CURRENT_SENSOR_s test_current;
+
+static double test_updateTime_s = 0.0;
+static uint32_t test_nrOfUpdates = 0;
+static double test_sumSquaredError = 0.0;
+static float test_maxError = 0.0f;
+static uint32_t test_nrOfErrors = 0;
+
+/*================== Function Implementations =============================*/
+
+/* stubs of the modules called by the EKF */
+STD_RETURN_TYPE_e DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e blockID) {
+    if (blockID == DATA_BLOCK_ID_CELLVOLTAGE) {
+        memcpy(dataptrtoReceiver, &test_cellvoltage, sizeof(test_cellvoltage));
+    } else {
+        memcpy(dataptrtoReceiver, &test_current, sizeof(test_current));
+    }
+    return E_OK;
+}
+
+STD_RETURN_TYPE_e SOX_RLS_GetCellResistance(uint16_t cellIdx, float *r0, float *r1) {
+    *r0 = SOX_EKF_R0_OHM;
+    *r1 = SOX_EKF_R1_OHM;
+    return E_NOT_OK;
+}
+
+float SOX_SOH_GetCapacity(void) {
+    return SOX_CELL_CAPACITY;
+}
+
+/* stubs of the modules called by sox.c, which provides SOC_GetFromVoltage() */
+void DB_WriteBlock(void *dataptrfromSender, DATA_BLOCK_ID_TYPE_e blockID) {
+}
+
+float SOX_RLS_GetMaxResistance(void) {
+    return SOX_EKF_R0_OHM + SOX_EKF_R1_OHM;
+}
+
+BMS_CURRENT_FLOW_STATE_e BMS_GetBatterySystemState(void) {
+    return BMS_AT_REST;
+}
+
+STD_RETURN_TYPE_e NVM_getSOC(SOX_SOC_s *dest_ptr) {
+    return E_OK;
+}
+
+STD_RETURN_TYPE_e NVM_setSOC(SOX_SOC_s *ptr) {
+    return E_OK;
+}
+
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+void SOX_SOH_Init(void) {
+}
+
+void SOX_SOH_AddCharge(int64_t charge_mAms) {
+}
+
+void SOX_SOH_RestPoint(float soc) {
+}
+
+void SOX_SOP_Calculate(const DATA_BLOCK_MINMAX_s *minmax, DATA_BLOCK_SOF_s *sof) {
+}
+
+
+static double TEST_Now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+/**
+ * @brief   runs one filter step for all cells with the same sample and evaluates the estimate
+ */
+static void TEST_Step(uint32_t time_ms, int32_t current_mA, uint16_t voltage_mV, float soc_perc) {
+    SOX_SOC_s soc;
+    double start = 0.0;
+    float error = 0.0f;
+
+    test_current.current = current_mA;
+    test_cellvoltage.timestamp = time_ms;
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        test_cellvoltage.voltage[i] = voltage_mV;
+    }
+
+    start = TEST_Now();
+    while (SOX_EKF_Update(SOX_EKF_CELLS_PER_CALL) == FALSE) {
+    }
+    test_updateTime_s += TEST_Now() - start;
+    test_nrOfUpdates++;
+
+    if ((time_ms >= TEST_CONVERGENCE_TIME_MS) && (SOX_EKF_GetSoc(&soc) == E_OK)) {
+        error = fabsf(soc.mean - soc_perc);
+        test_sumSquaredError += (double)error * (double)error;
+        test_nrOfErrors++;
+        if (error > test_maxError) {
+            test_maxError = error;
+        }
+    }
+}
+
+
+/**
+ * @brief   replays a recorded profile, returns the number of samples
+ */
+static uint32_t TEST_ReplayFile(const char *path) {
+    FILE *file = fopen(path, "r");
+    char line[128];
+    unsigned long time_ms = 0;
+    long current_mA = 0;
+    unsigned int voltage_mV = 0;
+    float soc_perc = 0.0f;
+    uint32_t nrOfSamples = 0;
+
+    if (file == NULL) {
+        perror(path);
+        exit(2);
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "%lu,%ld,%u,%f", &time_ms, &current_mA, &voltage_mV, &soc_perc) == 4) {
+            /* timestamp 0 is the initial value of the database */
+            TEST_Step((uint32_t)time_ms + 1u, (int32_t)current_mA, (uint16_t)voltage_mV, soc_perc);
+            nrOfSamples++;
+        }
+    }
+    fclose(file);
+    return nrOfSamples;
+}
+
+
+/**
+ * @brief   generates and replays a pulse profile of a 2RC cell model, returns the number of samples
+ */
+static uint32_t TEST_ReplayModel(void) {
+    const float dt = (float)TEST_SAMPLE_INTERVAL_MS / 1000.0f;
+    const float a1 = expf(-dt / SOX_EKF_TAU1_S);
+    const float a2 = expf(-dt / SOX_EKF_TAU2_S);
+    float soc = 0.9f;
+    float v1 = 0.0f;
+    float v2 = 0.0f;
+    float current = 0.0f;
+    float ocv = 0.0f;
+    float slope = 0.0f;
+    float voltage = 0.0f;
+    uint32_t seed = 1;
+    uint32_t nrOfSamples = 0;
+
+    for (uint32_t t = TEST_SAMPLE_INTERVAL_MS; t <= TEST_PROFILE_DURATION_MS; t += TEST_SAMPLE_INTERVAL_MS) {
+        /* 30 s at 40 A, 20 s rest, 10 s regenerative at -30 A, SOC 90 % to 15 % */
+        if (((t / 1000u) % 60u) < 30u) {
+            current = 40.0f;
+        } else if (((t / 1000u) % 60u) < 50u) {
+            current = 0.0f;
+        } else {
+            current = -30.0f;
+        }
+        soc -= current * dt / (TEST_CAPACITY_MISMATCH * SOX_CELL_CAPACITY * 3.6f);
+        v1 = a1 * v1 + TEST_RESISTANCE_MISMATCH * SOX_EKF_R1_OHM * (1.0f - a1) * current;
+        v2 = a2 * v2 + TEST_RESISTANCE_MISMATCH * SOX_EKF_R2_OHM * (1.0f - a2) * current;
+        ocv = SOX_EKF_GetOcv(soc, &slope);
+        voltage = ocv - v1 - v2 - TEST_RESISTANCE_MISMATCH * SOX_EKF_R0_OHM * current;
+
+        /* +-2 mV uniform measurement noise */
+        seed = seed * 1103515245u + 12345u;
+        voltage += ((float)((seed >> 16) % 4001u) - 2000.0f) * 1.0e-6f;
+        if (t == TEST_SAMPLE_INTERVAL_MS) {
+            /* filter is initialized from a voltage 30 mV above the true one */
+            voltage += 0.03f;
+        }
+        TEST_Step(t, (int32_t)(current * 1000.0f), (uint16_t)(voltage * 1000.0f + 0.5f), soc * 100.0f);
+        nrOfSamples++;
+    }
+    return nrOfSamples;
+}
+
+
+int main(int argc, char *argv[]) {
+    uint32_t nrOfSamples = 0;
+    float rmsError = 0.0f;
+    double updateTime_us = 0.0;
+
+    if (argc > 1) {
+        nrOfSamples = TEST_ReplayFile(argv[1]);
+    } else {
+        nrOfSamples = TEST_ReplayModel();
+    }
+    if (test_nrOfErrors == 0) {
+        printf("FAIL: profile too short, no sample after %u ms\n", TEST_CONVERGENCE_TIME_MS);
+        return 1;
+    }
+
+    rmsError = (float)sqrt(test_sumSquaredError / (double)test_nrOfErrors);
+    updateTime_us = 1e6 * test_updateTime_s / ((double)test_nrOfUpdates * (double)BS_NR_OF_BAT_CELLS);
+    printf("samples: %u, cells: %u\n", nrOfSamples, BS_NR_OF_BAT_CELLS);
+    printf("SOC error after %u s: rms %.2f %%, max %.2f %%\n", TEST_CONVERGENCE_TIME_MS / 1000u,
+            (double)rmsError, (double)test_maxError);
+    printf("time per cell update: %.3f us (host)\n", updateTime_us);
+
+    if ((rmsError > TEST_MAX_RMS_ERROR_PERC) || (test_maxError > TEST_MAX_ERROR_PERC)) {
+        printf("FAIL\n");
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,355 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    foxmath_test.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup HOSTTEST
+ * @prefix  TEST
+ *
+ * @brief   Host test of the fixed-point functions of foxmath
+ *
+ * The test is compiled with MATH_USE_DSP_INSTRUCTIONS set to TRUE, so the
+ * saturating operations call MATH_dspSsat16(), MATH_dspQadd() and
+ * MATH_dspQsub(). These are emulated here after the pseudocode of the ARMv7-M
+ * reference manual and compared with the portable C implementations on edge
+ * values and random inputs. foxmath.c itself is compiled with the default
+ * of the host, i.e. portable C.
+ *
+ * Covered: saturation at the limits of Q15 and Q31, float conversions, the
+ * accuracy of square root and reciprocal against double precision and the
+ * table and grid interpolation against a double precision reference.
+ *
+ * Usage: foxmath_test
+ */
+
+/*================== Includes =============================================*/
+#define MATH_USE_DSP_INSTRUCTIONS   TRUE
+#include "foxmath.h"
+
+#include <stdio.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * number of random inputs per check
+ */
+#define TEST_NR_OF_RANDOM_VALUES        1000000u
+
+/**
+ * largest relative error of the reciprocal, the Newton-Raphson iterations
+ * converge to the resolution of the Q30 intermediate values
+ */
+#define TEST_RECIPROCAL_MAX_ERROR       1.0e-8
+
+/*================== Constant and Variable Definitions ====================*/
+static uint32_t test_nrOfFailures = 0;
+static uint32_t test_random = 0x12345678u;
+
+static const int32_t test_edges[] = {
+    INT32_MIN, INT32_MIN + 1, -0x40000000, -0x10000, INT16_MIN - 1, INT16_MIN, INT16_MIN + 1,
+    -2, -1, 0, 1, 2, INT16_MAX - 1, INT16_MAX, INT16_MAX + 1, 0x10000, 0x40000000,
+    INT32_MAX - 1, INT32_MAX,
+};
+
+static const int32_t test_table_x[] = {-4000, -250, 0, 17, 1000, 65000};
+static const int32_t test_table_y[] = {1000000, -3, 0, 2000000000, -2000000000, 12345};
+static const MATH_TABLE_s test_table = {test_table_x, test_table_y, 6};
+
+static const int32_t test_grid_y[] = {-7, 2000000000, -2000000000, 0, 99, -1000};
+static const MATH_GRID_s test_grid = {-100, 5, test_grid_y, 6};
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   SSAT #16 after the ARMv7-M pseudocode SignedSatQ(x, 16)
+ */
+int32_t MATH_dspSsat16(int32_t x) {
+    if (x > ((1 << 15) - 1)) {
+        return (1 << 15) - 1;
+    }
+    if (x < -(1 << 15)) {
+        return -(1 << 15);
+    }
+    return x;
+}
+
+/**
+ * @brief   QADD, the sum overflowed if both operands have a sign different from the result
+ */
+int32_t MATH_dspQadd(int32_t a, int32_t b) {
+    uint32_t sum = (uint32_t)a + (uint32_t)b;
+
+    if ((((uint32_t)a ^ sum) & ((uint32_t)b ^ sum) & 0x80000000u) != 0u) {
+        return (a < 0) ? INT32_MIN : INT32_MAX;
+    }
+    return (int32_t)sum;
+}
+
+/**
+ * @brief   QSUB, the difference overflowed if the operands differ in sign and the result has the sign of b
+ */
+int32_t MATH_dspQsub(int32_t a, int32_t b) {
+    uint32_t difference = (uint32_t)a - (uint32_t)b;
+
+    if ((((uint32_t)a ^ (uint32_t)b) & ((uint32_t)a ^ difference) & 0x80000000u) != 0u) {
+        return (a < 0) ? INT32_MIN : INT32_MAX;
+    }
+    return (int32_t)difference;
+}
+
+
+static void TEST_Check(uint8_t condition, const char *description) {
+    if (condition == FALSE) {
+        printf("  FAIL: %s\n", description);
+        test_nrOfFailures++;
+    }
+}
+
+
+/**
+ * @brief   xorshift32 pseudo random numbers, the same sequence on every run
+ */
+static int32_t TEST_Random(void) {
+    test_random ^= test_random << 13;
+    test_random ^= test_random >> 17;
+    test_random ^= test_random << 5;
+    return (int32_t)test_random;
+}
+
+
+static void TEST_Saturation(void) {
+    printf("saturation at the Q15 and Q31 limits\n");
+    TEST_Check(MATH_addSat_q15(MATH_Q15_MAX, 1) == MATH_Q15_MAX, "Q15 add, positive overflow");
+    TEST_Check(MATH_addSat_q15(MATH_Q15_MIN, -1) == MATH_Q15_MIN, "Q15 add, negative overflow");
+    TEST_Check(MATH_addSat_q15(MATH_Q15_MAX, MATH_Q15_MIN) == -1, "Q15 add, no overflow");
+    TEST_Check(MATH_subSat_q15(MATH_Q15_MIN, 1) == MATH_Q15_MIN, "Q15 subtract, negative overflow");
+    TEST_Check(MATH_subSat_q15(0, MATH_Q15_MIN) == MATH_Q15_MAX, "Q15 subtract, -(-1)");
+    TEST_Check(MATH_mulSat_q15(MATH_Q15_MIN, MATH_Q15_MIN) == MATH_Q15_MAX, "Q15 multiply, -1 * -1");
+    TEST_Check(MATH_mulSat_q15(MATH_Q15_MIN, MATH_Q15_MAX) == -MATH_Q15_MAX, "Q15 multiply, -1 * max");
+    TEST_Check(MATH_mulSat_q15(0x4000, 0x4000) == 0x2000, "Q15 multiply, 0.5 * 0.5");
+    TEST_Check(MATH_mulSat_q15(1, 0x4000) == 1, "Q15 multiply, rounded to nearest");
+
+    TEST_Check(MATH_addSat_q31(MATH_Q31_MAX, 1) == MATH_Q31_MAX, "Q31 add, positive overflow");
+    TEST_Check(MATH_addSat_q31(MATH_Q31_MIN, -1) == MATH_Q31_MIN, "Q31 add, negative overflow");
+    TEST_Check(MATH_addSat_q31(MATH_Q31_MAX, MATH_Q31_MIN) == -1, "Q31 add, no overflow");
+    TEST_Check(MATH_subSat_q31(MATH_Q31_MIN, 1) == MATH_Q31_MIN, "Q31 subtract, negative overflow");
+    TEST_Check(MATH_subSat_q31(0, MATH_Q31_MIN) == MATH_Q31_MAX, "Q31 subtract, -(-1)");
+    TEST_Check(MATH_subSat_q31(MATH_Q31_MAX, -1) == MATH_Q31_MAX, "Q31 subtract, positive overflow");
+    TEST_Check(MATH_mulSat_q31(MATH_Q31_MIN, MATH_Q31_MIN) == MATH_Q31_MAX, "Q31 multiply, -1 * -1");
+    TEST_Check(MATH_mulSat_q31(MATH_Q31_MIN, MATH_Q31_MAX) == -MATH_Q31_MAX, "Q31 multiply, -1 * max");
+    TEST_Check(MATH_mulSat_q31(MATH_Q31_CONST(0.5), MATH_Q31_CONST(0.5)) == MATH_Q31_CONST(0.25), "Q31 multiply, 0.5 * 0.5");
+
+    TEST_Check(MATH_floatToQ15(1.0f) == MATH_Q15_MAX, "float to Q15, 1.0");
+    TEST_Check(MATH_floatToQ15(-3.0f) == MATH_Q15_MIN, "float to Q15, -3.0");
+    TEST_Check(MATH_floatToQ15(-0.5f) == MATH_Q15_CONST(-0.5), "float to Q15, -0.5");
+    TEST_Check(MATH_floatToQ31(1.0f) == MATH_Q31_MAX, "float to Q31, 1.0");
+    TEST_Check(MATH_floatToQ31(-2.0f) == MATH_Q31_MIN, "float to Q31, -2.0");
+    TEST_Check(MATH_floatToQ31(0.25f) == MATH_Q31_CONST(0.25), "float to Q31, 0.25");
+    TEST_Check(MATH_q15ToFloat(MATH_Q15_MIN) == -1.0f, "Q15 to float, -1");
+    TEST_Check(MATH_q31ToFloat(MATH_Q31_CONST(-0.75)) == -0.75f, "Q31 to float, -0.75");
+}
+
+
+static void TEST_DspAgainstC(void) {
+    uint32_t mismatches = 0;
+    uint16_t nrOfEdges = sizeof(test_edges) / sizeof(test_edges[0]);
+    int32_t a = 0;
+    int32_t b = 0;
+
+    printf("DSP instructions against portable C, edge values and %u random pairs\n", (unsigned)TEST_NR_OF_RANDOM_VALUES);
+    for (uint16_t i = 0; i < nrOfEdges; i++) {
+        for (uint16_t j = 0; j < nrOfEdges; j++) {
+            a = test_edges[i];
+            b = test_edges[j];
+            mismatches += (MATH_addSat_q31(a, b) != MATH_addSat_q31_c(a, b));
+            mismatches += (MATH_subSat_q31(a, b) != MATH_subSat_q31_c(a, b));
+        }
+        mismatches += (MATH_saturate_q15(test_edges[i]) != MATH_saturate_q15_c(test_edges[i]));
+    }
+    for (uint32_t i = 0; i < TEST_NR_OF_RANDOM_VALUES; i++) {
+        a = TEST_Random();
+        /* every second pair with a small operand, so both saturated and exact results occur */
+        b = ((i & 1u) != 0u) ? TEST_Random() : (TEST_Random() >> 16);
+        mismatches += (MATH_addSat_q31(a, b) != MATH_addSat_q31_c(a, b));
+        mismatches += (MATH_subSat_q31(a, b) != MATH_subSat_q31_c(a, b));
+        mismatches += (MATH_saturate_q15(b) != MATH_saturate_q15_c(b));
+        mismatches += (MATH_addSat_q15((int16_t)a, (int16_t)b) != MATH_saturate_q15_c((int32_t)(int16_t)a + (int16_t)b));
+    }
+    TEST_Check(mismatches == 0, "DSP and C results are equal");
+}
+
+
+static void TEST_SquareRoot(void) {
+    uint32_t errors = 0;
+    uint64_t x = 0;
+    uint64_t r = 0;
+    int32_t q31 = 0;
+
+    printf("square root, all Q15 values and %u random Q31 and 64 bit values\n", (unsigned)TEST_NR_OF_RANDOM_VALUES);
+    for (int32_t i = 0; i <= MATH_Q15_MAX; i++) {
+        /* largest r with r^2 <= i * 2^15 */
+        r = (uint64_t)MATH_sqrt_q15((int16_t)i);
+        x = (uint64_t)i << 15;
+        errors += ((r * r > x) || ((r + 1u) * (r + 1u) <= x));
+    }
+    TEST_Check(errors == 0, "Q15 square root is exact");
+    TEST_Check(MATH_sqrt_q15(-5) == 0, "Q15 square root of a negative value");
+
+    errors = 0;
+    for (uint32_t i = 0; i < TEST_NR_OF_RANDOM_VALUES; i++) {
+        q31 = TEST_Random() & MATH_Q31_MAX;
+        r = (uint64_t)MATH_sqrt_q31(q31);
+        x = (uint64_t)q31 << 31;
+        errors += ((r * r > x) || ((r + 1u) * (r + 1u) <= x));
+
+        x = ((uint64_t)(uint32_t)TEST_Random() << 32) | (uint32_t)TEST_Random();
+        x >>= ((uint32_t)TEST_Random() & 63u);
+        r = MATH_sqrt_uint64(x);
+        errors += ((r * r > x) || (((r + 1u) * (r + 1u) <= x) && (r < 0xFFFFFFFFu)));
+    }
+    TEST_Check(errors == 0, "Q31 and 64 bit square root are exact");
+    TEST_Check(MATH_sqrt_q31(MATH_Q31_MAX) == MATH_Q31_MAX, "Q31 square root of max");
+    TEST_Check(MATH_sqrt_uint64(UINT64_MAX) == 0xFFFFFFFFu, "64 bit square root of max");
+}
+
+
+static void TEST_Reciprocal(void) {
+    double maxError = 0.0;
+    double error = 0.0;
+    double expected = 0.0;
+    int32_t x = 0;
+    int32_t mantissa = 0;
+    uint8_t shift = 0;
+
+    printf("reciprocal, %u random values\n", (unsigned)TEST_NR_OF_RANDOM_VALUES);
+    for (uint32_t i = 0; i < TEST_NR_OF_RANDOM_VALUES + 4u; i++) {
+        if (i < 4u) {
+            x = test_edges[i == 0u ? 0u : (i == 1u ? 9u : (i == 2u ? 10u : 18u))];
+            if (x == 0) {
+                continue;
+            }
+        } else {
+            /* all magnitudes, so every normalization shift is used */
+            x = TEST_Random() >> ((uint32_t)TEST_Random() & 31u);
+            if (x == 0) {
+                x = 1;
+            }
+        }
+        mantissa = MATH_reciprocal_q31(x, &shift);
+        expected = 2147483648.0 / (double)x;
+        error = fabs((ldexp((double)mantissa / 2147483648.0, shift) - expected) / expected);
+        if (error > maxError) {
+            maxError = error;
+        }
+    }
+    printf("  largest relative error %.3g\n", maxError);
+    TEST_Check(maxError < TEST_RECIPROCAL_MAX_ERROR, "reciprocal accuracy");
+
+    mantissa = MATH_reciprocal_q31(0, &shift);
+    TEST_Check((mantissa == MATH_Q31_MAX) && (shift == 32u), "reciprocal of 0");
+}
+
+
+/**
+ * @brief   double precision reference of the interpolation
+ *
+ * The table interpolation divides and rounds toward zero, the grid
+ * interpolation shifts and rounds toward minus infinity.
+ */
+static int32_t TEST_Interpolate(const int32_t *xs, const int32_t *ys, uint16_t length, int32_t x, uint8_t roundDown) {
+    double step = 0.0;
+
+    uint16_t i = 0;
+
+    if (x <= xs[0]) {
+        return ys[0];
+    }
+    if (x >= xs[length - 1u]) {
+        return ys[length - 1u];
+    }
+    while (x >= xs[i + 1u]) {
+        i++;
+    }
+    step = ((double)ys[i + 1u] - ys[i]) * (x - xs[i]) / (double)(xs[i + 1u] - xs[i]);
+    return (int32_t)((double)ys[i] + ((roundDown == TRUE) ? floor(step) : trunc(step)));
+}
+
+
+static void TEST_Interpolation(void) {
+    int32_t gridX[6];
+    uint32_t errors = 0;
+
+    printf("table and grid interpolation\n");
+    for (uint16_t i = 0; i < 6u; i++) {
+        gridX[i] = test_grid.x0 + ((int32_t)i << test_grid.stepShift);
+    }
+    for (int32_t x = -5000; x <= 70000; x++) {
+        errors += (MATH_interpolateTable(&test_table, x) != TEST_Interpolate(test_table_x, test_table_y, 6u, x, FALSE));
+    }
+    for (int32_t x = -200; x <= 200; x++) {
+        errors += (MATH_interpolateGrid(&test_grid, x) != TEST_Interpolate(gridX, test_grid_y, 6u, x, TRUE));
+    }
+    TEST_Check(errors == 0, "interpolation equal to the reference");
+    TEST_Check(MATH_interpolateTable(&test_table, INT32_MIN) == test_table_y[0], "table, clamped below");
+    TEST_Check(MATH_interpolateTable(&test_table, INT32_MAX) == test_table_y[5], "table, clamped above");
+    TEST_Check(MATH_interpolateGrid(&test_grid, INT32_MIN) == test_grid_y[0], "grid, clamped below");
+    TEST_Check(MATH_interpolateGrid(&test_grid, INT32_MAX) == test_grid_y[5], "grid, clamped above");
+}
+
+
+int main(void) {
+    TEST_Saturation();
+    TEST_DspAgainstC();
+    TEST_SquareRoot();
+    TEST_Reciprocal();
+    TEST_Interpolation();
+
+    if (test_nrOfFailures > 0) {
+        printf("FAIL: %u checks failed\n", (unsigned)test_nrOfFailures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
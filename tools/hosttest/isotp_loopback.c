@@ -0,0 +1,647 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    isotp_loopback.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup HOSTTEST
+ * @prefix  TEST
+ *
+ * @brief   Host loopback test of the ISO-TP transport and its services
+ *
+ * Runs isotp.c and isotp_cfg.c against a simulated tester on a simulated
+ * CAN bus. Each tick of CANS_TICK_MS delivers the frames of the tester,
+ * calls ISOTP_MainFunction() and hands the frames of the BMS to the tester,
+ * in the order of CANS_MainFunction(). The frames of the BMS are queued in
+ * a buffer of CAN0_TX_BUFFER_LENGTH frames, the frames of the tester in a
+ * buffer of CAN0_RX_BUFFER_LENGTH frames.
+ *
+ * Covered: single frames, segmented requests with the flow control of the
+ * BMS, request overflow, segmented responses with block size, separation
+ * time and wait frames of the tester, the N_Bs timeout, a full transmit
+ * buffer and the range checks of ReadMemoryByAddress. The positive read
+ * maps the SRAM area at its target address and is skipped if the host
+ * does not allow this.
+ *
+ * Usage: isotp_loopback
+ */
+
+/*================== Includes =============================================*/
+#include "isotp.h"
+
+#include "cansignal.h"
+#include "diag.h"
+#include "eepr_cfg.h"
+#include "os.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * frames that can be queued in one direction of the simulated bus
+ */
+#define TEST_MAX_FRAMES                 64
+
+/**
+ * ticks after which a transfer is considered stuck, longer than the ISO-TP timeout
+ */
+#define TEST_MAX_TICKS                  ((3u * ISOTP_TIMEOUT_MS) / CANS_TICK_MS)
+
+/**
+ * SRAM area of isotp_memoryAreas[] that is mapped for the positive read
+ */
+#define TEST_SRAM_START                 0x20000000u
+#define TEST_SRAM_LENGTH                0x30000u
+
+/**
+ * EEPROM channel lengths of the stubbed channel configuration
+ */
+#define TEST_SHORT_CHANNEL_LENGTH       4u
+#define TEST_LONG_CHANNEL_LENGTH        1000u
+
+#define TEST_PCI_SINGLE_FRAME           0x0
+#define TEST_PCI_FIRST_FRAME            0x1
+#define TEST_PCI_CONSECUTIVE_FRAME      0x2
+#define TEST_PCI_FLOW_CONTROL           0x3
+
+#define TEST_FLOW_CONTINUE_TO_SEND      0x0
+#define TEST_FLOW_WAIT                  0x1
+#define TEST_FLOW_OVERFLOW              0x2
+
+/**
+ * frames queued in one direction of the simulated bus
+ */
+typedef struct {
+    uint8_t data[TEST_MAX_FRAMES][8];
+    uint16_t count;
+    uint16_t capacity;              /*!< frames accepted before the buffer is full */
+} TEST_QUEUE_s;
+
+/**
+ * states of the request sent by the tester
+ */
+typedef enum {
+    TEST_REQUEST_SENT       = 0,    /*!< single frame or all consecutive frames sent */
+    TEST_REQUEST_WAIT_FC    = 1,    /*!< waiting for a flow control frame of the BMS */
+    TEST_REQUEST_SEND_CF    = 2,    /*!< consecutive frames due */
+    TEST_REQUEST_REFUSED    = 3,    /*!< flow control overflow received */
+} TEST_REQUEST_STATE_e;
+
+/**
+ * simulated tester
+ */
+typedef struct {
+    /* flow control sent for segmented responses */
+    uint8_t blockSize;              /*!< block size sent to the BMS */
+    uint8_t stmin;                  /*!< separation time parameter sent to the BMS */
+    uint8_t nrOfWaits;              /*!< wait frames sent before each continue to send, one per tick */
+    uint8_t noFlowControl;          /*!< TRUE: first frames of the BMS are not answered */
+    uint8_t flowControlDue;         /*!< TRUE: a flow control frame has to be sent */
+    uint8_t waitsSent;              /*!< wait frames sent for the current block */
+    /* request */
+    const uint8_t *request;
+    uint16_t requestLength;
+    uint16_t requestIndex;
+    uint8_t requestSequence;
+    uint8_t requestBlockCounter;
+    TEST_REQUEST_STATE_e requestState;
+    uint8_t bmsBlockSize;           /*!< block size of the last flow control frame of the BMS */
+    uint16_t nrOfBmsFlowControls;   /*!< flow control frames received from the BMS */
+    /* response */
+    uint8_t response[ISOTP_TX_BUFFER_LENGTH];
+    uint16_t responseLength;
+    uint16_t responseIndex;
+    uint8_t responseSequence;
+    uint8_t responseBlockCounter;
+    uint8_t complete;               /*!< TRUE: response received */
+    uint8_t sequenceError;          /*!< TRUE: consecutive frame with wrong sequence number */
+    uint16_t nrOfConsecutiveFrames;
+    uint32_t lastConsecutiveFrame_ms;
+    uint32_t minSeparation_ms;      /*!< smallest time between two consecutive frames of the BMS */
+} TEST_TESTER_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static uint32_t test_time_ms = 0;
+static TEST_QUEUE_s test_toBms = {.capacity = CAN0_RX_BUFFER_LENGTH};
+static TEST_QUEUE_s test_toTester = {.capacity = CAN0_TX_BUFFER_LENGTH};
+static TEST_TESTER_s test_tester;
+static uint32_t test_nrOfFailures = 0;
+static uint32_t test_nrOfDroppedRequestFrames = 0;
+
+static uint8_t test_shortChannel[TEST_SHORT_CHANNEL_LENGTH] = {0x11, 0x22, 0x33, 0x44};
+static uint8_t test_longChannel[TEST_LONG_CHANNEL_LENGTH];
+
+/* stubs of the data read by the services */
+EEPR_CH_CFG_s eepr_ch_cfg[] = {
+    { .length = TEST_SHORT_CHANNEL_LENGTH, .bkpsramptr = test_shortChannel },
+    { .length = TEST_LONG_CHANNEL_LENGTH, .bkpsramptr = test_longChannel },
+};
+const uint8_t eepr_nr_of_channels = sizeof(eepr_ch_cfg)/sizeof(eepr_ch_cfg[0]);
+DIAG_ERROR_ENTRY_s diag_memory[DIAG_FAIL_ENTRY_LENGTH];
+
+/*================== Function Implementations =============================*/
+
+/* stubs of the modules called by ISO-TP */
+uint32_t OS_getOSSysTick(void) {
+    return test_time_ms;
+}
+
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+
+static STD_RETURN_TYPE_e TEST_Push(TEST_QUEUE_s *queue, const uint8_t *data) {
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+
+    if (queue->count < queue->capacity) {
+        memcpy(queue->data[queue->count], data, 8);
+        queue->count++;
+        retVal = E_OK;
+    }
+    return retVal;
+}
+
+
+STD_RETURN_TYPE_e CANS_AddMessage(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData,
+        uint32_t msgLength, uint32_t RTR) {
+    if ((canNode != CAN_NODE0) || (msgID != CAN_ID_ISOTP_RESPONSE) || (msgLength != 8) || (RTR != 0)) {
+        printf("  FAIL: frame on node %d, ID 0x%03X, length %u\n", (int)canNode, (unsigned)msgID, (unsigned)msgLength);
+        test_nrOfFailures++;
+        return E_NOT_OK;
+    }
+    return TEST_Push(&test_toTester, ptrMsgData);
+}
+
+
+static void TEST_Check(uint8_t condition, const char *description) {
+    if (condition == FALSE) {
+        printf("  FAIL: %s\n", description);
+        test_nrOfFailures++;
+    }
+}
+
+
+/**
+ * @brief   sends a frame of the tester, padded to 8 bytes
+ */
+static void TEST_SendFrame(const uint8_t *data, uint8_t length) {
+    uint8_t frame[8];
+
+    memset(frame, ISOTP_PADDING_BYTE, sizeof(frame));
+    memcpy(frame, data, length);
+    if (TEST_Push(&test_toBms, frame) != E_OK) {
+        test_nrOfDroppedRequestFrames++;
+    }
+}
+
+
+static void TEST_SendFlowControl(uint8_t flowStatus) {
+    uint8_t frame[3] = {(uint8_t)((TEST_PCI_FLOW_CONTROL << 4) | flowStatus), test_tester.blockSize, test_tester.stmin};
+
+    TEST_SendFrame(frame, sizeof(frame));
+}
+
+
+/**
+ * @brief   sends the frames of the tester that are due in this tick
+ */
+static void TEST_TesterStep(void) {
+    uint8_t frame[8];
+    uint16_t nrOfBytes = 0;
+
+    if (test_tester.flowControlDue == TRUE) {
+        if (test_tester.waitsSent < test_tester.nrOfWaits) {
+            TEST_SendFlowControl(TEST_FLOW_WAIT);
+            test_tester.waitsSent++;
+        } else {
+            TEST_SendFlowControl(TEST_FLOW_CONTINUE_TO_SEND);
+            test_tester.flowControlDue = FALSE;
+        }
+    }
+
+    while (test_tester.requestState == TEST_REQUEST_SEND_CF) {
+        nrOfBytes = test_tester.requestLength - test_tester.requestIndex;
+        if (nrOfBytes > 7) {
+            nrOfBytes = 7;
+        }
+        frame[0] = (uint8_t)((TEST_PCI_CONSECUTIVE_FRAME << 4) | test_tester.requestSequence);
+        memcpy(&frame[1], &test_tester.request[test_tester.requestIndex], nrOfBytes);
+        TEST_SendFrame(frame, (uint8_t)(nrOfBytes + 1));
+        test_tester.requestIndex += nrOfBytes;
+        test_tester.requestSequence = (test_tester.requestSequence + 1) & 0x0F;
+        test_tester.requestBlockCounter++;
+        if (test_tester.requestIndex >= test_tester.requestLength) {
+            test_tester.requestState = TEST_REQUEST_SENT;
+        } else if ((test_tester.bmsBlockSize > 0) && (test_tester.requestBlockCounter >= test_tester.bmsBlockSize)) {
+            test_tester.requestState = TEST_REQUEST_WAIT_FC;
+        }
+    }
+}
+
+
+/**
+ * @brief   processes a frame of the BMS in the tester
+ */
+static void TEST_TesterReceive(const uint8_t *frame) {
+    uint16_t nrOfBytes = 0;
+    uint32_t separation_ms = 0;
+
+    switch (frame[0] >> 4) {
+        case TEST_PCI_SINGLE_FRAME:
+            test_tester.responseLength = frame[0] & 0x0F;
+            memcpy(test_tester.response, &frame[1], test_tester.responseLength);
+            test_tester.complete = TRUE;
+            break;
+
+        case TEST_PCI_FIRST_FRAME:
+            test_tester.responseLength = (uint16_t)(((frame[0] & 0x0F) << 8) | frame[1]);
+            memcpy(test_tester.response, &frame[2], 6);
+            test_tester.responseIndex = 6;
+            test_tester.responseSequence = 1;
+            test_tester.responseBlockCounter = 0;
+            if (test_tester.noFlowControl == FALSE) {
+                test_tester.waitsSent = 0;
+                test_tester.flowControlDue = TRUE;
+            }
+            break;
+
+        case TEST_PCI_CONSECUTIVE_FRAME:
+            TEST_Check((test_tester.flowControlDue == FALSE) && (test_tester.noFlowControl == FALSE),
+                    "consecutive frame before the flow control of the tester");
+            if ((frame[0] & 0x0F) != test_tester.responseSequence) {
+                test_tester.sequenceError = TRUE;
+            }
+            if (test_tester.nrOfConsecutiveFrames > 0) {
+                separation_ms = test_time_ms - test_tester.lastConsecutiveFrame_ms;
+                if (separation_ms < test_tester.minSeparation_ms) {
+                    test_tester.minSeparation_ms = separation_ms;
+                }
+            }
+            test_tester.nrOfConsecutiveFrames++;
+            test_tester.lastConsecutiveFrame_ms = test_time_ms;
+            nrOfBytes = test_tester.responseLength - test_tester.responseIndex;
+            if (nrOfBytes > 7) {
+                nrOfBytes = 7;
+            }
+            memcpy(&test_tester.response[test_tester.responseIndex], &frame[1], nrOfBytes);
+            test_tester.responseIndex += nrOfBytes;
+            test_tester.responseSequence = (test_tester.responseSequence + 1) & 0x0F;
+            if (test_tester.responseIndex >= test_tester.responseLength) {
+                test_tester.complete = TRUE;
+            } else if (test_tester.blockSize > 0) {
+                test_tester.responseBlockCounter++;
+                if (test_tester.responseBlockCounter >= test_tester.blockSize) {
+                    test_tester.responseBlockCounter = 0;
+                    test_tester.waitsSent = 0;
+                    test_tester.flowControlDue = TRUE;
+                }
+            }
+            break;
+
+        case TEST_PCI_FLOW_CONTROL:
+            test_tester.nrOfBmsFlowControls++;
+            test_tester.bmsBlockSize = frame[1];
+            if (test_tester.requestState == TEST_REQUEST_WAIT_FC) {
+                if ((frame[0] & 0x0F) == TEST_FLOW_CONTINUE_TO_SEND) {
+                    test_tester.requestBlockCounter = 0;
+                    test_tester.requestState = TEST_REQUEST_SEND_CF;
+                } else if ((frame[0] & 0x0F) == TEST_FLOW_OVERFLOW) {
+                    test_tester.requestState = TEST_REQUEST_REFUSED;
+                }
+            }
+            break;
+
+        default:
+            TEST_Check(FALSE, "frame with invalid protocol control information");
+            break;
+    }
+}
+
+
+/**
+ * @brief   runs one CANS tick: frames of the tester, ISOTP_MainFunction(), frames of the BMS
+ */
+static void TEST_Tick(void) {
+    uint16_t nrOfFrames = 0;
+
+    TEST_TesterStep();
+    for (uint16_t i = 0; i < test_toBms.count; i++) {
+        ISOTP_ReceiveFrame(test_toBms.data[i], 8);
+    }
+    test_toBms.count = 0;
+
+    ISOTP_MainFunction();
+
+    /* frames queued by the tester in reaction go out in the next tick */
+    nrOfFrames = test_toTester.count;
+    test_toTester.count = 0;
+    for (uint16_t i = 0; i < nrOfFrames; i++) {
+        TEST_TesterReceive(test_toTester.data[i]);
+    }
+    test_time_ms += CANS_TICK_MS;
+}
+
+
+/**
+ * @brief   lets running transfers of the BMS time out
+ */
+static void TEST_Idle(void) {
+    uint8_t noFlowControl = test_tester.noFlowControl;
+
+    test_tester.noFlowControl = TRUE;
+    test_tester.flowControlDue = FALSE;
+    for (uint32_t i = 0; i < TEST_MAX_TICKS; i++) {
+        TEST_Tick();
+    }
+    test_tester.noFlowControl = noFlowControl;
+}
+
+
+/**
+ * @brief   sends a request with the flow control parameters set in test_tester and waits for the response
+ *
+ * @return  TRUE if the response was received completely
+ */
+static uint8_t TEST_Request(const uint8_t *request, uint16_t length) {
+    uint8_t frame[8];
+
+    test_tester.request = request;
+    test_tester.requestLength = length;
+    test_tester.nrOfBmsFlowControls = 0;
+    test_tester.complete = FALSE;
+    test_tester.sequenceError = FALSE;
+    test_tester.flowControlDue = FALSE;
+    test_tester.responseLength = 0;
+    test_tester.nrOfConsecutiveFrames = 0;
+    test_tester.minSeparation_ms = UINT32_MAX;
+    test_nrOfDroppedRequestFrames = 0;
+
+    if (length <= 7) {
+        frame[0] = (uint8_t)((TEST_PCI_SINGLE_FRAME << 4) | length);
+        memcpy(&frame[1], request, length);
+        TEST_SendFrame(frame, (uint8_t)(length + 1));
+        test_tester.requestState = TEST_REQUEST_SENT;
+    } else {
+        frame[0] = (uint8_t)((TEST_PCI_FIRST_FRAME << 4) | (length >> 8));
+        frame[1] = (uint8_t)(length & 0xFF);
+        memcpy(&frame[2], request, 6);
+        TEST_SendFrame(frame, 8);
+        test_tester.requestIndex = 6;
+        test_tester.requestSequence = 1;
+        test_tester.requestState = TEST_REQUEST_WAIT_FC;
+    }
+
+    for (uint32_t i = 0; (i < TEST_MAX_TICKS) && (test_tester.complete == FALSE) &&
+            (test_tester.requestState != TEST_REQUEST_REFUSED); i++) {
+        TEST_Tick();
+    }
+    TEST_Check(test_nrOfDroppedRequestFrames == 0, "frames of the tester dropped, receive buffer too small");
+    TEST_Check(test_tester.sequenceError == FALSE, "consecutive frame with wrong sequence number");
+    return test_tester.complete;
+}
+
+
+/**
+ * @brief   checks that the response is a negative response with the given code
+ */
+static void TEST_CheckNegativeResponse(uint8_t serviceId, uint8_t responseCode) {
+    const uint8_t expected[3] = {0x7F, serviceId, responseCode};
+
+    TEST_Check((test_tester.complete == TRUE) && (test_tester.responseLength == 3) &&
+            (memcmp(test_tester.response, expected, 3) == 0), "negative response");
+}
+
+
+static void TEST_SetFlowControl(uint8_t blockSize, uint8_t stmin, uint8_t nrOfWaits) {
+    test_tester.blockSize = blockSize;
+    test_tester.stmin = stmin;
+    test_tester.nrOfWaits = nrOfWaits;
+    test_tester.noFlowControl = FALSE;
+}
+
+
+static void TEST_Begin(const char *name) {
+    printf("%s\n", name);
+}
+
+
+static void TEST_SingleFrame(void) {
+    const uint8_t request[3] = {0x22, 0x01, 0x00};
+    const uint8_t expected[7] = {0x62, 0x01, 0x00, 0x11, 0x22, 0x33, 0x44};
+    const uint8_t unsupported[1] = {0x10};
+
+    TEST_Begin("single frame request and response");
+    TEST_SetFlowControl(0, 0, 0);
+    TEST_Check(TEST_Request(request, sizeof(request)), "response received");
+    TEST_Check((test_tester.responseLength == sizeof(expected)) &&
+            (memcmp(test_tester.response, expected, sizeof(expected)) == 0), "response data");
+    TEST_Check(test_tester.nrOfConsecutiveFrames == 0, "response sent as single frame");
+
+    TEST_Begin("unsupported service");
+    (void)TEST_Request(unsupported, sizeof(unsupported));
+    TEST_CheckNegativeResponse(0x10, ISOTP_NRC_SERVICE_NOT_SUPPORTED);
+}
+
+
+static void TEST_SegmentedRequest(void) {
+    static uint8_t request[ISOTP_RX_BUFFER_LENGTH + 1];
+    const uint16_t length = 100;
+    /* flow control frames after the first frame and after each full block of consecutive frames */
+    const uint16_t nrOfConsecutiveFrames = (length - 6 + 6) / 7;
+    const uint16_t nrOfFlowControls = 1 + (nrOfConsecutiveFrames - 1) / ISOTP_BLOCK_SIZE;
+
+    memset(request, 0x5A, sizeof(request));
+    request[0] = 0x22;
+
+    TEST_Begin("segmented request with the flow control of the BMS");
+    TEST_SetFlowControl(0, 0, 0);
+    (void)TEST_Request(request, length);
+    TEST_CheckNegativeResponse(0x22, ISOTP_NRC_INCORRECT_LENGTH);
+    TEST_Check(test_tester.nrOfBmsFlowControls == nrOfFlowControls, "one flow control frame per block");
+    TEST_Check(test_tester.bmsBlockSize == ISOTP_BLOCK_SIZE, "block size of the BMS");
+
+    TEST_Begin("request longer than the receive buffer");
+    (void)TEST_Request(request, ISOTP_RX_BUFFER_LENGTH + 1);
+    TEST_Check(test_tester.requestState == TEST_REQUEST_REFUSED, "flow control overflow");
+    TEST_Check(test_tester.complete == FALSE, "no response");
+}
+
+
+/**
+ * @brief   reads the long EEPROM channel with the given flow control of the tester
+ */
+static void TEST_ReadLongChannel(uint8_t blockSize, uint8_t stmin, uint8_t nrOfWaits, uint32_t minSeparation_ms) {
+    const uint8_t request[3] = {0x22, 0x01, 0x01};
+    char description[80];
+
+    snprintf(description, sizeof(description), "segmented response, block size %u, STmin 0x%02X, %u wait frames",
+            blockSize, stmin, nrOfWaits);
+    TEST_Begin(description);
+    TEST_SetFlowControl(blockSize, stmin, nrOfWaits);
+    TEST_Check(TEST_Request(request, sizeof(request)), "response received");
+    TEST_Check((test_tester.responseLength == (3 + TEST_LONG_CHANNEL_LENGTH)) &&
+            (test_tester.response[0] == 0x62) && (memcmp(&test_tester.response[1], &request[1], 2) == 0) &&
+            (memcmp(&test_tester.response[3], test_longChannel, TEST_LONG_CHANNEL_LENGTH) == 0), "response data");
+    TEST_Check(test_tester.minSeparation_ms >= minSeparation_ms, "separation time of the tester");
+}
+
+
+static void TEST_SegmentedResponse(void) {
+    TEST_ReadLongChannel(0, 0, 0, 0);
+    TEST_ReadLongChannel(4, 0, 0, 0);
+    TEST_ReadLongChannel(0, 20, 0, 20);
+    TEST_ReadLongChannel(8, 0xF5, 0, 1);
+    TEST_ReadLongChannel(4, 0, 3, 0);
+    TEST_ReadLongChannel(16, 0, ISOTP_MAX_WAIT_FRAMES, 0);
+}
+
+
+static void TEST_Aborts(void) {
+    const uint8_t request[3] = {0x22, 0x01, 0x01};
+    const uint8_t shortRequest[3] = {0x22, 0x01, 0x00};
+
+    TEST_Begin("more wait frames than ISOTP_MAX_WAIT_FRAMES");
+    TEST_SetFlowControl(0, 0, ISOTP_MAX_WAIT_FRAMES + 1);
+    TEST_Check(TEST_Request(request, sizeof(request)) == FALSE, "response aborted");
+    TEST_Check(test_tester.nrOfConsecutiveFrames == 0, "no consecutive frames");
+
+    TEST_Begin("no flow control of the tester");
+    TEST_SetFlowControl(0, 0, 0);
+    test_tester.noFlowControl = TRUE;
+    TEST_Check(TEST_Request(request, sizeof(request)) == FALSE, "response aborted");
+    TEST_SetFlowControl(0, 0, 0);
+    TEST_Check(TEST_Request(shortRequest, sizeof(shortRequest)), "next request processed after the timeout");
+
+    TEST_Begin("full transmit buffer");
+    test_toTester.capacity = 2;
+    TEST_ReadLongChannel(0, 0, 0, 0);
+    test_toTester.capacity = CAN0_TX_BUFFER_LENGTH;
+    TEST_Idle();
+}
+
+
+/**
+ * @brief   sends a ReadMemoryByAddress request
+ */
+static uint8_t TEST_ReadMemory(uint8_t format, uint32_t address, uint16_t size) {
+    static uint8_t request[8];
+
+    request[0] = 0x23;
+    request[1] = format;
+    request[2] = (uint8_t)(address >> 24);
+    request[3] = (uint8_t)(address >> 16);
+    request[4] = (uint8_t)(address >> 8);
+    request[5] = (uint8_t)address;
+    request[6] = (uint8_t)(size >> 8);
+    request[7] = (uint8_t)size;
+    return TEST_Request(request, sizeof(request));
+}
+
+
+static void TEST_ReadMemoryByAddress(void) {
+    const uint32_t address = TEST_SRAM_START + 0x100;
+    const uint16_t size = 600;
+    uint8_t *sram = NULL;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    TEST_SetFlowControl(0, 0, 0);
+
+    TEST_Begin("ReadMemoryByAddress, response longer than the transmit buffer");
+    (void)TEST_ReadMemory(0x24, TEST_SRAM_START, 0xFFFF);
+    TEST_CheckNegativeResponse(0x23, ISOTP_NRC_RESPONSE_TOO_LONG);
+
+    TEST_Begin("ReadMemoryByAddress, invalid requests");
+    (void)TEST_ReadMemory(0x14, TEST_SRAM_START, 0x10);
+    TEST_CheckNegativeResponse(0x23, ISOTP_NRC_INCORRECT_LENGTH);
+    (void)TEST_ReadMemory(0x24, 0x30000000, 0x10);
+    TEST_CheckNegativeResponse(0x23, ISOTP_NRC_REQUEST_OUT_OF_RANGE);
+    (void)TEST_ReadMemory(0x24, TEST_SRAM_START + TEST_SRAM_LENGTH - 0x10, 0x20);
+    TEST_CheckNegativeResponse(0x23, ISOTP_NRC_REQUEST_OUT_OF_RANGE);
+    (void)TEST_ReadMemory(0x24, TEST_SRAM_START, 0);
+    TEST_CheckNegativeResponse(0x23, ISOTP_NRC_REQUEST_OUT_OF_RANGE);
+
+    TEST_Begin("ReadMemoryByAddress, segmented response");
+#ifdef MAP_FIXED_NOREPLACE
+    flags |= MAP_FIXED_NOREPLACE;
+#endif
+    sram = mmap((void *)(uintptr_t)TEST_SRAM_START, TEST_SRAM_LENGTH, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (sram == MAP_FAILED) {
+        printf("  skipped: SRAM area cannot be mapped\n");
+    } else if (sram != (uint8_t *)(uintptr_t)TEST_SRAM_START) {
+        printf("  skipped: SRAM area mapped at %p\n", (void *)sram);
+        munmap(sram, TEST_SRAM_LENGTH);
+    } else {
+        for (uint32_t i = 0; i < TEST_SRAM_LENGTH; i++) {
+            sram[i] = (uint8_t)(i * 7u + (i >> 8));
+        }
+        TEST_Check(TEST_ReadMemory(0x24, address, size), "response received");
+        TEST_Check((test_tester.responseLength == (1 + size)) && (test_tester.response[0] == 0x63) &&
+                (memcmp(&test_tester.response[1], &sram[address - TEST_SRAM_START], size) == 0), "response data");
+        munmap(sram, TEST_SRAM_LENGTH);
+    }
+}
+
+
+int main(void) {
+    for (uint16_t i = 0; i < TEST_LONG_CHANNEL_LENGTH; i++) {
+        test_longChannel[i] = (uint8_t)(i * 13u + 1u);
+    }
+
+    TEST_SingleFrame();
+    TEST_SegmentedRequest();
+    TEST_SegmentedResponse();
+    TEST_Aborts();
+    TEST_ReadMemoryByAddress();
+
+    if (test_nrOfFailures > 0) {
+        printf("FAIL: %u checks failed\n", (unsigned)test_nrOfFailures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
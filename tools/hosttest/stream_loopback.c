@@ -0,0 +1,410 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    stream_loopback.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup HOSTTEST
+ * @prefix  TEST
+ *
+ * @brief   Host loopback test of the cell voltage stream on CAN
+ *
+ * Runs cansignal_stream.c one CANS_TICK_MS tick at a time and decodes the
+ * frames it sends as the decoder in tools/gui/foxbms_interface.py does: a
+ * delta frame is only applied if both absolute frames of the group were
+ * received and the sequence counter did not skip a value. The cell voltages
+ * of the stubbed database change between the periods of the stream.
+ *
+ * Every voltage the decoder updates must be the voltage of the current
+ * period, invalid cells decode as 0 and voltages above 13 bit as 8191 mV. At
+ * the end of each period all cells must be decoded, unless a frame got lost
+ * on the bus, in which case the group must be decoded again within
+ * CANS_STREAM_KEYFRAME_CYCLES periods. A frame the CAN module did not accept
+ * must not desynchronize the decoder. No tick may carry more frames than
+ * CANS_StreamGetMaxFramesPerTick().
+ *
+ * Usage: stream_loopback
+ */
+
+/*================== Includes =============================================*/
+#include "cansignal_stream.h"
+
+#include "batterysystem_cfg.h"
+#include "cansignal.h"
+#include "database.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*================== Macros and Definitions ===============================*/
+#define TEST_CELLS_PER_GROUP            8u
+#define TEST_CELLS_PER_ABSOLUTE         4u
+#define TEST_NR_OF_GROUPS               ((BS_NR_OF_BAT_CELLS + TEST_CELLS_PER_GROUP - 1u) / TEST_CELLS_PER_GROUP)
+#define TEST_PERIOD_TICKS               (CANS_STREAM_PERIOD_MS / CANS_TICK_MS)
+
+/**
+ * largest voltage of the stream, 13 bit
+ */
+#define TEST_VOLTAGE_MAX                0x1FFFu
+
+/**
+ * what happens to the next frame of the stream
+ */
+typedef enum {
+    TEST_FRAME_DELIVER      = 0,    /*!< frame accepted and received */
+    TEST_FRAME_REFUSE       = 1,    /*!< frame not accepted by the CAN module */
+    TEST_FRAME_LOSE         = 2,    /*!< frame accepted, but lost on the bus */
+} TEST_FRAME_FATE_e;
+
+/**
+ * decoder of the stream, as cell_voltage_stream in foxbms_interface.py
+ */
+typedef struct {
+    uint16_t voltages[TEST_NR_OF_GROUPS * TEST_CELLS_PER_GROUP];
+    uint8_t known[TEST_NR_OF_GROUPS];           /*!< TRUE: a frame of the group was received */
+    uint8_t sequence[TEST_NR_OF_GROUPS];
+    uint8_t validLow[TEST_NR_OF_GROUPS];        /*!< TRUE: base of the delta frames known for cells 0 - 3 */
+    uint8_t validHigh[TEST_NR_OF_GROUPS];       /*!< TRUE: base of the delta frames known for cells 4 - 7 */
+} TEST_DECODER_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static uint32_t test_nrOfFailures = 0;
+static uint32_t test_random = 0x12345678u;
+
+static DATA_BLOCK_CELLVOLTAGE_s test_database;
+static TEST_DECODER_s test_decoder;
+static TEST_FRAME_FATE_e test_nextFrame = TEST_FRAME_DELIVER;
+
+static uint32_t test_framesInTick = 0;
+static uint32_t test_nrOfAbsoluteFrames = 0;
+static uint32_t test_nrOfDeltaFrames = 0;
+static uint32_t test_nrOfWrongValues = 0;
+static uint32_t test_nrOfTooManyFrames = 0;
+
+/*================== Function Implementations =============================*/
+
+static void TEST_Check(uint8_t condition, const char *description) {
+    if (condition == FALSE) {
+        printf("  FAIL: %s\n", description);
+        test_nrOfFailures++;
+    }
+}
+
+
+/**
+ * @brief   xorshift32 pseudo random numbers, the same sequence on every run
+ */
+static uint32_t TEST_Random(void) {
+    test_random ^= test_random << 13;
+    test_random ^= test_random >> 17;
+    test_random ^= test_random << 5;
+    return test_random;
+}
+
+
+/**
+ * @brief   voltage of a cell as it has to be decoded in the current period
+ */
+static uint16_t TEST_GetExpectedVoltage(uint16_t cellIdx) {
+    uint16_t voltage = 0;
+
+    if (cellIdx < BS_NR_OF_BAT_CELLS) {
+        uint16_t modIdx = cellIdx / BS_NR_OF_BAT_CELLS_PER_MODULE;
+        if (((test_database.valid_volt[modIdx] >> (cellIdx % BS_NR_OF_BAT_CELLS_PER_MODULE)) & 0x01u) == 0u) {
+            voltage = test_database.voltage[cellIdx];
+            if (voltage > TEST_VOLTAGE_MAX) {
+                voltage = TEST_VOLTAGE_MAX;
+            }
+        }
+    }
+    return voltage;
+}
+
+
+/**
+ * @brief   stores a decoded voltage and compares it with the voltage sent
+ */
+static void TEST_SetDecodedVoltage(uint16_t cellIdx, uint16_t voltage) {
+    test_decoder.voltages[cellIdx] = voltage;
+    if (voltage != TEST_GetExpectedVoltage(cellIdx)) {
+        if (test_nrOfWrongValues < 10u) {
+            printf("  cell %u decoded as %u mV instead of %u mV\n", (unsigned)cellIdx, (unsigned)voltage,
+                    (unsigned)TEST_GetExpectedVoltage(cellIdx));
+        }
+        test_nrOfWrongValues++;
+    }
+}
+
+
+/**
+ * @brief   decodes one frame of the stream
+ */
+static void TEST_Decode(const uint8_t *data) {
+    uint64_t frame = 0;
+
+    for (uint8_t i = 0; i < 8u; i++) {
+        frame |= ((uint64_t)data[i]) << (8u * i);
+    }
+    uint8_t group = (uint8_t)(frame & 0x3Fu);
+    uint8_t type = (uint8_t)((frame >> 6) & 0x03u);
+    uint8_t sequence = (uint8_t)((frame >> 8) & 0x0Fu);
+    uint64_t payload = frame >> 12;
+    uint16_t first = group * TEST_CELLS_PER_GROUP;
+
+    if (group >= TEST_NR_OF_GROUPS) {
+        TEST_Check(FALSE, "group index in range");
+        return;
+    }
+    if ((test_decoder.known[group] == TRUE) && (((test_decoder.sequence[group] + 1u) & 0x0Fu) != sequence)) {
+        /* frames were lost, the base of the delta frames is unknown */
+        test_decoder.validLow[group] = FALSE;
+        test_decoder.validHigh[group] = FALSE;
+    }
+    test_decoder.known[group] = TRUE;
+    test_decoder.sequence[group] = sequence;
+
+    if ((type == CANS_STREAM_ABSOLUTE_LOW) || (type == CANS_STREAM_ABSOLUTE_HIGH)) {
+        uint16_t offset = TEST_CELLS_PER_ABSOLUTE * type;
+        for (uint8_t i = 0; i < TEST_CELLS_PER_ABSOLUTE; i++) {
+            TEST_SetDecodedVoltage(first + offset + i, (uint16_t)((payload >> (13u * i)) & TEST_VOLTAGE_MAX));
+        }
+        if (type == CANS_STREAM_ABSOLUTE_LOW) {
+            test_decoder.validLow[group] = TRUE;
+        } else {
+            test_decoder.validHigh[group] = TRUE;
+        }
+        test_nrOfAbsoluteFrames++;
+    } else if (type == CANS_STREAM_DELTA) {
+        if ((test_decoder.validLow[group] == TRUE) && (test_decoder.validHigh[group] == TRUE)) {
+            for (uint8_t i = 0; i < TEST_CELLS_PER_GROUP; i++) {
+                int32_t delta = (int32_t)((payload >> (6u * i)) & 0x3Fu);
+                if (delta >= 32) {
+                    delta -= 64;
+                }
+                TEST_SetDecodedVoltage(first + i, (uint16_t)(test_decoder.voltages[first + i] + delta));
+            }
+        }
+        test_nrOfDeltaFrames++;
+    } else {
+        TEST_Check(FALSE, "frame type defined");
+    }
+}
+
+
+/* stubs of the modules called by the stream */
+STD_RETURN_TYPE_e DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e blockID) {
+    if (blockID == DATA_BLOCK_ID_CELLVOLTAGE) {
+        memcpy(dataptrtoReceiver, &test_database, sizeof(test_database));
+    }
+    return E_OK;
+}
+
+
+STD_RETURN_TYPE_e CANS_AddMessage(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData,
+        uint32_t msgLength, uint32_t RTR) {
+    TEST_FRAME_FATE_e fate = test_nextFrame;
+
+    if ((canNode != CAN_NODE0) || (msgID != CAN_ID_CELLVOLTAGE_STREAM) || (msgLength != 8) || (RTR != 0)) {
+        printf("  FAIL: frame on node %d, ID 0x%03X, length %u\n", (int)canNode, (unsigned)msgID, (unsigned)msgLength);
+        test_nrOfFailures++;
+        return E_NOT_OK;
+    }
+    test_nextFrame = TEST_FRAME_DELIVER;
+    if (fate == TEST_FRAME_REFUSE) {
+        return E_NOT_OK;
+    }
+    test_framesInTick++;
+    if (fate == TEST_FRAME_DELIVER) {
+        TEST_Decode(ptrMsgData);
+    }
+    return E_OK;
+}
+
+
+/**
+ * @brief   runs one period of the stream and counts the cells decoded wrong at its end
+ *
+ * @return  number of cells whose decoded voltage differs from the database
+ */
+static uint32_t TEST_RunPeriod(void) {
+    uint32_t nrOfDifferences = 0;
+
+    for (uint32_t tick = 0; tick < TEST_PERIOD_TICKS; tick++) {
+        test_framesInTick = 0;
+        CANS_StreamCellVoltages();
+        if (test_framesInTick > CANS_StreamGetMaxFramesPerTick()) {
+            test_nrOfTooManyFrames++;
+        }
+    }
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        if (test_decoder.voltages[i] != TEST_GetExpectedVoltage(i)) {
+            nrOfDifferences++;
+        }
+    }
+    return nrOfDifferences;
+}
+
+
+/**
+ * @brief   changes every cell voltage by a random step of at most +-maxStep mV
+ */
+static void TEST_Walk(uint16_t maxStep) {
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        int32_t voltage = (int32_t)test_database.voltage[i] +
+                (int32_t)(TEST_Random() % (2u * maxStep + 1u)) - (int32_t)maxStep;
+        if (voltage < 2000) {
+            voltage = 2000;
+        }
+        test_database.voltage[i] = (uint16_t)voltage;
+    }
+}
+
+
+static void TEST_SmallChanges(void) {
+    uint32_t nrOfDifferences = 0;
+
+    printf("small changes of the voltages\n");
+    for (uint16_t i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        test_database.voltage[i] = 3600u + (TEST_Random() % 200u);
+    }
+    nrOfDifferences += TEST_RunPeriod();
+    test_nrOfAbsoluteFrames = 0;
+    test_nrOfDeltaFrames = 0;
+    for (uint32_t period = 0; period < 10u * CANS_STREAM_KEYFRAME_CYCLES; period++) {
+        TEST_Walk(31);
+        nrOfDifferences += TEST_RunPeriod();
+    }
+    printf("  %u delta frames, %u absolute frames\n", (unsigned)test_nrOfDeltaFrames, (unsigned)test_nrOfAbsoluteFrames);
+    TEST_Check(nrOfDifferences == 0u, "all cells decoded at the end of each period");
+    TEST_Check(test_nrOfDeltaFrames == (10u * CANS_STREAM_KEYFRAME_CYCLES * TEST_NR_OF_GROUPS) - (test_nrOfAbsoluteFrames / 2u),
+            "one frame per group and period");
+    TEST_Check(test_nrOfAbsoluteFrames == 2u * 10u * TEST_NR_OF_GROUPS, "absolute frames once per keyframe cycle");
+}
+
+
+static void TEST_LargeChanges(void) {
+    uint32_t nrOfDifferences = 0;
+
+    printf("large changes, invalid cells and voltages above 13 bit\n");
+    test_nrOfAbsoluteFrames = 0;
+    test_nrOfDeltaFrames = 0;
+    test_database.voltage[0] += 32u;
+    nrOfDifferences += TEST_RunPeriod();
+    test_database.voltage[BS_NR_OF_BAT_CELLS - 1u] -= 33u;
+    nrOfDifferences += TEST_RunPeriod();
+    TEST_Check(test_nrOfAbsoluteFrames >= 4u, "changes beyond 6 bit sent as absolute frames");
+
+    test_database.valid_volt[0] |= 0x08u;
+    test_database.voltage[BS_NR_OF_BAT_CELLS_PER_MODULE + 1u] = 9000u;
+    nrOfDifferences += TEST_RunPeriod();
+    TEST_Check(test_decoder.voltages[3] == 0u, "invalid cell decoded as 0");
+    TEST_Check(test_decoder.voltages[BS_NR_OF_BAT_CELLS_PER_MODULE + 1u] == TEST_VOLTAGE_MAX, "voltage limited to 13 bit");
+
+    test_database.valid_volt[0] &= ~0x08u;
+    test_database.voltage[BS_NR_OF_BAT_CELLS_PER_MODULE + 1u] = 3700u;
+    nrOfDifferences += TEST_RunPeriod();
+    for (uint32_t period = 0; period < CANS_STREAM_KEYFRAME_CYCLES; period++) {
+        TEST_Walk(400);
+        nrOfDifferences += TEST_RunPeriod();
+    }
+    TEST_Check(nrOfDifferences == 0u, "all cells decoded at the end of each period");
+}
+
+
+static void TEST_RefusedFrames(void) {
+    uint32_t nrOfDifferences = 0;
+
+    printf("frames not accepted by the CAN module\n");
+    for (uint32_t period = 0; period < 3u * CANS_STREAM_KEYFRAME_CYCLES; period++) {
+        TEST_Walk(20);
+        /* the first frame of the period is refused, its group is sent again
+         * in the next period */
+        test_nextFrame = TEST_FRAME_REFUSE;
+        (void)TEST_RunPeriod();
+        TEST_Walk(20);
+        nrOfDifferences += TEST_RunPeriod();
+    }
+    TEST_Check(nrOfDifferences == 0u, "all cells decoded after the next period");
+}
+
+
+static void TEST_LostFrames(void) {
+    uint32_t nrOfDifferences = 0;
+
+    printf("frames lost on the bus\n");
+    for (uint32_t i = 0; i < 3u * TEST_NR_OF_GROUPS; i++) {
+        /* lose the first frame sent from this slot on, a different group each time */
+        uint32_t slot = (i % TEST_NR_OF_GROUPS) % TEST_PERIOD_TICKS;
+        for (uint32_t tick = 0; tick < TEST_PERIOD_TICKS; tick++) {
+            if (tick == slot) {
+                test_nextFrame = TEST_FRAME_LOSE;
+            }
+            CANS_StreamCellVoltages();
+        }
+        test_nextFrame = TEST_FRAME_DELIVER;
+        for (uint32_t period = 0; period < CANS_STREAM_KEYFRAME_CYCLES; period++) {
+            TEST_Walk(20);
+            (void)TEST_RunPeriod();
+        }
+        TEST_Walk(20);
+        nrOfDifferences += TEST_RunPeriod();
+    }
+    TEST_Check(nrOfDifferences == 0u, "all cells decoded within CANS_STREAM_KEYFRAME_CYCLES periods");
+}
+
+
+int main(void) {
+    TEST_SmallChanges();
+    TEST_LargeChanges();
+    TEST_RefusedFrames();
+    TEST_LostFrames();
+
+    TEST_Check(test_nrOfWrongValues == 0u, "every decoded voltage sent in the same period");
+    TEST_Check(test_nrOfTooManyFrames == 0u, "frames per tick within CANS_StreamGetMaxFramesPerTick()");
+
+    if (test_nrOfFailures > 0) {
+        printf("FAIL: %u checks failed\n", (unsigned)test_nrOfFailures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
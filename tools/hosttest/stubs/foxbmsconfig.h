@@ -0,0 +1,7 @@
+/* generated by waf for the target build, fixed values for the host build */
+#ifndef FOXBMSCONFIG_H_
+#define FOXBMSCONFIG_H_
+#define BUILD_APPNAME_PREFIX "foxbms"
+#define BUILD_VERSION_PRIMARY "1.0"
+#define BUILD_VERSION_SECONDARY "1.0"
+#endif /* FOXBMSCONFIG_H_ */
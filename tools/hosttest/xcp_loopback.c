@@ -0,0 +1,425 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2021, Fraunhofer-Gesellschaft zur Foerderung der
+ *  angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer
+ * to foxBMS in your hardware, software, documentation or advertising
+ * materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    xcp_loopback.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup HOSTTEST
+ * @prefix  TEST
+ *
+ * @brief   Host loopback test of the XCP on CAN slave
+ *
+ * Sends the commands of a master to XCP_ReceiveFrame() and checks the
+ * responses and the DAQ frames sent by XCP_Event(). The test includes
+ * xcp.c with XCP_CALIBRATION_ENABLE set to TRUE, so DOWNLOAD is tested
+ * whatever the configuration of the firmware. The memory areas and the
+ * calibration section are variables of the test. As XCP addresses have
+ * 32 bit, the test is linked without position independent code.
+ *
+ * Covered: commands before CONNECT, SHORT_UPLOAD and UPLOAD inside and
+ * outside the memory areas, DOWNLOAD inside and across the end of the
+ * calibration section and with closed contactors, the allocation sequence
+ * of the dynamic DAQ lists, ODTs that do not fit in a frame, the limit of
+ * XCP_MAX_FRAMES_PER_EVENT frames per event, prescalers, START_STOP_SYNCH,
+ * configuration changes of running lists and DISCONNECT.
+ *
+ * Usage: xcp_loopback
+ */
+
+/*================== Includes =============================================*/
+#include "xcp_cfg.h"
+
+/* DOWNLOAD is tested, whatever the configuration of the firmware */
+#undef XCP_CALIBRATION_ENABLE
+#define XCP_CALIBRATION_ENABLE TRUE
+
+/**
+ * length of the calibration section
+ */
+#define TEST_CAL_LENGTH                 16u
+
+/* memory areas of the test instead of xcp_cfg.c, the addresses are only known at run time */
+static XCP_MEMORY_AREA_s test_readAreas[1];
+static const uint8_t test_nrOfReadAreas = 1;
+#define xcp_readAreas           test_readAreas
+#define xcp_nr_of_readAreas     test_nrOfReadAreas
+#define _e_xcp_cal              (&_s_xcp_cal[TEST_CAL_LENGTH])
+
+#include "xcp.c"
+
+#include <stdio.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * frames that can be recorded per command or event
+ */
+#define TEST_MAX_FRAMES                 64u
+
+/**
+ * frame sent by the slave
+ */
+typedef struct {
+    uint8_t data[8];
+    uint8_t length;
+} TEST_FRAME_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static uint32_t test_nrOfFailures = 0;
+
+/* measured variables, the only memory of the read area */
+static uint8_t test_memory[32];
+
+/* calibration section */
+uint8_t _s_xcp_cal[TEST_CAL_LENGTH];
+
+static TEST_FRAME_s test_frames[TEST_MAX_FRAMES];
+static uint8_t test_nrOfFrames = 0;
+static uint8_t test_calibrationAllowed = TRUE;
+
+const XCP_EVENT_CHANNEL_s xcp_eventChannels[XCP_EVENT_MAX] = {
+        { "APPL_1ms",   1 },
+        { "APPL_10ms",  10 },
+        { "APPL_100ms", 100 },
+};
+
+/*================== Function Implementations =============================*/
+
+/* stubs of the modules called by XCP */
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+uint8_t XCP_IsCalibrationAllowed(void) {
+    return test_calibrationAllowed;
+}
+
+STD_RETURN_TYPE_e CANS_AddMessage(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData,
+        uint32_t msgLength, uint32_t RTR) {
+    if ((canNode != CAN_NODE0) || (msgID != CAN_ID_XCP_RESPONSE) || (msgLength == 0) || (msgLength > 8) ||
+            (RTR != 0) || (test_nrOfFrames >= TEST_MAX_FRAMES)) {
+        printf("  FAIL: frame on node %d, ID 0x%03X, length %u\n", (int)canNode, (unsigned)msgID, (unsigned)msgLength);
+        test_nrOfFailures++;
+        return E_NOT_OK;
+    }
+    memcpy(test_frames[test_nrOfFrames].data, ptrMsgData, msgLength);
+    test_frames[test_nrOfFrames].length = (uint8_t)msgLength;
+    test_nrOfFrames++;
+    return E_OK;
+}
+
+
+static void TEST_Check(uint8_t condition, const char *description) {
+    if (condition == FALSE) {
+        printf("  FAIL: %s\n", description);
+        test_nrOfFailures++;
+    }
+}
+
+
+static uint32_t TEST_Address(const void *address) {
+    return (uint32_t)(uintptr_t)address;
+}
+
+
+/**
+ * @brief   sends a command of the master, padded to 8 bytes
+ *
+ * @return  the response, NULL_PTR if the slave did not send exactly one frame
+ */
+static const TEST_FRAME_s *TEST_Command(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint32_t value) {
+    uint8_t command[8] = {b0, b1, b2, b3,
+            (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+
+    test_nrOfFrames = 0;
+    XCP_ReceiveFrame(command, 8);
+    return (test_nrOfFrames == 1u) ? &test_frames[0] : NULL_PTR;
+}
+
+
+/**
+ * @brief   sends a command and checks for a positive response
+ */
+static const TEST_FRAME_s *TEST_Positive(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint32_t value,
+        const char *description) {
+    const TEST_FRAME_s *response = TEST_Command(b0, b1, b2, b3, value);
+
+    TEST_Check((response != NULL_PTR) && (response->data[0] == XCP_PID_RES), description);
+    return response;
+}
+
+
+/**
+ * @brief   sends a command and checks for a negative response with an error code
+ */
+static void TEST_Negative(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint32_t value, uint8_t errorCode,
+        const char *description) {
+    const TEST_FRAME_s *response = TEST_Command(b0, b1, b2, b3, value);
+
+    if ((response == NULL_PTR) || (response->data[0] != XCP_PID_ERR) || (response->data[1] != errorCode)) {
+        printf("  expected error 0x%02X, got %s 0x%02X\n", errorCode,
+                (response == NULL_PTR) ? "no response" : "response",
+                (response == NULL_PTR) ? 0u : (unsigned)response->data[1]);
+        TEST_Check(FALSE, description);
+    }
+}
+
+
+/**
+ * @brief   calls XCP_Event() and returns the number of frames sent
+ */
+static uint8_t TEST_Event(XCP_EVENT_CHANNEL_e channel) {
+    test_nrOfFrames = 0;
+    XCP_Event(channel);
+    return test_nrOfFrames;
+}
+
+
+/**
+ * @brief   allocates DAQ lists with one ODT entry per ODT
+ *
+ * @param   nrOfOdts    ODTs of each list, nrOfLists entries
+ * @param   entrySize   size of the ODT entries in bytes
+ */
+static void TEST_AllocateDaq(const uint8_t *nrOfOdts, uint8_t nrOfLists, uint8_t entrySize) {
+    TEST_Positive(XCP_CMD_FREE_DAQ, 0, 0, 0, 0, "FREE_DAQ");
+    TEST_Positive(XCP_CMD_ALLOC_DAQ, 0, nrOfLists, 0, 0, "ALLOC_DAQ");
+    for (uint8_t list = 0; list < nrOfLists; list++) {
+        TEST_Positive(XCP_CMD_ALLOC_ODT, 0, list, 0, nrOfOdts[list], "ALLOC_ODT");
+    }
+    for (uint8_t list = 0; list < nrOfLists; list++) {
+        for (uint8_t odt = 0; odt < nrOfOdts[list]; odt++) {
+            TEST_Positive(XCP_CMD_ALLOC_ODT_ENTRY, 0, list, 0, odt | (1u << 8), "ALLOC_ODT_ENTRY");
+            TEST_Positive(XCP_CMD_SET_DAQ_PTR, 0, list, 0, odt, "SET_DAQ_PTR");
+            TEST_Positive(XCP_CMD_WRITE_DAQ, 0xFF, entrySize, 0, TEST_Address(&test_memory[odt]), "WRITE_DAQ");
+        }
+    }
+}
+
+
+static void TEST_Connect(void) {
+    const TEST_FRAME_s *response = NULL_PTR;
+
+    printf("CONNECT, GET_STATUS and DISCONNECT\n");
+    TEST_Check(TEST_Command(XCP_CMD_GET_STATUS, 0, 0, 0, 0) == NULL_PTR, "commands ignored before CONNECT");
+    response = TEST_Positive(XCP_CMD_CONNECT, 0, 0, 0, 0, "CONNECT");
+    TEST_Check((response != NULL_PTR) && (response->length == 8u) && (response->data[1] == 0x05u) &&
+            (response->data[3] == XCP_MAX_CTO) && (response->data[4] == XCP_MAX_DTO), "CONNECT resources and sizes");
+    response = TEST_Positive(XCP_CMD_GET_STATUS, 0, 0, 0, 0, "GET_STATUS");
+    TEST_Check((response != NULL_PTR) && (response->data[1] == 0u), "no DAQ list running");
+    TEST_Negative(XCP_CMD_SYNCH, 0, 0, 0, 0, XCP_ERR_CMD_SYNCH, "SYNCH");
+    TEST_Negative(0xC0, 0, 0, 0, 0, XCP_ERR_CMD_UNKNOWN, "unknown command");
+    TEST_Positive(XCP_CMD_DISCONNECT, 0, 0, 0, 0, "DISCONNECT");
+    TEST_Check(TEST_Command(XCP_CMD_GET_STATUS, 0, 0, 0, 0) == NULL_PTR, "commands ignored after DISCONNECT");
+    TEST_Positive(XCP_CMD_CONNECT, 0, 0, 0, 0, "CONNECT");
+}
+
+
+static void TEST_Upload(void) {
+    const TEST_FRAME_s *response = NULL_PTR;
+
+    printf("SHORT_UPLOAD and UPLOAD\n");
+    for (uint8_t i = 0; i < sizeof(test_memory); i++) {
+        test_memory[i] = (uint8_t)(0xA0u + i);
+    }
+    response = TEST_Positive(XCP_CMD_SHORT_UPLOAD, 7, 0, 0, TEST_Address(&test_memory[25]), "SHORT_UPLOAD");
+    TEST_Check((response != NULL_PTR) && (response->length == 8u) && (memcmp(&response->data[1], &test_memory[25], 7) == 0),
+            "SHORT_UPLOAD data");
+    TEST_Negative(XCP_CMD_SHORT_UPLOAD, 7, 0, 0, TEST_Address(&test_memory[26]), XCP_ERR_ACCESS_DENIED,
+            "SHORT_UPLOAD across the end of the area");
+    TEST_Negative(XCP_CMD_SHORT_UPLOAD, 1, 0, 0, TEST_Address(&_s_xcp_cal[0]), XCP_ERR_ACCESS_DENIED,
+            "SHORT_UPLOAD outside the areas");
+    TEST_Negative(XCP_CMD_SHORT_UPLOAD, 0, 0, 0, TEST_Address(&test_memory[0]), XCP_ERR_OUT_OF_RANGE,
+            "SHORT_UPLOAD of 0 bytes");
+    TEST_Negative(XCP_CMD_SHORT_UPLOAD, 8, 0, 0, TEST_Address(&test_memory[0]), XCP_ERR_OUT_OF_RANGE,
+            "SHORT_UPLOAD longer than a frame");
+    TEST_Negative(XCP_CMD_SHORT_UPLOAD, 1, 0, 1, TEST_Address(&test_memory[0]), XCP_ERR_OUT_OF_RANGE,
+            "SHORT_UPLOAD with address extension");
+
+    TEST_Positive(XCP_CMD_SET_MTA, 0, 0, 0, TEST_Address(&test_memory[3]), "SET_MTA");
+    response = TEST_Positive(XCP_CMD_UPLOAD, 4, 0, 0, 0, "UPLOAD");
+    TEST_Check((response != NULL_PTR) && (response->length == 5u) && (memcmp(&response->data[1], &test_memory[3], 4) == 0),
+            "UPLOAD data");
+    response = TEST_Positive(XCP_CMD_UPLOAD, 2, 0, 0, 0, "UPLOAD");
+    TEST_Check((response != NULL_PTR) && (memcmp(&response->data[1], &test_memory[7], 2) == 0), "UPLOAD increments MTA");
+}
+
+
+static void TEST_Download(void) {
+    uint8_t calibration[TEST_CAL_LENGTH] = {0};
+
+    printf("DOWNLOAD\n");
+    TEST_Positive(XCP_CMD_SET_MTA, 0, 0, 0, TEST_Address(&_s_xcp_cal[4]), "SET_MTA");
+    TEST_Positive(XCP_CMD_DOWNLOAD, 4, 0x11, 0x22, 0x66554433u, "DOWNLOAD");
+    TEST_Positive(XCP_CMD_DOWNLOAD, 2, 0x77, 0x88, 0, "DOWNLOAD");
+    calibration[4] = 0x11u;
+    calibration[5] = 0x22u;
+    calibration[6] = 0x33u;
+    calibration[7] = 0x44u;
+    calibration[8] = 0x77u;
+    calibration[9] = 0x88u;
+    TEST_Check(memcmp(_s_xcp_cal, calibration, TEST_CAL_LENGTH) == 0, "DOWNLOAD data, MTA incremented");
+
+    TEST_Positive(XCP_CMD_SET_MTA, 0, 0, 0, TEST_Address(&_s_xcp_cal[TEST_CAL_LENGTH - 3u]), "SET_MTA");
+    TEST_Negative(XCP_CMD_DOWNLOAD, 4, 1, 2, 0x0403u, XCP_ERR_ACCESS_DENIED, "DOWNLOAD across the end of the section");
+    TEST_Positive(XCP_CMD_SET_MTA, 0, 0, 0, TEST_Address(&test_memory[0]), "SET_MTA");
+    TEST_Negative(XCP_CMD_DOWNLOAD, 1, 1, 0, 0, XCP_ERR_ACCESS_DENIED, "DOWNLOAD outside the section");
+    TEST_Positive(XCP_CMD_SET_MTA, 0, 0, 0, TEST_Address(&_s_xcp_cal[0]), "SET_MTA");
+    TEST_Negative(XCP_CMD_DOWNLOAD, 7, 1, 2, 0, XCP_ERR_CMD_SYNTAX, "DOWNLOAD longer than a frame");
+    test_calibrationAllowed = FALSE;
+    TEST_Negative(XCP_CMD_DOWNLOAD, 1, 1, 0, 0, XCP_ERR_RES_TEMP_NOT_ACCESS, "DOWNLOAD with closed contactors");
+    test_calibrationAllowed = TRUE;
+    TEST_Check((memcmp(_s_xcp_cal, calibration, TEST_CAL_LENGTH) == 0) && (test_memory[0] == 0xA0u),
+            "memory unchanged by refused DOWNLOAD");
+}
+
+
+static void TEST_Daq(void) {
+    const uint8_t nrOfOdts[2] = {2, 1};
+    const TEST_FRAME_s *response = NULL_PTR;
+
+    printf("DAQ lists\n");
+    TEST_Positive(XCP_CMD_FREE_DAQ, 0, 0, 0, 0, "FREE_DAQ");
+    TEST_Negative(XCP_CMD_ALLOC_ODT, 0, 0, 0, 1, XCP_ERR_SEQUENCE, "ALLOC_ODT before ALLOC_DAQ");
+    TEST_Negative(XCP_CMD_ALLOC_DAQ, 0, XCP_MAX_DAQ_LISTS + 1u, 0, 0, XCP_ERR_MEMORY_OVERFLOW, "too many DAQ lists");
+
+    TEST_AllocateDaq(nrOfOdts, 2, 4);
+    TEST_Negative(XCP_CMD_WRITE_DAQ, 0xFF, 4, 0, TEST_Address(&test_memory[0]), XCP_ERR_SEQUENCE,
+            "WRITE_DAQ behind the ODT");
+    TEST_Positive(XCP_CMD_SET_DAQ_PTR, 0, 0, 0, 0, "SET_DAQ_PTR");
+    TEST_Negative(XCP_CMD_WRITE_DAQ, 0xFF, 4, 0, TEST_Address(&_s_xcp_cal[0]), XCP_ERR_ACCESS_DENIED,
+            "WRITE_DAQ outside the areas");
+    TEST_Positive(XCP_CMD_WRITE_DAQ, 0xFF, 4, 0, TEST_Address(&test_memory[0]), "WRITE_DAQ");
+    TEST_Positive(XCP_CMD_SET_DAQ_LIST_MODE, 0, 0, 0, XCP_EVENT_10MS | (1u << 16), "SET_DAQ_LIST_MODE");
+    TEST_Positive(XCP_CMD_SET_DAQ_LIST_MODE, 0, 1, 0, XCP_EVENT_100MS | (2u << 16), "SET_DAQ_LIST_MODE");
+
+    TEST_Check(TEST_Event(XCP_EVENT_10MS) == 0u, "no frames before START");
+    TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 2, 0, 0, 0, "select DAQ list 0");
+    response = TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 2, 1, 0, 0, "select DAQ list 1");
+    TEST_Check((response != NULL_PTR) && (response->data[1] == 2u), "first PID of DAQ list 1");
+    TEST_Check(TEST_Event(XCP_EVENT_10MS) == 0u, "no frames before START_STOP_SYNCH");
+    TEST_Positive(XCP_CMD_START_STOP_SYNCH, 1, 0, 0, 0, "START_STOP_SYNCH start");
+    response = TEST_Positive(XCP_CMD_GET_STATUS, 0, 0, 0, 0, "GET_STATUS");
+    TEST_Check((response != NULL_PTR) && (response->data[1] == XCP_SESSION_DAQ_RUNNING), "DAQ running");
+
+    test_memory[1] = 0x5Au;
+    TEST_Check(TEST_Event(XCP_EVENT_10MS) == 2u, "one frame per ODT of DAQ list 0");
+    TEST_Check((test_frames[0].length == 5u) && (test_frames[0].data[0] == 0u) &&
+            (memcmp(&test_frames[0].data[1], &test_memory[0], 4) == 0) &&
+            (test_frames[1].data[0] == 1u) && (memcmp(&test_frames[1].data[1], &test_memory[1], 4) == 0),
+            "PID and sampled data");
+    TEST_Check(TEST_Event(XCP_EVENT_1MS) == 0u, "no frames of other event channels");
+    TEST_Check(TEST_Event(XCP_EVENT_100MS) == 0u, "prescaler 2, first event");
+    TEST_Check((TEST_Event(XCP_EVENT_100MS) == 1u) && (test_frames[0].data[0] == 2u), "prescaler 2, second event");
+
+    TEST_Negative(XCP_CMD_SET_DAQ_LIST_MODE, 0, 0, 0, XCP_EVENT_1MS | (1u << 16), XCP_ERR_DAQ_ACTIVE,
+            "SET_DAQ_LIST_MODE of running lists");
+    TEST_Negative(XCP_CMD_WRITE_DAQ, 0xFF, 4, 0, TEST_Address(&test_memory[0]), XCP_ERR_DAQ_ACTIVE,
+            "WRITE_DAQ of running lists");
+    TEST_Negative(XCP_CMD_ALLOC_DAQ, 0, 1, 0, 0, XCP_ERR_DAQ_ACTIVE, "ALLOC_DAQ of running lists");
+
+    TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 0, 0, 0, 0, "stop DAQ list 0");
+    TEST_Check(TEST_Event(XCP_EVENT_10MS) == 0u, "stopped list not sampled");
+    TEST_Positive(XCP_CMD_DISCONNECT, 0, 0, 0, 0, "DISCONNECT");
+    TEST_Check((TEST_Event(XCP_EVENT_100MS) == 0u) && (TEST_Event(XCP_EVENT_100MS) == 0u), "DISCONNECT stops DAQ");
+    TEST_Positive(XCP_CMD_CONNECT, 0, 0, 0, 0, "CONNECT");
+
+    /* an ODT entry that does not fit in the frame with the entries before */
+    TEST_Positive(XCP_CMD_FREE_DAQ, 0, 0, 0, 0, "FREE_DAQ");
+    TEST_Positive(XCP_CMD_ALLOC_DAQ, 0, 1, 0, 0, "ALLOC_DAQ");
+    TEST_Positive(XCP_CMD_ALLOC_ODT, 0, 0, 0, 1, "ALLOC_ODT");
+    TEST_Positive(XCP_CMD_ALLOC_ODT_ENTRY, 0, 0, 0, 2u << 8, "ALLOC_ODT_ENTRY");
+    TEST_Positive(XCP_CMD_SET_DAQ_PTR, 0, 0, 0, 0, "SET_DAQ_PTR");
+    TEST_Positive(XCP_CMD_WRITE_DAQ, 0xFF, 4, 0, TEST_Address(&test_memory[0]), "WRITE_DAQ");
+    TEST_Positive(XCP_CMD_WRITE_DAQ, 0xFF, 4, 0, TEST_Address(&test_memory[4]), "WRITE_DAQ");
+    TEST_Negative(XCP_CMD_START_STOP_DAQ_LIST, 1, 0, 0, 0, XCP_ERR_DAQ_CONFIG, "ODT longer than a frame");
+}
+
+
+static void TEST_EventLoad(void) {
+    const uint8_t nrOfOdts[3] = {XCP_MAX_FRAMES_PER_EVENT + 1u, XCP_MAX_FRAMES_PER_EVENT - 1u, 2};
+    uint8_t maxFrames = 0;
+
+    printf("frames per event\n");
+    TEST_AllocateDaq(nrOfOdts, 3, 1);
+    TEST_Negative(XCP_CMD_START_STOP_DAQ_LIST, 1, 0, 0, 0, XCP_ERR_DAQ_CONFIG,
+            "DAQ list with more ODTs than XCP_MAX_FRAMES_PER_EVENT");
+    TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 1, 1, 0, 0, "start DAQ list 1");
+    TEST_Negative(XCP_CMD_START_STOP_DAQ_LIST, 1, 2, 0, 0, XCP_ERR_DAQ_CONFIG,
+            "running lists of one event channel above XCP_MAX_FRAMES_PER_EVENT");
+    TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 2, 2, 0, 0, "select DAQ list 2");
+    TEST_Negative(XCP_CMD_START_STOP_SYNCH, 1, 0, 0, 0, XCP_ERR_DAQ_CONFIG,
+            "selected lists above XCP_MAX_FRAMES_PER_EVENT");
+    TEST_Positive(XCP_CMD_START_STOP_SYNCH, 0, 0, 0, 0, "START_STOP_SYNCH stop");
+    TEST_Positive(XCP_CMD_SET_DAQ_LIST_MODE, 0, 2, 0, XCP_EVENT_1MS | (1u << 16), "SET_DAQ_LIST_MODE");
+    TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 1, 1, 0, 0, "start DAQ list 1");
+    TEST_Positive(XCP_CMD_START_STOP_DAQ_LIST, 1, 2, 0, 0, "start DAQ list 2 on another event channel");
+
+    for (uint8_t channel = 0; channel < XCP_EVENT_MAX; channel++) {
+        uint8_t frames = TEST_Event((XCP_EVENT_CHANNEL_e)channel);
+        if (frames > maxFrames) {
+            maxFrames = frames;
+        }
+    }
+    TEST_Check((maxFrames > 0u) && (maxFrames <= XCP_MAX_FRAMES_PER_EVENT), "frames per event");
+    TEST_Positive(XCP_CMD_START_STOP_SYNCH, 0, 0, 0, 0, "START_STOP_SYNCH stop");
+}
+
+
+int main(void) {
+    test_readAreas[0].start = TEST_Address(&test_memory[0]);
+    test_readAreas[0].length = sizeof(test_memory);
+
+    TEST_Connect();
+    TEST_Upload();
+    TEST_Download();
+    TEST_Daq();
+    TEST_EventLoad();
+
+    if (test_nrOfFailures > 0) {
+        printf("FAIL: %u checks failed\n", (unsigned)test_nrOfFailures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}